@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck/ck.hpp"
+#include "ck/utility/common_header.hpp"
+#include "ck/tensor_description/tensor_descriptor.hpp"
+#include "ck/tensor_description/tensor_descriptor_helper.hpp"
+
+// number of distinct instantiations of every descriptor chain in a translation unit, the compile
+// time of each unit is roughly linear in it
+#ifndef CK_COMPILE_TIME_BENCHMARK_SCALE
+#define CK_COMPILE_TIME_BENCHMARK_SCALE 16
+#endif
+
+namespace ck {
+namespace compile_time_benchmark {
+
+inline constexpr index_t scale = CK_COMPILE_TIME_BENCHMARK_SCALE;
+
+// calls f(Number<I>{}) for I in [0, scale) and sums the results, so that every chain is
+// instantiated and none of them can be dropped as unused
+template <typename F, index_t... Is>
+index_t instantiate_chains(F f, Sequence<Is...>)
+{
+    return (f(Number<Is>{}) + ... + 0);
+}
+
+template <typename F>
+index_t instantiate_chains(F f)
+{
+    return instantiate_chains(f, typename arithmetic_sequence_gen<0, scale, 1>::type{});
+}
+
+// walks a coordinate over the first element of every step along the last dimension, the way the
+// threadwise copies do. This instantiates CalculateLowerIndex/UpdateLowerIndex of every transform
+template <typename Desc, typename Step>
+index_t walk_descriptor(const Desc& desc, const Step& step_idx, index_t num_steps)
+{
+    constexpr index_t ndim = Desc::GetNumOfDimension();
+
+    auto coord      = make_tensor_coordinate(desc, make_zero_multi_index<ndim>());
+    const auto step = make_tensor_coordinate_step(desc, step_idx);
+
+    index_t sum = coord.GetOffset();
+    for(index_t i = 1; i < num_steps; ++i)
+    {
+        move_tensor_coordinate(desc, coord, step);
+        if(coordinate_has_valid_offset_assuming_visible_index_is_valid(desc, coord))
+            sum += coord.GetOffset();
+    }
+    return sum;
+}
+
+} // namespace compile_time_benchmark
+} // namespace ck
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+// Grouped conv fwd descriptor chains: the NDHWGC input / KZYXGC weight / NDHWGK output of a 1d, 2d
+// or 3d conv (and its 1x1 specializations) lowered to GEMM by TransformConvFwdToGemm, then padded
+// to the tile and split into [K0, M/N, K1] as in DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle
+
+#include <array>
+
+#include "common.hpp"
+#include "ck/tensor_operation/gpu/device/matrix_padder.hpp"
+#include "ck/tensor_operation/operator_transform/transform_conv_fwd_to_gemm.hpp"
+
+namespace ck {
+namespace compile_time_benchmark {
+namespace {
+
+using tensor_operation::device::ConvolutionForwardSpecialization;
+using tensor_operation::device::GemmSpecialization;
+using tensor_operation::device::MatrixPadder;
+namespace ctl = tensor_layout::convolution;
+
+constexpr ConvolutionForwardSpecialization conv_specs[] = {
+    ConvolutionForwardSpecialization::Default,
+    ConvolutionForwardSpecialization::Filter1x1Pad0,
+    ConvolutionForwardSpecialization::Filter1x1Stride1Pad0};
+
+template <index_t NDimSpatial>
+struct ConvLayouts;
+
+template <>
+struct ConvLayouts<1>
+{
+    using ALayout = ctl::NWGC;
+    using BLayout = ctl::KXGC;
+    using ELayout = ctl::NWGK;
+};
+
+template <>
+struct ConvLayouts<2>
+{
+    using ALayout = ctl::NHWGC;
+    using BLayout = ctl::KYXGC;
+    using ELayout = ctl::NHWGK;
+};
+
+template <>
+struct ConvLayouts<3>
+{
+    using ALayout = ctl::NDHWGC;
+    using BLayout = ctl::KZYXGC;
+    using ELayout = ctl::NDHWGK;
+};
+
+template <index_t I>
+struct ConvTile
+{
+    static constexpr index_t NDimSpatial = 3 - I % 3;
+
+    static constexpr ConvolutionForwardSpecialization ConvSpec = conv_specs[(I / 3) % 3];
+
+    static constexpr auto K1        = Number<2 << (I % 3)>{};
+    static constexpr auto MPerBlock = Number<64 * (1 + I % 4)>{};
+    static constexpr auto NPerBlock = Number<64 * (1 + (I / 4) % 4)>{};
+    static constexpr auto KPerBlock = Number<K1 * (2 + (I / 2) % 3)>{};
+};
+
+// [G, N, C, spatial...] lengths and strides of a packed NDHWGC-like tensor
+template <index_t NDimSpatial>
+void make_gnc_wis(index_t G,
+                  index_t N,
+                  index_t C,
+                  index_t spatial,
+                  std::array<index_t, NDimSpatial + 3>& lengths,
+                  std::array<index_t, NDimSpatial + 3>& strides)
+{
+    lengths[0] = G;
+    lengths[1] = N;
+    lengths[2] = C;
+    for(index_t d = 0; d < NDimSpatial; ++d)
+        lengths[3 + d] = spatial;
+
+    // memory order N, spatial..., G, C
+    strides[2]  = 1;
+    strides[0]  = C;
+    index_t acc = G * C;
+    for(index_t d = NDimSpatial - 1; d >= 0; --d)
+    {
+        strides[3 + d] = acc;
+        acc *= spatial;
+    }
+    strides[1] = acc;
+}
+
+template <index_t I>
+index_t conv_fwd_chain(index_t G, index_t N, index_t K, index_t C, index_t spatial)
+{
+    using Tile    = ConvTile<I>;
+    using Layouts = ConvLayouts<Tile::NDimSpatial>;
+
+    constexpr index_t NDimSpatial = Tile::NDimSpatial;
+    constexpr bool is_filter_1x1  = Tile::ConvSpec != ConvolutionForwardSpecialization::Default;
+
+    constexpr auto I0 = Number<0>{};
+    constexpr auto I1 = Number<1>{};
+    constexpr auto K1 = Tile::K1;
+
+    const index_t filter = is_filter_1x1 ? 1 : 3;
+    const index_t pad    = is_filter_1x1 ? 0 : 1;
+
+    std::array<index_t, NDimSpatial + 3> a_lengths, a_strides, b_lengths, b_strides, e_lengths,
+        e_strides;
+    std::array<index_t, NDimSpatial> conv_strides, conv_dilations, left_pads, right_pads;
+    make_gnc_wis<NDimSpatial>(G, N, C, spatial, a_lengths, a_strides);
+    make_gnc_wis<NDimSpatial>(G, K, C, filter, b_lengths, b_strides);
+    make_gnc_wis<NDimSpatial>(G, N, K, spatial, e_lengths, e_strides);
+    conv_strides.fill(1);
+    conv_dilations.fill(1);
+    left_pads.fill(pad);
+    right_pads.fill(pad);
+
+    using Transform = tensor_operation::TransformConvFwdToGemm<NDimSpatial, Tile::ConvSpec>;
+
+    const auto a_grid_desc_mraw_kraw =
+        Transform::template MakeADescriptor_M_K<typename Layouts::ALayout>(a_lengths,
+                                                                           a_strides,
+                                                                           b_lengths,
+                                                                           b_strides,
+                                                                           e_lengths,
+                                                                           e_strides,
+                                                                           conv_strides,
+                                                                           conv_dilations,
+                                                                           left_pads,
+                                                                           right_pads);
+    const auto b_grid_desc_nraw_kraw =
+        Transform::template MakeBDescriptor_N_K<typename Layouts::BLayout>(b_lengths, b_strides);
+    const auto e_grid_desc_mraw_nraw =
+        Transform::template MakeCDescriptor_M_N<typename Layouts::ELayout>(e_lengths, e_strides);
+
+    const auto padder = MatrixPadder<GemmSpecialization::MNKPadding, index_t, index_t, index_t>{
+        Tile::MPerBlock, Tile::NPerBlock, Tile::KPerBlock};
+
+    const auto a_grid_desc_m_k = padder.PadADescriptor_M_K(a_grid_desc_mraw_kraw);
+    const auto b_grid_desc_n_k = padder.PadBDescriptor_N_K(b_grid_desc_nraw_kraw);
+    const auto e_grid_desc_m_n = padder.PadCDescriptor_M_N(e_grid_desc_mraw_nraw);
+
+    const auto a_grid_desc_ak0_m_ak1 =
+        transform_tensor_descriptor(a_grid_desc_m_k,
+                                    make_tuple(make_unmerge_transform(make_tuple(
+                                                   a_grid_desc_m_k.GetLength(I1) / K1, K1)),
+                                               make_pass_through_transform(
+                                                   a_grid_desc_m_k.GetLength(I0))),
+                                    make_tuple(Sequence<1>{}, Sequence<0>{}),
+                                    make_tuple(Sequence<0, 2>{}, Sequence<1>{}));
+    const auto b_grid_desc_bk0_n_bk1 =
+        transform_tensor_descriptor(b_grid_desc_n_k,
+                                    make_tuple(make_unmerge_transform(make_tuple(
+                                                   b_grid_desc_n_k.GetLength(I1) / K1, K1)),
+                                               make_pass_through_transform(
+                                                   b_grid_desc_n_k.GetLength(I0))),
+                                    make_tuple(Sequence<1>{}, Sequence<0>{}),
+                                    make_tuple(Sequence<0, 2>{}, Sequence<1>{}));
+    const auto e_grid_desc_mblock_mperblock_nblock_nperblock = transform_tensor_descriptor(
+        e_grid_desc_m_n,
+        make_tuple(make_unmerge_transform(make_tuple(
+                       e_grid_desc_m_n.GetLength(I0) / Tile::MPerBlock, Tile::MPerBlock)),
+                   make_unmerge_transform(make_tuple(
+                       e_grid_desc_m_n.GetLength(I1) / Tile::NPerBlock, Tile::NPerBlock))),
+        make_tuple(Sequence<0>{}, Sequence<1>{}),
+        make_tuple(Sequence<0, 1>{}, Sequence<2, 3>{}));
+
+    // moving along K0 goes through the merge of the filter and C dimensions of the input
+    return walk_descriptor(a_grid_desc_ak0_m_ak1, make_multi_index(1, 0, 0), 8) +
+           walk_descriptor(b_grid_desc_bk0_n_bk1, make_multi_index(1, 0, 0), 8) +
+           walk_descriptor(e_grid_desc_mblock_mperblock_nblock_nperblock,
+                           make_multi_index(0, 0, 0, 1),
+                           8);
+}
+
+} // namespace
+} // namespace compile_time_benchmark
+} // namespace ck
+
+ck::index_t ck_compile_time_benchmark_conv_fwd_ndhwgc_to_gemm(
+    ck::index_t G, ck::index_t N, ck::index_t K, ck::index_t C, ck::index_t spatial)
+{
+    return ck::compile_time_benchmark::instantiate_chains([&](auto i) {
+        return ck::compile_time_benchmark::conv_fwd_chain<i.value>(G, N, K, C, spatial);
+    });
+}
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+// GEMM descriptor chains of the xdl gridwise gemms: A/B [M/N, K] padded to the tile, split into
+// [K0, M/N, K1], E [M, N] split into [MBlock, MPerBlock, NBlock, NPerBlock], and the compile-time
+// LDS block descriptors split per xdl wave. Every chain I uses its own tile sizes and K1, like the
+// instances of a device op do
+
+#include "common.hpp"
+#include "ck/tensor_operation/gpu/device/matrix_padder.hpp"
+
+namespace ck {
+namespace compile_time_benchmark {
+namespace {
+
+using tensor_operation::device::GemmSpecialization;
+using tensor_operation::device::MatrixPadder;
+
+constexpr GemmSpecialization gemm_specs[] = {GemmSpecialization::Default,
+                                             GemmSpecialization::MNKPadding,
+                                             GemmSpecialization::MNPadding,
+                                             GemmSpecialization::KPadding};
+
+template <index_t I>
+struct GemmTile
+{
+    static constexpr auto K1         = Number<2 << (I % 3)>{};
+    static constexpr auto MPerBlock  = Number<64 * (1 + I % 4)>{};
+    static constexpr auto NPerBlock  = Number<64 * (1 + (I / 4) % 4)>{};
+    static constexpr auto KPerBlock  = Number<K1 * (2 + (I / 2) % 3)>{};
+    static constexpr auto K0PerBlock = Number<KPerBlock / K1>{};
+    static constexpr auto MPerXdl    = Number<(I % 2 == 0) ? 32 : 16>{};
+    static constexpr auto MWaves     = Number<2>{};
+    static constexpr auto MRepeat    = Number<MPerBlock / (MWaves * MPerXdl)>{};
+
+    static constexpr GemmSpecialization GemmSpec = gemm_specs[I % 4];
+    static constexpr bool is_a_row_major         = (I / 3) % 2 == 0;
+};
+
+template <index_t I>
+index_t gemm_chain(index_t M, index_t N, index_t K, index_t StrideA, index_t StrideE)
+{
+    using Tile = GemmTile<I>;
+
+    constexpr auto I0 = Number<0>{};
+    constexpr auto I1 = Number<1>{};
+    constexpr auto K1 = Tile::K1;
+
+    const auto padder = MatrixPadder<Tile::GemmSpec, index_t, index_t, index_t>{
+        Tile::MPerBlock, Tile::NPerBlock, Tile::KPerBlock};
+
+    // A[M, K] -> [AK0, M, AK1]
+    const auto a_grid_desc_mraw_kraw = [&]() {
+        if constexpr(Tile::is_a_row_major)
+            return make_naive_tensor_descriptor(make_tuple(M, K), make_tuple(StrideA, I1));
+        else
+            return make_naive_tensor_descriptor(make_tuple(M, K), make_tuple(I1, StrideA));
+    }();
+    const auto a_grid_desc_m_k = padder.PadADescriptor_M_K(a_grid_desc_mraw_kraw);
+    const auto a_grid_desc_ak0_m_ak1 =
+        transform_tensor_descriptor(a_grid_desc_m_k,
+                                    make_tuple(make_unmerge_transform(make_tuple(
+                                                   a_grid_desc_m_k.GetLength(I1) / K1, K1)),
+                                               make_pass_through_transform(
+                                                   a_grid_desc_m_k.GetLength(I0))),
+                                    make_tuple(Sequence<1>{}, Sequence<0>{}),
+                                    make_tuple(Sequence<0, 2>{}, Sequence<1>{}));
+
+    // B[N, K] -> [BK0, N, BK1]
+    const auto b_grid_desc_n_k = padder.PadBDescriptor_N_K(
+        make_naive_tensor_descriptor(make_tuple(N, K), make_tuple(K, I1)));
+    const auto b_grid_desc_bk0_n_bk1 =
+        transform_tensor_descriptor(b_grid_desc_n_k,
+                                    make_tuple(make_unmerge_transform(make_tuple(
+                                                   b_grid_desc_n_k.GetLength(I1) / K1, K1)),
+                                               make_pass_through_transform(
+                                                   b_grid_desc_n_k.GetLength(I0))),
+                                    make_tuple(Sequence<1>{}, Sequence<0>{}),
+                                    make_tuple(Sequence<0, 2>{}, Sequence<1>{}));
+
+    // E[M, N] -> [MBlock, MPerBlock, NBlock, NPerBlock]
+    const auto e_grid_desc_m_n = padder.PadCDescriptor_M_N(
+        make_naive_tensor_descriptor(make_tuple(M, N), make_tuple(StrideE, I1)));
+    const auto e_grid_desc_mblock_mperblock_nblock_nperblock = transform_tensor_descriptor(
+        e_grid_desc_m_n,
+        make_tuple(make_unmerge_transform(make_tuple(
+                       e_grid_desc_m_n.GetLength(I0) / Tile::MPerBlock, Tile::MPerBlock)),
+                   make_unmerge_transform(make_tuple(
+                       e_grid_desc_m_n.GetLength(I1) / Tile::NPerBlock, Tile::NPerBlock))),
+        make_tuple(Sequence<0>{}, Sequence<1>{}),
+        make_tuple(Sequence<0, 1>{}, Sequence<2, 3>{}));
+
+    // A in LDS [AK0, MPerBlock, AK1] -> [AK0, MRepeat, MWaves, MPerXdl, AK1], all compile-time
+    constexpr auto a_block_desc_ak0_m_ak1 = make_naive_tensor_descriptor(
+        make_tuple(Tile::K0PerBlock, Tile::MPerBlock, K1),
+        make_tuple(Number<Tile::MPerBlock + 1>{} * K1, K1, I1));
+    constexpr auto a_block_desc_k0_m0_m1_m2_k1 = transform_tensor_descriptor(
+        a_block_desc_ak0_m_ak1,
+        make_tuple(make_pass_through_transform(Tile::K0PerBlock),
+                   make_unmerge_transform(make_tuple(Tile::MRepeat, Tile::MWaves, Tile::MPerXdl)),
+                   make_pass_through_transform(K1)),
+        make_tuple(Sequence<0>{}, Sequence<1>{}, Sequence<2>{}),
+        make_tuple(Sequence<0>{}, Sequence<1, 2, 3>{}, Sequence<4>{}));
+    static_assert(a_block_desc_k0_m0_m1_m2_k1.GetElementSpaceSize() > 0);
+
+    // per-thread steps of the blockwise copies
+    return walk_descriptor(a_grid_desc_ak0_m_ak1, make_multi_index(1, 0, 0), 8) +
+           walk_descriptor(b_grid_desc_bk0_n_bk1, make_multi_index(1, 0, 0), 8) +
+           walk_descriptor(e_grid_desc_mblock_mperblock_nblock_nperblock,
+                           make_multi_index(0, 0, 0, 1),
+                           8) +
+           walk_descriptor(a_block_desc_k0_m0_m1_m2_k1, make_multi_index(0, 0, 0, 1, 0), 4);
+}
+
+} // namespace
+} // namespace compile_time_benchmark
+} // namespace ck
+
+ck::index_t ck_compile_time_benchmark_gemm_k0_m_k1(ck::index_t M, ck::index_t N, ck::index_t K)
+{
+    return ck::compile_time_benchmark::instantiate_chains(
+        [&](auto i) { return ck::compile_time_benchmark::gemm_chain<i.value>(M, N, K, K, N); });
+}
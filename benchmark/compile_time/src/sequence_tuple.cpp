@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+// The Sequence/Tuple metafunctions the descriptors are built on, instantiated directly on 4 to 16
+// element sequences: sorting, map inversion, scans, and reordering/scanning tuples of Numbers.
+// This keeps their cost visible apart from the descriptor chains that use them
+
+#include "common.hpp"
+
+namespace ck {
+namespace compile_time_benchmark {
+namespace {
+
+// a permutation of [0, NSize): k -> (k * (NSize - 1) + I) % NSize
+template <index_t I, index_t NSize>
+struct PermutationGen
+{
+    __host__ __device__ constexpr index_t operator()(index_t k) const
+    {
+        return (k * (NSize - 1) + I) % NSize;
+    }
+};
+
+// unsorted values with duplicates, like the dimension ids handled by the descriptors
+template <index_t I, index_t NSize>
+struct ValueGen
+{
+    __host__ __device__ constexpr index_t operator()(index_t k) const
+    {
+        return (k * 37 + I * 11) % (2 * NSize);
+    }
+};
+
+template <index_t I>
+index_t sequence_tuple_chain(index_t x)
+{
+    constexpr index_t NSize = 4 + I % 13;
+
+    using Permutation = typename sequence_gen<NSize, PermutationGen<I, NSize>>::type;
+    using Values      = typename sequence_gen<NSize, ValueGen<I, NSize>>::type;
+
+    // sequence.hpp
+    using Sorted       = typename sequence_sort<Values, math::less<index_t>>::type;
+    using UniqueSorted = typename sequence_unique_sort<Values,
+                                                       math::less<index_t>,
+                                                       math::equal<index_t>>::type;
+    using Inverse      = typename sequence_map_inverse<Permutation>::type;
+    static_assert(is_valid_sequence_map<Permutation>::value);
+    static_assert(is_valid_sequence_map<Inverse>::value);
+    static_assert(Sorted::Size() == NSize && UniqueSorted::Size() <= NSize);
+
+    constexpr auto strides =
+        reverse_exclusive_scan_sequence(Values{}, math::plus<index_t>{}, Number<1>{});
+    constexpr auto offsets =
+        inclusive_scan_sequence(Sorted{}, math::plus<index_t>{}, Number<0>{});
+
+    // tuple.hpp: tuples of Numbers and of runtime values, as in the descriptor lengths
+    const auto lengths = generate_tuple(
+        [&](auto i) {
+            if constexpr(i % 2 == 0)
+                return Number<Values::At(i) + 1>{};
+            else
+                return x + i;
+        },
+        Number<NSize>{});
+    const auto reordered = container_reorder_given_new2old(lengths, Permutation{});
+    const auto restored  = container_reorder_given_old2new(reordered, Permutation{});
+    const auto scanned   = container_reverse_exclusive_scan(
+        restored, [](auto a, auto b) { return a + b; }, Number<0>{});
+
+    return scanned[Number<0>{}] + strides[Number<0>{}] + offsets[Number<NSize - 1>{}] +
+           Inverse::At(Number<0>{});
+}
+
+} // namespace
+} // namespace compile_time_benchmark
+} // namespace ck
+
+ck::index_t ck_compile_time_benchmark_sequence_tuple(ck::index_t x)
+{
+    return ck::compile_time_benchmark::instantiate_chains(
+        [&](auto i) { return ck::compile_time_benchmark::sequence_tuple_chain<i.value>(x); });
+}
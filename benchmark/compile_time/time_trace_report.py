@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+# aggregate the clang -ftime-trace reports of a build into per-template instantiation and per-target
+# compile cost reports
+
+import argparse
+import json
+import re
+import sys
+from collections import defaultdict
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+INSTANTIATE_EVENTS = ("InstantiateClass", "InstantiateFunction")
+
+# "operator<", "operator<<=", ... are part of the name, not the start of a template argument list
+OPERATORS = ["<=>", "<<=", "<<", "<=", "<", ">>=", ">>", ">=", ">", "()", "[]"]
+
+
+def match_operator(detail: str, i: int) -> Optional[str]:
+    if not detail.startswith("operator", i):
+        return None
+    rest = detail[i + len("operator"):]
+    for op in OPERATORS:
+        # operator<<int> is operator< with template arguments, the brackets after it have to balance
+        if rest.startswith(op) and rest[len(op):].count(">") <= rest[len(op):].count("<"):
+            return "operator" + op
+    return None
+
+
+def template_name(detail: str) -> str:
+    """ck::sequence_sort_impl<ck::Sequence<3, 1>, ...> -> ck::sequence_sort_impl"""
+    out = []
+    depth = 0
+    i = 0
+    while i < len(detail):
+        op = match_operator(detail, i) if depth == 0 else None
+        if op is not None:
+            out.append(op)
+            i += len(op)
+            continue
+        c = detail[i]
+        if c == "<":
+            depth += 1
+        elif c == ">" and depth > 0:
+            depth -= 1
+        elif depth == 0:
+            out.append(c)
+        i += 1
+    return "".join(out).strip()
+
+
+class Stat:
+    def __init__(self):
+        self.count = 0
+        self.total_us = 0
+        self.self_us = 0
+
+    def to_dict(self):
+        return {"count": self.count, "total_us": self.total_us, "self_us": self.self_us}
+
+
+def find_traces(paths: List[str]) -> List[Path]:
+    traces = []
+    for p in map(Path, paths):
+        if p.is_dir():
+            traces.extend(sorted(p.rglob("*.json")))
+        else:
+            traces.append(p)
+    return traces
+
+
+def unit_source(trace: Path) -> Optional[Tuple[str, str]]:
+    """.../CMakeFiles/device_gemm_instance.dir/dir/x.cpp-hip-amdgcn-amd-amdhsa-gfx90a.json
+    -> ("device_gemm_instance", "dir/x.cpp"), the device and host traces of a unit share it"""
+    parts = trace.parts
+    for i in range(len(parts) - 2, -1, -1):
+        if parts[i] == "CMakeFiles" and parts[i + 1].endswith(".dir"):
+            source = "/".join(parts[i + 2:])
+            source = re.sub(r"(-hip-.*|-host-.*)?\.json$", "", source)
+            return parts[i + 1][:-len(".dir")], re.sub(r"\.o$", "", source)
+    return None
+
+
+def aggregate(trace: Path, stats: Dict[str, Stat]) -> Optional[Tuple[int, int]]:
+    """adds the instantiations of one trace to stats, returns the frontend and the total compile
+    time of the unit"""
+    try:
+        events = json.loads(trace.read_text()).get("traceEvents")
+    except (json.JSONDecodeError, AttributeError, UnicodeDecodeError):
+        return None
+    if not isinstance(events, list):
+        return None
+
+    frontend_us = 0
+    backend_us = 0
+    compiler_us = 0
+    per_thread = defaultdict(list)
+    for e in events:
+        if e.get("ph") != "X":
+            continue
+        if e.get("name") == "Frontend":
+            frontend_us += e.get("dur", 0)
+        elif e.get("name") == "Backend":
+            backend_us += e.get("dur", 0)
+        elif e.get("name") == "ExecuteCompiler":
+            compiler_us += e.get("dur", 0)
+        elif e.get("name") in INSTANTIATE_EVENTS:
+            per_thread[e.get("tid")].append(e)
+
+    # instantiations nest, the self time of an event is its duration minus that of its children
+    for thread_events in per_thread.values():
+        thread_events.sort(key=lambda e: (e["ts"], -e["dur"]))
+        stack = []  # [end, name, child_us, dur]
+
+        def pop(stack):
+            end, name, child_us, dur = stack.pop()
+            stats[name].self_us += dur - child_us
+            if stack:
+                stack[-1][2] += dur
+
+        for e in thread_events:
+            while stack and stack[-1][0] <= e["ts"]:
+                pop(stack)
+            name = template_name(e.get("args", {}).get("detail", "<unknown>"))
+            stats[name].count += 1
+            stats[name].total_us += e["dur"]
+            stack.append([e["ts"] + e["dur"], name, 0, e["dur"]])
+        while stack:
+            pop(stack)
+
+    return frontend_us, compiler_us or frontend_us + backend_us
+
+
+def print_table(title, rows, key):
+    print(title)
+    print(f"{'self ms':>10} {'total ms':>10} {'count':>8}  template")
+    for name, s in sorted(rows.items(), key=lambda kv: kv[1][key], reverse=True):
+        print(f"{s['self_us'] / 1000:10.1f} {s['total_us'] / 1000:10.1f} {s['count']:8d}  {name}")
+    print()
+
+
+def print_targets(targets, top):
+    print(f"top {top} targets by compile time")
+    print(f"{'total s':>10} {'front s':>10} {'max s':>10} {'units':>8}  target")
+    for name, t in sorted(targets.items(), key=lambda kv: kv[1]["total_us"], reverse=True)[:top]:
+        print(f"{t['total_us'] / 1e6:10.1f} {t['frontend_us'] / 1e6:10.1f} "
+              f"{t['max_unit_us'] / 1e6:10.1f} {t['units']:8d}  {name}")
+    print()
+
+
+def compare(report, baseline, threshold):
+    """prints the templates whose self time grew by more than threshold percent, returns how many"""
+    regressions = 0
+    base = baseline["templates"]
+    cur = report["templates"]
+    print(f"against baseline, threshold {threshold}%")
+    print(f"{'base ms':>10} {'ms':>10} {'change':>8}  template")
+
+    def line(name, b, c):
+        change = (c - b) * 100.0 / b if b > 0 else float("inf")
+        print(f"{b / 1000:10.1f} {c / 1000:10.1f} {change:7.1f}%  {name}")
+        return change
+
+    b = baseline["instantiate_self_us"]
+    c = report["instantiate_self_us"]
+    if line("<all instantiations>", b, c) > threshold:
+        regressions += 1
+    for name in sorted(set(base) | set(cur), key=lambda n: -cur.get(n, {}).get("self_us", 0)):
+        b = base.get(name, {}).get("self_us", 0)
+        c = cur.get(name, {}).get("self_us", 0)
+        # ignore noise on templates too cheap to matter
+        if max(b, c) < report["min_us"]:
+            continue
+        if c > b * (1 + threshold / 100.0):
+            line(name, b, c)
+            regressions += 1
+    print()
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="aggregate clang -ftime-trace reports into per-template instantiation costs")
+    parser.add_argument("paths", nargs="+", help="trace files or directories searched for *.json")
+    parser.add_argument("--top", type=int, default=40, help="number of templates listed")
+    parser.add_argument("--output", type=str, default=None, help="write the report as json")
+    parser.add_argument("--baseline", type=str, default=None, help="report of a previous run")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="regression threshold in percent against the baseline")
+    parser.add_argument("--min-us", type=int, default=10000,
+                        help="templates below this self time are not compared to the baseline")
+    parser.add_argument("--cost-table", type=str, default=None,
+                        help="write the compile time of every source of the cmake targets, "
+                        "as read by the unity build of the instance library")
+    args = parser.parse_args()
+
+    stats = defaultdict(Stat)
+    units = {}
+    # compile time of every source of a target, summed over its device and host traces
+    source_us = defaultdict(lambda: [0, 0])
+    for trace in find_traces(args.paths):
+        times = aggregate(trace, stats)
+        if times is None:
+            continue
+        units[str(trace)] = times[0]
+        source = unit_source(trace)
+        if source is not None:
+            source_us[source][0] += times[0]
+            source_us[source][1] += times[1]
+    if not units:
+        print("no -ftime-trace reports found in " + " ".join(args.paths), file=sys.stderr)
+        return 1
+
+    report = {
+        "units": units,
+        "frontend_us": sum(units.values()),
+        "instantiate_self_us": sum(s.self_us for s in stats.values()),
+        "min_us": args.min_us,
+        "templates": {name: s.to_dict() for name, s in stats.items()},
+    }
+
+    targets = {}
+    for (target, _), (frontend_us, total_us) in source_us.items():
+        t = targets.setdefault(target,
+                               {"units": 0, "frontend_us": 0, "total_us": 0, "max_unit_us": 0})
+        t["units"] += 1
+        t["frontend_us"] += frontend_us
+        t["total_us"] += total_us
+        t["max_unit_us"] = max(t["max_unit_us"], total_us)
+    report["targets"] = targets
+
+    print(f"{len(units)} units, frontend {report['frontend_us'] / 1e6:.2f} s, "
+          f"instantiation {report['instantiate_self_us'] / 1e6:.2f} s\n")
+    top = dict(sorted(report["templates"].items(), key=lambda kv: kv[1]["self_us"],
+                      reverse=True)[:args.top])
+    print_table(f"top {args.top} templates by self time", top, "self_us")
+    top = dict(sorted(report["templates"].items(), key=lambda kv: kv[1]["count"],
+                      reverse=True)[:args.top])
+    print_table(f"top {args.top} templates by instantiation count", top, "count")
+    if targets:
+        print_targets(targets, args.top)
+
+    if args.output:
+        Path(args.output).write_text(json.dumps(report, indent=1, sort_keys=True))
+    if args.cost_table:
+        costs = {f"{t}/{s}": round(us[1] / 1000, 1) for (t, s), us in source_us.items()}
+        Path(args.cost_table).write_text(json.dumps({"units_ms": costs}, indent=1, sort_keys=True))
+
+    if args.baseline:
+        baseline = json.loads(Path(args.baseline).read_text())
+        if compare(report, baseline, args.threshold) > 0:
+            return 2
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+// Run time of the loops of ReferenceGemm and ReferenceConvFwd (2d, GNHWC) for every traversal order
+// of ParallelTensorFunctor. The loop bodies are the ones of the references, with float data and
+// without elementwise operations.
+
+namespace {
+
+const std::array<std::pair<HostTraversalEnum, const char*>, 4> traversals{
+    {{HostTraversalEnum::RowMajor, "row-major"},
+     {HostTraversalEnum::Tiled, "tiled"},
+     {HostTraversalEnum::Snake, "snake"},
+     {HostTraversalEnum::Morton, "morton"}}};
+
+// fastest of repeat runs, the host timings are noisy
+template <typename F>
+double TimeMs(F f, int repeat)
+{
+    double min_ms = std::numeric_limits<double>::max();
+    for(int i = 0; i < repeat; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto end = std::chrono::steady_clock::now();
+        min_ms = std::min(min_ms, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return min_ms;
+}
+
+void Report(const char* traversal, double ms, double baseline_ms, const std::vector<float>& out)
+{
+    double checksum = 0;
+    for(float v : out)
+        checksum += v;
+    std::cout << std::setw(12) << traversal << std::fixed << std::setprecision(1) << std::setw(10)
+              << ms << " ms" << std::setprecision(2) << std::setw(8) << baseline_ms / ms << "x"
+              << "  checksum " << std::setprecision(3) << checksum << std::endl;
+}
+
+void BenchmarkGemm(std::size_t M,
+                   std::size_t N,
+                   std::size_t K,
+                   std::size_t tile_len,
+                   std::size_t num_thread,
+                   int repeat)
+{
+    // row-major A and B, as in the gemm examples
+    Tensor<float> a_m_k({M, K}, {K, std::size_t{1}});
+    Tensor<float> b_k_n({K, N}, {N, std::size_t{1}});
+    Tensor<float> c_m_n({M, N}, {N, std::size_t{1}});
+    for(std::size_t i = 0; i < a_m_k.mData.size(); ++i)
+        a_m_k.mData[i] = static_cast<float>(i % 7) - 3;
+    for(std::size_t i = 0; i < b_k_n.mData.size(); ++i)
+        b_k_n.mData[i] = static_cast<float>(i % 5) - 2;
+
+    auto f_mk_kn_mn = [&](auto m, auto n) {
+        float v_acc = 0;
+        for(std::size_t k = 0; k < K; ++k)
+        {
+            v_acc += a_m_k(m, k) * b_k_n(k, n);
+        }
+        c_m_n(m, n) = v_acc;
+    };
+
+    std::cout << "gemm M " << M << ", N " << N << ", K " << K << ", tiles " << tile_len << "x"
+              << tile_len << std::endl;
+    double baseline_ms = 0;
+    for(const auto& [traversal, name] : traversals)
+    {
+        const double ms = TimeMs(
+            [&] {
+                make_ParallelTensorFunctor(f_mk_kn_mn, M, N)
+                    .SetTraversal(traversal, tile_len)(num_thread);
+            },
+            repeat);
+        baseline_ms = traversal == HostTraversalEnum::RowMajor ? ms : baseline_ms;
+        Report(name, ms, baseline_ms, c_m_n.mData);
+    }
+}
+
+void BenchmarkConvFwd(std::size_t N,
+                      std::size_t K,
+                      std::size_t C,
+                      std::size_t Hi,
+                      std::size_t Wi,
+                      const std::array<std::size_t, 5>& tile_lens,
+                      std::size_t num_thread,
+                      int repeat)
+{
+    // 3x3 filter, stride 1 and pad 1, in the GNHWC/GKYXC/GNHWK layouts of the conv examples
+    const std::size_t G = 1, Y = 3, X = 3, Ho = Hi, Wo = Wi;
+    Tensor<float> input({G, N, C, Hi, Wi}, {C, Hi * Wi * G * C, std::size_t{1}, Wi * G * C, G * C});
+    Tensor<float> weight({G, K, C, Y, X}, {K * Y * X * C, Y * X * C, std::size_t{1}, X * C, C});
+    Tensor<float> output({G, N, K, Ho, Wo},
+                         {K, Ho * Wo * G * K, std::size_t{1}, Wo * G * K, G * K});
+    for(std::size_t i = 0; i < input.mData.size(); ++i)
+        input.mData[i] = static_cast<float>(i % 7) - 3;
+    for(std::size_t i = 0; i < weight.mData.size(); ++i)
+        weight.mData[i] = static_cast<float>(i % 5) - 2;
+
+    auto func = [&](auto g, auto n, auto k, auto ho, auto wo) {
+        float v_acc = 0;
+        for(std::size_t c = 0; c < C; ++c)
+        {
+            for(std::size_t y = 0; y < Y; ++y)
+            {
+                auto hi = static_cast<ck::long_index_t>(ho + y) - 1;
+                for(std::size_t x = 0; x < X; ++x)
+                {
+                    auto wi = static_cast<ck::long_index_t>(wo + x) - 1;
+                    if(hi >= 0 && static_cast<std::size_t>(hi) < Hi && wi >= 0 &&
+                       static_cast<std::size_t>(wi) < Wi)
+                    {
+                        v_acc += input(g, n, c, hi, wi) * weight(g, k, c, y, x);
+                    }
+                }
+            }
+        }
+        output(g, n, k, ho, wo) = v_acc;
+    };
+
+    std::cout << "conv fwd N " << N << ", K " << K << ", C " << C << ", Hi " << Hi << ", Wi "
+              << Wi << ", 3x3, tiles " << tile_lens[2] << "x" << tile_lens[3] << "x"
+              << tile_lens[4] << " (K x Ho x Wo)" << std::endl;
+    double baseline_ms = 0;
+    for(const auto& [traversal, name] : traversals)
+    {
+        const double ms = TimeMs(
+            [&] {
+                make_ParallelTensorFunctor(func, G, N, K, Ho, Wo)
+                    .SetTraversal(traversal, tile_lens)(num_thread);
+            },
+            repeat);
+        baseline_ms = traversal == HostTraversalEnum::RowMajor ? ms : baseline_ms;
+        Report(name, ms, baseline_ms, output.mData);
+    }
+}
+
+} // namespace
+
+// host_reference_benchmark [num_thread] [repeat] [M N K tile_len]
+int main(int argc, char* argv[])
+{
+    const std::size_t num_thread =
+        argc > 1 ? std::atoi(argv[1]) : std::max(std::thread::hardware_concurrency(), 1u);
+    const int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    std::size_t M = 512, N = 512, K = 2048, tile_len = 32;
+    if(argc > 6)
+    {
+        M        = std::atoi(argv[3]);
+        N        = std::atoi(argv[4]);
+        K        = std::atoi(argv[5]);
+        tile_len = std::atoi(argv[6]);
+    }
+
+    std::cout << num_thread << " threads, fastest of " << repeat << " runs" << std::endl;
+    BenchmarkGemm(M, N, K, tile_len, num_thread, repeat);
+    BenchmarkConvFwd(1, 64, 128, 56, 56, {1, 1, 16, 4, 16}, num_thread, repeat);
+    return 0;
+}
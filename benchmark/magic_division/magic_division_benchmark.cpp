@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/magic_division.hpp"
+
+// Host throughput of the magic number division against the native integer division, in ns per
+// dividend: a batch of dividends by the same divisor, and the mixed-radix decomposition of 1d
+// indices into the coordinates of a 4d tensor.
+
+template <typename F>
+double TimePerElement(F f, std::size_t num, int repeat)
+{
+    f(); // warm up
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < repeat; ++i)
+        f();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (num * repeat);
+}
+
+// keeps the compiler from dropping the results
+uint32_t Checksum(const std::vector<uint32_t>& v)
+{
+    return std::accumulate(v.begin(), v.end(), uint32_t{0}, [](auto a, auto b) { return a ^ b; });
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t num = argc > 1 ? std::atoll(argv[1]) : (1 << 22);
+    const int repeat      = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::vector<uint32_t> dividends(num);
+    std::iota(dividends.begin(), dividends.end(), 0);
+    std::vector<uint32_t> quotients(num);
+    uint32_t checksum = 0;
+
+    std::cout << num << " dividends, ns per dividend" << std::endl;
+    std::cout << std::setw(12) << "divisor" << std::setw(10) << "native" << std::setw(10)
+              << "MDiv" << std::setw(10) << "batched" << std::endl;
+    // divisors read at runtime, so that the native division is not strength-reduced
+    volatile uint32_t divisors[] = {3, 7, 641, 4096, 65537, 1000003};
+    for(uint32_t divisor : divisors)
+    {
+        const ck::MDiv mdiv(divisor);
+        const double native = TimePerElement(
+            [&] {
+                for(std::size_t i = 0; i < num; ++i)
+                    quotients[i] = dividends[i] / divisor;
+            },
+            num,
+            repeat);
+        checksum ^= Checksum(quotients);
+        const double scalar = TimePerElement(
+            [&] {
+                for(std::size_t i = 0; i < num; ++i)
+                    quotients[i] = mdiv.div(dividends[i]);
+            },
+            num,
+            repeat);
+        checksum ^= Checksum(quotients);
+        const double batched =
+            TimePerElement([&] { mdiv.div(dividends.data(), quotients.data(), num); }, num, repeat);
+        checksum ^= Checksum(quotients);
+        std::cout << std::setw(12) << divisor << std::fixed << std::setprecision(3)
+                  << std::setw(10) << native << std::setw(10) << scalar << std::setw(10) << batched
+                  << std::endl;
+    }
+
+    // [N, C, H, W] indices, as in ParallelTensorFunctor::GetNdIndices
+    volatile uint32_t volatile_lengths[] = {16, 7, 123, 33};
+    const std::array<uint32_t, 4> lengths{
+        volatile_lengths[0], volatile_lengths[1], volatile_lengths[2], volatile_lengths[3]};
+    const ck::MDivMixedRadix<4> radix(lengths);
+    std::vector<uint32_t> coords(num * 4);
+    const double native = TimePerElement(
+        [&] {
+            for(std::size_t i = 0; i < num; ++i)
+            {
+                uint32_t idx = dividends[i];
+                for(int d = 3; d > 0; --d)
+                {
+                    coords[i * 4 + d] = idx % lengths[d];
+                    idx /= lengths[d];
+                }
+                coords[i * 4] = idx;
+            }
+        },
+        num,
+        repeat);
+    checksum ^= Checksum(coords);
+    const double scalar = TimePerElement(
+        [&] {
+            for(std::size_t i = 0; i < num; ++i)
+                radix.decompose(dividends[i], &coords[i * 4]);
+        },
+        num,
+        repeat);
+    checksum ^= Checksum(coords);
+    const double batched = TimePerElement(
+        [&] { radix.decompose(dividends.data(), num, coords.data()); }, num, repeat);
+    checksum ^= Checksum(coords);
+    std::cout << std::setw(12) << "4d index" << std::setw(10) << native << std::setw(10) << scalar
+              << std::setw(10) << batched << std::endl;
+
+    std::cout << "checksum " << checksum << std::endl;
+    return 0;
+}
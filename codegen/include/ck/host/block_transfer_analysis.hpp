@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ck {
+namespace host {
+
+// One side (src or dst) of a ThreadGroupTensorSliceTransfer
+struct BlockTransferAccess
+{
+    std::vector<int> block_slice_lengths;
+    std::vector<int> thread_cluster_lengths;
+    std::vector<int> thread_cluster_arrange_order;
+    std::vector<int> access_order;
+    int vector_dim        = 0;
+    int scalar_per_vector = 1;
+    // lengths and element strides of the tensor, the block slice starts at its origin
+    std::vector<int> tensor_lengths;
+    std::vector<int> tensor_strides;
+    // element offset of an index for tensors that are not strided, e.g. swizzled LDS layouts,
+    // used instead of tensor_strides if set. Negative for padding, e.g. the K1 elements past K
+    // when K is not a multiple of K1.
+    std::function<std::int64_t(const std::vector<int>&)> tensor_offset;
+    int data_bytes = 2;
+};
+
+struct BlockTransferAnalysis
+{
+    // false if the vectors are not contiguous in memory or the threads do not tile the slice
+    bool valid = false;
+    // widest vector the thread slice and the tensor allow along the vector dim
+    int max_scalar_per_vector = 1;
+    // for global memory: bytes of a wavefront request over its number of contiguous byte ranges,
+    // and bytes accessed over bytes of the cache lines touched
+    double contiguous_bytes_per_request = 0;
+    double coalescing_efficiency        = 0;
+    // for LDS: max number of distinct bank words one bank serves in a cycle, 1 is conflict free
+    int lds_bank_conflict_degree = 0;
+};
+
+// Enumerates the vector accesses of every thread the way the threadwise transfers walk their
+// slice (the snake-curved SpaceFillingCurve) and evaluates them wavefront by wavefront
+BlockTransferAnalysis AnalyzeBlockTransfer(const BlockTransferAccess& access,
+                                           int wave_size        = 64,
+                                           int cache_line_bytes = 128);
+
+// Max number of distinct 4-byte words one of the 32 LDS banks has to serve among the lanes of
+// one instruction that access LDS in the same cycle, 1 is conflict free. lane_bytes holds the
+// first byte accessed by every lane, -1 for inactive lanes, and access_bytes the bytes per lane.
+// Wider accesses serve fewer lanes per cycle: 32 lanes for 4 bytes, 8 lanes for 16 bytes.
+int LdsBankConflictDegree(const std::vector<std::int64_t>& lane_bytes, int access_bytes);
+
+// Parses the values of a "ck::Sequence<...>" string
+std::vector<int> ParseSequence(const std::string& s);
+
+} // namespace host
+} // namespace ck
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include "ck/host/types.hpp"
+#include "ck/host/device_gemm_multiple_d/operation.hpp"
+#include "ck/host/device_batched_gemm_multiple_d/problem.hpp"
+
+namespace ck {
+namespace host {
+namespace device_batched_gemm_multiple_d {
+
+// Shares the tuning space of the non-batched GEMM, only the emitted device operation differs
+struct Operation_Xdl_CShuffle : device_gemm_multiple_d::Operation_Xdl_CShuffle
+{
+    static std::vector<std::vector<Operation_Xdl_CShuffle>> CreateOperations();
+    static std::vector<Operation_Xdl_CShuffle> CreateOperations(const Problem& prob);
+    static std::vector<Operation_Xdl_CShuffle> CreateOperations(const Problem& prob,
+                                                                const std::string& arch);
+
+    Solution ToSolution() const;
+};
+
+} // namespace device_batched_gemm_multiple_d
+} // namespace host
+} // namespace ck
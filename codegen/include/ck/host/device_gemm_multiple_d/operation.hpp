@@ -18,6 +18,10 @@ struct Operation_Xdl_CShuffle
 {
     static std::vector<std::vector<Operation_Xdl_CShuffle>> CreateOperations();
     static std::vector<Operation_Xdl_CShuffle> CreateOperations(const Problem& prob);
+    // Tiles generated from the problem shape, pruned and ordered best first by ScoreOperation.
+    // Falls back to the fixed tuning table when the shape is unknown.
+    static std::vector<Operation_Xdl_CShuffle>
+    CreateOperations(const Problem& prob, const std::string& arch, std::size_t batch = 1);
     TensorDesc A{};
     TensorDesc B{};
     DataType acc               = DataType::Float;
@@ -37,6 +41,24 @@ struct Operation_Xdl_CShuffle
     Solution ToSolution() const;
 };
 
+struct TileScore
+{
+    // Padded MxNxK over the useful MxNxK, minus one
+    double padding_waste = 0;
+    // Fraction of the workgroup slots of the device kept busy over all dispatch waves
+    double occupancy = 0;
+    // Relative throughput of one workgroup, from its tile shape and vector widths
+    double efficiency = 0;
+
+    double Value() const;
+    bool Dominates(const TileScore& other) const;
+};
+
+TileScore ScoreOperation(const Problem& prob,
+                         const Operation_Xdl_CShuffle& op,
+                         std::size_t num_cu,
+                         std::size_t batch = 1);
+
 } // namespace device_gemm_multiple_d
 } // namespace host
 } // namespace ck
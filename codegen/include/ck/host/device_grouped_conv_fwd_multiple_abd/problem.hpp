@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include "ck/host/types.hpp"
+
+namespace ck {
+namespace host {
+namespace device_grouped_conv_fwd_multiple_abd {
+
+// Grouped convolution forward with NDHWGC/GKZYXC/NDHWGK style layouts. Empty strides and
+// dilations default to 1, empty pads default to 0.
+struct Problem
+{
+    std::size_t NumDim                            = 2;
+    std::size_t G                                 = 0;
+    std::size_t N                                 = 0;
+    std::size_t C                                 = 0;
+    std::size_t K                                 = 0;
+    std::vector<std::size_t> InputSpatialLengths  = {};
+    std::vector<std::size_t> FilterSpatialLengths = {};
+    std::vector<std::size_t> ConvStrides          = {};
+    std::vector<std::size_t> ConvDilations        = {};
+    std::vector<std::size_t> InputLeftPads        = {};
+    std::vector<std::size_t> InputRightPads       = {};
+    DataType ADataType                            = DataType::Half;
+    DataType BDataType                            = DataType::Half;
+    DataType EDataType                            = DataType::Half;
+    std::vector<DataType> DsDataType              = {};
+    std::string AElementOp                        = PassThrough;
+    std::string BElementOp                        = PassThrough;
+    std::string CDEElementOp                      = PassThrough;
+
+    std::vector<std::size_t> GetOutputSpatialLengths() const;
+    std::size_t GetGemmM() const;
+    std::size_t GetGemmN() const;
+    std::size_t GetGemmK() const;
+
+    std::string GetIncludeHeader() const;
+
+    std::vector<Solution> GetSolutions(const std::string& arch) const;
+};
+
+} // namespace device_grouped_conv_fwd_multiple_abd
+} // namespace host
+} // namespace ck
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "ck/host/operation/gemm.hpp"
+
+namespace ck {
+namespace host {
+
+// LDS layouts of the A (K0 x M x K1) and B (K0 x N x K1) block tiles
+enum class LdsLayout
+{
+    // [K0, MN + extra, K1] of the gridwise gemms before v3, e.g. GridwiseGemmMultipleD_xdl_cshuffle
+    K0MNK1Padded,
+    // [MN, KPerBlock + extra] of GridwiseGemm_xdl_cshuffle_v3 with LdsExtra set
+    MNKPadded,
+    // xor swizzle of GridwiseGemm_xdl_cshuffle_v3 for a K contiguous (row major A, column major
+    // B) source
+    MNKXor,
+    // k fold and xor swizzle of GridwiseGemm_xdl_cshuffle_v3 for an MN contiguous source
+    KFoldXor,
+};
+
+// One of the A/B block tiles in LDS
+struct LdsTileDesc
+{
+    LdsLayout layout = LdsLayout::K0MNK1Padded;
+    int mn_per_block = 0;
+    int k_per_block  = 0;
+    int k1           = 0;
+    int mn_per_xdl   = 0;
+    // ABlockLdsExtraM / BBlockLdsExtraN
+    int lds_extra = 0;
+    // K0 x MN x K1 thread cluster of the block transfer, KFoldXor derives its fold from it
+    std::vector<int> thread_cluster_lengths;
+    int data_bytes = 2;
+};
+
+// Element offset of the [k0, mn, k1] index of the tile, the way the gridwise gemm LDS descriptor
+// computes it
+std::function<std::int64_t(const std::vector<int>&)> MakeLdsOffset(const LdsTileDesc& desc);
+
+struct GemmLdsDesc
+{
+    operation::TileDesc tile;
+    operation::BlockTransferDesc a_block_transfer;
+    operation::BlockTransferDesc b_block_transfer;
+    operation::CShuffleDesc cshuffle;
+    operation::CBlockTransferDesc c_block_transfer;
+    LdsLayout a_layout       = LdsLayout::K0MNK1Padded;
+    LdsLayout b_layout       = LdsLayout::K0MNK1Padded;
+    int a_data_bytes         = 2;
+    int b_data_bytes         = 2;
+    int c_shuffle_data_bytes = 2;
+    // K elements per xdlops step, lcm(AK1, BK1) if 0
+    int k_pack = 0;
+    // 2 for the pipelines that ping-pong between two LDS allocations
+    int num_lds_buffers = 1;
+};
+
+struct LdsHardwareDesc
+{
+    std::size_t lds_bytes_per_cu = 65536;
+    int max_waves_per_cu         = 32;
+    int wave_size                = 64;
+};
+
+struct GemmLdsAnalysis
+{
+    // GetSharedMemoryNumberOfByte() of the gridwise gemm: the A and B tiles padded to
+    // lcm(AK1, BK1) elements share LDS with the C shuffle slab, times the number of buffers
+    std::size_t a_bytes         = 0;
+    std::size_t b_bytes         = 0;
+    std::size_t c_shuffle_bytes = 0;
+    std::size_t total_bytes     = 0;
+    // workgroups and waves resident on a CU, limited by LDS and by the wave slots
+    int blocks_per_cu = 0;
+    int waves_per_cu  = 0;
+    double occupancy  = 0;
+    // max bank conflict degree of the LDS instructions of every stage, 1 is conflict free
+    int a_write_conflicts = 0;
+    int b_write_conflicts = 0;
+    int a_read_conflicts  = 0;
+    int b_read_conflicts  = 0;
+    int c_write_conflicts = 0;
+    int c_read_conflicts  = 0;
+};
+
+// The footprint and occupancy of AnalyzeGemmLds without enumerating the LDS accesses, the
+// conflict degrees are left 0. Cheap enough to score every candidate tile of a problem.
+GemmLdsAnalysis AnalyzeGemmLdsFootprint(const GemmLdsDesc& desc,
+                                        const LdsHardwareDesc& hardware = {});
+
+// Evaluates the LDS descriptors of an XDL gemm instance on the host: its footprint, the occupancy
+// it allows and the bank conflicts of the A/B block transfer stores, the xdlops loads and both
+// sides of the C shuffle. Throws std::runtime_error for tiles the waves do not divide.
+GemmLdsAnalysis AnalyzeGemmLds(const GemmLdsDesc& desc, const LdsHardwareDesc& hardware = {});
+
+} // namespace host
+} // namespace ck
@@ -14,5 +14,16 @@ namespace host {
 
 std::unordered_map<std::string_view, std::string_view> GetHeaders();
 
+// Names of the headers included by the source, in order of appearance. Conditional includes are
+// reported as well, so the dependencies found from them are a superset of the real ones.
+std::vector<std::string> ScanIncludes(std::string_view content);
+
+// Subset of GetHeaders() needed to compile a source including the roots: the roots themselves
+// and every embedded header they transitively include, plus ck/config.h
+std::unordered_map<std::string_view, std::string_view>
+GetHeadersFor(const std::vector<std::string>& roots);
+
+std::unordered_map<std::string_view, std::string_view> GetHeadersFor(const std::string& root);
+
 } // namespace host
 } // namespace ck
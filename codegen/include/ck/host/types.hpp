@@ -19,6 +19,7 @@ struct Solution
     Solution(std::string str, std::unordered_map<std::string, std::string> values);
     std::string ToTemplateString() const;
     std::string GetTemplateParameter(const std::string& name) const;
+    const std::unordered_map<std::string, std::string>& GetTemplateValues() const;
     template <class T>
     T GetTemplateParameter(const std::string& name) const
     {
@@ -38,11 +39,16 @@ enum class DataType
     Half,
     Float,
     Int8,
-    Int32
+    Int32,
+    BFloat16,
+    Float8,
+    BFloat8
 };
 
 std::string ToString(DataType dt);
 
+std::size_t SizeOf(DataType dt);
+
 enum class Layout
 {
     Row,
@@ -73,6 +79,7 @@ const std::string S = SequenceStr({xs...});
 
 constexpr const char* PassThrough = "ck::tensor_operation::element_wise::PassThrough";
 constexpr const char* Bilinear    = "ck::tensor_operation::element_wise::Bilinear";
+constexpr const char* Scale       = "ck::tensor_operation::element_wise::Scale";
 
 } // namespace host
 } // namespace ck
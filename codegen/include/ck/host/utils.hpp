@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include <unordered_set>
 
 namespace ck {
@@ -11,7 +12,17 @@ namespace host {
 
 std::size_t integer_divide_ceil(std::size_t x, std::size_t y);
 
+std::string GetGemmSpec(const std::size_t m,
+                        const std::size_t n,
+                        const std::size_t k,
+                        const std::size_t m_per_block,
+                        const std::size_t n_per_block,
+                        const std::size_t k_per_block);
+
 const std::unordered_set<std::string>& get_xdlop_archs();
 
+// Typical number of compute units of a device of the given arch, used by the tile cost models
+std::size_t get_cu_count(const std::string& arch);
+
 } // namespace host
 } // namespace ck
@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/host/block_transfer_analysis.hpp"
+#include "ck/library/utility/lds_bank_conflict.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace ck {
+namespace host {
+
+std::vector<int> ParseSequence(const std::string& s)
+{
+    const auto begin = s.find('<');
+    const auto end   = s.rfind('>');
+    if(begin == std::string::npos or end == std::string::npos or end < begin)
+        throw std::runtime_error("Not a sequence: " + s);
+
+    std::vector<int> result;
+    std::stringstream ss(s.substr(begin + 1, end - begin - 1));
+    std::string item;
+    while(std::getline(ss, item, ','))
+        result.push_back(std::stoi(item));
+    return result;
+}
+
+// Row-major decomposition of x over lengths
+static std::vector<int> Decompose(int x, const std::vector<int>& lengths)
+{
+    std::vector<int> idx(lengths.size());
+    for(int d = int(lengths.size()) - 1; d >= 0; d--)
+    {
+        idx[d] = x % lengths[d];
+        x /= lengths[d];
+    }
+    return idx;
+}
+
+// Index of the thread slice where access i of a SpaceFillingCurve with snake curving starts
+static std::vector<int> GetAccessIndex(int i,
+                                       const std::vector<int>& access_lengths,
+                                       const std::vector<int>& access_order,
+                                       const std::vector<int>& scalar_per_access)
+{
+    const std::size_t ndim = access_lengths.size();
+    std::vector<int> ordered_lengths(ndim);
+    for(std::size_t d = 0; d < ndim; d++)
+        ordered_lengths[d] = access_lengths[access_order[d]];
+    const auto ordered_idx = Decompose(i, ordered_lengths);
+
+    std::vector<int> idx(ndim);
+    for(std::size_t d = 0; d < ndim; d++)
+    {
+        // a dim is walked backward when the accesses of the dims before it are at an odd position
+        int tmp = ordered_idx[0];
+        for(std::size_t j = 1; j < d; j++)
+            tmp = tmp * ordered_lengths[j] + ordered_idx[j];
+        const bool forward = d == 0 or tmp % 2 == 0;
+
+        const int ordered = forward ? ordered_idx[d] : ordered_lengths[d] - 1 - ordered_idx[d];
+        idx[access_order[d]] = ordered * scalar_per_access[access_order[d]];
+    }
+    return idx;
+}
+
+int LdsBankConflictDegree(const std::vector<std::int64_t>& lane_bytes, int access_bytes)
+{
+    const int num_banks       = 32;
+    const int bank_bytes      = 4;
+    const int lanes_per_cycle = std::clamp(num_banks * bank_bytes / access_bytes, 1, 32);
+
+    int degree = 0;
+    for(std::size_t lane_begin = 0; lane_begin < lane_bytes.size(); lane_begin += lanes_per_cycle)
+        degree = std::max(degree,
+                          utils::get_lds_bank_conflict_degree(lane_bytes,
+                                                              lane_begin,
+                                                              lane_begin + lanes_per_cycle,
+                                                              access_bytes,
+                                                              num_banks,
+                                                              bank_bytes));
+    return degree;
+}
+
+BlockTransferAnalysis
+AnalyzeBlockTransfer(const BlockTransferAccess& access, int wave_size, int cache_line_bytes)
+{
+    BlockTransferAnalysis result;
+
+    const std::size_t ndim = access.block_slice_lengths.size();
+    if(access.thread_cluster_lengths.size() != ndim or
+       access.thread_cluster_arrange_order.size() != ndim or access.access_order.size() != ndim or
+       access.tensor_lengths.size() != ndim or
+       (not access.tensor_offset and access.tensor_strides.size() != ndim) or
+       access.vector_dim < 0 or access.vector_dim >= int(ndim) or access.scalar_per_vector < 1)
+        return result;
+
+    std::vector<int> thread_slice_lengths(ndim);
+    int num_threads = 1;
+    for(std::size_t d = 0; d < ndim; d++)
+    {
+        if(access.block_slice_lengths[d] % access.thread_cluster_lengths[d] != 0)
+            return result;
+        thread_slice_lengths[d] = access.block_slice_lengths[d] / access.thread_cluster_lengths[d];
+        num_threads *= access.thread_cluster_lengths[d];
+    }
+    const int thread_vector_length = thread_slice_lengths[access.vector_dim];
+    if(thread_vector_length % access.scalar_per_vector != 0)
+        return result;
+
+    // element offset, -1 outside of the tensor
+    auto get_offset = [&](const std::vector<int>& idx) -> std::int64_t {
+        for(std::size_t d = 0; d < ndim; d++)
+            if(idx[d] >= access.tensor_lengths[d])
+                return -1;
+        if(access.tensor_offset)
+            return std::max<std::int64_t>(access.tensor_offset(idx), -1);
+        std::int64_t offset = 0;
+        for(std::size_t d = 0; d < ndim; d++)
+            offset += std::int64_t(idx[d]) * access.tensor_strides[d];
+        return offset;
+    };
+
+    // widest vector the thread slice allows: in the block slice every aligned vector is either
+    // outside of the tensor or padding as a whole (one predicate for the vector), or has
+    // contiguous elements starting at an aligned offset
+    int block_slice_size = 1;
+    for(auto length : access.block_slice_lengths)
+        block_slice_size *= length;
+    for(int width = 16; width > 1 and result.max_scalar_per_vector == 1; width /= 2)
+    {
+        if(thread_vector_length % width != 0 or
+           access.tensor_lengths[access.vector_dim] % width != 0)
+            continue;
+        bool vectorizable = true;
+        for(int i = 0; i < block_slice_size and vectorizable; i++)
+        {
+            auto idx = Decompose(i, access.block_slice_lengths);
+            if(idx[access.vector_dim] % width != 0)
+                continue;
+            const auto offset = get_offset(idx);
+            vectorizable      = offset < 0 or offset % width == 0;
+            for(int v = 1; v < width and vectorizable; v++)
+            {
+                idx[access.vector_dim]++;
+                const auto next = get_offset(idx);
+                vectorizable    = offset < 0 ? next < 0 : next == offset + v;
+            }
+        }
+        if(vectorizable)
+            result.max_scalar_per_vector = width;
+    }
+    result.valid = result.max_scalar_per_vector % access.scalar_per_vector == 0;
+
+    // threads are mapped through make_cluster_descriptor
+    std::vector<int> arranged_cluster_lengths(ndim);
+    for(std::size_t d = 0; d < ndim; d++)
+        arranged_cluster_lengths[d] =
+            access.thread_cluster_lengths[access.thread_cluster_arrange_order[d]];
+    std::vector<std::vector<int>> thread_origins(num_threads, std::vector<int>(ndim));
+    for(int t = 0; t < num_threads; t++)
+    {
+        const auto arranged_idx = Decompose(t, arranged_cluster_lengths);
+        for(std::size_t d = 0; d < ndim; d++)
+            thread_origins[t][access.thread_cluster_arrange_order[d]] =
+                arranged_idx[d] * thread_slice_lengths[access.thread_cluster_arrange_order[d]];
+    }
+
+    std::vector<int> scalar_per_access(ndim, 1);
+    scalar_per_access[access.vector_dim] = access.scalar_per_vector;
+    std::vector<int> access_lengths(ndim);
+    int num_access = 1;
+    for(std::size_t d = 0; d < ndim; d++)
+    {
+        access_lengths[d] = thread_slice_lengths[d] / scalar_per_access[d];
+        num_access *= access_lengths[d];
+    }
+
+    const int vector_bytes   = access.scalar_per_vector * access.data_bytes;
+    std::size_t num_requests = 0, num_ranges = 0;
+    std::int64_t total_bytes = 0, total_lines = 0;
+    std::vector<int> idx(ndim);
+    for(int i = 0; i < num_access; i++)
+    {
+        const auto access_idx =
+            GetAccessIndex(i, access_lengths, access.access_order, scalar_per_access);
+        for(int wave_begin = 0; wave_begin < num_threads; wave_begin += wave_size)
+        {
+            const int wave_end = std::min(num_threads, wave_begin + wave_size);
+
+            // first byte of the vector of every lane, -1 outside of the tensor
+            std::vector<std::int64_t> lane_bytes;
+            for(int t = wave_begin; t < wave_end; t++)
+            {
+                for(std::size_t d = 0; d < ndim; d++)
+                    idx[d] = thread_origins[t][d] + access_idx[d];
+                const auto offset = get_offset(idx);
+                lane_bytes.push_back(offset < 0 ? -1 : offset * access.data_bytes);
+            }
+
+            std::vector<std::pair<std::int64_t, std::int64_t>> ranges;
+            for(auto begin : lane_bytes)
+                if(begin >= 0)
+                    ranges.emplace_back(begin, begin + vector_bytes);
+            if(ranges.empty())
+                continue;
+            std::sort(ranges.begin(), ranges.end());
+
+            std::set<std::int64_t> lines;
+            auto current = ranges.front();
+            auto close   = [&] {
+                total_bytes += current.second - current.first;
+                num_ranges++;
+                for(auto line = current.first / cache_line_bytes;
+                    line <= (current.second - 1) / cache_line_bytes;
+                    line++)
+                    lines.insert(line);
+            };
+            for(const auto& range : ranges)
+            {
+                if(range.first > current.second)
+                {
+                    close();
+                    current = range;
+                }
+                current.second = std::max(current.second, range.second);
+            }
+            close();
+            total_lines += lines.size();
+            num_requests++;
+
+            result.lds_bank_conflict_degree =
+                std::max(result.lds_bank_conflict_degree,
+                         LdsBankConflictDegree(lane_bytes, vector_bytes));
+        }
+    }
+
+    if(num_requests > 0)
+    {
+        result.contiguous_bytes_per_request = double(total_bytes) / double(num_ranges);
+        result.coalescing_efficiency = double(total_bytes) / double(total_lines * cache_line_bytes);
+    }
+    return result;
+}
+
+} // namespace host
+} // namespace ck
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/host/device_batched_gemm_multiple_d/operation.hpp"
+#include "ck/host/stringutils.hpp"
+#include <algorithm>
+
+namespace ck {
+namespace host {
+namespace device_batched_gemm_multiple_d {
+
+static device_gemm_multiple_d::Problem ToGemmProblem(const Problem& prob)
+{
+    device_gemm_multiple_d::Problem result;
+    result.M            = prob.M;
+    result.N            = prob.N;
+    result.K            = prob.K;
+    result.TransA       = prob.TransA;
+    result.TransB       = prob.TransB;
+    result.TransE       = prob.TransE;
+    result.DsTrans      = prob.DsTrans;
+    result.ADataType    = prob.ADataType;
+    result.BDataType    = prob.BDataType;
+    result.EDataType    = prob.EDataType;
+    result.DsDataType   = prob.DsDataType;
+    result.AElementOp   = prob.AElementOp;
+    result.BElementOp   = prob.BElementOp;
+    result.CDEElementOp = prob.CDEElementOp;
+    return result;
+}
+
+using GemmOperation = device_gemm_multiple_d::Operation_Xdl_CShuffle;
+
+static std::vector<Operation_Xdl_CShuffle> FromGemmOperations(const std::vector<GemmOperation>& ops)
+{
+    return Transform(ops, [](const auto& op) {
+        Operation_Xdl_CShuffle x;
+        static_cast<GemmOperation&>(x) = op;
+        return x;
+    });
+}
+
+std::vector<Operation_Xdl_CShuffle> Operation_Xdl_CShuffle::CreateOperations(const Problem& prob)
+{
+    return FromGemmOperations(GemmOperation::CreateOperations(ToGemmProblem(prob)));
+}
+
+std::vector<Operation_Xdl_CShuffle>
+Operation_Xdl_CShuffle::CreateOperations(const Problem& prob, const std::string& arch)
+{
+    // Every batch adds a grid of workgroups, which changes how well the tiles fill the device
+    const auto batch = std::max<std::size_t>(prob.Batch, 1);
+    return FromGemmOperations(GemmOperation::CreateOperations(ToGemmProblem(prob), arch, batch));
+}
+
+std::vector<std::vector<Operation_Xdl_CShuffle>> Operation_Xdl_CShuffle::CreateOperations()
+{
+    std::vector<Problem> problems;
+    for(bool TransA : {true, false})
+        for(bool TransB : {true, false})
+        {
+            Problem prob;
+            prob.TransA = TransA;
+            prob.TransB = TransB;
+            problems.push_back(prob);
+        }
+    return Transform(problems, [](const Problem& p) { return CreateOperations(p); });
+}
+
+static const char* const DeviceBatchedGemmMultiD_XdlTemplate =
+    "ck::tensor_operation::device::DeviceBatchedGemmMultiD_Xdl<${LayoutA}, ${LayoutB}, "
+    "${LayoutDs}, ${LayoutE}, ${ADataType}, ${BDataType}, ${AccDataType}, ${CShuffleDataType}, "
+    "${DsDataType}, ${EDataType}, ${AElementwiseOperation}, ${BElementwiseOperation}, "
+    "${CDEElementwiseOperation}, ${GemmSpecialization}, ${NumGemmkPrefetchStage}, ${BlockSize}, "
+    "${MPerBlock}, ${NPerBlock}, ${KPerBlock}, ${AK1}, ${BK1}, ${MPerXDL}, ${NPerXDL}, "
+    "${MXdlPerWave}, ${NXdlPerWave}, ${ABlockTransferThreadClusterLengths_AK0_M_AK1}, "
+    "${ABlockTransferThreadClusterArrangeOrder}, ${ABlockTransferSrcAccessOrder}, "
+    "${ABlockTransferSrcVectorDim}, ${ABlockTransferSrcScalarPerVector}, "
+    "${ABlockTransferDstScalarPerVector_AK1}, ${ABlockLdsExtraM}, "
+    "${BBlockTransferThreadClusterLengths_BK0_N_BK1}, ${BBlockTransferThreadClusterArrangeOrder}, "
+    "${BBlockTransferSrcAccessOrder}, ${BBlockTransferSrcVectorDim}, "
+    "${BBlockTransferSrcScalarPerVector}, ${BBlockTransferDstScalarPerVector_BK1}, "
+    "${BBlockLdsExtraN}, ${CShuffleMXdlPerWavePerShuffle}, ${CShuffleNXdlPerWavePerShuffle}, "
+    "${CDEBlockTransferClusterLengths_MBlock_MPerBlock_NBlock_NPerBlock}, "
+    "${CDEBlockTransferScalarPerVector_NPerBlock}>";
+
+Solution Operation_Xdl_CShuffle::ToSolution() const
+{
+    // The template arguments are identical to DeviceGemmMultipleD_Xdl_CShuffle except that the
+    // LDS padding flags are bool
+    auto values =
+        device_gemm_multiple_d::Operation_Xdl_CShuffle::ToSolution().GetTemplateValues();
+    values["ABlockLdsExtraM"] = this->a_block_transfer.lds_add_extra_dim ? "true" : "false";
+    values["BBlockLdsExtraN"] = this->b_block_transfer.lds_add_extra_dim ? "true" : "false";
+
+    return Solution{InterpolateString(DeviceBatchedGemmMultiD_XdlTemplate, values),
+                    std::move(values)};
+}
+
+} // namespace device_batched_gemm_multiple_d
+} // namespace host
+} // namespace ck
@@ -20,7 +20,8 @@ std::vector<Solution> Problem::GetSolutions(const std::string& arch) const
 {
     if(get_xdlop_archs().count(arch) == 0)
         return {};
-    auto ops = ck::host::device_gemm_multiple_d::Operation_Xdl_CShuffle::CreateOperations(*this);
+    auto ops =
+        ck::host::device_gemm_multiple_d::Operation_Xdl_CShuffle::CreateOperations(*this, arch);
     std::vector<Solution> result;
     std::transform(ops.begin(), ops.end(), std::back_inserter(result), [&](const auto& op) {
         return op.ToSolution();
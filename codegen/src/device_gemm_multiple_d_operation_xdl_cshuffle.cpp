@@ -2,36 +2,38 @@
 // Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
 
 #include "ck/host/device_gemm_multiple_d/operation.hpp"
+#include "ck/host/block_transfer_analysis.hpp"
+#include "ck/host/gemm_lds_model.hpp"
 #include "ck/host/stringutils.hpp"
 #include "ck/host/utils.hpp"
+#include <algorithm>
 #include <cassert>
+#include <optional>
 
 namespace ck {
 namespace host {
 namespace device_gemm_multiple_d {
 
-static std::string GetGemmSpec(const std::size_t m,
-                               const std::size_t n,
-                               const std::size_t k,
-                               const std::size_t m_per_block,
-                               const std::size_t n_per_block,
-                               const std::size_t k_per_block)
+static Layout ToLayout(bool Trans) { return Trans ? Layout::Column : Layout::Row; }
+
+static Operation_Xdl_CShuffle MakeOperation(const Problem& prob, const operation::TileDesc& tile)
 {
-    std::string spec = "";
-    if(integer_divide_ceil(m, m_per_block) * m_per_block - m != 0)
-        spec += "M";
-    if(integer_divide_ceil(n, n_per_block) * n_per_block - n != 0)
-        spec += "N";
-    if(integer_divide_ceil(k, k_per_block) * k_per_block - k != 0)
-        spec += "K";
-    if(spec == "")
-        return "ck::tensor_operation::device::GemmSpecialization::Default";
-
-    return "ck::tensor_operation::device::GemmSpecialization::" + spec + "Padding";
+    Operation_Xdl_CShuffle x;
+    x.tile_desc = tile;
+    x.A         = TensorDesc{prob.ADataType, ToLayout(prob.TransA)};
+    x.B         = TensorDesc{prob.BDataType, ToLayout(prob.TransB)};
+    x.E         = TensorDesc{prob.EDataType, ToLayout(prob.TransE)};
+    x.Ds        = Transform(prob.DsTrans, prob.DsDataType, [](auto trans, auto dt) {
+        return TensorDesc{dt, ToLayout(trans)};
+    });
+    x.a_elem_op           = prob.AElementOp;
+    x.b_elem_op           = prob.BElementOp;
+    x.cde_elem_op         = prob.CDEElementOp;
+    x.gemm_specialization = GetGemmSpec(
+        prob.M, prob.N, prob.K, tile.m_per_block, tile.n_per_block, tile.k_per_block);
+    return x;
 }
 
-static Layout ToLayout(bool Trans) { return Trans ? Layout::Column : Layout::Row; }
-
 std::vector<Operation_Xdl_CShuffle> Operation_Xdl_CShuffle::CreateOperations(const Problem& prob)
 {
     std::vector<Operation_Xdl_CShuffle> result;
@@ -167,32 +169,316 @@ std::vector<Operation_Xdl_CShuffle> Operation_Xdl_CShuffle::CreateOperations(con
 
     for(std::size_t i = 0; i < tile_descriptions.size(); i++)
     {
-        Operation_Xdl_CShuffle x;
-        x.tile_desc           = tile_descriptions[i];
-        x.a_block_transfer    = a_block_descriptions[i];
-        x.b_block_transfer    = b_block_descriptions[i];
-        x.cshuffle            = cshuffle_descriptions[i];
-        x.c_block_transfer    = c_block_descriptions[i];
-        x.A                   = TensorDesc{prob.ADataType, ToLayout(prob.TransA)};
-        x.B                   = TensorDesc{prob.BDataType, ToLayout(prob.TransB)};
-        x.E                   = TensorDesc{prob.EDataType, ToLayout(prob.TransE)};
-        x.Ds                  = Transform(prob.DsTrans, prob.DsDataType, [](auto trans, auto dt) {
-            return TensorDesc{dt, ToLayout(trans)};
-        });
-        x.a_elem_op           = prob.AElementOp;
-        x.b_elem_op           = prob.BElementOp;
-        x.cde_elem_op         = prob.CDEElementOp;
-        x.gemm_specialization = GetGemmSpec(prob.M,
-                                            prob.N,
-                                            prob.K,
-                                            x.tile_desc.m_per_block,
-                                            x.tile_desc.n_per_block,
-                                            x.tile_desc.k_per_block);
+        Operation_Xdl_CShuffle x = MakeOperation(prob, tile_descriptions[i]);
+        x.a_block_transfer       = a_block_descriptions[i];
+        x.b_block_transfer       = b_block_descriptions[i];
+        x.cshuffle               = cshuffle_descriptions[i];
+        x.c_block_transfer       = c_block_descriptions[i];
         result.push_back(x);
     }
     return result;
 }
 
+// Largest vector width, at most max_width, that divides both the per-thread slice and the
+// tensor length along the vectorized dimension
+static int GetScalarPerVector(std::size_t length, int slice, int max_width = 8)
+{
+    for(int width = max_width; width > 1; width /= 2)
+    {
+        if(slice % width == 0 and length % width == 0)
+            return width;
+    }
+    return 1;
+}
+
+// A/B block transfers whose K1 stores to LDS serialize more than this are rejected: the
+// [K0, MN + 1, K1] padding makes the stores of a K contiguous source conflict free or 2-way,
+// an MN contiguous source writes mn_per_block / cluster_mn rows per thread and conflicts that many
+// ways, up to 16
+static constexpr int MaxLdsStoreConflicts = 4;
+
+// Fills the block transfers of A and B. The K0 x MN thread cluster has to cover the block size
+// exactly, each thread then loads K1 along K, or a strip of the MN slice when MN is contiguous.
+// The loads use the widest vector that divides both the thread slice and the contiguous
+// dimension. The matrix is packed, so the other strides are multiples of that dimension and the
+// vectors are contiguous and aligned. The K1 stores to the [K0, MN + 1, K1] LDS block are
+// evaluated by AnalyzeBlockTransfer and bound by MaxLdsStoreConflicts.
+static bool DeriveBlockTransfer(int block_size,
+                                int k0,
+                                int mn_per_block,
+                                std::size_t mn,
+                                std::size_t k,
+                                bool mn_contiguous,
+                                int k1,
+                                int data_bytes,
+                                operation::BlockTransferDesc& transfer)
+{
+    if(block_size % k0 != 0)
+        return false;
+    const int cluster_mn = block_size / k0;
+    if(cluster_mn > mn_per_block or mn_per_block % cluster_mn != 0)
+        return false;
+    transfer.thread_cluster_length    = SequenceStr({k0, cluster_mn, 1});
+    transfer.dst_scalar_per_vector_k1 = k1;
+    transfer.lds_add_extra_dim        = 1;
+    if(mn_contiguous)
+    {
+        transfer.thread_cluster_arrange_order = S<0, 2, 1>;
+        transfer.src_access_order             = S<0, 2, 1>;
+        transfer.src_vec_dim                  = 1;
+        transfer.src_scalar_per_vector = GetScalarPerVector(mn, mn_per_block / cluster_mn);
+    }
+    else
+    {
+        transfer.thread_cluster_arrange_order = S<1, 0, 2>;
+        transfer.src_access_order             = S<1, 0, 2>;
+        transfer.src_vec_dim                  = 2;
+        transfer.src_scalar_per_vector        = GetScalarPerVector(k, k1);
+    }
+
+    LdsTileDesc lds;
+    lds.mn_per_block = mn_per_block;
+    lds.k_per_block  = k0 * k1;
+    lds.k1           = k1;
+    lds.lds_extra    = transfer.lds_add_extra_dim;
+    lds.data_bytes   = data_bytes;
+
+    BlockTransferAccess dst;
+    dst.block_slice_lengths          = {k0, mn_per_block, k1};
+    dst.thread_cluster_lengths       = {k0, cluster_mn, 1};
+    dst.thread_cluster_arrange_order = ParseSequence(transfer.thread_cluster_arrange_order);
+    dst.access_order                 = {0, 1, 2};
+    dst.vector_dim                   = 2;
+    dst.scalar_per_vector            = k1;
+    dst.tensor_lengths               = dst.block_slice_lengths;
+    dst.tensor_offset                = MakeLdsOffset(lds);
+    dst.data_bytes                   = data_bytes;
+    const auto stores                = AnalyzeBlockTransfer(dst);
+    return stores.valid and stores.lds_bank_conflict_degree <= MaxLdsStoreConflicts;
+}
+
+// Picks the widest store along N for which the threads of the block tile one shuffle slab of
+// MWave * MPerXDL rows by NWave * NPerXDL * CShuffleNXdlPerWavePerShuffle columns
+static bool DeriveCBlockTransfer(const operation::TileDesc& tile,
+                                 int max_width,
+                                 operation::CShuffleDesc& cshuffle,
+                                 operation::CBlockTransferDesc& transfer)
+{
+    const int m_waves = tile.m_per_block / (tile.m_Xdl_per_wave * tile.m_per_XDL);
+    const int n_waves = tile.n_per_block / (tile.n_Xdl_per_wave * tile.n_per_XDL);
+    for(int width = max_width; width >= 1; width /= 2)
+    {
+        for(int n_shuffle = 1; n_shuffle <= tile.n_Xdl_per_wave; n_shuffle *= 2)
+        {
+            if(tile.n_Xdl_per_wave % n_shuffle != 0)
+                continue;
+            const int n_slab = n_waves * tile.n_per_XDL * n_shuffle;
+            const int m_slab = m_waves * tile.m_per_XDL;
+            if(n_slab % width != 0)
+                continue;
+            const int n_threads = n_slab / width;
+            if(tile.block_size % n_threads != 0)
+                continue;
+            const int m_threads = tile.block_size / n_threads;
+            if(m_slab % m_threads != 0)
+                continue;
+            cshuffle = {1, n_shuffle};
+            transfer = {SequenceStr({1, m_threads, 1, n_threads}), width};
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool DeriveOperation(const Problem& prob, Operation_Xdl_CShuffle& x)
+{
+    const auto& tile = x.tile_desc;
+    if(not DeriveBlockTransfer(tile.block_size,
+                               tile.k_per_block / tile.ak1,
+                               tile.m_per_block,
+                               prob.M,
+                               prob.K,
+                               prob.TransA,
+                               tile.ak1,
+                               SizeOf(prob.ADataType),
+                               x.a_block_transfer))
+        return false;
+    if(not DeriveBlockTransfer(tile.block_size,
+                               tile.k_per_block / tile.bk1,
+                               tile.n_per_block,
+                               prob.N,
+                               prob.K,
+                               not prob.TransB,
+                               tile.bk1,
+                               SizeOf(prob.BDataType),
+                               x.b_block_transfer))
+        return false;
+    // E and Ds are written along N, column major outputs are only stored element by element
+    const bool n_contiguous =
+        not prob.TransE and std::none_of(prob.DsTrans.begin(), prob.DsTrans.end(), [](bool t) {
+            return t;
+        });
+    const int max_width = n_contiguous ? GetScalarPerVector(prob.N, 8) : 1;
+    return DeriveCBlockTransfer(tile, max_width, x.cshuffle, x.c_block_transfer);
+}
+
+std::vector<Operation_Xdl_CShuffle> Operation_Xdl_CShuffle::CreateOperations(
+    const Problem& prob, const std::string& arch, std::size_t batch)
+{
+    if(prob.M == 0 or prob.N == 0 or prob.K == 0)
+        return CreateOperations(prob);
+
+    // Small tiles serve skinny problems and 16x16 XDL instructions tiles with less than 32 rows
+    // or columns. DeviceGemmMultipleD_Xdl_CShuffle has no split-K, so K-heavy problems get
+    // deeper KPerBlock tiles instead to halve the main loop trip count.
+    const std::vector<int> block_sizes   = {256, 128, 64};
+    const std::vector<int> mn_per_blocks = {256, 128, 64, 32, 16};
+    const std::vector<int> k_per_blocks  = {32, 64};
+    const int k1                         = 8;
+
+    std::vector<Operation_Xdl_CShuffle> candidates;
+    for(int k_per_block : k_per_blocks)
+        for(int block_size : block_sizes)
+            for(int m_per_block : mn_per_blocks)
+                for(int n_per_block : mn_per_blocks)
+                {
+                    // Among the wave layouts of a tile, prefer the squarest XDL grid per wave
+                    std::optional<Operation_Xdl_CShuffle> best;
+                    int best_imbalance = 0;
+                    const int num_waves = block_size / 64;
+                    for(int m_waves = 1; m_waves <= num_waves; m_waves *= 2)
+                        for(int per_xdl : {32, 16})
+                        {
+                            const int n_waves = num_waves / m_waves;
+                            if(m_per_block % (m_waves * per_xdl) != 0 or
+                               n_per_block % (n_waves * per_xdl) != 0)
+                                continue;
+                            const int m_xdl = m_per_block / (m_waves * per_xdl);
+                            const int n_xdl = n_per_block / (n_waves * per_xdl);
+                            // Keep the accumulators within 128 VGPRs
+                            if(m_xdl * n_xdl * per_xdl * per_xdl / 64 > 128)
+                                continue;
+                            Operation_Xdl_CShuffle x = MakeOperation(
+                                prob,
+                                {block_size,
+                                 m_per_block,
+                                 n_per_block,
+                                 k_per_block,
+                                 k1,
+                                 k1,
+                                 per_xdl,
+                                 per_xdl,
+                                 m_xdl,
+                                 n_xdl,
+                                 1});
+                            if(not DeriveOperation(prob, x))
+                                continue;
+                            const int imbalance = std::abs(m_xdl - n_xdl) * 4 +
+                                                  std::abs(m_waves - n_waves) +
+                                                  (per_xdl == 32 ? 0 : 1);
+                            if(not best or imbalance < best_imbalance)
+                            {
+                                best           = x;
+                                best_imbalance = imbalance;
+                            }
+                        }
+                    if(best)
+                        candidates.push_back(*best);
+                }
+
+    const auto num_cu = get_cu_count(arch);
+    auto scores       = Transform(candidates, [&](const auto& op) {
+        return ScoreOperation(prob, op, num_cu, batch);
+    });
+
+    // Drop the dominated candidates, of candidates with equal scores only the first one is kept
+    std::vector<std::size_t> kept;
+    for(std::size_t i = 0; i < candidates.size(); i++)
+    {
+        bool dominated = false;
+        for(std::size_t j = 0; j < candidates.size() and not dominated; j++)
+        {
+            if(i == j)
+                continue;
+            const bool same = scores[i].padding_waste == scores[j].padding_waste and
+                              scores[i].occupancy == scores[j].occupancy and
+                              scores[i].efficiency == scores[j].efficiency;
+            dominated = scores[j].Dominates(scores[i]) or (same and j < i);
+        }
+        if(not dominated)
+            kept.push_back(i);
+    }
+    std::stable_sort(kept.begin(), kept.end(), [&](std::size_t i, std::size_t j) {
+        return scores[i].Value() > scores[j].Value();
+    });
+    return Transform(kept, [&](std::size_t i) { return candidates[i]; });
+}
+
+double TileScore::Value() const { return occupancy * efficiency / (1.0 + padding_waste); }
+
+bool TileScore::Dominates(const TileScore& other) const
+{
+    if(padding_waste > other.padding_waste or occupancy < other.occupancy or
+       efficiency < other.efficiency)
+        return false;
+    return padding_waste < other.padding_waste or occupancy > other.occupancy or
+           efficiency > other.efficiency;
+}
+
+TileScore ScoreOperation(const Problem& prob,
+                         const Operation_Xdl_CShuffle& op,
+                         std::size_t num_cu,
+                         std::size_t batch)
+{
+    const auto& tile   = op.tile_desc;
+    const auto m_tiles = integer_divide_ceil(prob.M, tile.m_per_block);
+    const auto n_tiles = integer_divide_ceil(prob.N, tile.n_per_block);
+    const auto k_tiles = integer_divide_ceil(prob.K, tile.k_per_block);
+    const double padded_work = double(m_tiles * tile.m_per_block) *
+                               double(n_tiles * tile.n_per_block) *
+                               double(k_tiles * tile.k_per_block);
+
+    TileScore score;
+    score.padding_waste = padded_work / (double(prob.M) * double(prob.N) * double(prob.K)) - 1.0;
+
+    // The workgroups a CU holds, limited by its 8 wave slots and by the 64 KiB of LDS that the
+    // padded A/B tiles share with the C shuffle slab
+    GemmLdsDesc lds;
+    lds.tile                 = tile;
+    lds.a_block_transfer     = op.a_block_transfer;
+    lds.b_block_transfer     = op.b_block_transfer;
+    lds.cshuffle             = op.cshuffle;
+    lds.c_block_transfer     = op.c_block_transfer;
+    lds.a_data_bytes         = SizeOf(prob.ADataType);
+    lds.b_data_bytes         = SizeOf(prob.BDataType);
+    lds.c_shuffle_data_bytes = SizeOf(op.cs_type);
+    LdsHardwareDesc hardware;
+    hardware.max_waves_per_cu = 8;
+
+    const std::size_t slots_per_cu =
+        std::max(1, AnalyzeGemmLdsFootprint(lds, hardware).blocks_per_cu);
+    const std::size_t slots        = num_cu * slots_per_cu;
+    const std::size_t blocks       = m_tiles * n_tiles * batch;
+    // A block of a skinny problem that is mostly padding keeps its slot busy for little work, so
+    // only the useful fraction of the output tiles counts towards occupancy
+    const double useful_fraction =
+        double(prob.M) * double(prob.N) /
+        (double(m_tiles * tile.m_per_block) * double(n_tiles * tile.n_per_block));
+    score.occupancy = double(blocks) * useful_fraction /
+                      double(integer_divide_ceil(blocks, slots) * slots);
+
+    // Data reuse of the tile relative to 256x128, the per-iteration synchronization cost
+    // relative to KPerBlock = 64 and the global load widths relative to 8 elements
+    const double reuse = double(tile.m_per_block) * tile.n_per_block /
+                         (tile.m_per_block + tile.n_per_block) / (256.0 * 128.0 / 384.0);
+    const double k_loop = (tile.k_per_block / (tile.k_per_block + 16.0)) / (64.0 / 80.0);
+    const double loads =
+        (op.a_block_transfer.src_scalar_per_vector + op.b_block_transfer.src_scalar_per_vector) /
+        16.0;
+    score.efficiency = std::min(1.0, reuse) * std::min(1.0, k_loop) * loads;
+    return score;
+}
+
 std::vector<std::vector<Operation_Xdl_CShuffle>> Operation_Xdl_CShuffle::CreateOperations()
 {
     std::vector<Problem> problems;
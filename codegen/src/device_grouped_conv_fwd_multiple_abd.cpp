@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/problem.hpp"
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/operation.hpp"
+#include "ck/host/utils.hpp"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+namespace ck {
+namespace host {
+namespace device_grouped_conv_fwd_multiple_abd {
+
+static std::size_t GetOrDefault(const std::vector<std::size_t>& v, std::size_t i, std::size_t x)
+{
+    return v.empty() ? x : v.at(i);
+}
+
+std::vector<std::size_t> Problem::GetOutputSpatialLengths() const
+{
+    if(InputSpatialLengths.size() != NumDim or FilterSpatialLengths.size() != NumDim)
+        throw std::runtime_error("Spatial lengths do not match NumDim");
+    std::vector<std::size_t> result;
+    for(std::size_t i = 0; i < NumDim; i++)
+    {
+        auto stride   = GetOrDefault(ConvStrides, i, 1);
+        auto dilation = GetOrDefault(ConvDilations, i, 1);
+        auto padded   = InputSpatialLengths[i] + GetOrDefault(InputLeftPads, i, 0) +
+                      GetOrDefault(InputRightPads, i, 0);
+        if(FilterSpatialLengths[i] == 0 or stride == 0 or dilation == 0)
+            throw std::runtime_error("Filter lengths, strides and dilations must be positive");
+        auto filter = (FilterSpatialLengths[i] - 1) * dilation + 1;
+        if(filter > padded)
+            throw std::runtime_error("Dilated filter is larger than the padded input");
+        result.push_back((padded - filter) / stride + 1);
+    }
+    return result;
+}
+
+static std::size_t Product(const std::vector<std::size_t>& v)
+{
+    return std::accumulate(v.begin(), v.end(), std::size_t{1}, std::multiplies<std::size_t>{});
+}
+
+std::size_t Problem::GetGemmM() const { return N * Product(GetOutputSpatialLengths()); }
+
+std::size_t Problem::GetGemmN() const { return K; }
+
+std::size_t Problem::GetGemmK() const { return C * Product(FilterSpatialLengths); }
+
+std::string Problem::GetIncludeHeader() const
+{
+    return "ck/tensor_operation/gpu/device/impl/"
+           "device_grouped_conv_fwd_multiple_abd_xdl_cshuffle.hpp";
+}
+
+std::vector<Solution> Problem::GetSolutions(const std::string& arch) const
+{
+    if(get_xdlop_archs().count(arch) == 0)
+        return {};
+    auto ops = Operation_Xdl_CShuffle::CreateOperations(*this);
+    std::vector<Solution> result;
+    std::transform(ops.begin(), ops.end(), std::back_inserter(result), [&](const auto& op) {
+        return op.ToSolution();
+    });
+    return result;
+}
+
+} // namespace device_grouped_conv_fwd_multiple_abd
+} // namespace host
+} // namespace ck
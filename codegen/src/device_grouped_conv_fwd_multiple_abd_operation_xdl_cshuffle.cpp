@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/operation.hpp"
+#include "ck/host/stringutils.hpp"
+#include "ck/host/utils.hpp"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace ck {
+namespace host {
+namespace device_grouped_conv_fwd_multiple_abd {
+
+static std::string GetConvSpec(const Problem& prob)
+{
+    auto all_of = [](const std::vector<std::size_t>& v, std::size_t x) {
+        return std::all_of(v.begin(), v.end(), [&](auto y) { return y == x; });
+    };
+    bool filter1x1 = all_of(prob.FilterSpatialLengths, 1);
+    bool pad0      = all_of(prob.InputLeftPads, 0) and all_of(prob.InputRightPads, 0);
+    bool stride1   = all_of(prob.ConvStrides, 1);
+    std::string spec = "Default";
+    if(filter1x1 and pad0 and stride1)
+        spec = "Filter1x1Stride1Pad0";
+    else if(filter1x1 and pad0)
+        spec = "Filter1x1Pad0";
+    return "ck::tensor_operation::device::ConvolutionForwardSpecialization::" + spec;
+}
+
+static DataType GetAccDataType(DataType dt)
+{
+    return dt == DataType::Int8 ? DataType::Int32 : DataType::Float;
+}
+
+std::vector<Operation_Xdl_CShuffle> Operation_Xdl_CShuffle::CreateOperations(const Problem& prob)
+{
+    std::vector<Operation_Xdl_CShuffle> result;
+
+    std::vector<operation::TileDesc> tile_descriptions = {
+        // clang-format off
+//  Block|  MPer|  NPer|  KPer| AK1| BK1| MPer| NPer| MXdl| NXdl| NumGemmK|
+//   Size| Block| Block| Block|    |    |  XDL|  XDL|  Per|  Per| Prefetch|
+//       |      |      |      |    |    |     |     | Wave| Wave|    Stage|
+//       |      |      |      |    |    |     |     |     |     |         |
+  {   256,   256,   128,    32,   8,   8,   32,   32,    4,    2,        1},
+  {   256,   128,   256,    32,   8,   8,   32,   32,    2,    4,        1},
+  {   128,   128,   128,    32,   8,   8,   32,   32,    4,    2,        1},
+  {   256,   128,   128,    32,   8,   8,   32,   32,    2,    2,        1},
+  {   128,   128,    64,    32,   8,   8,   32,   32,    2,    2,        1},
+  {   128,    64,   128,    32,   8,   8,   32,   32,    2,    2,        1},
+  {    64,    64,    64,    32,   8,   8,   32,   32,    2,    2,        1},
+  {   256,   128,    64,    32,   8,   8,   32,   32,    2,    1,        1},
+  {   256,    64,   128,    32,   8,   8,   32,   32,    1,    2,        1},
+  {   128,   128,    32,    32,   8,   8,   32,   32,    2,    1,        1},
+  {   128,    32,   128,    32,   8,   8,   32,   32,    1,    2,        1},
+  {    64,    64,    32,    32,   8,   8,   32,   32,    2,    1,        1},
+  {    64,    32,    64,    32,   8,   8,   32,   32,    1,    2,        1},
+        // clang-format on
+    };
+
+    // A (NDHWGC) and B (GKZYXC) are both contiguous along the GEMM K dimension, so the same
+    // transfer parameters serve both sides
+    std::vector<operation::BlockTransferDesc> ab_block_descriptions = {
+        // clang-format off
+//   BlockTransfer|  BlockTransfer|  BlockTransfer|  BlockTransfer|  BlockTransfer|  BlockTransfer|  BlockLds|
+//   ThreadCluster|  ThreadCluster| SrcAccessOrder|   SrcVectorDim|      SrcScalar|      DstScalar|  AddExtra|
+// Lengths_K0_M_K1|   ArrangeOrder|               |               |      PerVector|   PerVector_K1|          |
+//                |               |               |               |               |               |          |
+  {    S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 32, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 32, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 32, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 16, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 32, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 32, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 16, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 16, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+        // clang-format on
+    };
+
+    std::vector<operation::CShuffleDesc> cshuffle_descriptions(tile_descriptions.size(), {1, 1});
+
+    std::vector<operation::CBlockTransferDesc> c_block_descriptions = {
+        // clang-format off
+// CBlockTransferClusterLengths|  CBlockTransfer
+//         _MBlock_MWaveMPerXdl| ScalarPerVector
+//         _NBlock_NWaveNPerXdl|   _NWaveNPerXdl
+//                             |                
+  {              S<1, 32, 1, 8>,               8},
+  {              S<1, 32, 1, 8>,               8},
+  {              S<1, 16, 1, 8>,               8},
+  {              S<1, 32, 1, 8>,               8},
+  {              S<1, 32, 1, 4>,               8},
+  {              S<1, 16, 1, 8>,               8},
+  {              S<1, 16, 1, 4>,               8},
+  {              S<1, 32, 1, 8>,               8},
+  {              S<1, 32, 1, 8>,               8},
+  {              S<1, 32, 1, 4>,               8},
+  {              S<1, 16, 1, 8>,               8},
+  {              S<1, 16, 1, 4>,               8},
+  {              S<1, 16, 1, 4>,               8},
+        // clang-format on
+    };
+
+    assert(tile_descriptions.size() == ab_block_descriptions.size());
+    assert(tile_descriptions.size() == c_block_descriptions.size());
+
+    // Channels that cannot be read with full vectors only get the generic scalar instance
+    if(prob.C % 8 != 0 or prob.K % 8 != 0)
+    {
+        tile_descriptions     = {{64, 64, 64, 32, 8, 8, 32, 32, 2, 2, 1}};
+        ab_block_descriptions = {{S<4, 16, 1>, S<1, 0, 2>, S<1, 0, 2>, 2, 1, 8, 1}};
+        cshuffle_descriptions = {{1, 1}};
+        c_block_descriptions  = {{S<1, 16, 1, 4>, 1}};
+    }
+
+    const auto conv_spec = GetConvSpec(prob);
+    const auto gemm_m    = prob.GetGemmM();
+    const auto gemm_n    = prob.GetGemmN();
+    const auto gemm_k    = prob.GetGemmK();
+
+    for(std::size_t i = 0; i < tile_descriptions.size(); i++)
+    {
+        Operation_Xdl_CShuffle x;
+        x.num_dim             = prob.NumDim;
+        x.tile_desc           = tile_descriptions[i];
+        x.a_block_transfer    = ab_block_descriptions[i];
+        x.b_block_transfer    = ab_block_descriptions[i];
+        x.cshuffle            = cshuffle_descriptions[i];
+        x.c_block_transfer    = c_block_descriptions[i];
+        x.a_type              = prob.ADataType;
+        x.b_type              = prob.BDataType;
+        x.acc                 = GetAccDataType(prob.ADataType);
+        x.cs_type             = prob.EDataType;
+        x.ds_type             = prob.DsDataType;
+        x.e_type              = prob.EDataType;
+        x.a_elem_op           = prob.AElementOp;
+        x.b_elem_op           = prob.BElementOp;
+        x.cde_elem_op         = prob.CDEElementOp;
+        x.conv_specialization = conv_spec;
+        x.gemm_specialization = GetGemmSpec(gemm_m,
+                                            gemm_n,
+                                            gemm_k,
+                                            x.tile_desc.m_per_block,
+                                            x.tile_desc.n_per_block,
+                                            x.tile_desc.k_per_block);
+        result.push_back(x);
+    }
+    return result;
+}
+
+std::vector<std::vector<Operation_Xdl_CShuffle>> Operation_Xdl_CShuffle::CreateOperations()
+{
+    std::vector<Problem> problems;
+    for(std::size_t num_dim : {1, 2, 3})
+    {
+        Problem prob;
+        prob.NumDim               = num_dim;
+        prob.C                    = 64;
+        prob.K                    = 64;
+        prob.InputSpatialLengths  = std::vector<std::size_t>(num_dim, 3);
+        prob.FilterSpatialLengths = std::vector<std::size_t>(num_dim, 3);
+        problems.push_back(prob);
+    }
+    return Transform(problems, [](const Problem& p) { return CreateOperations(p); });
+}
+
+static std::string GetConvLayout(std::size_t num_dim, const std::string& tensor)
+{
+    static const std::vector<std::vector<std::string>> layouts = {
+        // Input, Weight, Output
+        {"NWGC", "GKXC", "NWGK"},
+        {"NHWGC", "GKYXC", "NHWGK"},
+        {"NDHWGC", "GKZYXC", "NDHWGK"},
+    };
+    if(num_dim < 1 or num_dim > 3)
+        throw std::runtime_error("Unsupported number of spatial dimensions");
+    const auto& l = layouts[num_dim - 1];
+    auto layout   = tensor == "A" ? l[0] : tensor == "B" ? l[1] : l[2];
+    return "ck::tensor_layout::convolution::" + layout;
+}
+
+static const char* const DeviceGroupedConvFwdMultipleABD_Xdl_CShuffleTemplate =
+    "ck::tensor_operation::device::DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle<${NumDim}, "
+    "${LayoutA}, ${LayoutB}, ${LayoutDs}, ${LayoutE}, ${ADataType}, ${BDataType}, "
+    "${AccDataType}, ${CShuffleDataType}, ${DsDataType}, ${EDataType}, "
+    "${AElementwiseOperation}, ${BElementwiseOperation}, ${CDEElementwiseOperation}, "
+    "${ConvSpecialization}, ${GemmSpecialization}, ${NumGemmkPrefetchStage}, ${BlockSize}, "
+    "${MPerBlock}, ${NPerBlock}, ${KPerBlock}, ${AK1}, ${BK1}, ${MPerXDL}, ${NPerXDL}, "
+    "${MXdlPerWave}, ${NXdlPerWave}, ${ABlockTransferThreadClusterLengths_AK0_M_AK1}, "
+    "${ABlockTransferThreadClusterArrangeOrder}, ${ABlockTransferSrcAccessOrder}, "
+    "${ABlockTransferSrcVectorDim}, ${ABlockTransferSrcScalarPerVector}, "
+    "${ABlockTransferDstScalarPerVector_AK1}, ${ABlockLdsExtraM}, "
+    "${BBlockTransferThreadClusterLengths_BK0_N_BK1}, ${BBlockTransferThreadClusterArrangeOrder}, "
+    "${BBlockTransferSrcAccessOrder}, ${BBlockTransferSrcVectorDim}, "
+    "${BBlockTransferSrcScalarPerVector}, ${BBlockTransferDstScalarPerVector_BK1}, "
+    "${BBlockLdsExtraN}, ${CShuffleMXdlPerWavePerShuffle}, ${CShuffleNXdlPerWavePerShuffle}, "
+    "${CDEBlockTransferClusterLengths_MBlock_MPerBlock_NBlock_NPerBlock}, "
+    "${CDEBlockTransferScalarPerVector_NPerBlock}>";
+
+Solution Operation_Xdl_CShuffle::ToSolution() const
+{
+    std::unordered_map<std::string, std::string> values = {
+        {"NumDim", std::to_string(this->num_dim)},
+        {"LayoutA", GetConvLayout(this->num_dim, "A")},
+        {"LayoutB", GetConvLayout(this->num_dim, "B")},
+        {"LayoutDs",
+         MakeTuple(Transform(this->ds_type,
+                             [&](auto) { return GetConvLayout(this->num_dim, "E"); }))},
+        {"LayoutE", GetConvLayout(this->num_dim, "E")},
+        {"ADataType", ToString(this->a_type)},
+        {"BDataType", ToString(this->b_type)},
+        {"AccDataType", ToString(this->acc)},
+        {"CShuffleDataType", ToString(this->cs_type)},
+        {"DsDataType", MakeTuple(Transform(this->ds_type, [](auto dt) { return ToString(dt); }))},
+        {"EDataType", ToString(this->e_type)},
+        {"AElementwiseOperation", this->a_elem_op},
+        {"BElementwiseOperation", this->b_elem_op},
+        {"CDEElementwiseOperation", this->cde_elem_op},
+        {"ConvSpecialization", this->conv_specialization},
+        {"GemmSpecialization", this->gemm_specialization},
+        {"NumGemmkPrefetchStage", std::to_string(this->tile_desc.num_gemmk_prefetch_stage)},
+        {"BlockSize", std::to_string(this->tile_desc.block_size)},
+        {"MPerBlock", std::to_string(this->tile_desc.m_per_block)},
+        {"NPerBlock", std::to_string(this->tile_desc.n_per_block)},
+        {"KPerBlock", std::to_string(this->tile_desc.k_per_block)},
+        {"AK1", std::to_string(this->tile_desc.ak1)},
+        {"BK1", std::to_string(this->tile_desc.bk1)},
+        {"MPerXDL", std::to_string(this->tile_desc.m_per_XDL)},
+        {"NPerXDL", std::to_string(this->tile_desc.n_per_XDL)},
+        {"MXdlPerWave", std::to_string(this->tile_desc.m_Xdl_per_wave)},
+        {"NXdlPerWave", std::to_string(this->tile_desc.n_Xdl_per_wave)},
+        {"ABlockTransferThreadClusterLengths_AK0_M_AK1",
+         this->a_block_transfer.thread_cluster_length},
+        {"ABlockTransferThreadClusterArrangeOrder",
+         this->a_block_transfer.thread_cluster_arrange_order},
+        {"ABlockTransferSrcAccessOrder", this->a_block_transfer.src_access_order},
+        {"ABlockTransferSrcVectorDim", std::to_string(this->a_block_transfer.src_vec_dim)},
+        {"ABlockTransferSrcScalarPerVector",
+         std::to_string(this->a_block_transfer.src_scalar_per_vector)},
+        {"ABlockTransferDstScalarPerVector_AK1",
+         std::to_string(this->a_block_transfer.dst_scalar_per_vector_k1)},
+        {"ABlockLdsExtraM", std::to_string(this->a_block_transfer.lds_add_extra_dim)},
+        {"BBlockTransferThreadClusterLengths_BK0_N_BK1",
+         this->b_block_transfer.thread_cluster_length},
+        {"BBlockTransferThreadClusterArrangeOrder",
+         this->b_block_transfer.thread_cluster_arrange_order},
+        {"BBlockTransferSrcAccessOrder", this->b_block_transfer.src_access_order},
+        {"BBlockTransferSrcVectorDim", std::to_string(this->b_block_transfer.src_vec_dim)},
+        {"BBlockTransferSrcScalarPerVector",
+         std::to_string(this->b_block_transfer.src_scalar_per_vector)},
+        {"BBlockTransferDstScalarPerVector_BK1",
+         std::to_string(this->b_block_transfer.dst_scalar_per_vector_k1)},
+        {"BBlockLdsExtraN", std::to_string(this->b_block_transfer.lds_add_extra_dim)},
+        {"CShuffleMXdlPerWavePerShuffle",
+         std::to_string(this->cshuffle.m_Xdl_per_wave_per_shuffle)},
+        {"CShuffleNXdlPerWavePerShuffle",
+         std::to_string(this->cshuffle.n_Xdl_per_wave_per_shuffle)},
+        {"CDEBlockTransferClusterLengths_MBlock_MPerBlock_NBlock_NPerBlock",
+         this->c_block_transfer.cluster_lengths_m_block_m_wave_m_per_Xdl_n_block_n_wave_n_per_Xdl},
+        {"CDEBlockTransferScalarPerVector_NPerBlock",
+         std::to_string(this->c_block_transfer.scalar_per_vector_n_wave_n_per_Xdl)},
+    };
+
+    return Solution{
+        InterpolateString(DeviceGroupedConvFwdMultipleABD_Xdl_CShuffleTemplate, values),
+        std::move(values)};
+}
+
+} // namespace device_grouped_conv_fwd_multiple_abd
+} // namespace host
+} // namespace ck
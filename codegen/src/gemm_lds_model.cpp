@@ -0,0 +1,336 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/host/gemm_lds_model.hpp"
+#include "ck/host/block_transfer_analysis.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace ck {
+namespace host {
+
+std::function<std::int64_t(const std::vector<int>&)> MakeLdsOffset(const LdsTileDesc& desc)
+{
+    if(desc.mn_per_block <= 0 or desc.k1 <= 0 or desc.k_per_block <= 0 or
+       desc.k_per_block % desc.k1 != 0 or desc.data_bytes <= 0)
+        throw std::runtime_error("Invalid LDS tile");
+    const std::int64_t mn_per_block = desc.mn_per_block;
+    const std::int64_t k_per_block  = desc.k_per_block;
+    const std::int64_t k1           = desc.k1;
+    const std::int64_t k0           = k_per_block / k1;
+    const std::int64_t extra        = desc.lds_extra;
+
+    switch(desc.layout)
+    {
+    case LdsLayout::K0MNK1Padded:
+        return [=](const std::vector<int>& idx) {
+            return idx[0] * (mn_per_block + extra) * k1 + idx[1] * k1 + idx[2];
+        };
+    case LdsLayout::MNKPadded:
+        return [=](const std::vector<int>& idx) {
+            return idx[0] * k1 + idx[1] * (k_per_block + extra) + idx[2];
+        };
+    case LdsLayout::MNKXor: {
+        // MLdsLayer rows of MN share the 128 bytes of the banks
+        const std::int64_t layers = std::max<std::int64_t>(1, 128 / k_per_block / desc.data_bytes);
+        if(mn_per_block % layers != 0)
+            throw std::runtime_error("MPerBlock is not a multiple of MLdsLayer");
+        return [=](const std::vector<int>& idx) {
+            const std::int64_t row = idx[1] / layers;
+            const std::int64_t kk  = (idx[0] * layers + idx[1] % layers) ^ (row % (k0 * layers));
+            return kk * k1 + row * k_per_block * layers + idx[2];
+        };
+    }
+    case LdsLayout::KFoldXor: {
+        if(desc.thread_cluster_lengths.size() != 3 or desc.mn_per_xdl <= 0)
+            throw std::runtime_error("KFoldXor needs the thread cluster and MN per xdl");
+        const std::int64_t mn0            = desc.thread_cluster_lengths[1];
+        const std::int64_t k_thread_write = desc.thread_cluster_lengths[0];
+        const std::int64_t k_thread_read  = 64 / desc.mn_per_xdl;
+        if(mn0 <= 0 or k_thread_write <= 0 or k_thread_read <= 0 or mn_per_block % mn0 != 0 or
+           k0 % k_thread_write != 0 or k0 % k_thread_read != 0)
+            throw std::runtime_error("Invalid KFoldXor tile");
+        const std::int64_t mn1                 = mn_per_block / mn0;
+        const std::int64_t k0_per_thread_write = k0 / k_thread_write;
+        const std::int64_t k0_per_thread_read  = k0 / k_thread_read;
+
+        const std::int64_t kfold = k1 * mn0 * desc.data_bytes > 128
+                                       ? 1
+                                       : 128 / (k1 * mn0 * desc.data_bytes);
+        const std::int64_t k_thread_read_perm =
+            kfold * k0_per_thread_write / k0_per_thread_read > 1
+                ? k_thread_read / (kfold * k0_per_thread_write / k0_per_thread_read)
+                : k_thread_read;
+        const std::int64_t pair =
+            k1 * desc.mn_per_xdl * desc.data_bytes > 128
+                ? 1
+                : std::min(128 / (k1 * desc.mn_per_xdl * desc.data_bytes), mn0);
+
+        // lengths of the packed [KThreadWrite / kfold / KThreadReadPerm, K0PerThreadWrite,
+        // KThreadReadPerm * MN1, kfold * MN0 / pair, pair, K1] descriptor
+        const std::vector<std::int64_t> lengths = {k_thread_write / kfold / k_thread_read_perm,
+                                                   k0_per_thread_write,
+                                                   k_thread_read_perm * mn1,
+                                                   kfold * mn0 / pair,
+                                                   pair,
+                                                   k1};
+        if(std::any_of(lengths.begin(), lengths.end(), [](auto l) { return l <= 0; }))
+            throw std::runtime_error("Invalid KFoldXor tile");
+        return [=](const std::vector<int>& idx) {
+            // k0 is merged from [KThreadReadPerm, D0, kfold, K0PerThreadWrite] and mn from
+            // [MN0 / pair, pair, MN1]
+            const std::int64_t u2 = idx[0] % k0_per_thread_write;
+            const std::int64_t u4 = idx[0] / k0_per_thread_write % kfold;
+            const std::int64_t u1 = idx[0] / k0_per_thread_write / kfold % lengths[0];
+            const std::int64_t u0 = idx[0] / k0_per_thread_write / kfold / lengths[0];
+            const std::int64_t u3 = idx[1] % mn1;
+            const std::int64_t u6 = idx[1] / mn1 % pair;
+            const std::int64_t u5 = idx[1] / mn1 / pair;
+
+            const std::int64_t d2 = u0 * mn1 + u3;
+            const std::int64_t d3 = (u4 * (mn0 / pair) + u5) ^ (d2 % lengths[3]);
+            return ((((u1 * lengths[1] + u2) * lengths[2] + d2) * lengths[3] + d3) * lengths[4] +
+                    u6) *
+                       lengths[5] +
+                   idx[2];
+        };
+    }
+    }
+    throw std::runtime_error("Unknown LDS layout");
+}
+
+static LdsTileDesc MakeTileDesc(LdsLayout layout,
+                                const operation::TileDesc& tile,
+                                const operation::BlockTransferDesc& transfer,
+                                int mn_per_block,
+                                int k1,
+                                int mn_per_xdl,
+                                int data_bytes)
+{
+    LdsTileDesc desc;
+    desc.layout                 = layout;
+    desc.mn_per_block           = mn_per_block;
+    desc.k_per_block            = tile.k_per_block;
+    desc.k1                     = k1;
+    desc.mn_per_xdl             = mn_per_xdl;
+    desc.lds_extra              = transfer.lds_add_extra_dim;
+    desc.thread_cluster_lengths = ParseSequence(transfer.thread_cluster_length);
+    desc.data_bytes             = data_bytes;
+    return desc;
+}
+
+// Max offset plus one, the element space size of the descriptor
+static std::int64_t
+GetElementSpaceSize(const LdsTileDesc& desc,
+                    const std::function<std::int64_t(const std::vector<int>&)>& offset)
+{
+    std::int64_t size = 0;
+    for(int k0 = 0; k0 < desc.k_per_block / desc.k1; k0++)
+        for(int mn = 0; mn < desc.mn_per_block; mn++)
+            size = std::max(size, offset({k0, mn, desc.k1 - 1}) + 1);
+    return size;
+}
+
+static int GetWriteConflicts(const LdsTileDesc& desc,
+                             const std::function<std::int64_t(const std::vector<int>&)>& offset,
+                             const operation::BlockTransferDesc& transfer,
+                             int wave_size)
+{
+    BlockTransferAccess dst;
+    dst.block_slice_lengths          = {desc.k_per_block / desc.k1, desc.mn_per_block, desc.k1};
+    dst.thread_cluster_lengths       = desc.thread_cluster_lengths;
+    dst.thread_cluster_arrange_order = ParseSequence(transfer.thread_cluster_arrange_order);
+    dst.access_order                 = {0, 1, 2};
+    dst.vector_dim                   = 2;
+    dst.scalar_per_vector            = transfer.dst_scalar_per_vector_k1;
+    dst.tensor_lengths               = dst.block_slice_lengths;
+    dst.tensor_offset                = offset;
+    dst.data_bytes                   = desc.data_bytes;
+    return AnalyzeBlockTransfer(dst, wave_size).lds_bank_conflict_degree;
+}
+
+// The xdlops loads of every wave: lane l reads K1 wide vectors of row l % MNPerXdl of its xdl
+// tile, at the KPerThread slice of input block l / MNPerXdl
+static int GetReadConflicts(const LdsTileDesc& desc,
+                            const std::function<std::int64_t(const std::vector<int>&)>& offset,
+                            int mn_xdl_per_wave,
+                            int k_pack,
+                            int wave_size)
+{
+    const int mn_waves      = desc.mn_per_block / (mn_xdl_per_wave * desc.mn_per_xdl);
+    const int input_blocks  = wave_size / desc.mn_per_xdl;
+    const int k_per_thread  = desc.k_per_block / input_blocks;
+    const int vector_length = std::min(k_pack, desc.k1);
+    if(mn_waves == 0 or input_blocks == 0 or k_per_thread % k_pack != 0 or
+       k_pack % vector_length != 0)
+        throw std::runtime_error("Invalid xdlops tile");
+
+    int degree = 0;
+    std::vector<std::int64_t> lane_bytes(wave_size);
+    for(int wave = 0; wave < mn_waves; wave++)
+        for(int repeat = 0; repeat < mn_xdl_per_wave; repeat++)
+            for(int k = 0; k < k_per_thread; k += vector_length)
+            {
+                for(int lane = 0; lane < wave_size; lane++)
+                {
+                    const int mn = (repeat * mn_waves + wave) * desc.mn_per_xdl +
+                                   lane % desc.mn_per_xdl;
+                    const int kk = k_per_thread * (lane / desc.mn_per_xdl) + k;
+                    lane_bytes[lane] =
+                        offset({kk / desc.k1, mn, kk % desc.k1}) * desc.data_bytes;
+                }
+                degree = std::max(
+                    degree, LdsBankConflictDegree(lane_bytes, vector_length * desc.data_bytes));
+            }
+    return degree;
+}
+
+// The number of waves along M and N, checks that they tile the block
+static std::pair<int, int> GetWaves(const operation::TileDesc& tile,
+                                    const LdsHardwareDesc& hardware)
+{
+    if(tile.block_size <= 0 or tile.block_size % hardware.wave_size != 0 or
+       tile.m_per_XDL != tile.n_per_XDL or tile.m_per_XDL <= 0 or tile.m_Xdl_per_wave <= 0 or
+       tile.n_Xdl_per_wave <= 0)
+        throw std::runtime_error("Invalid gemm tile");
+    const int m_waves   = tile.m_per_block / (tile.m_Xdl_per_wave * tile.m_per_XDL);
+    const int n_waves   = tile.n_per_block / (tile.n_Xdl_per_wave * tile.n_per_XDL);
+    const int num_waves = tile.block_size / hardware.wave_size;
+    if(m_waves * n_waves != num_waves)
+        throw std::runtime_error("The waves do not tile the block");
+    return {m_waves, n_waves};
+}
+
+static LdsTileDesc MakeATileDesc(const GemmLdsDesc& desc)
+{
+    return MakeTileDesc(desc.a_layout,
+                        desc.tile,
+                        desc.a_block_transfer,
+                        desc.tile.m_per_block,
+                        desc.tile.ak1,
+                        desc.tile.m_per_XDL,
+                        desc.a_data_bytes);
+}
+
+static LdsTileDesc MakeBTileDesc(const GemmLdsDesc& desc)
+{
+    return MakeTileDesc(desc.b_layout,
+                        desc.tile,
+                        desc.b_block_transfer,
+                        desc.tile.n_per_block,
+                        desc.tile.bk1,
+                        desc.tile.n_per_XDL,
+                        desc.b_data_bytes);
+}
+
+GemmLdsAnalysis AnalyzeGemmLdsFootprint(const GemmLdsDesc& desc, const LdsHardwareDesc& hardware)
+{
+    const auto& tile              = desc.tile;
+    const auto [m_waves, n_waves] = GetWaves(tile, hardware);
+    const int num_waves           = m_waves * n_waves;
+
+    const auto a_desc = MakeATileDesc(desc);
+    const auto b_desc = MakeBTileDesc(desc);
+
+    GemmLdsAnalysis result;
+
+    const std::int64_t max_lds_align = std::lcm(tile.ak1, tile.bk1);
+    auto aligned_space_size          = [&](const LdsTileDesc& d) {
+        const auto size = GetElementSpaceSize(d, MakeLdsOffset(d));
+        return std::size_t((size + max_lds_align - 1) / max_lds_align * max_lds_align);
+    };
+    const int c_m = desc.cshuffle.m_Xdl_per_wave_per_shuffle * m_waves * tile.m_per_XDL;
+    const int c_n = desc.cshuffle.n_Xdl_per_wave_per_shuffle * n_waves * tile.n_per_XDL;
+
+    result.a_bytes         = aligned_space_size(a_desc) * desc.a_data_bytes;
+    result.b_bytes         = aligned_space_size(b_desc) * desc.b_data_bytes;
+    result.c_shuffle_bytes = std::size_t(c_m) * c_n * desc.c_shuffle_data_bytes;
+    // the A/B tiles and the C shuffle slab share every buffer
+    result.total_bytes =
+        std::max(result.a_bytes + result.b_bytes, result.c_shuffle_bytes) * desc.num_lds_buffers;
+    // resident workgroups are limited by LDS and by the wave slots
+    result.blocks_per_cu = std::min<std::size_t>(hardware.lds_bytes_per_cu / result.total_bytes,
+                                                 hardware.max_waves_per_cu / num_waves);
+    result.waves_per_cu  = result.blocks_per_cu * num_waves;
+    result.occupancy     = double(result.waves_per_cu) / hardware.max_waves_per_cu;
+    return result;
+}
+
+GemmLdsAnalysis AnalyzeGemmLds(const GemmLdsDesc& desc, const LdsHardwareDesc& hardware)
+{
+    const auto& tile              = desc.tile;
+    const auto [m_waves, n_waves] = GetWaves(tile, hardware);
+    const int num_waves           = m_waves * n_waves;
+    const int k_pack              = desc.k_pack > 0 ? desc.k_pack : std::lcm(tile.ak1, tile.bk1);
+
+    const int c_m = desc.cshuffle.m_Xdl_per_wave_per_shuffle * m_waves * tile.m_per_XDL;
+    const int c_n = desc.cshuffle.n_Xdl_per_wave_per_shuffle * n_waves * tile.n_per_XDL;
+
+    const auto a_desc   = MakeATileDesc(desc);
+    const auto b_desc   = MakeBTileDesc(desc);
+    const auto a_offset = MakeLdsOffset(a_desc);
+    const auto b_offset = MakeLdsOffset(b_desc);
+
+    GemmLdsAnalysis result = AnalyzeGemmLdsFootprint(desc, hardware);
+
+    // A/B block transfer stores and xdlops loads
+    result.a_write_conflicts =
+        GetWriteConflicts(a_desc, a_offset, desc.a_block_transfer, hardware.wave_size);
+    result.b_write_conflicts =
+        GetWriteConflicts(b_desc, b_offset, desc.b_block_transfer, hardware.wave_size);
+    result.a_read_conflicts =
+        GetReadConflicts(a_desc, a_offset, tile.m_Xdl_per_wave, k_pack, hardware.wave_size);
+    result.b_read_conflicts =
+        GetReadConflicts(b_desc, b_offset, tile.n_Xdl_per_wave, k_pack, hardware.wave_size);
+
+    // C shuffle stores: each lane writes the accumulators of its xdl column scalar by scalar,
+    // rows m2 * (InputBlocks * 4) + (lane / NPerXdl) * 4 + m4 of the packed [CM, CN] slab
+    const int input_blocks   = hardware.wave_size / tile.n_per_XDL;
+    const int groups_per_blk = tile.m_per_XDL / (input_blocks * 4);
+    if(groups_per_blk == 0)
+        throw std::runtime_error("Invalid xdlops tile");
+    std::vector<std::int64_t> lane_bytes(hardware.wave_size);
+    for(int wave = 0; wave < num_waves; wave++)
+        for(int m_xdl = 0; m_xdl < desc.cshuffle.m_Xdl_per_wave_per_shuffle; m_xdl++)
+            for(int n_xdl = 0; n_xdl < desc.cshuffle.n_Xdl_per_wave_per_shuffle; n_xdl++)
+                for(int m2 = 0; m2 < groups_per_blk; m2++)
+                    for(int m4 = 0; m4 < 4; m4++)
+                    {
+                        for(int lane = 0; lane < hardware.wave_size; lane++)
+                        {
+                            const int m = (m_xdl * m_waves + wave / n_waves) * tile.m_per_XDL +
+                                          m2 * input_blocks * 4 + lane / tile.n_per_XDL * 4 + m4;
+                            const int n = (n_xdl * n_waves + wave % n_waves) * tile.n_per_XDL +
+                                          lane % tile.n_per_XDL;
+                            lane_bytes[lane] =
+                                (std::int64_t(m) * c_n + n) * desc.c_shuffle_data_bytes;
+                        }
+                        result.c_write_conflicts =
+                            std::max(result.c_write_conflicts,
+                                     LdsBankConflictDegree(lane_bytes, desc.c_shuffle_data_bytes));
+                    }
+
+    // C shuffle loads of the block transfer to global memory
+    const auto& c_transfer = desc.c_block_transfer;
+    BlockTransferAccess c_src;
+    c_src.block_slice_lengths          = {1, c_m, 1, c_n};
+    c_src.thread_cluster_lengths       =
+        ParseSequence(c_transfer.cluster_lengths_m_block_m_wave_m_per_Xdl_n_block_n_wave_n_per_Xdl);
+    c_src.thread_cluster_arrange_order = {0, 1, 2, 3};
+    c_src.access_order                 = {0, 1, 2, 3};
+    c_src.vector_dim                   = 3;
+    c_src.scalar_per_vector            = c_transfer.scalar_per_vector_n_wave_n_per_Xdl;
+    c_src.tensor_lengths               = c_src.block_slice_lengths;
+    c_src.tensor_strides               = {c_m * c_n, c_n, c_n, 1};
+    c_src.data_bytes                   = desc.c_shuffle_data_bytes;
+
+    result.c_read_conflicts =
+        AnalyzeBlockTransfer(c_src, hardware.wave_size).lds_bank_conflict_degree;
+
+    return result;
+}
+
+} // namespace host
+} // namespace ck
@@ -1,5 +1,6 @@
 #include "ck/host/headers.hpp"
 #include "ck_headers.hpp"
+#include <filesystem>
 
 namespace ck {
 namespace host {
@@ -13,5 +14,103 @@ std::unordered_map<std::string_view, std::string_view> GetHeaders()
     return headers;
 }
 
+static std::size_t SkipSpaces(std::string_view s, std::size_t i)
+{
+    while(i < s.size() and (s[i] == ' ' or s[i] == '\t'))
+        i++;
+    return i;
+}
+
+std::vector<std::string> ScanIncludes(std::string_view content)
+{
+    std::vector<std::string> result;
+    std::size_t line_start = 0;
+    while(line_start < content.size())
+    {
+        auto line_end = content.find('\n', line_start);
+        if(line_end == std::string_view::npos)
+            line_end = content.size();
+        auto line = content.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+
+        auto i = SkipSpaces(line, 0);
+        if(i >= line.size() or line[i] != '#')
+            continue;
+        i = SkipSpaces(line, i + 1);
+        if(line.substr(i, 7) != "include")
+            continue;
+        i = SkipSpaces(line, i + 7);
+        if(i >= line.size() or (line[i] != '"' and line[i] != '<'))
+            continue;
+        const char close = line[i] == '"' ? '"' : '>';
+        auto last        = line.find(close, i + 1);
+        if(last == std::string_view::npos)
+            continue;
+        result.emplace_back(line.substr(i + 1, last - i - 1));
+    }
+    return result;
+}
+
+using HeaderGraph = std::unordered_map<std::string_view, std::vector<std::string_view>>;
+
+// Embedded headers directly included by each embedded header. An include is looked up next to the
+// including header first, then from the include root; system headers are not embedded and dropped.
+static const HeaderGraph& GetHeaderGraph()
+{
+    static const HeaderGraph graph = [] {
+        HeaderGraph result;
+        auto headers = GetHeaders();
+        for(const auto& [name, content] : headers)
+        {
+            auto& deps      = result[name];
+            const auto base = std::filesystem::path(name).parent_path();
+            for(const auto& include : ScanIncludes(content))
+            {
+                const auto relative = (base / include).lexically_normal().generic_string();
+                auto it             = headers.find(relative);
+                if(it == headers.end())
+                    it = headers.find(include);
+                if(it != headers.end())
+                    deps.push_back(it->first);
+            }
+        }
+        return result;
+    }();
+    return graph;
+}
+
+std::unordered_map<std::string_view, std::string_view>
+GetHeadersFor(const std::vector<std::string>& roots)
+{
+    static const auto headers = GetHeaders();
+    const auto& graph         = GetHeaderGraph();
+
+    std::unordered_map<std::string_view, std::string_view> result;
+    std::vector<std::string_view> stack;
+    auto visit = [&](std::string_view name) {
+        auto it = headers.find(name);
+        if(it == headers.end() or result.count(it->first) > 0)
+            return;
+        result.insert(*it);
+        stack.push_back(it->first);
+    };
+    visit("ck/config.h");
+    for(const auto& root : roots)
+        visit(root);
+    while(not stack.empty())
+    {
+        auto name = stack.back();
+        stack.pop_back();
+        for(auto dep : graph.at(name))
+            visit(dep);
+    }
+    return result;
+}
+
+std::unordered_map<std::string_view, std::string_view> GetHeadersFor(const std::string& root)
+{
+    return GetHeadersFor(std::vector<std::string>{root});
+}
+
 } // namespace host
-} // namespace ck
\ No newline at end of file
+} // namespace ck
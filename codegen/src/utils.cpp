@@ -2,6 +2,7 @@
 // Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
 
 #include "ck/host/utils.hpp"
+#include <unordered_map>
 
 namespace ck {
 namespace host {
@@ -11,11 +12,41 @@ std::size_t integer_divide_ceil(std::size_t x, std::size_t y)
     return (x + y - std::size_t{1}) / y;
 }
 
+std::string GetGemmSpec(const std::size_t m,
+                        const std::size_t n,
+                        const std::size_t k,
+                        const std::size_t m_per_block,
+                        const std::size_t n_per_block,
+                        const std::size_t k_per_block)
+{
+    std::string spec = "";
+    if(integer_divide_ceil(m, m_per_block) * m_per_block - m != 0)
+        spec += "M";
+    if(integer_divide_ceil(n, n_per_block) * n_per_block - n != 0)
+        spec += "N";
+    if(integer_divide_ceil(k, k_per_block) * k_per_block - k != 0)
+        spec += "K";
+    if(spec == "")
+        return "ck::tensor_operation::device::GemmSpecialization::Default";
+
+    return "ck::tensor_operation::device::GemmSpecialization::" + spec + "Padding";
+}
+
 const std::unordered_set<std::string>& get_xdlop_archs()
 {
     static std::unordered_set<std::string> supported_archs{"gfx90a", "gfx908", "gfx940", "gfx942"};
     return supported_archs;
 }
 
+std::size_t get_cu_count(const std::string& arch)
+{
+    static const std::unordered_map<std::string, std::size_t> cu_counts{
+        {"gfx908", 120}, {"gfx90a", 104}, {"gfx940", 228}, {"gfx941", 304}, {"gfx942", 304}};
+    auto it = cu_counts.find(arch);
+    if(it == cu_counts.end())
+        return 64;
+    return it->second;
+}
+
 } // namespace host
 } // namespace ck
@@ -0,0 +1,160 @@
+#include "ck/host/block_transfer_analysis.hpp"
+#include "ck/host/device_gemm_multiple_d/operation.hpp"
+#include "ck/host/types.hpp"
+#include "ck/host/utils.hpp"
+#include <test.hpp>
+
+// The A block transfer of the xdl gemms: [K0, M, K1] = [4, 64, 8] slice of a row major fp16 A
+// with K = 64, 256 threads
+ck::host::BlockTransferAccess MakeRowMajorA(int scalar_per_vector)
+{
+    ck::host::BlockTransferAccess access;
+    access.block_slice_lengths          = {4, 64, 8};
+    access.thread_cluster_lengths       = {4, 64, 1};
+    access.thread_cluster_arrange_order = {1, 0, 2};
+    access.access_order                 = {1, 0, 2};
+    access.vector_dim                   = 2;
+    access.scalar_per_vector            = scalar_per_vector;
+    access.tensor_lengths               = {8, 64, 8};
+    access.tensor_strides               = {8, 64, 1};
+    return access;
+}
+
+TEST_CASE(test_parse_sequence)
+{
+    EXPECT(ck::host::ParseSequence(ck::host::S<4, 64, 1>) == std::vector<int>{4, 64, 1});
+    EXPECT(ck::host::ParseSequence("ck::Sequence<>").empty());
+}
+
+TEST_CASE(test_row_major_src)
+{
+    const auto analysis = ck::host::AnalyzeBlockTransfer(MakeRowMajorA(8));
+    EXPECT(analysis.valid);
+    EXPECT(analysis.max_scalar_per_vector == 8);
+    // 4 lanes load 64 contiguous bytes of a 128 byte row
+    EXPECT(analysis.contiguous_bytes_per_request == 64);
+    EXPECT(analysis.coalescing_efficiency == 0.5);
+
+    // element by element every lane touches its own bytes
+    const auto scalar = ck::host::AnalyzeBlockTransfer(MakeRowMajorA(1));
+    EXPECT(scalar.valid);
+    EXPECT(scalar.max_scalar_per_vector == 8);
+    EXPECT(scalar.contiguous_bytes_per_request == 2);
+}
+
+TEST_CASE(test_wrong_vector_dim)
+{
+    // M is not contiguous in a row major A
+    auto access                         = MakeRowMajorA(8);
+    access.thread_cluster_lengths       = {4, 8, 8};
+    access.thread_cluster_arrange_order = {0, 2, 1};
+    access.access_order                 = {0, 2, 1};
+    access.vector_dim                   = 1;
+
+    const auto analysis = ck::host::AnalyzeBlockTransfer(access);
+    EXPECT(not analysis.valid);
+    EXPECT(analysis.max_scalar_per_vector == 1);
+}
+
+TEST_CASE(test_lds_dst)
+{
+    // The [K0, M, K1] LDS block, the 4 K0 of a row of M hit the same banks without padding
+    auto access           = MakeRowMajorA(8);
+    access.access_order   = {0, 1, 2};
+    access.tensor_lengths = {4, 64, 8};
+    access.tensor_strides = {64 * 8, 8, 1};
+    EXPECT(ck::host::AnalyzeBlockTransfer(access).lds_bank_conflict_degree == 4);
+
+    access.tensor_strides = {65 * 8, 8, 1};
+    EXPECT(ck::host::AnalyzeBlockTransfer(access).lds_bank_conflict_degree == 2);
+}
+
+TEST_CASE(test_padded_k_tail)
+{
+    // K = 12 seen as [K0, M, K1] = [2, 64, 8], the last 4 K1 elements of K0 = 1 are padding. A
+    // vector is either all padding or all data, so only 4 elements can be loaded at once.
+    auto access           = MakeRowMajorA(4);
+    access.tensor_lengths = {2, 64, 8};
+    access.tensor_offset  = [](const std::vector<int>& idx) -> std::int64_t {
+        const int k = idx[0] * 8 + idx[2];
+        return k < 12 ? idx[1] * 12 + k : -1;
+    };
+    const auto analysis = ck::host::AnalyzeBlockTransfer(access);
+    EXPECT(analysis.valid);
+    EXPECT(analysis.max_scalar_per_vector == 4);
+
+    access.scalar_per_vector = 8;
+    EXPECT(not ck::host::AnalyzeBlockTransfer(access).valid);
+
+    // K = 16 has no padding but rows of 16 elements, the K0 = 1 slice is still 8 wide
+    access.tensor_offset = [](const std::vector<int>& idx) -> std::int64_t {
+        return idx[1] * 16 + idx[0] * 8 + idx[2];
+    };
+    EXPECT(ck::host::AnalyzeBlockTransfer(access).max_scalar_per_vector == 8);
+}
+
+// The A/B loads of a packed matrix, seen as [K0, MN, K1]
+ck::host::BlockTransferAccess MakeGemmSrc(const ck::host::operation::BlockTransferDesc& transfer,
+                                          int k_per_block,
+                                          int mn_per_block,
+                                          int k1,
+                                          int mn,
+                                          int k,
+                                          bool mn_contiguous)
+{
+    ck::host::BlockTransferAccess access;
+    access.block_slice_lengths          = {k_per_block / k1, mn_per_block, k1};
+    access.thread_cluster_lengths       = ck::host::ParseSequence(transfer.thread_cluster_length);
+    access.thread_cluster_arrange_order = ck::host::ParseSequence(
+        transfer.thread_cluster_arrange_order);
+    access.access_order      = ck::host::ParseSequence(transfer.src_access_order);
+    access.vector_dim        = transfer.src_vec_dim;
+    access.scalar_per_vector = transfer.src_scalar_per_vector;
+    access.tensor_lengths    = {int(ck::host::integer_divide_ceil(k, k1)), mn, k1};
+    access.tensor_strides    = mn_contiguous ? std::vector<int>{k1 * mn, 1, mn}
+                                             : std::vector<int>{k1, k, 1};
+    return access;
+}
+
+TEST_CASE(test_gemm_derived_transfers)
+{
+    // The analytic vector widths of the shape-driven gemm tiles are the widest the loads allow
+    using ck::host::device_gemm_multiple_d::Operation_Xdl_CShuffle;
+    for(bool trans_a : {false, true})
+        for(bool trans_b : {false, true})
+        {
+            ck::host::device_gemm_multiple_d::Problem prob;
+            prob.M      = 96;
+            prob.N      = 200;
+            prob.K      = 64;
+            prob.TransA = trans_a;
+            prob.TransB = trans_b;
+            auto ops    = Operation_Xdl_CShuffle::CreateOperations(prob, "gfx90a");
+            EXPECT(not ops.empty());
+            for(const auto& op : ops)
+            {
+                const auto& tile = op.tile_desc;
+                const auto a     = ck::host::AnalyzeBlockTransfer(MakeGemmSrc(op.a_block_transfer,
+                                                                          tile.k_per_block,
+                                                                          tile.m_per_block,
+                                                                          tile.ak1,
+                                                                          prob.M,
+                                                                          prob.K,
+                                                                          trans_a));
+                const auto b     = ck::host::AnalyzeBlockTransfer(MakeGemmSrc(op.b_block_transfer,
+                                                                          tile.k_per_block,
+                                                                          tile.n_per_block,
+                                                                          tile.bk1,
+                                                                          prob.N,
+                                                                          prob.K,
+                                                                          not trans_b));
+                EXPECT(a.valid and b.valid);
+                EXPECT(op.a_block_transfer.src_scalar_per_vector ==
+                       std::min(a.max_scalar_per_vector, 8));
+                EXPECT(op.b_block_transfer.src_scalar_per_vector ==
+                       std::min(b.max_scalar_per_vector, 8));
+            }
+        }
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
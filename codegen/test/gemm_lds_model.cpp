@@ -0,0 +1,114 @@
+#include "ck/host/gemm_lds_model.hpp"
+#include "ck/host/types.hpp"
+#include <set>
+#include <test.hpp>
+
+// A 256x128x32 fp16 tile of 256 threads, 2x2 waves of 4x2 32x32 xdl tiles, K1 = 8
+ck::host::GemmLdsDesc MakeGemm(ck::host::LdsLayout layout, int lds_extra)
+{
+    ck::host::GemmLdsDesc desc;
+    desc.tile             = {256, 256, 128, 32, 8, 8, 32, 32, 4, 2, 1};
+    desc.a_block_transfer = {
+        ck::host::S<4, 64, 1>, ck::host::S<1, 0, 2>, ck::host::S<1, 0, 2>, 2, 8, 8, lds_extra};
+    desc.b_block_transfer = desc.a_block_transfer;
+    desc.cshuffle         = {1, 1};
+    desc.c_block_transfer = {ck::host::S<1, 32, 1, 8>, 8};
+    desc.a_layout         = layout;
+    desc.b_layout         = layout;
+    return desc;
+}
+
+TEST_CASE(test_footprint)
+{
+    const auto analysis =
+        ck::host::AnalyzeGemmLds(MakeGemm(ck::host::LdsLayout::K0MNK1Padded, 1));
+    // [4, 256 + 1, 8] and [4, 128 + 1, 8] fp16, the 64x64 C shuffle slab reuses the same LDS
+    EXPECT(analysis.a_bytes == std::size_t(3 * 257 * 8 + 256 * 8) * 2);
+    EXPECT(analysis.b_bytes == std::size_t(3 * 129 * 8 + 128 * 8) * 2);
+    EXPECT(analysis.c_shuffle_bytes == std::size_t(64 * 64 * 2));
+    EXPECT(analysis.total_bytes == analysis.a_bytes + analysis.b_bytes);
+    EXPECT(analysis.blocks_per_cu == 2);
+    EXPECT(analysis.waves_per_cu == 8);
+    EXPECT(analysis.occupancy == 0.25);
+
+    auto two_buffers            = MakeGemm(ck::host::LdsLayout::K0MNK1Padded, 1);
+    two_buffers.num_lds_buffers = 2;
+    const auto ping_pong        = ck::host::AnalyzeGemmLds(two_buffers);
+    EXPECT(ping_pong.total_bytes == 2 * analysis.total_bytes);
+    EXPECT(ping_pong.blocks_per_cu == 1);
+
+    // the wave slots limit small tiles
+    const auto small = ck::host::AnalyzeGemmLds(
+        MakeGemm(ck::host::LdsLayout::K0MNK1Padded, 1), {65536 * 8, 32, 64});
+    EXPECT(small.blocks_per_cu == 8);
+    EXPECT(small.occupancy == 1);
+
+    // the footprint alone, as the tile search scores its candidates
+    const auto footprint =
+        ck::host::AnalyzeGemmLdsFootprint(MakeGemm(ck::host::LdsLayout::K0MNK1Padded, 1));
+    EXPECT(footprint.total_bytes == analysis.total_bytes);
+    EXPECT(footprint.blocks_per_cu == analysis.blocks_per_cu);
+    EXPECT(footprint.occupancy == analysis.occupancy);
+    EXPECT(footprint.a_write_conflicts == 0);
+}
+
+TEST_CASE(test_padding_conflicts)
+{
+    // Without padding the 4 K0 of an M row written by consecutive threads hit the same banks
+    const auto unpadded =
+        ck::host::AnalyzeGemmLds(MakeGemm(ck::host::LdsLayout::K0MNK1Padded, 0));
+    const auto padded = ck::host::AnalyzeGemmLds(MakeGemm(ck::host::LdsLayout::K0MNK1Padded, 1));
+    EXPECT(unpadded.a_write_conflicts == 4);
+    EXPECT(padded.a_write_conflicts == 1);
+    // the xdlops read consecutive K1 vectors of M either way
+    EXPECT(unpadded.a_read_conflicts == 1);
+    EXPECT(padded.a_read_conflicts == 1);
+
+    // Rows of KPerBlock = 32 fp16 are 16 banks apart, padding them by K1 spreads the rows
+    const auto mk = ck::host::AnalyzeGemmLds(MakeGemm(ck::host::LdsLayout::MNKPadded, 0));
+    const auto mk_padded = ck::host::AnalyzeGemmLds(MakeGemm(ck::host::LdsLayout::MNKPadded, 8));
+    EXPECT(mk.a_read_conflicts == 4);
+    EXPECT(mk_padded.a_read_conflicts == 1);
+    EXPECT(mk_padded.a_bytes > mk.a_bytes);
+
+    // the xor swizzle halves the conflicts without growing the tile
+    const auto mk_xor = ck::host::AnalyzeGemmLds(MakeGemm(ck::host::LdsLayout::MNKXor, 0));
+    EXPECT(mk_xor.a_read_conflicts == 2);
+    EXPECT(mk_xor.a_bytes == mk.a_bytes);
+
+    EXPECT(padded.c_write_conflicts == 1);
+    EXPECT(padded.c_read_conflicts == 1);
+}
+
+TEST_CASE(test_xor_layouts_are_bijective)
+{
+    for(int k_per_block : {32, 64})
+        for(auto layout : {ck::host::LdsLayout::MNKXor, ck::host::LdsLayout::KFoldXor})
+        {
+            const int k0 = k_per_block / 8;
+            const ck::host::LdsTileDesc desc{layout, 128, k_per_block, 8, 32, 0, {k0, 256 / k0, 1}};
+            const auto offset = ck::host::MakeLdsOffset(desc);
+
+            std::set<std::int64_t> offsets;
+            for(int i = 0; i < k0; i++)
+                for(int mn = 0; mn < 128; mn++)
+                    for(int k1 = 0; k1 < 8; k1++)
+                    {
+                        const auto o = offset({i, mn, k1});
+                        EXPECT(o >= 0 and o < 128 * k_per_block);
+                        offsets.insert(o);
+                    }
+            EXPECT(offsets.size() == std::size_t(128 * k_per_block));
+        }
+}
+
+TEST_CASE(test_invalid_tile)
+{
+    // 192 rows are not a multiple of the 2 M waves of 4 xdl tiles
+    auto desc             = MakeGemm(ck::host::LdsLayout::K0MNK1Padded, 1);
+    desc.tile.m_per_block = 192;
+    EXPECT(test::throws([&] { ck::host::AnalyzeGemmLds(desc); }));
+    EXPECT(test::throws([&] { ck::host::AnalyzeGemmLdsFootprint(desc); }));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -14,10 +14,10 @@
 using half = _Float16;
 // using half = __fp16;
 
-std::vector<rtc::src_file> get_headers_for_test()
+std::vector<rtc::src_file> get_headers_for_test(const std::string& include)
 {
     std::vector<rtc::src_file> result;
-    auto hs = ck::host::GetHeaders();
+    auto hs = ck::host::GetHeadersFor(include);
     std::transform(
         hs.begin(), hs.end(), std::back_inserter(result), [&](const auto& p) -> rtc::src_file {
             return {p.first, p.second};
@@ -167,7 +167,7 @@ TEST_CASE(test_problem_kernel)
                                                 {"m", std::to_string(prob.M)},
                                                 {"n", std::to_string(prob.N)},
                                                 {"k", std::to_string(prob.K)}});
-        auto srcs = get_headers_for_test();
+        auto srcs = get_headers_for_test(prob.GetIncludeHeader());
         srcs.push_back({"main.cpp", src});
         rtc::compile_options options;
         options.kernel_name = "f";
@@ -0,0 +1,108 @@
+#include "ck/host/device_batched_gemm_multiple_d/problem.hpp"
+#include "ck/host/device_gemm_multiple_d/problem.hpp"
+#include "ck/host/headers.hpp"
+#include "ck/host/stringutils.hpp"
+#include <rtc/compile_kernel.hpp>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <test.hpp>
+
+std::size_t total_size(const std::unordered_map<std::string_view, std::string_view>& headers)
+{
+    return std::accumulate(headers.begin(), headers.end(), std::size_t{0}, [](auto n, auto p) {
+        return n + p.second.size();
+    });
+}
+
+std::vector<rtc::src_file>
+to_src_files(const std::unordered_map<std::string_view, std::string_view>& headers)
+{
+    return ck::host::Transform(
+        headers, [](const auto& p) -> rtc::src_file { return {p.first, p.second}; });
+}
+
+bool has_header(const std::unordered_map<std::string_view, std::string_view>& headers,
+                std::string_view name)
+{
+    return headers.find(name) != headers.end();
+}
+
+TEST_CASE(test_scan_includes)
+{
+    auto includes = ck::host::ScanIncludes("#include \"a.hpp\"\n"
+                                           "  #  include <b/c.hpp>\n"
+                                           "#ifdef X\n"
+                                           "#include \"d.hpp\" // comment\n"
+                                           "#endif\n"
+                                           "// #include not at the start\n"
+                                           "#pragma once\n"
+                                           "#include\"e.hpp\"");
+    EXPECT(includes == std::vector<std::string>{"a.hpp", "b/c.hpp", "d.hpp", "e.hpp"});
+}
+
+TEST_CASE(test_relative_includes)
+{
+    // device_batched_gemm_multi_d.hpp includes "device_base.hpp" from its own directory
+    ck::host::device_batched_gemm_multiple_d::Problem prob;
+    auto headers = ck::host::GetHeadersFor(prob.GetIncludeHeader());
+    EXPECT(has_header(headers, "ck/tensor_operation/gpu/device/device_base.hpp"));
+    EXPECT(not has_header(headers, "device_base.hpp"));
+}
+
+TEST_CASE(test_gemm_header_subset)
+{
+    ck::host::device_gemm_multiple_d::Problem prob;
+    auto all     = ck::host::GetHeaders();
+    auto headers = ck::host::GetHeadersFor(prob.GetIncludeHeader());
+    EXPECT(has_header(headers, prob.GetIncludeHeader()));
+    EXPECT(has_header(headers, "ck/config.h"));
+    EXPECT(has_header(headers, "ck/ck.hpp"));
+    EXPECT(headers.size() < all.size());
+    for(const auto& [name, content] : headers)
+    {
+        EXPECT(has_header(all, name));
+        EXPECT(all.at(name) == content);
+    }
+    std::cout << "Headers: " << headers.size() << "/" << all.size() << ", bytes "
+              << total_size(headers) << "/" << total_size(all) << std::endl;
+}
+
+const std::string gemm_instance = R"__ck__(
+#include <${include}>
+
+using G = ${template};
+extern "C" __global__ void f() {}
+)__ck__";
+
+// Reports the compile time of a solution with all headers and with the header subset
+TEST_CASE(test_header_subset_compile_time)
+{
+    ck::host::device_gemm_multiple_d::Problem prob;
+    prob.M        = 1024;
+    prob.N        = 1024;
+    prob.K        = 1024;
+    auto solution = prob.GetSolutions("gfx90a").front();
+    auto src      = ck::host::InterpolateString(
+        gemm_instance,
+        {{"include", prob.GetIncludeHeader()}, {"template", solution.ToTemplateString()}});
+
+    auto time_compile = [&](const auto& headers) {
+        auto srcs = to_src_files(headers);
+        srcs.push_back({"main.cpp", src});
+        rtc::compile_options options;
+        options.kernel_name = "f";
+        options.arch        = "gfx90a";
+        auto start          = std::chrono::steady_clock::now();
+        auto object         = rtc::compile_object(srcs, options);
+        auto stop           = std::chrono::steady_clock::now();
+        EXPECT(not object.empty());
+        return std::chrono::duration<double, std::milli>(stop - start).count();
+    };
+    auto all_ms    = time_compile(ck::host::GetHeaders());
+    auto subset_ms = time_compile(ck::host::GetHeadersFor(prob.GetIncludeHeader()));
+    std::cout << "All headers: " << all_ms << "ms, header subset: " << subset_ms << "ms"
+              << std::endl;
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
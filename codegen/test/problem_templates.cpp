@@ -0,0 +1,294 @@
+#include "ck/host/device_gemm_multiple_d/operation.hpp"
+#include "ck/host/device_gemm_multiple_d/problem.hpp"
+#include "ck/host/device_batched_gemm_multiple_d/problem.hpp"
+#include "ck/host/device_batched_gemm_softmax_gemm/problem.hpp"
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/problem.hpp"
+#include "ck/host/gemm_lds_model.hpp"
+#include "ck/host/stringutils.hpp"
+#include "ck/host/types.hpp"
+#include "ck/host/utils.hpp"
+#include <algorithm>
+#include <array>
+#include <string>
+#include <test.hpp>
+
+bool starts_with(const std::string& s, const std::string& prefix)
+{
+    return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+bool contains(const std::string& s, const std::string& x) { return s.find(x) != std::string::npos; }
+
+TEST_CASE(test_data_types)
+{
+    EXPECT(ck::host::ToString(ck::host::DataType::BFloat16) == "ck::bhalf_t");
+    EXPECT(ck::host::ToString(ck::host::DataType::Float8) == "ck::f8_t");
+    EXPECT(ck::host::ToString(ck::host::DataType::BFloat8) == "ck::bf8_t");
+}
+
+TEST_CASE(test_unsupported_arch)
+{
+    ck::host::device_grouped_conv_fwd_multiple_abd::Problem prob;
+    EXPECT(prob.GetSolutions("gfx1100").empty());
+}
+
+TEST_CASE(test_gemm_bf16)
+{
+    ck::host::device_gemm_multiple_d::Problem prob;
+    prob.M         = 256;
+    prob.N         = 256;
+    prob.K         = 256;
+    prob.ADataType = ck::host::DataType::BFloat16;
+    prob.BDataType = ck::host::DataType::BFloat16;
+    prob.EDataType = ck::host::DataType::BFloat16;
+    for(const auto& solution : prob.GetSolutions("gfx90a"))
+        EXPECT(starts_with(solution.ToTemplateString(),
+                           "ck::tensor_operation::device::DeviceGemmMultipleD_Xdl_CShuffle<"
+                           "ck::tensor_layout::gemm::RowMajor, ck::tensor_layout::gemm::RowMajor, "
+                           "ck::Tuple<>, ck::tensor_layout::gemm::RowMajor, ck::bhalf_t, "
+                           "ck::bhalf_t, float,"));
+}
+
+TEST_CASE(test_gemm_unknown_shape)
+{
+    // Without a shape the fixed tuning table is used
+    ck::host::device_gemm_multiple_d::Problem prob;
+    EXPECT(prob.GetSolutions("gfx90a").size() == 8);
+}
+
+TEST_CASE(test_gemm_small_m)
+{
+    using ck::host::device_gemm_multiple_d::Operation_Xdl_CShuffle;
+    ck::host::device_gemm_multiple_d::Problem prob;
+    prob.M = 16;
+    prob.N = 4096;
+    prob.K = 4096;
+    auto ops = Operation_Xdl_CShuffle::CreateOperations(prob, "gfx90a");
+    EXPECT(not ops.empty());
+    EXPECT(ops.front().tile_desc.m_per_block <= 32);
+    EXPECT(ops.front().tile_desc.m_per_XDL == 16);
+
+    auto num_cu = ck::host::get_cu_count("gfx90a");
+    auto scores = ck::host::Transform(ops, [&](const auto& op) {
+        return ck::host::device_gemm_multiple_d::ScoreOperation(prob, op, num_cu);
+    });
+    for(std::size_t i = 0; i < scores.size(); i++)
+    {
+        if(i > 0)
+            EXPECT(scores[i - 1].Value() >= scores[i].Value());
+        for(const auto& score : scores)
+            EXPECT(not score.Dominates(scores[i]));
+    }
+
+    auto solutions = prob.GetSolutions("gfx90a");
+    EXPECT(solutions.size() == ops.size());
+    EXPECT(not contains(solutions.front().ToTemplateString(), "${"));
+    // The unpadded 16-row tiles survive the pruning
+    EXPECT(std::any_of(solutions.begin(), solutions.end(), [](const auto& solution) {
+        return solution.GetTemplateParameter("MPerBlock") == "16" and
+               solution.GetTemplateParameter("GemmSpecialization") ==
+                   "ck::tensor_operation::device::GemmSpecialization::Default";
+    }));
+}
+
+TEST_CASE(test_gemm_skinny_ranking)
+{
+    // Mostly padded tall tiles must not win on occupancy alone
+    for(std::size_t m : {1, 16})
+    {
+        ck::host::device_gemm_multiple_d::Problem prob;
+        prob.M         = m;
+        prob.N         = 4096;
+        prob.K         = 4096;
+        auto solutions = prob.GetSolutions("gfx90a");
+        EXPECT(not solutions.empty());
+        EXPECT(solutions.front().GetTemplateParameter<int>("MPerBlock") <= 32);
+    }
+}
+
+TEST_CASE(test_gemm_unaligned)
+{
+    ck::host::device_gemm_multiple_d::Problem prob;
+    prob.M         = 1000;
+    prob.N         = 1002;
+    prob.K         = 999;
+    prob.TransB    = true;
+    auto solutions = prob.GetSolutions("gfx942");
+    EXPECT(not solutions.empty());
+    for(const auto& solution : solutions)
+    {
+        // Loads along K and stores along N can not be wider than the sizes allow
+        EXPECT(solution.GetTemplateParameter("ABlockTransferSrcScalarPerVector") == "1");
+        EXPECT(solution.GetTemplateParameter("BBlockTransferSrcScalarPerVector") == "1");
+        EXPECT(solution.GetTemplateParameter<int>("CDEBlockTransferScalarPerVector_NPerBlock") <=
+               2);
+        EXPECT(contains(solution.GetTemplateParameter("GemmSpecialization"), "KPadding"));
+    }
+}
+
+TEST_CASE(test_gemm_lds_store_conflicts)
+{
+    // Column major A and row major B are MN contiguous, the threads store several rows to LDS
+    using ck::host::device_gemm_multiple_d::Operation_Xdl_CShuffle;
+    ck::host::device_gemm_multiple_d::Problem prob;
+    prob.M      = 4096;
+    prob.N      = 4096;
+    prob.K      = 4096;
+    prob.TransA = true;
+    auto ops    = Operation_Xdl_CShuffle::CreateOperations(prob, "gfx90a");
+    EXPECT(not ops.empty());
+    for(const auto& op : ops)
+    {
+        ck::host::GemmLdsDesc desc;
+        desc.tile             = op.tile_desc;
+        desc.a_block_transfer = op.a_block_transfer;
+        desc.b_block_transfer = op.b_block_transfer;
+        desc.cshuffle         = op.cshuffle;
+        desc.c_block_transfer = op.c_block_transfer;
+        const auto lds        = ck::host::AnalyzeGemmLds(desc);
+        EXPECT(lds.a_write_conflicts <= 4);
+        EXPECT(lds.b_write_conflicts <= 4);
+    }
+}
+
+TEST_CASE(test_gemm_tiny)
+{
+    // Vectors along a K that is odd or shorter than K1 fall back to narrower loads
+    for(auto [m, n, k] : std::vector<std::array<std::size_t, 3>>{
+            {1, 1, 1}, {1, 64, 1}, {1, 4096, 4100}, {1, 4096, 4095}, {16, 4096, 4095}})
+    {
+        ck::host::device_gemm_multiple_d::Problem prob;
+        prob.M = m;
+        prob.N = n;
+        prob.K = k;
+        EXPECT(not prob.GetSolutions("gfx90a").empty());
+    }
+}
+
+TEST_CASE(test_batched_gemm)
+{
+    ck::host::device_batched_gemm_multiple_d::Problem prob;
+    prob.Batch  = 16;
+    prob.M      = 1024;
+    prob.N      = 1000;
+    prob.K      = 512;
+    prob.TransB = true;
+    auto solutions = prob.GetSolutions("gfx942");
+    EXPECT(not solutions.empty());
+    for(const auto& solution : solutions)
+    {
+        auto s = solution.ToTemplateString();
+        EXPECT(starts_with(s,
+                           "ck::tensor_operation::device::DeviceBatchedGemmMultiD_Xdl<"
+                           "ck::tensor_layout::gemm::RowMajor, "
+                           "ck::tensor_layout::gemm::ColumnMajor, ck::Tuple<>, "
+                           "ck::tensor_layout::gemm::RowMajor, ck::half_t, ck::half_t, float, "
+                           "ck::half_t, ck::Tuple<>, ck::half_t,"));
+        EXPECT(contains(s, "GemmSpecialization::NPadding"));
+        EXPECT(solution.GetTemplateParameter("ABlockLdsExtraM") == "true");
+        EXPECT(solution.GetTemplateParameter("BBlockLdsExtraN") == "true");
+    }
+}
+
+TEST_CASE(test_grouped_conv_fwd)
+{
+    ck::host::device_grouped_conv_fwd_multiple_abd::Problem prob;
+    prob.NumDim               = 2;
+    prob.G                    = 2;
+    prob.N                    = 4;
+    prob.C                    = 64;
+    prob.K                    = 128;
+    prob.InputSpatialLengths  = {28, 28};
+    prob.FilterSpatialLengths = {3, 3};
+    prob.InputLeftPads        = {1, 1};
+    prob.InputRightPads       = {1, 1};
+    prob.ADataType            = ck::host::DataType::Float8;
+    prob.BDataType            = ck::host::DataType::Float8;
+    prob.EDataType            = ck::host::DataType::Float8;
+    EXPECT(prob.GetOutputSpatialLengths() == std::vector<std::size_t>{28, 28});
+    EXPECT(prob.GetGemmM() == 4 * 28 * 28);
+    EXPECT(prob.GetGemmK() == 64 * 3 * 3);
+    auto solutions = prob.GetSolutions("gfx942");
+    EXPECT(solutions.size() > 1);
+    for(const auto& solution : solutions)
+    {
+        auto s = solution.ToTemplateString();
+        EXPECT(starts_with(s,
+                           "ck::tensor_operation::device::DeviceGroupedConvFwdMultipleABD_Xdl_"
+                           "CShuffle<2, ck::tensor_layout::convolution::NHWGC, "
+                           "ck::tensor_layout::convolution::GKYXC, ck::Tuple<>, "
+                           "ck::tensor_layout::convolution::NHWGK, ck::f8_t, ck::f8_t, float, "
+                           "ck::f8_t, ck::Tuple<>, ck::f8_t,"));
+        EXPECT(contains(s, "ConvolutionForwardSpecialization::Default"));
+        EXPECT(solution.GetTemplateParameter("ABlockTransferSrcScalarPerVector") == "8");
+    }
+}
+
+TEST_CASE(test_grouped_conv_fwd_1x1_unaligned)
+{
+    ck::host::device_grouped_conv_fwd_multiple_abd::Problem prob;
+    prob.NumDim               = 3;
+    prob.G                    = 1;
+    prob.N                    = 1;
+    prob.C                    = 3;
+    prob.K                    = 5;
+    prob.InputSpatialLengths  = {4, 4, 4};
+    prob.FilterSpatialLengths = {1, 1, 1};
+    prob.DsDataType           = {ck::host::DataType::Half};
+    auto solutions            = prob.GetSolutions("gfx90a");
+    EXPECT(solutions.size() == 1);
+    auto s = solutions.front().ToTemplateString();
+    EXPECT(contains(s,
+                    "ck::tensor_layout::convolution::GKZYXC, "
+                    "ck::Tuple<ck::tensor_layout::convolution::NDHWGK>, "
+                    "ck::tensor_layout::convolution::NDHWGK,"));
+    EXPECT(contains(s, "ConvolutionForwardSpecialization::Filter1x1Stride1Pad0"));
+    EXPECT(solutions.front().GetTemplateParameter("ABlockTransferSrcScalarPerVector") == "1");
+}
+
+TEST_CASE(test_grouped_conv_fwd_filter_too_large)
+{
+    ck::host::device_grouped_conv_fwd_multiple_abd::Problem prob;
+    prob.NumDim               = 2;
+    prob.InputSpatialLengths  = {4, 4};
+    prob.FilterSpatialLengths = {3, 3};
+    prob.ConvDilations        = {1, 2};
+    EXPECT(test::throws<std::runtime_error>([&] { prob.GetOutputSpatialLengths(); }));
+    EXPECT(test::throws<std::runtime_error>([&] { prob.GetGemmM(); }));
+    prob.InputLeftPads  = {0, 1};
+    prob.InputRightPads = {0, 0};
+    EXPECT(prob.GetOutputSpatialLengths() == std::vector<std::size_t>{2, 1});
+}
+
+TEST_CASE(test_softmax_gemm)
+{
+    ck::host::device_batched_gemm_softmax_gemm::Problem prob;
+    prob.G0     = 2;
+    prob.G1     = 8;
+    prob.M      = 512;
+    prob.N      = 512;
+    prob.K      = 64;
+    prob.O      = 64;
+    prob.Causal = true;
+    auto solutions = prob.GetSolutions("gfx90a");
+    EXPECT(not solutions.empty());
+    for(const auto& solution : solutions)
+    {
+        auto s = solution.ToTemplateString();
+        EXPECT(starts_with(s,
+                           "ck::tensor_operation::device::DeviceBatchedGemmSoftmaxGemmPermute_Xdl_"
+                           "CShuffle<2, 1, 1, 1, 1, ck::half_t, ck::half_t, ck::half_t, "
+                           "ck::half_t, ck::Tuple<>, ck::Tuple<>, float, ck::half_t,"));
+        EXPECT(contains(s, "ck::tensor_operation::element_wise::Scale"));
+        EXPECT(contains(s, "MaskingSpecialization::MaskOutUpperTriangle>"));
+        EXPECT(not contains(s, "${"));
+    }
+    auto padded = std::count_if(solutions.begin(), solutions.end(), [](const auto& solution) {
+        return solution.GetTemplateParameter("GemmSpecialization") ==
+               "ck::tensor_operation::device::GemmSpecialization::OPadding";
+    });
+    // Tiles with Gemm1NPerBlock = 128 have to pad the head dimension of 64
+    EXPECT(padded > 0);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
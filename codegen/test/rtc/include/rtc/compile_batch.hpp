@@ -0,0 +1,49 @@
+#ifndef GUARD_HOST_TEST_RTC_INCLUDE_RTC_COMPILE_BATCH
+#define GUARD_HOST_TEST_RTC_INCLUDE_RTC_COMPILE_BATCH
+
+#include <rtc/compile_kernel.hpp>
+#include <string>
+#include <vector>
+
+namespace rtc {
+
+struct compile_job
+{
+    std::vector<src_file> srcs;
+    compile_options options = compile_options{};
+};
+
+enum class compile_status
+{
+    success,
+    failed,
+    timeout
+};
+
+struct compile_result
+{
+    compile_status status = compile_status::failed;
+    std::vector<char> object{};
+    std::string error = "";
+    // Time of the compile, shared with the duplicates of the job
+    double elapsed_ms = 0;
+    // Index of the job that was actually compiled, differs from the own index for duplicates
+    std::size_t compiled_job = 0;
+};
+
+struct batch_options
+{
+    // Number of concurrent compiles, hardware concurrency when zero
+    std::size_t workers = 0;
+    // Per-job limit applied to jobs that do not set their own timeout_ms
+    std::size_t timeout_ms = 0;
+};
+
+// Compiles all jobs on a bounded worker pool. Jobs that hash to the same cache key are
+// compiled once and share the result. The returned vector is in the same order as jobs.
+std::vector<compile_result> compile_objects(const std::vector<compile_job>& jobs,
+                                            batch_options options = batch_options{});
+
+} // namespace rtc
+
+#endif
@@ -3,7 +3,9 @@
 
 #include <rtc/kernel.hpp>
 #include <filesystem>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace rtc {
 
@@ -13,12 +15,32 @@ struct src_file
     std::string_view content;
 };
 
+struct kernel_cache;
+
 struct compile_options
 {
     std::string flags       = "";
     std::string kernel_name = "main";
+    // Compiler command, the ROCm clang++ is used when empty
+    std::string compiler = "";
+    // Target architecture, the current device is queried when empty
+    std::string arch = "";
+    // Optional cache of compiled objects shared between compiles
+    const kernel_cache* cache = nullptr;
+    // Kill the compiler after this many milliseconds, no limit when zero
+    std::size_t timeout_ms = 0;
+};
+
+struct compile_timeout : std::runtime_error
+{
+    using std::runtime_error::runtime_error;
 };
 
+std::string default_compiler();
+
+std::vector<char> compile_object(const std::vector<src_file>& src,
+                                 compile_options options = compile_options{});
+
 kernel compile_kernel(const std::vector<src_file>& src,
                       compile_options options = compile_options{});
 
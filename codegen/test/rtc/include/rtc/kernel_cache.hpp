@@ -0,0 +1,60 @@
+#ifndef GUARD_HOST_TEST_RTC_INCLUDE_RTC_KERNEL_CACHE
+#define GUARD_HOST_TEST_RTC_INCLUDE_RTC_KERNEL_CACHE
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace rtc {
+
+struct src_file;
+struct compile_options;
+
+struct kernel_cache_options
+{
+    // Directory shared between processes, the disk level is disabled when empty
+    std::filesystem::path directory = "";
+    // Least recently used objects are removed once the directory grows past this size
+    std::size_t max_disk_bytes = std::size_t{1} << 30;
+    // Number of objects kept in the in-memory front cache
+    std::size_t max_memory_entries = 256;
+};
+
+struct kernel_cache_impl;
+
+// Content-addressed cache of compiled code objects. Entries are keyed by a hash of every
+// source file (including embedded headers), the compiler command, flags and target arch.
+struct kernel_cache
+{
+    kernel_cache(kernel_cache_options options = kernel_cache_options{});
+
+    // Cache configured from CK_RTC_CACHE_DIR and CK_RTC_CACHE_MAX_BYTES
+    static kernel_cache& get_default();
+
+    static std::string make_key(const std::vector<src_file>& srcs, const compile_options& options);
+
+    std::optional<std::vector<char>> load(const std::string& key) const;
+    void store(const std::string& key, const std::vector<char>& obj) const;
+
+    std::vector<char> get_or_compile(const std::string& key,
+                                     const std::function<std::vector<char>()>& compile) const;
+
+    // Drops the in-memory entries, the disk level is left untouched
+    void clear_memory() const;
+    // Removes least recently used files until the directory fits in max_disk_bytes. Called on
+    // construction and by the stores that take the tracked size past the limit, so a store
+    // does not scan the directory
+    void evict() const;
+
+    const kernel_cache_options& options() const;
+
+    private:
+    std::shared_ptr<kernel_cache_impl> impl;
+};
+
+} // namespace rtc
+
+#endif
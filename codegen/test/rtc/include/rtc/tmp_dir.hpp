@@ -6,12 +6,15 @@
 
 namespace rtc {
 
+std::string unique_string(const std::string& prefix);
+
 struct tmp_dir
 {
     std::filesystem::path path;
     tmp_dir(const std::string& prefix = "");
 
-    void execute(const std::string& cmd) const;
+    // Runs cmd inside the directory and returns its exit code
+    int execute(const std::string& cmd) const;
 
     tmp_dir(tmp_dir const&) = delete;
     tmp_dir& operator=(tmp_dir const&) = delete;
@@ -0,0 +1,101 @@
+#include <rtc/compile_batch.hpp>
+#include <rtc/hip.hpp>
+#include <rtc/kernel_cache.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+
+namespace rtc {
+
+std::vector<compile_result> compile_objects(const std::vector<compile_job>& jobs,
+                                            batch_options options)
+{
+    std::vector<compile_result> results(jobs.size());
+    if(jobs.empty())
+        return results;
+
+    // Resolve defaults up front so identical jobs produce identical keys
+    std::vector<compile_options> job_options;
+    std::string device_arch;
+    for(const auto& job : jobs)
+    {
+        auto opts = job.options;
+        if(opts.compiler.empty())
+            opts.compiler = default_compiler();
+        if(opts.arch.empty())
+        {
+            if(device_arch.empty())
+                device_arch = get_device_name();
+            opts.arch = device_arch;
+        }
+        if(opts.timeout_ms == 0)
+            opts.timeout_ms = options.timeout_ms;
+        job_options.push_back(opts);
+    }
+
+    std::vector<std::size_t> unique_jobs;
+    std::unordered_map<std::string, std::size_t> first_job;
+    for(std::size_t i = 0; i < jobs.size(); i++)
+    {
+        auto key = kernel_cache::make_key(jobs[i].srcs, job_options[i]);
+        auto it  = first_job.emplace(key, i).first;
+        results[i].compiled_job = it->second;
+        if(it->second == i)
+            unique_jobs.push_back(i);
+    }
+
+    std::size_t workers = options.workers;
+    if(workers == 0)
+        workers = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    workers = std::min(workers, unique_jobs.size());
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&] {
+        for(std::size_t n = next++; n < unique_jobs.size(); n = next++)
+        {
+            auto i     = unique_jobs[n];
+            auto& r    = results[i];
+            auto start = std::chrono::steady_clock::now();
+            try
+            {
+                r.object = compile_object(jobs[i].srcs, job_options[i]);
+                r.status = compile_status::success;
+            }
+            catch(const compile_timeout& e)
+            {
+                r.status = compile_status::timeout;
+                r.error  = e.what();
+            }
+            catch(const std::exception& e)
+            {
+                r.status = compile_status::failed;
+                r.error  = e.what();
+            }
+            auto stop    = std::chrono::steady_clock::now();
+            r.elapsed_ms = std::chrono::duration<double, std::milli>(stop - start).count();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(std::size_t t = 1; t < workers; t++)
+        threads.emplace_back(worker);
+    worker();
+    for(auto& t : threads)
+        t.join();
+
+    for(std::size_t i = 0; i < jobs.size(); i++)
+    {
+        auto j = results[i].compiled_job;
+        if(j == i)
+            continue;
+        results[i].status     = results[j].status;
+        results[i].object     = results[j].object;
+        results[i].error      = results[j].error;
+        results[i].elapsed_ms = results[j].elapsed_ms;
+    }
+    return results;
+}
+
+} // namespace rtc
@@ -1,5 +1,6 @@
 #include "rtc/hip.hpp"
 #include <rtc/compile_kernel.hpp>
+#include <rtc/kernel_cache.hpp>
 #include <rtc/tmp_dir.hpp>
 #include <stdexcept>
 #include <iostream>
@@ -55,15 +56,16 @@ void write_string(const std::string& filename, const std::string_view& buffer)
     write_buffer(filename, buffer.data(), buffer.size());
 }
 
-std::string compiler() { return "/opt/rocm/llvm/bin/clang++ -x hip --cuda-device-only"; }
+std::string default_compiler() { return "/opt/rocm/llvm/bin/clang++ -x hip --cuda-device-only"; }
 
-kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options)
+static std::vector<char> compile_object_uncached(const std::vector<src_file>& srcs,
+                                                 compile_options options)
 {
     assert(not srcs.empty());
     tmp_dir td{"compile"};
     options.flags += " -I. -O3";
     options.flags += " -std=c++17";
-    options.flags += " --offload-arch=" + get_device_name();
+    options.flags += " --offload-arch=" + options.arch;
     std::string out;
 
     for(const auto& src : srcs)
@@ -81,13 +83,42 @@ kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options
     }
 
     options.flags += " -o " + out;
-    td.execute(compiler() + options.flags);
+    std::string cmd = options.compiler + options.flags;
+    if(options.timeout_ms > 0)
+    {
+        // coreutils timeout exits with 124 when the limit is hit
+        cmd = "timeout -k 1 " + std::to_string(options.timeout_ms / 1000.0) + " " + cmd;
+        if(td.execute(cmd) == 124)
+            throw compile_timeout("Compilation timed out after " +
+                                  std::to_string(options.timeout_ms) + "ms");
+    }
+    else
+    {
+        td.execute(cmd);
+    }
 
     auto out_path = td.path / out;
     if(not std::filesystem::exists(out_path))
         throw std::runtime_error("Output file missing: " + out);
 
-    auto obj = read_buffer(out_path.string());
+    return read_buffer(out_path.string());
+}
+
+std::vector<char> compile_object(const std::vector<src_file>& srcs, compile_options options)
+{
+    if(options.compiler.empty())
+        options.compiler = default_compiler();
+    if(options.arch.empty())
+        options.arch = get_device_name();
+    if(options.cache == nullptr)
+        return compile_object_uncached(srcs, options);
+    return options.cache->get_or_compile(kernel_cache::make_key(srcs, options),
+                                         [&] { return compile_object_uncached(srcs, options); });
+}
+
+kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options)
+{
+    auto obj = compile_object(srcs, options);
 
     return kernel{obj.data(), options.kernel_name};
 }
@@ -0,0 +1,291 @@
+#include <rtc/kernel_cache.hpp>
+#include <rtc/compile_kernel.hpp>
+#include <rtc/tmp_dir.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace rtc {
+
+namespace {
+
+struct hasher
+{
+    // Two independent FNV-1a streams give a 128-bit key
+    std::uint64_t h1 = 14695981039346656037ull;
+    std::uint64_t h2 = 0x84222325cbf29ce4ull;
+
+    void update(const char* data, std::size_t n)
+    {
+        for(std::size_t i = 0; i < n; i++)
+        {
+            auto c = static_cast<unsigned char>(data[i]);
+            h1     = (h1 ^ c) * 1099511628211ull;
+            h2     = (h2 ^ c) * 0x100000001b3ull + 0x9e3779b97f4a7c15ull;
+        }
+    }
+
+    // Length prefix so that concatenated fields cannot alias
+    void update(std::string_view s)
+    {
+        std::uint64_t n = s.size();
+        update(reinterpret_cast<const char*>(&n), sizeof(n));
+        update(s.data(), s.size());
+    }
+
+    std::string digest() const
+    {
+        std::stringstream ss;
+        ss << std::hex << std::setfill('0') << std::setw(16) << h1 << std::setw(16) << h2;
+        return ss.str();
+    }
+};
+
+std::vector<char> read_file(const std::filesystem::path& p)
+{
+    std::ifstream is(p, std::ios::binary | std::ios::ate);
+    if(not is)
+        return {};
+    std::size_t n = is.tellg();
+    std::vector<char> result(n);
+    is.seekg(0, std::ios::beg);
+    if(not is.read(result.data(), n))
+        return {};
+    return result;
+}
+
+} // namespace
+
+struct kernel_cache_impl
+{
+    using entry = std::pair<std::string, std::shared_ptr<const std::vector<char>>>;
+
+    kernel_cache_options options;
+    std::mutex m;
+    std::list<entry> lru;
+    std::unordered_map<std::string, std::list<entry>::iterator> table;
+    // Size of the directory as of the last scan, plus the objects stored since. Other processes
+    // writing to the same directory are only seen at the next scan
+    std::uintmax_t disk_bytes = 0;
+
+    // Returns true when the directory may have grown past max_disk_bytes
+    bool add_disk_bytes(std::uintmax_t n)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        disk_bytes += n;
+        return disk_bytes > options.max_disk_bytes;
+    }
+
+    std::shared_ptr<const std::vector<char>> find(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto it = table.find(key);
+        if(it == table.end())
+            return nullptr;
+        lru.splice(lru.begin(), lru, it->second);
+        return it->second->second;
+    }
+
+    void insert(const std::string& key, std::shared_ptr<const std::vector<char>> obj)
+    {
+        if(options.max_memory_entries == 0)
+            return;
+        std::lock_guard<std::mutex> lock(m);
+        auto it = table.find(key);
+        if(it != table.end())
+        {
+            lru.splice(lru.begin(), lru, it->second);
+            return;
+        }
+        lru.emplace_front(key, std::move(obj));
+        table[key] = lru.begin();
+        while(lru.size() > options.max_memory_entries)
+        {
+            table.erase(lru.back().first);
+            lru.pop_back();
+        }
+    }
+
+    std::filesystem::path path_of(const std::string& key) const
+    {
+        return options.directory / (key + ".o");
+    }
+};
+
+kernel_cache::kernel_cache(kernel_cache_options options)
+    : impl(std::make_shared<kernel_cache_impl>())
+{
+    impl->options = std::move(options);
+    if(not impl->options.directory.empty())
+    {
+        std::filesystem::create_directories(impl->options.directory);
+        // The only full scan besides the ones of stores that go over the limit
+        evict();
+    }
+}
+
+kernel_cache& kernel_cache::get_default()
+{
+    static kernel_cache cache = [] {
+        kernel_cache_options options;
+        if(const char* dir = std::getenv("CK_RTC_CACHE_DIR"))
+            options.directory = dir;
+        if(const char* max_bytes = std::getenv("CK_RTC_CACHE_MAX_BYTES"))
+            options.max_disk_bytes = std::stoull(max_bytes);
+        return kernel_cache{options};
+    }();
+    return cache;
+}
+
+std::string kernel_cache::make_key(const std::vector<src_file>& srcs,
+                                   const compile_options& options)
+{
+    // Sort by path so the key does not depend on header map iteration order
+    std::vector<const src_file*> sorted;
+    std::transform(srcs.begin(), srcs.end(), std::back_inserter(sorted), [](const auto& src) {
+        return &src;
+    });
+    std::sort(sorted.begin(), sorted.end(), [](const auto* x, const auto* y) {
+        return x->path < y->path;
+    });
+
+    hasher h;
+    h.update(options.compiler);
+    h.update(options.flags);
+    h.update(options.arch);
+    for(const auto* src : sorted)
+    {
+        h.update(src->path.generic_string());
+        h.update(src->content);
+    }
+    return h.digest();
+}
+
+std::optional<std::vector<char>> kernel_cache::load(const std::string& key) const
+{
+    if(auto obj = impl->find(key))
+        return *obj;
+    if(impl->options.directory.empty())
+        return std::nullopt;
+
+    auto p   = impl->path_of(key);
+    auto obj = read_file(p);
+    if(obj.empty())
+        return std::nullopt;
+    // Refresh the timestamp so eviction is least recently used rather than oldest
+    std::error_code ec;
+    std::filesystem::last_write_time(p, std::filesystem::file_time_type::clock::now(), ec);
+    impl->insert(key, std::make_shared<const std::vector<char>>(obj));
+    return obj;
+}
+
+void kernel_cache::store(const std::string& key, const std::vector<char>& obj) const
+{
+    impl->insert(key, std::make_shared<const std::vector<char>>(obj));
+    if(impl->options.directory.empty())
+        return;
+
+    // Write to a private file first and rename it into place, so concurrent readers
+    // either see a complete object or nothing at all
+    auto p   = impl->path_of(key);
+    auto tmp = impl->options.directory / (unique_string(key) + ".tmp");
+    {
+        std::ofstream os(tmp, std::ios::binary);
+        os.write(obj.data(), obj.size());
+        if(not os)
+        {
+            std::error_code ec;
+            std::filesystem::remove(tmp, ec);
+            throw std::runtime_error("Failed to write cache entry: " + tmp.string());
+        }
+    }
+    std::error_code ec;
+    // Replacing an existing entry does not grow the directory
+    auto replaced = std::filesystem::file_size(p, ec);
+    if(ec)
+        replaced = 0;
+    std::filesystem::rename(tmp, p, ec);
+    if(ec)
+    {
+        // The entry stays in memory only, do not leave the private file behind
+        std::error_code remove_ec;
+        std::filesystem::remove(tmp, remove_ec);
+        if(remove_ec)
+            throw std::runtime_error("Failed to remove cache entry: " + tmp.string());
+        return;
+    }
+    if(impl->add_disk_bytes(obj.size() - std::min<std::uintmax_t>(replaced, obj.size())))
+        evict();
+}
+
+std::vector<char> kernel_cache::get_or_compile(
+    const std::string& key, const std::function<std::vector<char>()>& compile) const
+{
+    if(auto obj = load(key))
+        return std::move(*obj);
+    auto obj = compile();
+    store(key, obj);
+    return obj;
+}
+
+void kernel_cache::clear_memory() const
+{
+    std::lock_guard<std::mutex> lock(impl->m);
+    impl->table.clear();
+    impl->lru.clear();
+}
+
+void kernel_cache::evict() const
+{
+    if(impl->options.directory.empty())
+        return;
+
+    struct file_entry
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type time;
+        std::uintmax_t size;
+    };
+    std::vector<file_entry> files;
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for(const auto& f : std::filesystem::directory_iterator(impl->options.directory, ec))
+    {
+        if(f.path().extension() != ".o")
+            continue;
+        // Files may disappear underneath us when another process is evicting
+        std::error_code fec;
+        auto size = f.file_size(fec);
+        auto time = f.last_write_time(fec);
+        if(fec)
+            continue;
+        files.push_back({f.path(), time, size});
+        total += size;
+    }
+    if(total > impl->options.max_disk_bytes)
+    {
+        std::sort(files.begin(), files.end(), [](const auto& x, const auto& y) {
+            return x.time < y.time;
+        });
+        for(const auto& f : files)
+        {
+            if(total <= impl->options.max_disk_bytes)
+                break;
+            std::filesystem::remove(f.path, ec);
+            total -= f.size;
+        }
+    }
+    std::lock_guard<std::mutex> lock(impl->m);
+    impl->disk_bytes = total;
+}
+
+const kernel_cache_options& kernel_cache::options() const { return impl->options; }
+
+} // namespace rtc
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <random>
 #include <thread>
+#include <sys/wait.h>
 #include <unistd.h>
 
 namespace rtc {
@@ -37,10 +38,13 @@ tmp_dir::tmp_dir(const std::string& prefix)
     std::filesystem::create_directories(this->path);
 }
 
-void tmp_dir::execute(const std::string& cmd) const
+int tmp_dir::execute(const std::string& cmd) const
 {
     std::string s = "cd " + path.string() + "; " + cmd;
-    std::system(s.c_str());
+    int status    = std::system(s.c_str());
+    if(status == -1 or not WIFEXITED(status))
+        return -1;
+    return WEXITSTATUS(status);
 }
 
 tmp_dir::~tmp_dir() { std::filesystem::remove_all(this->path); }
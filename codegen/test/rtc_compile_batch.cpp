@@ -0,0 +1,89 @@
+#include "ck/host/device_gemm_multiple_d/problem.hpp"
+#include "ck/host/device_gemm_multiple_d/operation.hpp"
+#include <rtc/compile_batch.hpp>
+#include <rtc/tmp_dir.hpp>
+#include <fstream>
+#include <string>
+#include <test.hpp>
+
+// Stand-in for clang++: fails on "error", hangs on "slow" and otherwise copies the source
+const std::string mock_compiler = R"__sh__(
+out=""
+while [ $# -gt 0 ]; do
+    if [ "$1" = "-o" ]; then out="$2"; fi
+    shift
+done
+if grep -q error main.cpp; then exit 1; fi
+if grep -q slow main.cpp; then sleep 10; fi
+cat main.cpp > "$out"
+)__sh__";
+
+struct mock_env
+{
+    rtc::tmp_dir td{"batch-test"};
+
+    mock_env() { std::ofstream(td.path / "mock.sh") << mock_compiler; }
+
+    rtc::compile_job job(const std::string& src) const
+    {
+        rtc::compile_job result;
+        result.srcs             = {{"main.cpp", src}};
+        result.options.compiler = "sh " + (td.path / "mock.sh").string();
+        result.options.arch     = "gfx90a";
+        return result;
+    }
+};
+
+bool has_status(const rtc::compile_result& r, rtc::compile_status status)
+{
+    return r.status == status;
+}
+
+TEST_CASE(test_solutions_deduplicated)
+{
+    mock_env env;
+    ck::host::device_gemm_multiple_d::Problem prob;
+    prob.M = 1024;
+    prob.N = 1024;
+    prob.K = 1024;
+    auto solutions = prob.GetSolutions("gfx90a");
+
+    std::vector<std::string> srcs;
+    for(const auto& solution : solutions)
+        srcs.push_back("using G = " + solution.ToTemplateString() + ";\n");
+    // Warming a service typically asks for the same solutions more than once
+    std::vector<rtc::compile_job> jobs;
+    for(int i = 0; i < 2; i++)
+        for(const auto& src : srcs)
+            jobs.push_back(env.job(src));
+
+    rtc::batch_options options;
+    options.workers = 4;
+    auto results    = rtc::compile_objects(jobs, options);
+    EXPECT(results.size() == jobs.size());
+    for(std::size_t i = 0; i < results.size(); i++)
+    {
+        EXPECT(has_status(results[i], rtc::compile_status::success));
+        EXPECT(std::string(results[i].object.begin(), results[i].object.end()) ==
+               srcs[i % srcs.size()]);
+        EXPECT(results[i].compiled_job == i % srcs.size());
+        EXPECT(results[i].elapsed_ms == results[results[i].compiled_job].elapsed_ms);
+    }
+}
+
+TEST_CASE(test_failure_and_timeout)
+{
+    mock_env env;
+    std::vector<rtc::compile_job> jobs = {env.job("ok"), env.job("error"), env.job("slow")};
+
+    rtc::batch_options options;
+    options.timeout_ms = 500;
+    auto results       = rtc::compile_objects(jobs, options);
+    EXPECT(has_status(results[0], rtc::compile_status::success));
+    EXPECT(has_status(results[1], rtc::compile_status::failed));
+    EXPECT(not results[1].error.empty());
+    EXPECT(has_status(results[2], rtc::compile_status::timeout));
+    EXPECT(results[2].elapsed_ms < 5000);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,174 @@
+#include <rtc/compile_kernel.hpp>
+#include <rtc/kernel_cache.hpp>
+#include <rtc/tmp_dir.hpp>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <test.hpp>
+
+// Stand-in for clang++ that records each invocation and copies the source to the output
+const std::string stub_compiler = R"__sh__(
+echo run >> "$(dirname "$0")/count"
+out=""
+while [ $# -gt 0 ]; do
+    if [ "$1" = "-o" ]; then out="$2"; fi
+    shift
+done
+cat main.cpp > "$out"
+)__sh__";
+
+struct stub_env
+{
+    rtc::tmp_dir td{"cache-test"};
+
+    stub_env() { std::ofstream(td.path / "stub.sh") << stub_compiler; }
+
+    rtc::compile_options options(const rtc::kernel_cache& cache) const
+    {
+        rtc::compile_options result;
+        result.compiler = "sh " + (td.path / "stub.sh").string();
+        result.arch     = "gfx90a";
+        result.cache    = &cache;
+        return result;
+    }
+
+    int count() const
+    {
+        std::ifstream is(td.path / "count");
+        int n = 0;
+        std::string line;
+        while(std::getline(is, line))
+            n++;
+        return n;
+    }
+};
+
+std::string to_string(const std::vector<char>& obj) { return {obj.begin(), obj.end()}; }
+
+TEST_CASE(test_memory_hit)
+{
+    stub_env env;
+    rtc::kernel_cache cache;
+    std::vector<rtc::src_file> srcs = {{"main.cpp", "kernel a"}, {"a.hpp", "header"}};
+    auto obj1                       = rtc::compile_object(srcs, env.options(cache));
+    auto obj2                       = rtc::compile_object(srcs, env.options(cache));
+    EXPECT(to_string(obj1) == "kernel a");
+    EXPECT(obj1 == obj2);
+    EXPECT(env.count() == 1);
+}
+
+TEST_CASE(test_key_depends_on_inputs)
+{
+    stub_env env;
+    rtc::kernel_cache cache;
+    auto options                    = env.options(cache);
+    std::vector<rtc::src_file> srcs = {{"main.cpp", "kernel a"}, {"a.hpp", "header"}};
+    auto key                        = rtc::kernel_cache::make_key(srcs, options);
+
+    std::vector<rtc::src_file> reordered = {{"a.hpp", "header"}, {"main.cpp", "kernel a"}};
+    EXPECT(rtc::kernel_cache::make_key(reordered, options) == key);
+
+    std::vector<rtc::src_file> header_changed = {{"main.cpp", "kernel a"}, {"a.hpp", "header2"}};
+    EXPECT(rtc::kernel_cache::make_key(header_changed, options) != key);
+
+    auto other_arch = options;
+    other_arch.arch = "gfx942";
+    EXPECT(rtc::kernel_cache::make_key(srcs, other_arch) != key);
+
+    auto other_flags = options;
+    other_flags.flags += " -DFOO";
+    EXPECT(rtc::kernel_cache::make_key(srcs, other_flags) != key);
+
+    rtc::compile_object(srcs, options);
+    rtc::compile_object(header_changed, options);
+    rtc::compile_object(srcs, other_arch);
+    EXPECT(env.count() == 3);
+}
+
+TEST_CASE(test_disk_shared)
+{
+    stub_env env;
+    rtc::tmp_dir dir{"cache-dir"};
+    rtc::kernel_cache_options cache_options;
+    cache_options.directory = dir.path;
+    rtc::kernel_cache cache1{cache_options};
+    rtc::kernel_cache cache2{cache_options};
+    std::vector<rtc::src_file> srcs = {{"main.cpp", "kernel b"}};
+
+    rtc::compile_object(srcs, env.options(cache1));
+    // A second cache over the same directory models another process
+    auto obj = rtc::compile_object(srcs, env.options(cache2));
+    EXPECT(to_string(obj) == "kernel b");
+    EXPECT(env.count() == 1);
+
+    cache2.clear_memory();
+    EXPECT(cache2.load(rtc::kernel_cache::make_key(srcs, env.options(cache2))).has_value());
+    EXPECT(env.count() == 1);
+}
+
+TEST_CASE(test_eviction)
+{
+    stub_env env;
+    rtc::tmp_dir dir{"cache-dir"};
+    rtc::kernel_cache_options cache_options;
+    cache_options.directory          = dir.path;
+    cache_options.max_disk_bytes     = 20;
+    cache_options.max_memory_entries = 0;
+    rtc::kernel_cache cache{cache_options};
+
+    cache.store("k1", std::vector<char>(8, 'a'));
+    cache.store("k2", std::vector<char>(8, 'b'));
+    // k1 is the oldest entry until it is loaded again
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(dir.path / "k1.o", now - std::chrono::hours(2));
+    std::filesystem::last_write_time(dir.path / "k2.o", now - std::chrono::hours(1));
+    EXPECT(cache.load("k1").has_value());
+    cache.store("k3", std::vector<char>(8, 'c'));
+
+    int files = 0;
+    for(const auto& f : std::filesystem::directory_iterator(dir.path))
+        files += f.path().extension() == ".o" ? 1 : 0;
+    EXPECT(files == 2);
+    EXPECT(cache.load("k3").has_value());
+    // The refreshed k1 survives, the least recently used k2 is evicted
+    EXPECT(cache.load("k1").has_value());
+    EXPECT(not cache.load("k2").has_value());
+}
+
+TEST_CASE(test_evict_on_open)
+{
+    rtc::tmp_dir dir{"cache-dir"};
+    rtc::kernel_cache_options cache_options;
+    cache_options.directory          = dir.path;
+    cache_options.max_memory_entries = 0;
+    {
+        rtc::kernel_cache cache{cache_options};
+        cache.store("k1", std::vector<char>(8, 'a'));
+        cache.store("k2", std::vector<char>(8, 'b'));
+        cache.store("k3", std::vector<char>(8, 'c'));
+    }
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(dir.path / "k1.o", now - std::chrono::hours(3));
+    std::filesystem::last_write_time(dir.path / "k2.o", now - std::chrono::hours(2));
+    std::filesystem::last_write_time(dir.path / "k3.o", now - std::chrono::hours(1));
+
+    // A cache with a smaller limit trims the directory when it is opened
+    cache_options.max_disk_bytes = 20;
+    rtc::kernel_cache cache{cache_options};
+    EXPECT(not std::filesystem::exists(dir.path / "k1.o"));
+    EXPECT(cache.load("k2").has_value());
+    EXPECT(cache.load("k3").has_value());
+
+    // Replacing an entry does not count twice, so nothing is evicted
+    cache.store("k3", std::vector<char>(8, 'd'));
+    EXPECT(std::filesystem::exists(dir.path / "k2.o"));
+    // A new entry goes over the limit
+    cache.store("k4", std::vector<char>(8, 'e'));
+    int files = 0;
+    for(const auto& f : std::filesystem::directory_iterator(dir.path))
+        files += f.path().extension() == ".o" ? 1 : 0;
+    EXPECT(files == 2);
+    EXPECT(cache.load("k4").has_value());
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
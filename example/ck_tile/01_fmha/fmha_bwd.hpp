@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/kernel_launch.hpp"
+#include "ck_tile/ops/fmha.hpp"
+#include "mask.hpp"
+#include <string>
+#include <type_traits>
+
+// the data types follow the template arguments of ck_tile::reference_fmha_bwd(), which is the
+// host reference the backward instances are validated against
+template <typename DataType>
+struct FmhaBwdTypeConfig;
+
+template <>
+struct FmhaBwdTypeConfig<ck_tile::half_t>
+{
+    using QDataType        = ck_tile::half_t;
+    using KDataType        = ck_tile::half_t;
+    using VDataType        = ck_tile::half_t;
+    using BiasDataType     = ck_tile::half_t;
+    using ODataType        = ck_tile::half_t;
+    using LSEDataType      = float;
+    using OGradDataType    = ck_tile::half_t;
+    using AccDataType      = float; // data type for every gemm accumulation and dS
+    using QGradDataType    = ck_tile::half_t;
+    using KGradDataType    = ck_tile::half_t;
+    using VGradDataType    = ck_tile::half_t;
+    using BiasGradDataType = ck_tile::half_t;
+};
+
+template <>
+struct FmhaBwdTypeConfig<ck_tile::bf16_t>
+{
+    using QDataType        = ck_tile::bf16_t;
+    using KDataType        = ck_tile::bf16_t;
+    using VDataType        = ck_tile::bf16_t;
+    using BiasDataType     = ck_tile::bf16_t;
+    using ODataType        = ck_tile::bf16_t;
+    using LSEDataType      = float;
+    using OGradDataType    = ck_tile::bf16_t;
+    using AccDataType      = float; // data type for every gemm accumulation and dS
+    using QGradDataType    = ck_tile::bf16_t;
+    using KGradDataType    = ck_tile::bf16_t;
+    using VGradDataType    = ck_tile::bf16_t;
+    using BiasGradDataType = ck_tile::bf16_t;
+};
+
+// runtime args of fmha_bwd(). q/k/v/bias/o/lse are the inputs and outputs of the forward pass,
+// do_ptr is dO. The strides follow fmha_fwd_args, dq/dk/dv share the strides of q/k/v and dbias
+// the ones of bias. For MQA/GQA (nhead_q != nhead_k) dk/dv are per query head, the caller sums
+// them over each group
+struct fmha_bwd_args
+{
+    const void* q_ptr;
+    const void* k_ptr;
+    const void* v_ptr;
+    const void* bias_ptr;
+    const void* o_ptr;
+    const void* lse_ptr;
+    const void* do_ptr;
+    void* dq_ptr;
+    void* dk_ptr;
+    void* dv_ptr;
+    void* dbias_ptr;
+    const void* seqstart_q_ptr;
+    const void* seqstart_k_ptr;
+    const void* seqlen_k_ptr;
+    ck_tile::index_t seqlen_q;
+    ck_tile::index_t seqlen_k;
+    ck_tile::index_t batch;
+    ck_tile::index_t max_seqlen_q;
+    ck_tile::index_t max_seqlen_k;
+    ck_tile::index_t hdim_q;
+    ck_tile::index_t hdim_v;
+    ck_tile::index_t nhead_q;
+    ck_tile::index_t nhead_k;
+    float scale;
+    ck_tile::index_t stride_q;
+    ck_tile::index_t stride_k;
+    ck_tile::index_t stride_v;
+    ck_tile::index_t stride_bias;
+    ck_tile::index_t stride_o;
+    ck_tile::index_t stride_do;
+    ck_tile::index_t nhead_stride_q;
+    ck_tile::index_t nhead_stride_k;
+    ck_tile::index_t nhead_stride_v;
+    ck_tile::index_t nhead_stride_bias;
+    ck_tile::index_t nhead_stride_o;
+    ck_tile::index_t nhead_stride_lse;
+    ck_tile::index_t nhead_stride_do;
+    ck_tile::index_t batch_stride_q;
+    ck_tile::index_t batch_stride_k;
+    ck_tile::index_t batch_stride_v;
+    ck_tile::index_t batch_stride_bias;
+    ck_tile::index_t batch_stride_o;
+    ck_tile::index_t batch_stride_lse;
+    ck_tile::index_t batch_stride_do;
+    ck_tile::index_t window_size_left;
+    ck_tile::index_t window_size_right;
+    ck_tile::index_t mask_type;
+};
+
+// this is used to pattern-match internl kernel implementation, not to instantiate kernel
+template <ck_tile::index_t HDim_,
+          typename DataType_,
+          bool kIsGroupMode_,
+          typename FmhaMask_,
+          bool kHasBias_,
+          bool kHasBiasGrad_>
+struct fmha_bwd_traits_
+{
+    static constexpr ck_tile::index_t HDim = HDim_;
+    using DataType                         = ck_tile::remove_cvref_t<DataType_>;
+    static constexpr bool kIsGroupMode     = kIsGroupMode_;
+    using FmhaMask                         = ck_tile::remove_cvref_t<FmhaMask_>;
+    static constexpr bool kHasBias         = kHasBias_;
+    static constexpr bool kHasBiasGrad     = kHasBiasGrad_;
+};
+
+template <typename Traits_>
+float fmha_bwd_(const ck_tile::stream_config&, fmha_bwd_args);
+
+// This is the public API, will be generated by script. There is no ck_tile backward pipeline
+// yet, so the generated fmha_bwd() has no instance to dispatch to and always returns -1
+struct fmha_bwd_traits
+{
+    int hdim_q;
+    int hdim_v;
+    std::string data_type;
+    bool is_group_mode;
+    mask_enum mask_type;
+    bool has_bias;
+    bool has_dbias;
+};
+float fmha_bwd(fmha_bwd_traits, fmha_bwd_args, const ck_tile::stream_config&);
@@ -6,11 +6,15 @@
 #include "mask.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstring>
 #include <functional>
 #include <numeric>
+#include <optional>
 #include <ostream>
+#include <random>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -66,6 +70,10 @@ auto create_args(int argc, char* argv[])
             "if using static quantization fusion or not. 0: original flow(not prefered)\n"
             "1: apply scale_p and scale_o with respect to P and O. calculate scale_s, scale_p,\n"
             "scale_o according to range_q, range_k, range_v, range_p, range_o")
+        .insert("kv_dequant",
+                "0",
+                "quantize K/V per head instead of per tensor, used if squant=1. head h of K/V\n"
+                "uses range_k/v * (h + 1) / h_k, its scales are passed to the kernel in arrays")
         .insert("iperm",
                 "1",
                 "permute input\n"
@@ -87,7 +95,29 @@ auto create_args(int argc, char* argv[])
                 "now)")
         .insert("vlayout", "r", "r for row-major(seqlen*hdim), c for col-major(hdim*seqlen)")
         .insert("lse", "0", "0 not store lse, 1 store lse")
+        .insert("page_block_size",
+                "0",
+                "rows per page of a paged K/V cache, 0 means contiguous K/V\n"
+                "pages are assigned to the sequences through a random block table")
+        .insert("num_splits",
+                "1",
+                "number of parts seqlen_k is split into, >1 runs the split-kv kernel and merges\n"
+                "the partial results with a combine kernel (for small seqlen_q, e.g. decoding)")
+        .insert("s_knew",
+                "0",
+                "seqlen of new K/V rows appended to the K/V cache before attention, 0 means none\n"
+                "the cache holds s_k - s_knew rows before, s_k after (batch mode only)")
+        .insert("rotary_dim",
+                "0",
+                "rotary embedding applied to Q and the new K rows while appending, 0 means none")
+        .insert("rotary_interleaved",
+                "1",
+                "1: rotate pairs of adjacent elements, 0: rotate the two halves of rotary_dim")
         .insert("kname", "0", "if set to 1 will print kernel name")
+        .insert("sched",
+                "0",
+                "if set to 1 will print the predicted load balance of the group mode grid\n"
+                "and of a longest-first work list over the same (batch, head, q-tile) units")
         .insert(
             "init", "1", "init method. 0:random int, 1:random float, 2:trig float, 3:quantization")
         .insert("seed",
@@ -196,6 +226,13 @@ bool run(const ck_tile::ArgParser& arg_parser)
 
     float dtype_max = ck_tile::type_convert<float>(ck_tile::numeric<DataType>::max());
 
+    bool kv_dequant = arg_parser.get_bool("kv_dequant");
+    if(kv_dequant && !squant)
+    {
+        std::cerr << "per-head kv dequant is only supported with squant=1 for now" << std::endl;
+        return false;
+    }
+
     float scale_p = 1.f;
     float scale_o = 1.f;
 
@@ -207,10 +244,77 @@ bool run(const ck_tile::ArgParser& arg_parser)
         scale_o = range_p * range_v / range_o / dtype_max;
     }
 
+    // per-head [range_k/v of head h / max(fp8_t)], the kernel multiplies them into scale_s/scale_o
+    std::vector<float> k_descale_host(nhead_k, 1.f);
+    std::vector<float> v_descale_host(nhead_k, 1.f);
+    if(kv_dequant)
+    {
+        for(ck_tile::index_t h = 0; h < nhead_k; ++h)
+        {
+            k_descale_host[h] = range_k * (h + 1) / nhead_k / dtype_max;
+            v_descale_host[h] = range_v * (h + 1) / nhead_k / dtype_max;
+        }
+        scale_s = scale_s / (range_k / dtype_max);
+        scale_o = scale_o / (range_v / dtype_max);
+    }
+
     std::string vlayout = arg_parser.get_str("vlayout");
     bool use_bias       = arg_parser.get_bool("bias");
     bool lse            = arg_parser.get_bool("lse");
 
+    ck_tile::index_t page_block_size = arg_parser.get_int("page_block_size");
+    const bool is_paged_kv           = 0 < page_block_size;
+    if(is_paged_kv && vlayout != std::string("r"))
+    {
+        std::cerr << "paged kv only support row-major V for now" << std::endl;
+        return false;
+    }
+
+    if(kv_dequant && (use_bias || is_paged_kv || vlayout == std::string("r")))
+    {
+        std::cerr << "per-head kv dequant only support col-major V, without bias or paged kv"
+                  << std::endl;
+        return false;
+    }
+
+    ck_tile::index_t num_splits = arg_parser.get_int("num_splits");
+    const bool do_split_kv      = 1 < num_splits;
+    if(do_split_kv && (is_paged_kv || squant || vlayout != std::string("r")))
+    {
+        std::cerr << "split kv only support row-major V, without paged kv or fp8 static quant"
+                  << std::endl;
+        return false;
+    }
+    num_splits = std::max(num_splits, 1);
+
+    ck_tile::index_t seqlen_knew   = arg_parser.get_int("s_knew");
+    const bool need_append_kvcache = 0 < seqlen_knew;
+    ck_tile::index_t rotary_dim    = arg_parser.get_int("rotary_dim");
+    bool is_rotary_interleaved     = arg_parser.get_bool("rotary_interleaved");
+    if(need_append_kvcache)
+    {
+        if(mode != mode_enum::batch || seqlen_k < seqlen_knew || vlayout != std::string("r"))
+        {
+            std::cerr << "appending to the kv cache only support batch mode, row-major V and "
+                         "s_knew <= s_k for now"
+                      << std::endl;
+            return false;
+        }
+        if(rotary_dim < 0 || rotary_dim % 2 != 0 || hdim_q < rotary_dim)
+        {
+            std::cerr << "rotary_dim must be even and no larger than d" << std::endl;
+            return false;
+        }
+    }
+    else if(0 < rotary_dim)
+    {
+        std::cerr << "rotary embedding is applied while appending to the kv cache, set s_knew"
+                  << std::endl;
+        return false;
+    }
+    // rows in the K/V cache before appending
+    const ck_tile::index_t cache_seqlen_k = seqlen_k - std::max(seqlen_knew, 0);
+
     mask_info mask = mask_info::decode(arg_parser.get_str("mask"), seqlen_q, seqlen_k);
 
     int init_method              = arg_parser.get_int("init");
@@ -223,6 +327,7 @@ bool run(const ck_tile::ArgParser& arg_parser)
     int stream_warmup = arg_parser.get_int("warmup");
     int stream_repeat = arg_parser.get_int("repeat");
     bool kname        = arg_parser.get_bool("kname");
+    bool sched        = arg_parser.get_bool("sched");
 
     ck_tile::stream_config stream_config{
         nullptr, true, /* log_level = */ (kname ? 1 : 0), stream_warmup, stream_repeat};
@@ -268,6 +373,34 @@ bool run(const ck_tile::ArgParser& arg_parser)
         }
     }
 
+    if(sched && mode == mode_enum::group)
+    {
+        hipDeviceProp_t props;
+        int device;
+        HIP_CHECK_ERROR(hipGetDevice(&device));
+        HIP_CHECK_ERROR(hipGetDeviceProperties(&props, device));
+
+        // bm0 = 128 and bn1 = hdim for all the tiles emitted by generate.py, one block per CU
+        ck_tile::FmhaFwdScheduleProblem problem{seqstart_q_host,
+                                                seqstart_k_host,
+                                                nhead,
+                                                hdim_v,
+                                                128,
+                                                hdim_v,
+                                                props.multiProcessorCount};
+        const auto grid      = ck_tile::get_fmha_fwd_grid_stats(problem);
+        const auto work_list = ck_tile::make_fmha_fwd_work_list(problem, problem.num_slots);
+        const auto packed    = ck_tile::get_fmha_fwd_work_list_stats(problem, work_list);
+        // without any query rows neither launch has work to do
+        const double speedup =
+            packed.makespan == 0 ? 1.0 : static_cast<double>(grid.makespan) / packed.makespan;
+
+        std::cout << "sched: grid " << grid.num_blocks << " blocks (" << grid.num_idle_blocks
+                  << " idle), efficiency " << grid.efficiency << "; work list "
+                  << packed.num_blocks << " blocks, efficiency " << packed.efficiency
+                  << "; predicted speedup " << speedup << std::endl;
+    }
+
     auto get_lengths = [&](bool permute,
                            ck_tile::index_t b /*batch*/,
                            ck_tile::index_t h /*nhead*/,
@@ -309,12 +442,55 @@ bool run(const ck_tile::ArgParser& arg_parser)
     ck_tile::HostTensor<ODataType> o_host(
         get_lengths(o_perm, shape_batch, nhead, shape_seqlen_q, hdim_v));
 
+    // partial results of the splits, [num_splits, shape_batch, nhead, shape_seqlen_q(, hdim_v)]
+    ck_tile::HostTensor<LSEDataType> lse_acc_host(
+        do_split_kv
+            ? std::array<ck_tile::index_t, 4>{num_splits, shape_batch, nhead, shape_seqlen_q}
+            : std::array<ck_tile::index_t, 4>{1, 1, 1, 1} /* dummy shape for simplifying code */);
+    ck_tile::HostTensor<OaccDataType> o_acc_host(
+        do_split_kv ? std::array<ck_tile::index_t, 5>{num_splits,
+                                                      shape_batch,
+                                                      nhead,
+                                                      shape_seqlen_q,
+                                                      hdim_v}
+                    : std::array<ck_tile::index_t, 5>{1, 1, 1, 1, 1});
+
+    // new K/V rows, laid out like K/V
+    ck_tile::HostTensor<KDataType> knew_host(
+        need_append_kvcache
+            ? get_lengths(i_perm, batch, nhead_k, seqlen_knew, hdim_q)
+            : std::array<ck_tile::index_t, 4>{1, 1, 1, 1} /* dummy shape for simplifying code */);
+    ck_tile::HostTensor<VDataType> vnew_host(
+        need_append_kvcache
+            ? get_lengths(i_perm, batch, nhead_k, seqlen_knew, hdim_v)
+            : std::array<ck_tile::index_t, 4>{1, 1, 1, 1} /* dummy shape for simplifying code */);
+
+    // cos/sin of every position a new row of Q/K can be at, [positions, rotary_dim / 2]
+    const ck_tile::index_t rotary_len = cache_seqlen_k + std::max(seqlen_q, seqlen_knew);
+    ck_tile::HostTensor<QDataType> rotary_cos_host(
+        0 < rotary_dim ? std::array<ck_tile::index_t, 2>{rotary_len, rotary_dim / 2}
+                       : std::array<ck_tile::index_t, 2>{1, 1} /* dummy shape */);
+    ck_tile::HostTensor<QDataType> rotary_sin_host(rotary_cos_host.get_lengths());
+    if(0 < rotary_dim)
+    {
+        rotary_cos_host.ForEach([&](auto& self, auto i) {
+            const float angle = i[0] * std::pow(10000.f, -2.f * i[1] / rotary_dim);
+            self(i)           = ck_tile::type_convert<QDataType>(std::cos(angle));
+        });
+        rotary_sin_host.ForEach([&](auto& self, auto i) {
+            const float angle = i[0] * std::pow(10000.f, -2.f * i[1] / rotary_dim);
+            self(i)           = ck_tile::type_convert<QDataType>(std::sin(angle));
+        });
+    }
+
     if(init_method == 0)
     {
         ck_tile::FillUniformDistributionIntegerValue<QDataType>{-2.f, 2.f, seed}(q_host);
         ck_tile::FillUniformDistributionIntegerValue<KDataType>{-2.f, 2.f, seed}(k_host);
         ck_tile::FillUniformDistributionIntegerValue<VDataType>{-2.f, 2.f, seed}(v_host);
         ck_tile::FillUniformDistributionIntegerValue<BiasDataType>{-2.f, 2.f, seed}(bias_host);
+        ck_tile::FillUniformDistributionIntegerValue<KDataType>{-2.f, 2.f, seed}(knew_host);
+        ck_tile::FillUniformDistributionIntegerValue<VDataType>{-2.f, 2.f, seed}(vnew_host);
     }
     else if(init_method == 1)
     {
@@ -322,6 +498,8 @@ bool run(const ck_tile::ArgParser& arg_parser)
         ck_tile::FillUniformDistribution<KDataType>{0.f, 1.f, seed}(k_host);
         ck_tile::FillUniformDistribution<VDataType>{0.f, 1.f, seed}(v_host);
         ck_tile::FillUniformDistribution<BiasDataType>{0.f, 1.f, seed}(bias_host);
+        ck_tile::FillUniformDistribution<KDataType>{0.f, 1.f, seed}(knew_host);
+        ck_tile::FillUniformDistribution<VDataType>{0.f, 1.f, seed}(vnew_host);
     }
     else if(init_method == 2)
     {
@@ -329,12 +507,16 @@ bool run(const ck_tile::ArgParser& arg_parser)
         ck_tile::FillTrigValue<KDataType>{}(k_host);
         ck_tile::FillTrigValue<VDataType>{}(v_host);
         ck_tile::FillTrigValue<BiasDataType>{}(bias_host);
+        ck_tile::FillTrigValue<KDataType>{}(knew_host);
+        ck_tile::FillTrigValue<VDataType>{}(vnew_host);
     }
     else if(init_method == 3) // suitable for fp8 quantization
     {
         ck_tile::FillUniformDistribution<QDataType>{-dtype_max, dtype_max, seed}(q_host);
         ck_tile::FillUniformDistribution<KDataType>{-dtype_max, dtype_max, seed}(k_host);
         ck_tile::FillUniformDistribution<VDataType>{-dtype_max, dtype_max, seed}(v_host);
+        ck_tile::FillUniformDistribution<KDataType>{-dtype_max, dtype_max, seed}(knew_host);
+        ck_tile::FillUniformDistribution<VDataType>{-dtype_max, dtype_max, seed}(vnew_host);
 
         // bias_fp8 = qscale_bias * bias_fp32
         float qscale_bias = (dtype_max / range_q) * (dtype_max / range_k);
@@ -342,21 +524,119 @@ bool run(const ck_tile::ArgParser& arg_parser)
         ck_tile::FillUniformDistribution<BiasDataType>{-qscale_bias, qscale_bias, seed}(bias_host);
     }
 
+    // paged kv: scatter the K/V of each sequence over the pages of a pool, in random order. pool
+    // pages are [page_block_size, nhead_k, hdim]
+    std::vector<int32_t> block_table_host(1, 0);
+    ck_tile::index_t max_pages_per_seq = 1;
+    ck_tile::index_t num_page_blocks   = 1;
+    if(is_paged_kv)
+    {
+        max_pages_per_seq = 0;
+        num_page_blocks   = 0;
+        for(ck_tile::index_t wb = 0; wb < batch; ++wb)
+        {
+            const ck_tile::index_t num_pages = ck_tile::integer_divide_ceil(
+                seqstart_k_host[wb + 1] - seqstart_k_host[wb], page_block_size);
+            max_pages_per_seq = std::max(max_pages_per_seq, num_pages);
+            num_page_blocks += num_pages;
+        }
+        max_pages_per_seq = std::max(max_pages_per_seq, 1);
+        num_page_blocks   = std::max(num_page_blocks, 1);
+
+        std::vector<int32_t> pages(num_page_blocks);
+        std::iota(pages.begin(), pages.end(), 0);
+        std::shuffle(pages.begin(),
+                     pages.end(),
+                     std::mt19937(seed.has_value() ? *seed : std::random_device{}()));
+
+        block_table_host.assign(batch * max_pages_per_seq, 0);
+        auto next_page = pages.begin();
+        for(ck_tile::index_t wb = 0; wb < batch; ++wb)
+        {
+            const ck_tile::index_t num_pages = ck_tile::integer_divide_ceil(
+                seqstart_k_host[wb + 1] - seqstart_k_host[wb], page_block_size);
+            for(ck_tile::index_t i = 0; i < num_pages; ++i)
+                block_table_host[wb * max_pages_per_seq + i] = *next_page++;
+        }
+    }
+
+    ck_tile::HostTensor<KDataType> k_pool_host(
+        is_paged_kv
+            ? std::array<ck_tile::index_t, 4>{num_page_blocks, page_block_size, nhead_k, hdim_q}
+            : std::array<ck_tile::index_t, 4>{1, 1, 1, 1} /* dummy shape */);
+    ck_tile::HostTensor<VDataType> v_pool_host(
+        is_paged_kv
+            ? std::array<ck_tile::index_t, 4>{num_page_blocks, page_block_size, nhead_k, hdim_v}
+            : std::array<ck_tile::index_t, 4>{1, 1, 1, 1} /* dummy shape */);
+    auto scatter_kv_to_pages = [&]() {
+        for(ck_tile::index_t wb = 0; wb < batch; ++wb)
+        {
+            const ck_tile::index_t real_seqlen_k = seqstart_k_host[wb + 1] - seqstart_k_host[wb];
+            const ck_tile::index_t b             = (mode == mode_enum::batch ? wb : 0);
+            const ck_tile::index_t key_offset =
+                (mode == mode_enum::batch ? 0 : seqstart_k_host[wb]);
+
+            for(ck_tile::index_t n = 0; n < real_seqlen_k; ++n)
+            {
+                const ck_tile::index_t page =
+                    block_table_host[wb * max_pages_per_seq + n / page_block_size];
+                const ck_tile::index_t row = n % page_block_size;
+                // clang-format off
+                for(ck_tile::index_t h = 0; h < nhead_k; ++h)
+                {
+                    for(ck_tile::index_t d = 0; d < hdim_q; ++d)
+                        k_pool_host(page, row, h, d) = i_perm ? k_host(b, h, n + key_offset, d) : k_host(b, n + key_offset, h, d);
+                    for(ck_tile::index_t d = 0; d < hdim_v; ++d)
+                        v_pool_host(page, row, h, d) = i_perm ? v_host(b, h, n + key_offset, d) : v_host(b, n + key_offset, h, d);
+                }
+                // clang-format on
+            }
+        }
+    };
+    if(is_paged_kv)
+    {
+        // the rows of the pool past seqlen_k must never reach the output, make them stand out
+        ck_tile::FillConstant<KDataType>{ck_tile::numeric<KDataType>::quiet_NaN()}(k_pool_host);
+        ck_tile::FillConstant<VDataType>{ck_tile::numeric<VDataType>::quiet_NaN()}(v_pool_host);
+        scatter_kv_to_pages();
+    }
+
     ck_tile::DeviceMem q_buf(q_host.get_element_space_size_in_bytes());
-    ck_tile::DeviceMem k_buf(k_host.get_element_space_size_in_bytes());
-    ck_tile::DeviceMem v_buf(v_host.get_element_space_size_in_bytes());
+    ck_tile::DeviceMem k_buf(is_paged_kv ? k_pool_host.get_element_space_size_in_bytes()
+                                         : k_host.get_element_space_size_in_bytes());
+    ck_tile::DeviceMem v_buf(is_paged_kv ? v_pool_host.get_element_space_size_in_bytes()
+                                         : v_host.get_element_space_size_in_bytes());
     ck_tile::DeviceMem bias_buf(bias_host.get_element_space_size_in_bytes());
     ck_tile::DeviceMem lse_buf(lse_host.get_element_space_size_in_bytes());
     ck_tile::DeviceMem o_buf(o_host.get_element_space_size_in_bytes());
+    ck_tile::DeviceMem lse_acc_buf(lse_acc_host.get_element_space_size_in_bytes());
+    ck_tile::DeviceMem o_acc_buf(o_acc_host.get_element_space_size_in_bytes());
     ck_tile::DeviceMem seqstart_q(seqstart_q_host.size() * sizeof(int32_t));
     ck_tile::DeviceMem seqstart_k(seqstart_k_host.size() * sizeof(int32_t));
+    ck_tile::DeviceMem block_table_buf(block_table_host.size() * sizeof(int32_t));
+    ck_tile::DeviceMem knew_buf(knew_host.get_element_space_size_in_bytes());
+    ck_tile::DeviceMem vnew_buf(vnew_host.get_element_space_size_in_bytes());
+    ck_tile::DeviceMem rotary_cos_buf(rotary_cos_host.get_element_space_size_in_bytes());
+    ck_tile::DeviceMem rotary_sin_buf(rotary_sin_host.get_element_space_size_in_bytes());
+    const std::vector<int32_t> cache_seqlen_k_host(batch, cache_seqlen_k);
+    ck_tile::DeviceMem cache_seqlen_k_buf(cache_seqlen_k_host.size() * sizeof(int32_t));
+    ck_tile::DeviceMem k_descale_buf(k_descale_host.size() * sizeof(float));
+    ck_tile::DeviceMem v_descale_buf(v_descale_host.size() * sizeof(float));
 
     q_buf.ToDevice(q_host.data());
-    k_buf.ToDevice(k_host.data());
-    v_buf.ToDevice(v_host.data());
+    k_buf.ToDevice(is_paged_kv ? k_pool_host.data() : k_host.data());
+    v_buf.ToDevice(is_paged_kv ? v_pool_host.data() : v_host.data());
+    block_table_buf.ToDevice(block_table_host.data());
     bias_buf.ToDevice(bias_host.data());
     seqstart_q.ToDevice(seqstart_q_host.data());
     seqstart_k.ToDevice(seqstart_k_host.data());
+    knew_buf.ToDevice(knew_host.data());
+    vnew_buf.ToDevice(vnew_host.data());
+    rotary_cos_buf.ToDevice(rotary_cos_host.data());
+    rotary_sin_buf.ToDevice(rotary_sin_host.data());
+    cache_seqlen_k_buf.ToDevice(cache_seqlen_k_host.data());
+    k_descale_buf.ToDevice(k_descale_host.data());
+    v_descale_buf.ToDevice(v_descale_host.data());
 
     // clang-format off
     auto layout_str = [&](bool permute){
@@ -374,7 +654,19 @@ bool run(const ck_tile::ArgParser& arg_parser)
               << ", h:" << nhead << "/" << nhead_k << ", s:" << seqlen_q << "/" << seqlen_k
               << ", d:" << hdim_q << "/" << hdim_v << ", scale_s:" << scale_s
               << ", bias:" << use_bias << ", lse:" << lse << ", squant:" << squant
-              << ", mask:" << mask << ", v:" << vlayout << std::flush;
+              << ", mask:" << mask << ", v:" << vlayout;
+    if(kv_dequant)
+        std::cout << ", kv_dequant";
+    if(is_paged_kv)
+        std::cout << ", page:" << page_block_size;
+    if(do_split_kv)
+        std::cout << ", splits:" << num_splits;
+    if(need_append_kvcache)
+        std::cout << ", s_knew:" << seqlen_knew;
+    if(0 < rotary_dim)
+        std::cout << ", rotary_dim:" << rotary_dim
+                  << (is_rotary_interleaved ? "(inter)" : "(half)");
+    std::cout << std::flush;
 
     auto fmha_traits = fmha_fwd_traits{hdim_q,
                                        hdim_v,
@@ -384,7 +676,10 @@ bool run(const ck_tile::ArgParser& arg_parser)
                                        mask.type,
                                        use_bias,
                                        lse,
-                                       squant};
+                                       squant,
+                                       is_paged_kv,
+                                       do_split_kv,
+                                       kv_dequant};
 
     auto p_compute_element_func = [&]() {
         if constexpr(std::is_same_v<DataType, ck_tile::fp8_t>)
@@ -407,10 +702,14 @@ bool run(const ck_tile::ArgParser& arg_parser)
         ///       seqlen_k] in this example, hence both the 'batch_stride_bias' &
         ///       'nhead_stride_bias' are 0.
         // setup stride_* arguments
+        // paged K/V pool is [num_page_blocks, page_block_size, nhead_k, hdim] whatever iperm is,
+        // the batch_stride_k/v are used as the stride between two pages
         const ck_tile::index_t stride_q = (i_perm ? hdim_q : nhead * hdim_q);
-        const ck_tile::index_t stride_k = (i_perm ? hdim_q : nhead_k * hdim_q);
+        const ck_tile::index_t stride_k = (i_perm && !is_paged_kv ? hdim_q : nhead_k * hdim_q);
         const ck_tile::index_t stride_v = [&]() {
-            if(is_v_rowmajor)
+            if(is_paged_kv)
+                return nhead_k * hdim_v;
+            else if(is_v_rowmajor)
                 return i_perm ? hdim_v : nhead_k * hdim_v;
             else
                 return i_perm ? shape_seqlen_k : nhead_k * shape_seqlen_k;
@@ -419,9 +718,12 @@ bool run(const ck_tile::ArgParser& arg_parser)
         const ck_tile::index_t stride_o    = (o_perm ? hdim_v : nhead * hdim_v);
         // setup nhead_stride_* arguments
         const ck_tile::index_t nhead_stride_q = (i_perm ? shape_seqlen_q * hdim_q : hdim_q);
-        const ck_tile::index_t nhead_stride_k = (i_perm ? shape_seqlen_k * hdim_q : hdim_q);
+        const ck_tile::index_t nhead_stride_k =
+            (i_perm && !is_paged_kv ? shape_seqlen_k * hdim_q : hdim_q);
         const ck_tile::index_t nhead_stride_v = [&]() {
-            if(is_v_rowmajor)
+            if(is_paged_kv)
+                return hdim_v;
+            else if(is_v_rowmajor)
                 return i_perm ? shape_seqlen_k * hdim_v : hdim_v;
             else
                 return i_perm ? hdim_v * shape_seqlen_k : shape_seqlen_k;
@@ -432,11 +734,21 @@ bool run(const ck_tile::ArgParser& arg_parser)
         const ck_tile::index_t nhead_stride_o   = (o_perm ? shape_seqlen_q * hdim_v : hdim_v);
         // setup batch_stride_* arguments
         const ck_tile::index_t batch_stride_q    = (nhead * shape_seqlen_q * hdim_q);
-        const ck_tile::index_t batch_stride_k    = (nhead_k * shape_seqlen_k * hdim_q);
-        const ck_tile::index_t batch_stride_v    = (nhead_k * hdim_v * shape_seqlen_k);
+        const ck_tile::index_t batch_stride_k =
+            (is_paged_kv ? page_block_size : shape_seqlen_k) * nhead_k * hdim_q;
+        const ck_tile::index_t batch_stride_v =
+            (is_paged_kv ? page_block_size : shape_seqlen_k) * nhead_k * hdim_v;
         const ck_tile::index_t batch_stride_bias = (0 * nhead * shape_seqlen_q * shape_seqlen_k);
         const ck_tile::index_t batch_stride_lse  = (nhead * shape_seqlen_q * 1);
         const ck_tile::index_t batch_stride_o    = (nhead * shape_seqlen_q * hdim_v);
+        // setup split kv accumulation strides, the buffers are always bhsd
+        const ck_tile::index_t stride_o_acc         = hdim_v;
+        const ck_tile::index_t nhead_stride_lse_acc = shape_seqlen_q;
+        const ck_tile::index_t nhead_stride_o_acc   = shape_seqlen_q * hdim_v;
+        const ck_tile::index_t batch_stride_lse_acc = nhead * shape_seqlen_q;
+        const ck_tile::index_t batch_stride_o_acc   = nhead * shape_seqlen_q * hdim_v;
+        const ck_tile::index_t split_stride_lse_acc = shape_batch * nhead * shape_seqlen_q;
+        const ck_tile::index_t split_stride_o_acc   = shape_batch * nhead * shape_seqlen_q * hdim_v;
 
         return fmha_fwd_args{q_buf.GetDeviceBuffer(),
                              k_buf.GetDeviceBuffer(),
@@ -477,9 +789,92 @@ bool run(const ck_tile::ArgParser& arg_parser)
                              batch_stride_o,
                              mask.left,
                              mask.right,
-                             static_cast<ck_tile::index_t>(mask.type)};
+                             static_cast<ck_tile::index_t>(mask.type),
+                             block_table_buf.GetDeviceBuffer(),
+                             max_pages_per_seq,
+                             page_block_size,
+                             num_page_blocks,
+                             lse_acc_buf.GetDeviceBuffer(),
+                             o_acc_buf.GetDeviceBuffer(),
+                             num_splits,
+                             stride_o_acc,
+                             nhead_stride_lse_acc,
+                             nhead_stride_o_acc,
+                             batch_stride_lse_acc,
+                             batch_stride_o_acc,
+                             split_stride_lse_acc,
+                             split_stride_o_acc,
+                             kv_dequant ? k_descale_buf.GetDeviceBuffer() : nullptr,
+                             kv_dequant ? v_descale_buf.GetDeviceBuffer() : nullptr};
     }();
 
+    if(need_append_kvcache)
+    {
+        const auto rope_type = [&]() {
+            if(rotary_dim == 0)
+                return ck_tile::RotaryEmbeddingEnum::NONE;
+            return is_rotary_interleaved ? ck_tile::RotaryEmbeddingEnum::INTERLEAVED
+                                         : ck_tile::RotaryEmbeddingEnum::HALF_ROTATED;
+        }();
+        auto appendkv_traits = fmha_fwd_appendkv_traits{data_type, rope_type, is_paged_kv};
+
+        // Knew/Vnew are laid out like K/V, the caches and Q are the ones given to fmha_fwd()
+        const ck_tile::index_t stride_knew       = (i_perm ? hdim_q : nhead_k * hdim_q);
+        const ck_tile::index_t stride_vnew       = (i_perm ? hdim_v : nhead_k * hdim_v);
+        const ck_tile::index_t nhead_stride_knew = (i_perm ? seqlen_knew * hdim_q : hdim_q);
+        const ck_tile::index_t nhead_stride_vnew = (i_perm ? seqlen_knew * hdim_v : hdim_v);
+        const ck_tile::index_t batch_stride_knew = (nhead_k * seqlen_knew * hdim_q);
+        const ck_tile::index_t batch_stride_vnew = (nhead_k * seqlen_knew * hdim_v);
+
+        auto appendkv_args = fmha_fwd_appendkv_args{q_buf.GetDeviceBuffer(),
+                                                    k_buf.GetDeviceBuffer(),
+                                                    knew_buf.GetDeviceBuffer(),
+                                                    v_buf.GetDeviceBuffer(),
+                                                    vnew_buf.GetDeviceBuffer(),
+                                                    cache_seqlen_k_buf.GetDeviceBuffer(),
+                                                    seqlen_q,
+                                                    seqlen_knew,
+                                                    batch,
+                                                    hdim_q,
+                                                    hdim_v,
+                                                    nhead,
+                                                    nhead_k,
+                                                    rotary_cos_buf.GetDeviceBuffer(),
+                                                    rotary_sin_buf.GetDeviceBuffer(),
+                                                    rotary_dim,
+                                                    fmha_args.block_table_ptr,
+                                                    fmha_args.batch_stride_block_table,
+                                                    fmha_args.page_block_size,
+                                                    fmha_args.stride_q,
+                                                    fmha_args.stride_k,
+                                                    stride_knew,
+                                                    fmha_args.stride_v,
+                                                    stride_vnew,
+                                                    fmha_args.nhead_stride_q,
+                                                    fmha_args.nhead_stride_k,
+                                                    nhead_stride_knew,
+                                                    fmha_args.nhead_stride_v,
+                                                    nhead_stride_vnew,
+                                                    fmha_args.batch_stride_q,
+                                                    fmha_args.batch_stride_k,
+                                                    batch_stride_knew,
+                                                    fmha_args.batch_stride_v,
+                                                    batch_stride_vnew};
+
+        // Q is rotated in place, so the kernel must run exactly once
+        const ck_tile::stream_config appendkv_stream_config{
+            stream_config.stream_id_, true, stream_config.log_level_, 0, 1};
+        const float appendkv_ave_time =
+            fmha_fwd_appendkv(appendkv_traits, appendkv_args, appendkv_stream_config);
+        if(appendkv_ave_time < 0)
+        {
+            std::cout << ", appendkv not supported yet" << std::flush << std::endl;
+            return false;
+        }
+        std::cout << std::fixed << ", appendkv: " << std::setprecision(3) << appendkv_ave_time
+                  << " ms" << std::flush;
+    }
+
     float ave_time = fmha_fwd(fmha_traits, fmha_args, stream_config);
 
     if(ave_time < 0)
@@ -507,6 +902,59 @@ bool run(const ck_tile::ArgParser& arg_parser)
 
     bool pass = true;
 
+    // update the host copies of Q and the K/V cache the same way fmha_fwd_appendkv() did
+    if(need_append_kvcache)
+    {
+        // clang-format off
+        auto view = [&](auto& t, ck_tile::index_t h, ck_tile::index_t s, ck_tile::index_t d) {
+            using T = typename std::remove_reference_t<decltype(t)>::Data::value_type;
+            ck_tile::HostTensor<T> t_ref({batch * h, s, d});
+            if(i_perm) t_ref.ForEach([&](auto& self, auto i) { self(i) = t(i[0] / h, i[0] % h, i[1], i[2]); });
+            else       t_ref.ForEach([&](auto& self, auto i) { self(i) = t(i[0] / h, i[1], i[0] % h, i[2]); });
+            return t_ref;
+        };
+        auto write_back = [&](const auto& t_ref, auto& t, ck_tile::index_t h) {
+            if(i_perm) t_ref.ForEach([&](auto& self, auto i) { t(i[0] / h, i[0] % h, i[1], i[2]) = self(i); });
+            else       t_ref.ForEach([&](auto& self, auto i) { t(i[0] / h, i[1], i[0] % h, i[2]) = self(i); });
+        };
+        // clang-format on
+
+        std::optional<std::reference_wrapper<const ck_tile::HostTensor<QDataType>>> rotary_cos_ref;
+        std::optional<std::reference_wrapper<const ck_tile::HostTensor<QDataType>>> rotary_sin_ref;
+        if(0 < rotary_dim)
+        {
+            rotary_cos_ref = rotary_cos_host;
+            rotary_sin_ref = rotary_sin_host;
+
+            auto q_ref = view(q_host, nhead, seqlen_q, hdim_q);
+            ck_tile::reference_batched_rotary_position_embedding(
+                q_ref,
+                rotary_cos_host,
+                rotary_sin_host,
+                is_rotary_interleaved,
+                q_ref,
+                std::vector<ck_tile::index_t>(batch * nhead, cache_seqlen_k));
+            write_back(q_ref, q_host, nhead);
+        }
+
+        auto k_ref = view(k_host, nhead_k, seqlen_k, hdim_q);
+        auto v_ref = view(v_host, nhead_k, seqlen_k, hdim_v);
+        ck_tile::reference_fmha_fwd_appendkv<KDataType, QDataType>(
+            view(knew_host, nhead_k, seqlen_knew, hdim_q),
+            view(vnew_host, nhead_k, seqlen_knew, hdim_v),
+            k_ref,
+            v_ref,
+            std::vector<ck_tile::index_t>(batch * nhead_k, cache_seqlen_k),
+            rotary_cos_ref,
+            rotary_sin_ref,
+            is_rotary_interleaved);
+        write_back(k_ref, k_host, nhead_k);
+        write_back(v_ref, v_host, nhead_k);
+
+        if(is_paged_kv)
+            scatter_kv_to_pages();
+    }
+
     for(ck_tile::index_t wb = 0; wb < batch; ++wb)
     {
         const ck_tile::index_t real_seqlen_q = seqstart_q_host[wb + 1] - seqstart_q_host[wb];
@@ -529,8 +977,6 @@ bool run(const ck_tile::ArgParser& arg_parser)
         ck_tile::HostTensor<VDataType> v_host_ref(v_host_ref_lengths, v_host_ref_strides);
         ck_tile::HostTensor<ODataType> o_host_ref({nhead, real_seqlen_q, hdim_v});
 
-        ck_tile::HostTensor<SMPLComputeDataType> s_host_ref({nhead, real_seqlen_q, real_seqlen_k});
-        ck_tile::HostTensor<PDataType> p_host_ref({nhead, real_seqlen_q, real_seqlen_k});
         ck_tile::HostTensor<SMPLComputeDataType> lse_host_ref({nhead, real_seqlen_q});
 
         ck_tile::index_t nr = nhead / nhead_k;
@@ -555,18 +1001,12 @@ bool run(const ck_tile::ArgParser& arg_parser)
         }
         // clang-format on
 
-        // reference
-        ck_tile::reference_batched_gemm<QDataType, KDataType, SaccDataType, SMPLComputeDataType>(
-            q_host_ref,
-            k_host_ref,
-            s_host_ref,
-            ck_tile::identity{},
-            ck_tile::identity{},
-            ck_tile::scales(scale_s));
-
+        std::optional<std::reference_wrapper<const ck_tile::HostTensor<BiasDataType>>> bias_ref;
+        ck_tile::HostTensor<BiasDataType> bias_host_ref(
+            use_bias ? std::array<ck_tile::index_t, 3>{1, real_seqlen_q, real_seqlen_k}
+                     : std::array<ck_tile::index_t, 3>{1, 1, 1} /* dummy shape */);
         if(use_bias)
         {
-            ck_tile::HostTensor<BiasDataType> bias_host_ref({1, real_seqlen_q, real_seqlen_k});
             // clang-format off
             if(i_perm)
                 bias_host_ref.ForEach([&](auto& self, auto i) { self(i) = bias_host(0, 0, i[1] + query_offset, i[2] + key_offset); });
@@ -575,33 +1015,113 @@ bool run(const ck_tile::ArgParser& arg_parser)
             // clang-format on
 
             // broadcast from [1, real_seqlen_q, real_seqlen_k] to [nhead, real_seqlen_q,
-            // real_seqlen_k]
-            ck_tile::reference_batched_elementwise<SMPLComputeDataType,
-                                                   BiasDataType,
-                                                   SMPLComputeDataType,
-                                                   SMPLComputeDataType>(
-                s_host_ref, bias_host_ref, s_host_ref);
+            // real_seqlen_k] inside the reference
+            bias_ref = bias_host_ref;
+        }
+
+        std::optional<std::reference_wrapper<ck_tile::HostTensor<SMPLComputeDataType>>> lse_ref;
+        if(lse)
+        {
+            lse_ref = lse_host_ref;
         }
 
+        // reference, S and P are never materialized so long seqlen_k stays validatable
+        auto reference = [&](const auto& mask_ref) {
+            if(is_paged_kv)
+            {
+                const std::vector<int32_t> block_table_ref(
+                    block_table_host.begin() + wb * max_pages_per_seq,
+                    block_table_host.begin() + (wb + 1) * max_pages_per_seq);
+
+                ck_tile::reference_fmha_fwd_paged_kv<QDataType,
+                                                     KDataType,
+                                                     VDataType,
+                                                     BiasDataType,
+                                                     SaccDataType,
+                                                     SMPLComputeDataType,
+                                                     PDataType,
+                                                     OaccDataType,
+                                                     ODataType>(q_host_ref,
+                                                                k_pool_host,
+                                                                v_pool_host,
+                                                                block_table_ref,
+                                                                real_seqlen_k,
+                                                                bias_ref,
+                                                                o_host_ref,
+                                                                mask_ref,
+                                                                ck_tile::scales(scale_s),
+                                                                p_compute_element_func,
+                                                                oacc_element_func,
+                                                                lse_ref);
+                return;
+            }
+            if(kv_dequant)
+            {
+                // expand the scales of the K/V heads to the query heads
+                std::vector<float> k_descale_ref(nhead), v_descale_ref(nhead);
+                for(ck_tile::index_t h = 0; h < nhead; ++h)
+                {
+                    k_descale_ref[h] = k_descale_host[h / nr];
+                    v_descale_ref[h] = v_descale_host[h / nr];
+                }
+
+                ck_tile::reference_fmha_fwd_kv_dequant<QDataType,
+                                                       KDataType,
+                                                       VDataType,
+                                                       BiasDataType,
+                                                       SaccDataType,
+                                                       SMPLComputeDataType,
+                                                       PDataType,
+                                                       OaccDataType,
+                                                       ODataType>(q_host_ref,
+                                                                  k_host_ref,
+                                                                  v_host_ref,
+                                                                  bias_ref,
+                                                                  o_host_ref,
+                                                                  mask_ref,
+                                                                  k_descale_ref,
+                                                                  v_descale_ref,
+                                                                  ck_tile::scales(scale_s),
+                                                                  p_compute_element_func,
+                                                                  oacc_element_func,
+                                                                  lse_ref);
+                return;
+            }
+            ck_tile::reference_fmha_fwd<QDataType,
+                                        KDataType,
+                                        VDataType,
+                                        BiasDataType,
+                                        SaccDataType,
+                                        SMPLComputeDataType,
+                                        PDataType,
+                                        OaccDataType,
+                                        ODataType>(q_host_ref,
+                                                   k_host_ref,
+                                                   v_host_ref,
+                                                   bias_ref,
+                                                   o_host_ref,
+                                                   mask_ref,
+                                                   ck_tile::scales(scale_s),
+                                                   p_compute_element_func,
+                                                   oacc_element_func,
+                                                   lse_ref);
+        };
+
         if(mask.type == mask_enum::no_mask)
         {
-            ck_tile::reference_batched_masking<SaccDataType>(
-                s_host_ref, FmhaMasks::NoMask{real_seqlen_q, real_seqlen_k});
+            reference(FmhaMasks::NoMask{real_seqlen_q, real_seqlen_k});
         }
         else if(mask.type == mask_enum::window_generic)
         {
-            ck_tile::reference_batched_masking<SaccDataType>(
-                s_host_ref,
-                ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
-                    mask.left, mask.right, real_seqlen_q, real_seqlen_k));
+            reference(ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
+                mask.left, mask.right, real_seqlen_q, real_seqlen_k));
         }
         else
         {
             // if left window size is negative, means causal
             // else means generic (for current batch)
             if(mask.left < 0)
-                ck_tile::reference_batched_masking<SaccDataType>(
-                    s_host_ref,
+                reference(
                     ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::CausalMask>(
                         mask.left,
                         mask.right,
@@ -609,8 +1129,7 @@ bool run(const ck_tile::ArgParser& arg_parser)
                         real_seqlen_k,
                         mask.type == mask_enum::mask_top_left));
             else
-                ck_tile::reference_batched_masking<SaccDataType>(
-                    s_host_ref,
+                reference(
                     ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
                         mask.left,
                         mask.right,
@@ -618,24 +1137,6 @@ bool run(const ck_tile::ArgParser& arg_parser)
                         real_seqlen_k,
                         mask.type == mask_enum::mask_top_left));
         }
-        if(lse)
-        {
-            ck_tile::reference_batched_softmax<SMPLComputeDataType, SMPLComputeDataType, PDataType>(
-                s_host_ref, p_host_ref, p_compute_element_func, lse_host_ref);
-        }
-        else
-        {
-            ck_tile::reference_batched_softmax<SMPLComputeDataType, SMPLComputeDataType, PDataType>(
-                s_host_ref, p_host_ref, p_compute_element_func);
-        }
-
-        ck_tile::reference_batched_gemm<PDataType, VDataType, OaccDataType, ODataType>(
-            p_host_ref,
-            v_host_ref,
-            o_host_ref,
-            ck_tile::identity{},
-            ck_tile::identity{},
-            oacc_element_func);
 
         ck_tile::HostTensor<ODataType> o_host_result({nhead, real_seqlen_q, hdim_v});
         // clang-format off
@@ -73,13 +73,6 @@ struct FmhaFwdTypeConfig<ck_tile::bf8_t>
     using ODataType           = ck_tile::bf8_t;
 };
 
-struct FmhaMasks
-{
-    using NoMask      = ck_tile::GenericAttentionMask<false>;
-    using GenericMask = ck_tile::GenericAttentionMask<true, true>;
-    using CausalMask  = ck_tile::GenericAttentionMask<true, false>;
-};
-
 // runtime args, some will passed to karg, some will used to compute grids/blocks
 struct fmha_fwd_args
 {
@@ -123,12 +116,53 @@ struct fmha_fwd_args
     ck_tile::index_t window_size_left;
     ck_tile::index_t window_size_right;
     ck_tile::index_t mask_type;
+    // paged kv only. k_ptr/v_ptr point to a pool of num_page_blocks pages of page_block_size
+    // rows, batch_stride_k/v are the strides between two pages. the pages of batch b are
+    // block_table_ptr[b * batch_stride_block_table + i]
+    const void* block_table_ptr;
+    ck_tile::index_t batch_stride_block_table;
+    ck_tile::index_t page_block_size;
+    ck_tile::index_t num_page_blocks;
+    // split kv only. seqlen_k is cut into num_splits parts computed by different blocks, their
+    // partial O/lse go to o_acc_ptr/lse_acc_ptr (OaccDataType/LSEDataType), which are laid out
+    // like o/lse with an extra outermost split dimension. a second kernel merges them into
+    // o_ptr/lse_ptr
+    void* lse_acc_ptr;
+    void* o_acc_ptr;
+    ck_tile::index_t num_splits;
+    ck_tile::index_t stride_o_acc;
+    ck_tile::index_t nhead_stride_lse_acc;
+    ck_tile::index_t nhead_stride_o_acc;
+    ck_tile::index_t batch_stride_lse_acc;
+    ck_tile::index_t batch_stride_o_acc;
+    ck_tile::index_t split_stride_lse_acc;
+    ck_tile::index_t split_stride_o_acc;
+    // kv dequant only. K/V are quantized per head, [nhead_k] fp32 dequant scales. S and O of the
+    // heads sharing K/V head h_k are further scaled by k_descale_ptr[h_k]/v_descale_ptr[h_k]
+    const void* k_descale_ptr;
+    const void* v_descale_ptr;
 };
 
 template <typename FmhaKernel>
 auto fmha_fwd_create_kargs_and_grids(fmha_fwd_args args)
 {
     assert(args.nhead_q % args.nhead_k == 0);
+    // split kv kernels write their partial results into the accumulation buffers
+    if constexpr(FmhaKernel::kHasSplitKV)
+    {
+        args.lse_ptr          = args.lse_acc_ptr;
+        args.o_ptr            = args.o_acc_ptr;
+        args.stride_o         = args.stride_o_acc;
+        args.nhead_stride_lse = args.nhead_stride_lse_acc;
+        args.nhead_stride_o   = args.nhead_stride_o_acc;
+        args.batch_stride_lse = args.batch_stride_lse_acc;
+        args.batch_stride_o   = args.batch_stride_o_acc;
+    }
+    else
+    {
+        args.num_splits = 1;
+    }
+
     auto kargs = [&] {
         // create group mode kernel arguments
         if constexpr(FmhaKernel::kIsGroupMode)
@@ -161,7 +195,18 @@ auto fmha_fwd_create_kargs_and_grids(fmha_fwd_args args)
                                          args.nhead_stride_o,
                                          args.window_size_left,
                                          args.window_size_right,
-                                         args.mask_type);
+                                         args.mask_type,
+                                         args.block_table_ptr,
+                                         args.batch_stride_block_table,
+                                         args.page_block_size,
+                                         args.num_page_blocks,
+                                         args.batch_stride_k,
+                                         args.batch_stride_v,
+                                         args.num_splits,
+                                         args.split_stride_lse_acc,
+                                         args.split_stride_o_acc,
+                                         args.k_descale_ptr,
+                                         args.v_descale_ptr);
         }
         else
         { // create batch mode kernel arguments
@@ -198,11 +243,159 @@ auto fmha_fwd_create_kargs_and_grids(fmha_fwd_args args)
                                          args.batch_stride_o,
                                          args.window_size_left,
                                          args.window_size_right,
-                                         args.mask_type);
+                                         args.mask_type,
+                                         args.block_table_ptr,
+                                         args.batch_stride_block_table,
+                                         args.page_block_size,
+                                         args.num_page_blocks,
+                                         args.batch_stride_k,
+                                         args.batch_stride_v,
+                                         args.num_splits,
+                                         args.split_stride_lse_acc,
+                                         args.split_stride_o_acc,
+                                         args.k_descale_ptr,
+                                         args.v_descale_ptr);
+        }
+    }();
+
+    dim3 grids = FmhaKernel::GridSize(
+        args.batch, args.nhead_q, args.max_seqlen_q, args.hdim_v, args.num_splits);
+    return ck_tile::make_tuple(kargs, grids);
+}
+
+template <typename CombineKernel>
+auto fmha_fwd_splitkv_combine_create_kargs_and_grids(fmha_fwd_args args)
+{
+    auto kargs = [&] {
+        // create group mode kernel arguments
+        if constexpr(CombineKernel::kIsGroupMode)
+        {
+            return CombineKernel::MakeKargs(args.lse_acc_ptr,
+                                            args.o_acc_ptr,
+                                            args.lse_ptr,
+                                            args.o_ptr,
+                                            args.seqstart_q_ptr,
+                                            args.hdim_v,
+                                            args.num_splits,
+                                            args.stride_o_acc,
+                                            args.stride_o,
+                                            args.nhead_stride_lse_acc,
+                                            args.nhead_stride_o_acc,
+                                            args.nhead_stride_lse,
+                                            args.nhead_stride_o,
+                                            args.split_stride_lse_acc,
+                                            args.split_stride_o_acc);
+        }
+        else
+        { // create batch mode kernel arguments
+            return CombineKernel::MakeKargs(args.lse_acc_ptr,
+                                            args.o_acc_ptr,
+                                            args.lse_ptr,
+                                            args.o_ptr,
+                                            args.seqlen_q,
+                                            args.hdim_v,
+                                            args.num_splits,
+                                            args.stride_o_acc,
+                                            args.stride_o,
+                                            args.nhead_stride_lse_acc,
+                                            args.nhead_stride_o_acc,
+                                            args.nhead_stride_lse,
+                                            args.nhead_stride_o,
+                                            args.split_stride_lse_acc,
+                                            args.split_stride_o_acc,
+                                            args.batch_stride_lse_acc,
+                                            args.batch_stride_o_acc,
+                                            args.batch_stride_lse,
+                                            args.batch_stride_o);
         }
     }();
 
-    dim3 grids = FmhaKernel::GridSize(args.batch, args.nhead_q, args.max_seqlen_q, args.hdim_v);
+    dim3 grids = CombineKernel::GridSize(args.batch, args.nhead_q, args.max_seqlen_q);
+    return ck_tile::make_tuple(kargs, grids);
+}
+
+// runtime args of fmha_fwd_appendkv(), which updates the K/V cache with the new tokens (and
+// applies rotary embedding to Q/Knew) before calling fmha_fwd(). batch mode only.
+// k_ptr/v_ptr point to the caches, rows [0, seqlen_k_ptr[b]) are already filled and the
+// seqlen_knew rows of knew_ptr/vnew_ptr are written after them. q_ptr is rotated in place
+struct fmha_fwd_appendkv_args
+{
+    void* q_ptr;
+    void* k_ptr;
+    const void* knew_ptr;
+    void* v_ptr;
+    const void* vnew_ptr;
+    const void* seqlen_k_ptr;
+    ck_tile::index_t seqlen_q;
+    ck_tile::index_t seqlen_knew;
+    ck_tile::index_t batch;
+    ck_tile::index_t hdim_q;
+    ck_tile::index_t hdim_v;
+    ck_tile::index_t nhead_q;
+    ck_tile::index_t nhead_k;
+    // [max position, rotary_dim / 2], positions seqlen_k_ptr[b] + i of the new rows must exist
+    const void* rotary_cos_ptr;
+    const void* rotary_sin_ptr;
+    ck_tile::index_t rotary_dim;
+    // paged kv only, same as fmha_fwd_args
+    const void* block_table_ptr;
+    ck_tile::index_t batch_stride_block_table;
+    ck_tile::index_t page_block_size;
+    ck_tile::index_t stride_q;
+    ck_tile::index_t stride_k;
+    ck_tile::index_t stride_knew;
+    ck_tile::index_t stride_v;
+    ck_tile::index_t stride_vnew;
+    ck_tile::index_t nhead_stride_q;
+    ck_tile::index_t nhead_stride_k;
+    ck_tile::index_t nhead_stride_knew;
+    ck_tile::index_t nhead_stride_v;
+    ck_tile::index_t nhead_stride_vnew;
+    ck_tile::index_t batch_stride_q;
+    ck_tile::index_t batch_stride_k;
+    ck_tile::index_t batch_stride_knew;
+    ck_tile::index_t batch_stride_v;
+    ck_tile::index_t batch_stride_vnew;
+};
+
+template <typename Kernel>
+auto fmha_fwd_appendkv_create_kargs_and_grids(fmha_fwd_appendkv_args args)
+{
+    assert(args.nhead_q % args.nhead_k == 0);
+    auto kargs = Kernel::MakeKargs(args.q_ptr,
+                                   args.k_ptr,
+                                   args.knew_ptr,
+                                   args.v_ptr,
+                                   args.vnew_ptr,
+                                   args.seqlen_k_ptr,
+                                   args.seqlen_q,
+                                   args.seqlen_knew,
+                                   args.hdim_q,
+                                   args.hdim_v,
+                                   args.nhead_q / args.nhead_k,
+                                   args.rotary_cos_ptr,
+                                   args.rotary_sin_ptr,
+                                   args.rotary_dim,
+                                   args.block_table_ptr,
+                                   args.batch_stride_block_table,
+                                   args.page_block_size,
+                                   args.stride_q,
+                                   args.stride_k,
+                                   args.stride_knew,
+                                   args.stride_v,
+                                   args.stride_vnew,
+                                   args.nhead_stride_q,
+                                   args.nhead_stride_k,
+                                   args.nhead_stride_knew,
+                                   args.nhead_stride_v,
+                                   args.nhead_stride_vnew,
+                                   args.batch_stride_q,
+                                   args.batch_stride_k,
+                                   args.batch_stride_knew,
+                                   args.batch_stride_v,
+                                   args.batch_stride_vnew);
+
+    dim3 grids = Kernel::GridSize(args.batch, args.nhead_q, args.seqlen_q, args.seqlen_knew);
     return ck_tile::make_tuple(kargs, grids);
 }
 
@@ -225,7 +418,10 @@ template <ck_tile::index_t HDim_,
           bool kPadS_,
           bool kPadSK_,
           bool kPadD_,
-          bool kPadDv_>
+          bool kPadDv_,
+          bool kIsPagedKV_,
+          bool kHasSplitKV_,
+          bool kHasKVDequant_>
 struct fmha_fwd_traits_
 {
     static constexpr ck_tile::index_t HDim           = HDim_;
@@ -247,6 +443,9 @@ struct fmha_fwd_traits_
     static constexpr bool kPadSK                     = kPadSK_;
     static constexpr bool kPadD                      = kPadD_;
     static constexpr bool kPadDv                     = kPadDv_;
+    static constexpr bool kIsPagedKV                 = kIsPagedKV_;
+    static constexpr bool kHasSplitKV                = kHasSplitKV_;
+    static constexpr bool kHasKVDequant              = kHasKVDequant_;
 };
 
 template <typename Traits_>
@@ -264,6 +463,31 @@ struct fmha_fwd_traits
     bool has_bias;
     bool has_lse;
     bool do_fp8_static_quant;
+    bool is_paged_kv;
+    bool do_split_kv;
+    bool has_kv_dequant;
     // TODO: padding check is inside this api
 };
 float fmha_fwd(fmha_fwd_traits, fmha_fwd_args, const ck_tile::stream_config&);
+
+template <typename DataType_, ck_tile::RotaryEmbeddingEnum RotaryEnum_, bool kIsPagedKV_>
+struct fmha_fwd_appendkv_traits_
+{
+    using DataType                   = ck_tile::remove_cvref_t<DataType_>;
+    static constexpr auto RotaryEnum = RotaryEnum_;
+    static constexpr bool kIsPagedKV = kIsPagedKV_;
+};
+
+template <typename Traits_>
+float fmha_fwd_appendkv_(const ck_tile::stream_config&, fmha_fwd_appendkv_args);
+
+// This is the public API, will be generated by script
+struct fmha_fwd_appendkv_traits
+{
+    std::string data_type;
+    ck_tile::RotaryEmbeddingEnum rope_type;
+    bool is_paged_kv;
+};
+float fmha_fwd_appendkv(fmha_fwd_appendkv_traits,
+                        fmha_fwd_appendkv_args,
+                        const ck_tile::stream_config&);
@@ -65,7 +65,16 @@ BOOL_MAP = {
     "f" : "false"
 }
 
-DIRECTIONS = ["fwd"]
+ROPE_MAP = {
+    "no" : "ck_tile::RotaryEmbeddingEnum::NONE",
+    "inter" : "ck_tile::RotaryEmbeddingEnum::INTERLEAVED",
+    "half" : "ck_tile::RotaryEmbeddingEnum::HALF_ROTATED"
+}
+
+# sync with FmhaFwdSplitKVCombineKernel::kMaxSplits
+SPLITKV_MAX_SPLITS = 128
+
+DIRECTIONS = ["fwd", "bwd"]
 GEN_DIR = ""    # in Cmake, have to generate files in same folder
 
 FMHA_FWD_KERNEL_HEADER = """// SPDX-License-Identifier: MIT
@@ -93,9 +102,12 @@ using fmha_trait_{F_idx} = ck_tile::TileFmhaTraits<{F_spad},
                                                     {F_dpad},
                                                     {F_dvpad},
                                                     {F_bias},
-                                                    {F_lse},
+                                                    {F_pipeline_lse},
                                                     {F_squant},
-                                                    {F_occupancy}>;
+                                                    {F_occupancy},
+                                                    {F_pagedkv},
+                                                    {F_splitkv},
+                                                    {F_kvdequant}>;
 using fmha_mask_{F_idx} = {F_mask};
 
 using fmha_pipeline_problem_{F_idx} = ck_tile::BlockFmhaPipelineProblem<
@@ -108,7 +120,7 @@ using fmha_pipeline_problem_{F_idx} = ck_tile::BlockFmhaPipelineProblem<
     typename FmhaFwdTypeConfig<fmha_dtype_{F_idx}>::LSEDataType,
     typename FmhaFwdTypeConfig<fmha_dtype_{F_idx}>::PDataType,
     typename FmhaFwdTypeConfig<fmha_dtype_{F_idx}>::OaccDataType,
-    typename FmhaFwdTypeConfig<fmha_dtype_{F_idx}>::ODataType,
+    typename FmhaFwdTypeConfig<fmha_dtype_{F_idx}>::{F_pipeline_odtype},
     fmha_shape_{F_idx},
     {F_mode},
     fmha_mask_{F_idx},
@@ -119,7 +131,7 @@ using fmha_pipeline_{F_idx} = {F_pipeline}<
 
 using fmha_epilogue_{F_idx} =
     ck_tile::Default2DEpilogue<ck_tile::Default2DEpilogueProblem<typename FmhaFwdTypeConfig<{F_dtype}>::OaccDataType,
-                                           typename FmhaFwdTypeConfig<{F_dtype}>::ODataType,
+                                           typename FmhaFwdTypeConfig<{F_dtype}>::{F_pipeline_odtype},
                                            {F_spad}, {F_dvpad}>>;
 
 using fmha_kernel_{F_idx} =
@@ -128,10 +140,12 @@ using fmha_kernel_{F_idx} =
                   fmha_epilogue_{F_idx}>;
 
 using trait_{F_idx} = fmha_fwd_traits_<{F_hdim}, {F_dtype}, {F_mode},{F_bm0}, {F_bn0}, {F_bk0}, {F_bn1}, {F_bk1}, {F_bk0blen}, {F_vlayout},
-                        {F_pipeline_enum}, fmha_mask_{F_idx}, {F_bias}, {F_lse}, {F_squant}, {F_spad}, {F_skpad}, {F_dpad}, {F_dvpad}>;
+                        {F_pipeline_enum}, fmha_mask_{F_idx}, {F_bias}, {F_lse}, {F_squant}, {F_spad}, {F_skpad}, {F_dpad}, {F_dvpad}, {F_pagedkv}, {F_splitkv}, {F_kvdequant}>;
 
 #include <iostream>
+"""
 
+FMHA_FWD_KERNEL_LAUNCH="""
 template<>
 float fmha_fwd_<trait_{F_idx}>(const ck_tile::stream_config& s, fmha_fwd_args a)
 {{
@@ -145,8 +159,164 @@ float fmha_fwd_<trait_{F_idx}>(const ck_tile::stream_config& s, fmha_fwd_args a)
 }}
 """
 
+# split kv instances write partial O/lse of every split, then merge them with a second kernel
+FMHA_FWD_SPLITKV_KERNEL_LAUNCH="""
+using fmha_combine_kernel_{F_idx} =
+    ck_tile::FmhaFwdSplitKVCombineKernel<typename FmhaFwdTypeConfig<{F_dtype}>::LSEDataType,
+                                         typename FmhaFwdTypeConfig<{F_dtype}>::OaccDataType,
+                                         typename FmhaFwdTypeConfig<{F_dtype}>::ODataType,
+                                         {F_mode},
+                                         {F_lse}>;
+
+template<>
+float fmha_fwd_<trait_{F_idx}>(const ck_tile::stream_config& s, fmha_fwd_args a)
+{{
+    using k_ = fmha_kernel_{F_idx};
+    using c_ = fmha_combine_kernel_{F_idx};
+    if(s.log_level_ > 0)
+        std::cout << ", " << k_::GetName() << ", " << c_::GetName() << std::flush;
+    float ave_time = 0;
+    {{
+        auto [kargs, grids] = fmha_fwd_create_kargs_and_grids<k_>(a);
+        constexpr dim3 blocks             = k_::BlockSize();
+        constexpr ck_tile::index_t kBlockPerCu = k_::kBlockPerCu;
+        ave_time += ck_tile::launch_kernel<blocks.x, kBlockPerCu>(s, k_{{}}, grids, blocks, 0, kargs);
+    }}
+    {{
+        auto [kargs, grids] = fmha_fwd_splitkv_combine_create_kargs_and_grids<c_>(a);
+        constexpr dim3 blocks             = c_::BlockSize();
+        constexpr ck_tile::index_t kBlockPerCu = c_::kBlockPerCu;
+        ave_time += ck_tile::launch_kernel<blocks.x, kBlockPerCu>(s, c_{{}}, grids, blocks, 0, kargs);
+    }}
+    return ave_time;
+}}
+"""
+
 FMHA_FWD_API_FILENAME="fmha_fwd_api.cpp"
+FMHA_FWD_API_INCLUDES="""
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+"""
+
 FMHA_FWD_API="""
+namespace {{
+// instances are looked up by the enum-like fields of fmha_fwd_traits, packed into one key.
+// entries sharing a key keep the generation order, the first one whose seqlen/hdim/page check
+// passes on the runtime arguments is launched
+struct fmha_fwd_api_entry
+{{
+    uint32_t key;
+    bool (*check)(const fmha_fwd_args&);
+    float (*run)(const ck_tile::stream_config&, fmha_fwd_args);
+}};
+
+constexpr uint32_t fmha_fwd_api_key(uint32_t dtype, uint32_t hdim, bool mode, bool vlayout,
+                                    uint32_t mask, bool bias, bool lse, bool squant, bool pagedkv,
+                                    bool splitkv, bool kvdequant)
+{{
+    return (dtype << 20) | (hdim << 10) | (uint32_t(mode) << 9) | (uint32_t(vlayout) << 8) |
+           (mask << 6) | (uint32_t(bias) << 5) | (uint32_t(lse) << 4) | (uint32_t(squant) << 3) |
+           (uint32_t(pagedkv) << 2) | (uint32_t(splitkv) << 1) | uint32_t(kvdequant);
+}}
+
+int fmha_fwd_api_dtype(const std::string& data_type)
+{{
+{F_dtype_case}
+    return -1;
+}}
+
+int fmha_fwd_api_hdim(int dtype, int hdim_q, int hdim_v)
+{{
+{F_hdim_case}
+    return -1;
+}}
+
+uint32_t fmha_fwd_api_mask(const fmha_fwd_traits& t)
+{{
+{F_mask_case}
+    return 0;
+}}
+
+// sorted by key
+constexpr fmha_fwd_api_entry fmha_fwd_api_entries[] = {{
+{F_entries}
+}};
+
+constexpr bool fmha_fwd_api_entries_sorted()
+{{
+    for(std::size_t i = 1; i < std::size(fmha_fwd_api_entries); ++i)
+        if(fmha_fwd_api_entries[i - 1].key > fmha_fwd_api_entries[i].key)
+            return false;
+    return true;
+}}
+static_assert(fmha_fwd_api_entries_sorted(), "fmha_fwd_api_entries must be sorted by key");
+
+bool fmha_fwd_api_same_traits(const fmha_fwd_traits& lhs, const fmha_fwd_traits& rhs)
+{{
+    return lhs.hdim_q == rhs.hdim_q && lhs.hdim_v == rhs.hdim_v &&
+           lhs.is_group_mode == rhs.is_group_mode && lhs.is_v_rowmajor == rhs.is_v_rowmajor &&
+           lhs.mask_type == rhs.mask_type && lhs.has_bias == rhs.has_bias &&
+           lhs.has_lse == rhs.has_lse && lhs.do_fp8_static_quant == rhs.do_fp8_static_quant &&
+           lhs.is_paged_kv == rhs.is_paged_kv && lhs.do_split_kv == rhs.do_split_kv &&
+           lhs.has_kv_dequant == rhs.has_kv_dequant && lhs.data_type == rhs.data_type;
+}}
+}} // namespace
+
+float fmha_fwd(fmha_fwd_traits t, fmha_fwd_args a, const ck_tile::stream_config& s){{
+    // repeated calls (e.g. decoding) mostly come with the same traits, skip the lookup then
+    static thread_local fmha_fwd_traits last_t{{-1, -1, "", false, false, mask_enum::no_mask,
+                                               false, false, false, false, false, false}};
+    static thread_local const fmha_fwd_api_entry* first = nullptr;
+    static thread_local const fmha_fwd_api_entry* last  = nullptr;
+    if(!fmha_fwd_api_same_traits(t, last_t))
+    {{
+        last_t = t;
+        first = last = nullptr;
+
+        const int dtype = fmha_fwd_api_dtype(t.data_type);
+        const int hdim  = dtype < 0 ? -1 : fmha_fwd_api_hdim(dtype, t.hdim_q, t.hdim_v);
+        if(hdim < 0)
+            return -1;
+
+        const uint32_t key = fmha_fwd_api_key(dtype, hdim, t.is_group_mode, t.is_v_rowmajor,
+                                              fmha_fwd_api_mask(t), t.has_bias, t.has_lse,
+                                              t.do_fp8_static_quant, t.is_paged_kv, t.do_split_kv,
+                                              t.has_kv_dequant);
+        first = std::lower_bound(std::begin(fmha_fwd_api_entries), std::end(fmha_fwd_api_entries),
+                                 key, [](const auto& e, uint32_t k) {{ return e.key < k; }});
+        last  = std::upper_bound(first, std::end(fmha_fwd_api_entries),
+                                 key, [](uint32_t k, const auto& e) {{ return k < e.key; }});
+    }}
+
+    for(auto e = first; e != last; ++e)
+        if(e->check(a))
+            return e->run(s, a);
+    return -1;
+}}
+"""
+
+FMHA_FWD_API_EMPTY="""
+float fmha_fwd(fmha_fwd_traits, fmha_fwd_args, const ck_tile::stream_config&){
+    return -1;
+}
+"""
+
+FMHA_FWD_API_PER_DTYPE_CASE="""    if(data_type == \"{F_dtype}\")
+        return {F_dtype_id};"""
+
+FMHA_FWD_API_PER_HDIM_CASE="""    if(dtype == {F_dtype_id} && hdim_q <= {F_hdim} && hdim_v <= {F_hdim})
+        return {F_hdim};"""
+
+FMHA_FWD_API_PER_MASK_CASE="""    if({F_mask_check})
+        return {F_mask_id};"""
+
+FMHA_FWD_API_ENTRY="""    {{fmha_fwd_api_key({F_dtype_id}, {F_hdim}, {F_mode}, {F_vlayout}, {F_mask_id}, {F_bias}, {F_lse}, {F_squant}, {F_pagedkv}, {F_splitkv}, {F_kvdequant}),
+     []([[maybe_unused]] const fmha_fwd_args& a) {{ return ({F_scheck}) && ({F_skcheck}) && ({F_dcheck}) && ({F_dvcheck}) && ({F_pagecheck}) && ({F_splitcheck}); }},
+     fmha_fwd_<fmha_fwd_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_bm0}, {F_bn0}, {F_bk0}, {F_bn1}, {F_bk1}, {F_bk0blen}, {F_vlayout}, {F_pipeline_enum}, {F_mask}, {F_bias}, {F_lse}, {F_squant}, {F_spad}, {F_skpad}, {F_dpad}, {F_dvpad}, {F_pagedkv}, {F_splitkv}, {F_kvdequant}>>}},"""
+
+# if/else chain the table above replaced, only emitted as the baseline of --dispatch_bench
+FMHA_FWD_API_CHAIN="""
 float fmha_fwd(fmha_fwd_traits t, fmha_fwd_args a, const ck_tile::stream_config& s){{
     float r = -1;
 {F_dispatch}
@@ -154,14 +324,199 @@ float fmha_fwd(fmha_fwd_traits t, fmha_fwd_args a, const ck_tile::stream_config&
 }}
 """
 
-FMHA_FWD_API_PER_DTYPE="""    {F_if}(t.data_type.compare(\"{F_dtype}\") == 0){{
+FMHA_FWD_API_CHAIN_PER_DTYPE="""    {F_if}(t.data_type.compare(\"{F_dtype}\") == 0){{
 {F_hdim_case}
     }}
 """
-FMHA_FWD_API_PER_HDIM_CASE="""        {F_if} (t.hdim_q <= {F_hdim} && t.hdim_v <= {F_hdim}) {{
+FMHA_FWD_API_CHAIN_PER_HDIM_CASE="""        {F_if} (t.hdim_q <= {F_hdim} && t.hdim_v <= {F_hdim}) {{
 {F_inner_dispatch}
         }}
 """
+# host only microbenchmark of fmha_fwd() dispatch, the table lookup against the old if/else chain.
+# kernels are replaced by stubs, so it builds with any host compiler:
+#   python generate.py --dispatch_bench bench.cpp && g++ -O2 -std=c++17 bench.cpp && ./a.out
+FMHA_FWD_DISPATCH_BENCH_HEADER="""// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.\n
+// auto generated by generate.py --dispatch_bench
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace ck_tile {{
+using index_t = int32_t;
+struct fp16_t {{}};
+struct bf16_t {{}};
+struct fp8_t {{}};
+struct stream_config {{}};
+enum class BlockFmhaPipelineEnum {{ QRKSVS, QRKSVS_ASYNC }};
+template <bool IsMasking = true, bool IsLocal = false> struct GenericAttentionMask {{}};
+template <bool IsMasking = true> struct SimplifiedGenericAttentionMask {{}};
+}} // namespace ck_tile
+
+enum class mask_enum {{ no_mask = 0, mask_top_left, mask_bottom_right, window_generic }};
+
+struct FmhaMasks
+{{
+    using NoMask      = ck_tile::GenericAttentionMask<false>;
+    using GenericMask = ck_tile::GenericAttentionMask<true, true>;
+    using CausalMask  = ck_tile::GenericAttentionMask<true, false>;
+}};
+
+struct fmha_fwd_args
+{{
+    ck_tile::index_t seqlen_q, seqlen_k, hdim_q, hdim_v, page_block_size, num_splits;
+}};
+
+struct fmha_fwd_traits
+{{
+    int hdim_q;
+    int hdim_v;
+    std::string data_type;
+    bool is_group_mode;
+    bool is_v_rowmajor;
+    mask_enum mask_type;
+    bool has_bias;
+    bool has_lse;
+    bool do_fp8_static_quant;
+    bool is_paged_kv;
+    bool do_split_kv;
+    bool has_kv_dequant;
+}};
+
+template <ck_tile::index_t, typename, bool, ck_tile::index_t, ck_tile::index_t, ck_tile::index_t,
+          ck_tile::index_t, ck_tile::index_t, ck_tile::index_t, bool, ck_tile::BlockFmhaPipelineEnum,
+          typename, bool, bool, bool, bool, bool, bool, bool, bool, bool, bool>
+struct fmha_fwd_traits_ {{}};
+
+// records which instance got selected instead of launching it
+static const void* selected = nullptr;
+template <typename Traits_>
+float fmha_fwd_(const ck_tile::stream_config&, fmha_fwd_args)
+{{
+    static const char tag = 0;
+    selected = &tag;
+    return 0;
+}}
+"""
+
+FMHA_FWD_DISPATCH_BENCH_MAIN="""
+struct problem
+{{
+    fmha_fwd_traits t;
+    fmha_fwd_args a;
+}};
+
+template <typename F>
+double ns_per_call(const std::vector<problem>& problems, int repeat, F&& f)
+{{
+    // best of a few runs, the host may be noisy
+    [[maybe_unused]] static volatile float sink;
+    double best = 0;
+    for(int run = 0; run < 5; ++run)
+    {{
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < repeat; ++i)
+            for(const auto& p : problems)
+                sink = f(p.t, p.a, ck_tile::stream_config{{}});
+        auto stop = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+        best      = run == 0 ? ns : std::min(best, ns);
+    }}
+    return best / (double(repeat) * problems.size());
+}}
+
+int main()
+{{
+    std::vector<problem> problems;
+    for(std::string dtype : {{{F_dtypes}}})
+        for(int hdim : {{32, 64, 96, 128, 256, 320}})
+            for(int flags = 0; flags < (1 << 9); ++flags)
+                for(auto mask : {{mask_enum::no_mask, mask_enum::mask_top_left, mask_enum::window_generic}})
+                    for(int seqlen : {{1, 128, 1000}})
+                    {{
+                        fmha_fwd_traits t{{hdim, hdim, dtype, bool(flags & 1), bool(flags & 2), mask,
+                                          bool(flags & 4), bool(flags & 8), bool(flags & 16), bool(flags & 32),
+                                          bool(flags & 128), bool(flags & 256)}};
+                        fmha_fwd_args a{{seqlen, flags & 64 ? seqlen : 4096, hdim, hdim, 128, 8}};
+                        problems.push_back({{t, a}});
+                    }}
+
+    // both paths must pick the same instance (or none)
+    int num_dispatched = 0;
+    for(const auto& p : problems)
+    {{
+        selected = nullptr;
+        float r0 = chain::fmha_fwd(p.t, p.a, ck_tile::stream_config{{}});
+        const void* s0 = selected;
+        selected = nullptr;
+        float r1 = table::fmha_fwd(p.t, p.a, ck_tile::stream_config{{}});
+        if(r0 != r1 || s0 != selected)
+        {{
+            std::printf("mismatch: %s hdim:%d\\n", p.t.data_type.c_str(), p.t.hdim_q);
+            return 1;
+        }}
+        num_dispatched += (s0 != nullptr);
+    }}
+    std::printf("%zu problems, %d dispatched, %d instances\\n", problems.size(), num_dispatched, {F_num_instances});
+
+    // decoding calls fmha_fwd() again and again with the same traits
+    const std::vector<problem> decode(1, problems[problems.size() / 2]);
+    std::printf("same traits : chain %6.1f ns, table %6.1f ns\\n",
+                ns_per_call(decode, 200000, chain::fmha_fwd),
+                ns_per_call(decode, 200000, table::fmha_fwd));
+    std::printf("mixed traits: chain %6.1f ns, table %6.1f ns\\n",
+                ns_per_call(problems, 100, chain::fmha_fwd),
+                ns_per_call(problems, 100, table::fmha_fwd));
+    return 0;
+}}
+"""
+
+# K/V cache append (+ rotary embedding of Q/Knew) run before fmha_fwd() when decoding with a cache
+FMHA_FWD_APPENDKV_KERNEL_BODY="""
+using fmha_appendkv_kernel_{F_idx} =
+    ck_tile::FmhaFwdAppendKVKernel<{F_dtype}, {F_rope}, {F_pagedkv}>;
+
+using trait_appendkv_{F_idx} = fmha_fwd_appendkv_traits_<{F_dtype}, {F_rope}, {F_pagedkv}>;
+
+#include <iostream>
+
+template<>
+float fmha_fwd_appendkv_<trait_appendkv_{F_idx}>(const ck_tile::stream_config& s, fmha_fwd_appendkv_args a)
+{{
+    using k_ = fmha_appendkv_kernel_{F_idx};
+    if(s.log_level_ > 0)
+        std::cout << ", " << k_::GetName() << std::flush;
+    auto [kargs, grids] = fmha_fwd_appendkv_create_kargs_and_grids<k_>(a);
+    constexpr dim3 blocks             = k_::BlockSize();
+    constexpr ck_tile::index_t kBlockPerCu = k_::kBlockPerCu;
+    return ck_tile::launch_kernel<blocks.x, kBlockPerCu>(s, k_{{}}, grids, blocks, 0, kargs);
+}}
+"""
+
+FMHA_FWD_APPENDKV_API_FILENAME="fmha_fwd_appendkv_api.cpp"
+FMHA_FWD_APPENDKV_API="""
+float fmha_fwd_appendkv(fmha_fwd_appendkv_traits t, fmha_fwd_appendkv_args a, const ck_tile::stream_config& s){{
+    float r = -1;
+{F_dispatch}
+    return r;
+}}
+"""
+
+FMHA_FWD_APPENDKV_API_PER_DTYPE="""    {F_if}(t.data_type.compare(\"{F_dtype}\") == 0){{
+{F_inner_dispatch}
+    }}
+"""
+
+FMHA_FWD_APPENDKV_API_INNER_DISPATCH="""        {F_if}((t.rope_type == {F_rope}) && (t.is_paged_kv == {F_pagedkv}) && ({F_ropecheck})) {{
+            using trait_ = fmha_fwd_appendkv_traits_<{F_dtype}, {F_rope}, {F_pagedkv}>;
+            return fmha_fwd_appendkv_<trait_>(s, a);
+        }}
+"""
+
 MASK_CHECK_MAP = {
     "no" : "t.mask_type == mask_enum::no_mask",
     "causal" : "t.mask_type == mask_enum::mask_top_left || t.mask_type == mask_enum::mask_bottom_right",
@@ -173,9 +528,9 @@ MASK_SIMPLIFIED_CHECK_MAP = {
     "s_mask" : "t.mask_type != mask_enum::no_mask",
 }
 
-FMHA_FWD_API_INNER_DISPATCH="""            {F_if}((t.is_group_mode == {F_mode}) && (t.is_v_rowmajor == {F_vlayout}) && ({F_mask_check}) && (t.has_bias == {F_bias}) && (t.has_lse == {F_lse}) && (t.do_fp8_static_quant == {F_squant}) &&
-                        ({F_scheck}) && ({F_skcheck}) && ({F_dcheck}) && ({F_dvcheck})) {{
-                using trait_ = fmha_fwd_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_bm0}, {F_bn0}, {F_bk0}, {F_bn1}, {F_bk1}, {F_bk0blen}, {F_vlayout}, {F_pipeline_enum}, {F_mask}, {F_bias}, {F_lse}, {F_squant}, {F_spad}, {F_skpad}, {F_dpad}, {F_dvpad}>;
+FMHA_FWD_API_CHAIN_INNER_DISPATCH="""            {F_if}((t.is_group_mode == {F_mode}) && (t.is_v_rowmajor == {F_vlayout}) && ({F_mask_check}) && (t.has_bias == {F_bias}) && (t.has_lse == {F_lse}) && (t.do_fp8_static_quant == {F_squant}) && (t.is_paged_kv == {F_pagedkv}) && (t.do_split_kv == {F_splitkv}) && (t.has_kv_dequant == {F_kvdequant}) &&
+                        ({F_scheck}) && ({F_skcheck}) && ({F_dcheck}) && ({F_dvcheck}) && ({F_pagecheck}) && ({F_splitcheck})) {{
+                using trait_ = fmha_fwd_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_bm0}, {F_bn0}, {F_bk0}, {F_bn1}, {F_bk1}, {F_bk0blen}, {F_vlayout}, {F_pipeline_enum}, {F_mask}, {F_bias}, {F_lse}, {F_squant}, {F_spad}, {F_skpad}, {F_dpad}, {F_dvpad}, {F_pagedkv}, {F_splitkv}, {F_kvdequant}>;
                 return fmha_fwd_<trait_>(s, a);
             }}
 """
@@ -220,11 +575,14 @@ class FmhaFwdApiTrait:
     skpad     : str
     dpad      : str
     dvpad     : str
+    pagedkv   : str
+    splitkv   : str
+    kvdequant : str
 
     @property
     def name(self) -> str:
         return f'{self.hdim}-{self.dtype}-{self.mode}-{self.bm0}-{self.bn0}-{self.bk0}-{self.bn0}-{self.bk1}-{self.bk0blen}-'+\
-                    f'{self.vlayout}-{self.mask}-{self.bias}-{self.lse}-{self.squant}-{self.spad}-{self.skpad}-{self.dpad}-{self.dvpad}'
+                    f'{self.vlayout}-{self.mask}-{self.bias}-{self.lse}-{self.squant}-{self.spad}-{self.skpad}-{self.dpad}-{self.dvpad}-{self.pagedkv}-{self.splitkv}-{self.kvdequant}'
 
     @property
     def scheck(self) -> str:
@@ -270,6 +628,18 @@ class FmhaFwdApiTrait:
             else :                return f'a.hdim_v % {self.bk0blen} == 0'
         else:   assert False
 
+    @property
+    def pagecheck(self) -> str:
+        # a kN0 tile of K/V must not straddle two pages
+        if self.pagedkv == 't': return f'a.page_block_size % {self.bn0} == 0'
+        else :                  return 'true'
+
+    @property
+    def splitcheck(self) -> str:
+        # the combine kernel keeps the weights of all the splits in LDS
+        if self.splitkv == 't': return f'1 <= a.num_splits && a.num_splits <= {SPLITKV_MAX_SPLITS}'
+        else :                  return 'true'
+
 @dataclass
 class FmhaFwdPipeline:
     tag : str
@@ -283,6 +653,9 @@ class FmhaFwdPipeline:
     F_lse       : str  #
     F_squant    : str  #
     F_mask      : str  # value from MASK_MAP
+    F_pagedkv   : str = 'f' # true/false
+    F_splitkv   : str = 'f' # true/false
+    F_kvdequant : str = 'f' # true/false
 
     @property
     def name(self) -> str:
@@ -304,6 +677,9 @@ class FmhaFwdPipeline:
             if self.F_mask != 'no' : n += f'_m{self.F_mask[0]}'
         if self.F_lse == 't' : n += '_lse'
         if self.F_squant == 't' : n += '_squant'
+        if self.F_pagedkv == 't' : n += '_pagedkv'
+        if self.F_splitkv == 't' : n += '_splitkv'
+        if self.F_kvdequant == 't' : n += '_kvdequant'
         return n
 
 class FmhaFwdApiPool:
@@ -320,8 +696,47 @@ class FmhaFwdApiPool:
 
         self.pool[trait.dtype][trait.hdim].append(copy.copy(trait))
 
+    def inner_format_args(self, trait : FmhaFwdApiTrait) -> dict:
+        return dict(F_mode=MODE_MAP[trait.mode], F_vlayout=LAYOUT_MAP[trait.vlayout],
+                    F_pipeline_enum=PIPELINE_ENUM_MAP[trait.pipeline_tag], F_mask=get_mask_map(self.mask_impl)[trait.mask],
+                    F_mask_check=get_mask_check_map(self.mask_impl)[trait.mask], F_bias=BOOL_MAP[trait.bias], F_lse=BOOL_MAP[trait.lse],
+                    F_squant=BOOL_MAP[trait.squant], F_pagedkv=BOOL_MAP[trait.pagedkv], F_splitkv=BOOL_MAP[trait.splitkv], F_kvdequant=BOOL_MAP[trait.kvdequant], F_scheck=trait.scheck, F_skcheck=trait.skcheck, F_dcheck=trait.dcheck, F_dvcheck=trait.dvcheck, F_pagecheck=trait.pagecheck, F_splitcheck=trait.splitcheck,
+                    F_spad=BOOL_MAP[trait.spad], F_skpad=BOOL_MAP[trait.skpad], F_dpad=BOOL_MAP[trait.dpad], F_dvpad=BOOL_MAP[trait.dvpad],
+                    F_bm0=trait.bm0, F_bn0=trait.bn0, F_bk0=trait.bk0, F_bn1=trait.bn1, F_bk1=trait.bk1, F_bk0blen=trait.bk0blen,
+                    F_hdim=trait.hdim, F_dtype=DTYPE_MAP[trait.dtype])
+
+    # must match fmha_fwd_api_key() in FMHA_FWD_API
+    def api_key(self, dtype_id : int, trait : FmhaFwdApiTrait) -> int:
+        mask_id = list(get_mask_check_map(self.mask_impl).keys()).index(trait.mask)
+        assert int(trait.hdim) < 1024 and dtype_id < 16
+        return (dtype_id << 20) | (int(trait.hdim) << 10) | (int(trait.mode == 'group') << 9) | (int(trait.vlayout == 'row') << 8) | \
+                (mask_id << 6) | (int(trait.bias == 't') << 5) | (int(trait.lse == 't') << 4) | (int(trait.squant == 't') << 3) | \
+                (int(trait.pagedkv == 't') << 2) | (int(trait.splitkv == 't') << 1) | int(trait.kvdequant == 't')
+
     @property
-    def api(self) -> str:
+    def api_body(self) -> str:
+        if len(self.pool) == 0:
+            return FMHA_FWD_API_EMPTY
+        mask_check_map = get_mask_check_map(self.mask_impl)
+        dtype_cases = list()
+        hdim_cases  = list()
+        mask_cases  = [FMHA_FWD_API_PER_MASK_CASE.format(F_mask_check=check, F_mask_id=i) for i, check in enumerate(mask_check_map.values())]
+        entries     = list()
+        for i, dtype in enumerate(self.pool.keys()):
+            dtype_cases.append(FMHA_FWD_API_PER_DTYPE_CASE.format(F_dtype=dtype, F_dtype_id=i))
+            for hdim in self.pool[dtype].keys():
+                hdim_cases.append(FMHA_FWD_API_PER_HDIM_CASE.format(F_dtype_id=i, F_hdim=hdim))
+                for trait in self.pool[dtype][hdim]:
+                    mask_id = list(mask_check_map.keys()).index(trait.mask)
+                    entry = FMHA_FWD_API_ENTRY.format(F_dtype_id=i, F_mask_id=mask_id, **self.inner_format_args(trait))
+                    entries.append((self.api_key(i, trait), entry))
+        # stable, instances sharing a key keep the order of get_pipelines()
+        entries.sort(key=lambda e: e[0])
+        return FMHA_FWD_API.format(F_dtype_case='\n'.join(dtype_cases), F_hdim_case='\n'.join(hdim_cases),
+                                   F_mask_case='\n'.join(mask_cases), F_entries='\n'.join(e for _, e in entries))
+
+    @property
+    def chain_api_body(self) -> str:
         per_dtypes=str()
         for i, dtype in enumerate(self.pool.keys()):
             per_hdim_case=str()
@@ -330,18 +745,16 @@ class FmhaFwdApiPool:
                 inners=str()
                 for k, trait in enumerate(traits):
                     if_k = 'if' if k == 0 else 'else if'
-                    inners = inners + FMHA_FWD_API_INNER_DISPATCH.format(F_if=if_k, F_mode=MODE_MAP[trait.mode], F_vlayout=LAYOUT_MAP[trait.vlayout],
-                                   F_pipeline_enum=PIPELINE_ENUM_MAP[trait.pipeline_tag], F_mask=get_mask_map(self.mask_impl)[trait.mask],
-                                   F_mask_check=get_mask_check_map(self.mask_impl)[trait.mask], F_bias=BOOL_MAP[trait.bias], F_lse=BOOL_MAP[trait.lse],
-                                   F_squant=BOOL_MAP[trait.squant], F_scheck=trait.scheck, F_skcheck=trait.skcheck, F_dcheck=trait.dcheck, F_dvcheck=trait.dvcheck,
-                                   F_spad=BOOL_MAP[trait.spad], F_skpad=BOOL_MAP[trait.skpad], F_dpad=BOOL_MAP[trait.dpad], F_dvpad=BOOL_MAP[trait.dvpad],
-                                   F_bm0=trait.bm0, F_bn0=trait.bn0, F_bk0=trait.bk0, F_bn1=trait.bn1, F_bk1=trait.bk1, F_bk0blen=trait.bk0blen,
-                                   F_hdim=hdim, F_dtype=DTYPE_MAP[dtype])
+                    inners = inners + FMHA_FWD_API_CHAIN_INNER_DISPATCH.format(F_if=if_k, **self.inner_format_args(trait))
                 if_j = 'if' if j == 0 else 'else if'
-                per_hdim_case = per_hdim_case + FMHA_FWD_API_PER_HDIM_CASE.format(F_if=if_j, F_hdim=hdim, F_inner_dispatch=inners)
+                per_hdim_case = per_hdim_case + FMHA_FWD_API_CHAIN_PER_HDIM_CASE.format(F_if=if_j, F_hdim=hdim, F_inner_dispatch=inners)
             if_i = 'if' if i == 0 else 'else if'
-            per_dtypes = per_dtypes + FMHA_FWD_API_PER_DTYPE.format(F_if=if_i, F_dtype=dtype, F_hdim_case=per_hdim_case)
-        return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_API.format(F_dispatch = per_dtypes)
+            per_dtypes = per_dtypes + FMHA_FWD_API_CHAIN_PER_DTYPE.format(F_if=if_i, F_dtype=dtype, F_hdim_case=per_hdim_case)
+        return FMHA_FWD_API_CHAIN.format(F_dispatch = per_dtypes)
+
+    @property
+    def api(self) -> str:
+        return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_API_INCLUDES + self.api_body
 
 @dataclass
 class FmhaFwdTileSize:
@@ -377,7 +790,8 @@ class FmhaFwdKernel:
 
     @property
     def template(self) -> str:
-        kernel_body = str()
+        is_splitkv = self.F_pipeline.F_splitkv == 't'
+        launch = FMHA_FWD_SPLITKV_KERNEL_LAUNCH if is_splitkv else FMHA_FWD_KERNEL_LAUNCH
         return FMHA_FWD_KERNEL_HEADER + \
             FMHA_FWD_KERNEL_BODY.format(
                 F_idx           = self.F_idx,
@@ -403,11 +817,22 @@ class FmhaFwdKernel:
                 F_bias          = BOOL_MAP[self.F_pipeline.F_bias],
                 F_lse           = BOOL_MAP[self.F_pipeline.F_lse],
                 F_squant        = BOOL_MAP[self.F_pipeline.F_squant],
+                F_pagedkv       = BOOL_MAP[self.F_pipeline.F_pagedkv],
+                F_splitkv       = BOOL_MAP[self.F_pipeline.F_splitkv],
+                F_kvdequant     = BOOL_MAP[self.F_pipeline.F_kvdequant],
+                # splits always store their lse, and O in the accumulation type, for the combine kernel
+                F_pipeline_lse  = BOOL_MAP['t' if is_splitkv else self.F_pipeline.F_lse],
+                F_pipeline_odtype = 'OaccDataType' if is_splitkv else 'ODataType',
                 F_occupancy     = self.F_tile.F_occupancy,
                 F_pipeline_enum = PIPELINE_ENUM_MAP[self.F_pipeline.tag],
                 F_mask          = get_mask_map(self.mask_impl)[self.F_pipeline.F_mask],
                 F_mode          = MODE_MAP[self.F_mode],
-                F_pipeline      = PIPELINE_MAP[self.F_pipeline.tag])
+                F_pipeline      = PIPELINE_MAP[self.F_pipeline.tag]) + \
+            launch.format(
+                F_idx           = self.F_idx,
+                F_dtype         = DTYPE_MAP[self.F_dtype],
+                F_mode          = MODE_MAP[self.F_mode],
+                F_lse           = BOOL_MAP[self.F_pipeline.F_lse])
 
     @property
     def name(self) -> str:
@@ -439,7 +864,10 @@ class FmhaFwdKernel:
                 spad=self.F_pipeline.F_spad,
                 skpad=self.F_pipeline.F_skpad,
                 dpad=self.F_pipeline.F_dpad,
-                dvpad=self.F_pipeline.F_dvpad)
+                dvpad=self.F_pipeline.F_dvpad,
+                pagedkv=self.F_pipeline.F_pagedkv,
+                splitkv=self.F_pipeline.F_splitkv,
+                kvdequant=self.F_pipeline.F_kvdequant)
 
 # TODO: design a more practical way to do it
 # this is current supported tile size per hdim
@@ -488,10 +916,20 @@ def get_blobs(kernel_filter : Optional[str], receipt, mask_impl) -> Tuple[FmhaFw
                     if receipt == 1:
                         pipelines.append(FmhaFwdPipeline('qr', 'row', 't', 't', 't', 't', bias, lse, squant, mask)) # TODO: cover arbitraty hdim
                         pipelines.append(FmhaFwdPipeline('qr', 'col', 't', 'f', 't', 't', bias, lse, squant, mask)) # TODO: cover arbitraty hdim
+                if bias == 'f':
+                    # paged kv, only the qr pipeline walks K/V through a block table
+                    pipelines.append(FmhaFwdPipeline('qr', 'row', 't', 't', 't', 't', bias, lse, squant, mask, 't'))
+                    # split kv for small seqlen_q (decoding), only the qr pipeline splits seqlen_k
+                    pipelines.append(FmhaFwdPipeline('qr', 'row', 't', 't', 't', 't', bias, lse, squant, mask, 'f', 't'))
         elif dtype in ['fp8', 'bf8']:
             # no need lse kernels
             for mask, bias in itertools.product(get_mask_map(mask_impl).keys(), ["t", "f"]):
                 pipelines.append(FmhaFwdPipeline('qr', 'col', 'f', 'f', 'f', 'f', bias, 'f', squant, mask))
+                if bias == 'f':
+                    # K/V quantized per head (e.g. kv cache), folded into scale_s/scale_o
+                    pipelines.append(FmhaFwdPipeline('qr', 'col', 'f', 'f', 'f', 'f', bias, 'f', squant, mask, 'f', 'f', 't'))
+                    # padded, for decoding shapes (seqlen_q < bm0) and group mode
+                    pipelines.append(FmhaFwdPipeline('qr', 'col', 't', 't', 't', 't', bias, 'f', squant, mask, 'f', 'f', 't'))
         else:
             assert False
         return pipelines
@@ -528,33 +966,216 @@ def get_blobs(kernel_filter : Optional[str], receipt, mask_impl) -> Tuple[FmhaFw
 
     return (api_pool, gen)
 
-def write_single_kernel(kernel: FmhaFwdKernel, autogen_dir: Path) -> None:
+@dataclass
+class FmhaFwdAppendKVKernel:
+    F_idx           : int  # this is not a tunable, but a counter to differentiate symbol
+    F_dtype         : str  # data type
+    F_rope          : str  # value from ROPE_MAP
+    F_pagedkv       : str  # true/false
+
+    @property
+    def ropecheck(self) -> str:
+        # pairs of the first rotary_dim elements are rotated
+        if self.F_rope == 'no': return 'true'
+        else :                  return '0 < a.rotary_dim && a.rotary_dim % 2 == 0 && a.rotary_dim <= a.hdim_q'
+
+    def format_args(self) -> dict:
+        return dict(F_idx=self.F_idx, F_dtype=DTYPE_MAP[self.F_dtype], F_rope=ROPE_MAP[self.F_rope],
+                    F_pagedkv=BOOL_MAP[self.F_pagedkv], F_ropecheck=self.ropecheck)
+
+    @property
+    def template(self) -> str:
+        return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_APPENDKV_KERNEL_BODY.format(**self.format_args())
+
+    @property
+    def name(self) -> str:
+        n = f"fmha_fwd_appendkv_{self.F_dtype}"
+        if self.F_rope != 'no' : n += f'_r{self.F_rope}'
+        if self.F_pagedkv == 't' : n += '_pagedkv'
+        return n
+
+    @property
+    def filename(self) -> str:
+        return self.name + ".cpp"
+
+class FmhaFwdAppendKVApiPool:
+    def __init__(self):
+        self.pool = dict()
+
+    def register_kernel(self, kernel : FmhaFwdAppendKVKernel) -> None:
+        if kernel.F_dtype not in self.pool.keys():
+            self.pool[kernel.F_dtype] = list()
+        self.pool[kernel.F_dtype].append(copy.copy(kernel))
+
+    @property
+    def api(self) -> str:
+        per_dtypes=str()
+        for i, dtype in enumerate(self.pool.keys()):
+            inners=str()
+            for j, kernel in enumerate(self.pool[dtype]):
+                if_j = 'if' if j == 0 else 'else if'
+                inners = inners + FMHA_FWD_APPENDKV_API_INNER_DISPATCH.format(F_if=if_j, **kernel.format_args())
+            if_i = 'if' if i == 0 else 'else if'
+            per_dtypes = per_dtypes + FMHA_FWD_APPENDKV_API_PER_DTYPE.format(F_if=if_i, F_dtype=dtype, F_inner_dispatch=inners)
+        return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_APPENDKV_API.format(F_dispatch=per_dtypes)
+
+def get_fwd_appendkv_blobs(kernel_filter : Optional[str]) -> Tuple[FmhaFwdAppendKVApiPool, List[FmhaFwdAppendKVKernel]]:
+    gen = list()
+    api_pool = FmhaFwdAppendKVApiPool()
+
+    # the kernel is not tiled over hdim, one instance covers every hdim
+    for dtype, rope, pagedkv in itertools.product(['fp16', 'bf16'], ROPE_MAP.keys(), ['f', 't']):
+        k = FmhaFwdAppendKVKernel(F_idx=0, F_dtype=dtype, F_rope=rope, F_pagedkv=pagedkv)
+        if kernel_filter != None:
+            if not fnmatch.fnmatch(k.name, kernel_filter):
+                continue
+        api_pool.register_kernel(k)
+        gen.append(k)
+
+    return (api_pool, gen)
+
+FMHA_BWD_KERNEL_HEADER = """// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.\n
+// auto generated by generate.py
+#include "fmha_bwd.hpp"
+"""
+
+FMHA_BWD_API_FILENAME="fmha_bwd_api.cpp"
+FMHA_BWD_API="""
+float fmha_bwd(fmha_bwd_traits t, fmha_bwd_args a, const ck_tile::stream_config& s){{
+    float r = -1;
+{F_dispatch}
+    return r;
+}}
+"""
+
+FMHA_BWD_API_EMPTY="""
+float fmha_bwd(fmha_bwd_traits, fmha_bwd_args, const ck_tile::stream_config&){
+    return -1;
+}
+"""
+
+FMHA_BWD_API_PER_DTYPE="""    {F_if}(t.data_type.compare(\"{F_dtype}\") == 0){{
+{F_hdim_case}
+    }}
+"""
+
+FMHA_BWD_API_PER_HDIM_CASE="""        {F_if}(t.hdim_q <= {F_hdim} && t.hdim_v <= {F_hdim}) {{
+{F_inner_dispatch}
+        }}
+"""
+
+FMHA_BWD_API_INNER_DISPATCH="""            {F_if}((t.is_group_mode == {F_mode}) && ({F_mask_check}) && (t.has_bias == {F_bias}) && (t.has_dbias == {F_dbias})) {{
+                using trait_ = fmha_bwd_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_mask}, {F_bias}, {F_dbias}>;
+                return fmha_bwd_<trait_>(s, a);
+            }}
+"""
+
+@dataclass
+class FmhaBwdApiTrait:
+    dtype : str  # data type
+    hdim  : str  # hdim_q/hdim_v upper bound
+    mode  : str  # value from MODE_MAP
+    mask  : str  # value from MASK_MAP
+    bias  : str  # true/false
+    dbias : str  # true/false
+
+class FmhaBwdApiPool:
+    def __init__(self, mask_impl):
+        self.pool = dict()
+        self.mask_impl = mask_impl
+
+    def register_traits(self, trait : FmhaBwdApiTrait) -> None:
+        if trait.dtype not in self.pool.keys():
+            self.pool[trait.dtype] = dict()
+        if trait.hdim not in self.pool[trait.dtype].keys():
+            self.pool[trait.dtype][trait.hdim] = list()
+
+        self.pool[trait.dtype][trait.hdim].append(copy.copy(trait))
+
+    @property
+    def api(self) -> str:
+        if len(self.pool) == 0:
+            return FMHA_BWD_KERNEL_HEADER + FMHA_BWD_API_EMPTY
+        per_dtypes=str()
+        for i, dtype in enumerate(self.pool.keys()):
+            per_hdim_case=str()
+            for j, hdim in enumerate(self.pool[dtype].keys()):
+                inners=str()
+                for k, trait in enumerate(self.pool[dtype][hdim]):
+                    if_k = 'if' if k == 0 else 'else if'
+                    inners = inners + FMHA_BWD_API_INNER_DISPATCH.format(F_if=if_k, F_mode=MODE_MAP[trait.mode],
+                                F_mask=get_mask_map(self.mask_impl)[trait.mask], F_mask_check=get_mask_check_map(self.mask_impl)[trait.mask],
+                                F_bias=BOOL_MAP[trait.bias], F_dbias=BOOL_MAP[trait.dbias], F_hdim=hdim, F_dtype=DTYPE_MAP[dtype])
+                if_j = 'if' if j == 0 else 'else if'
+                per_hdim_case = per_hdim_case + FMHA_BWD_API_PER_HDIM_CASE.format(F_if=if_j, F_hdim=hdim, F_inner_dispatch=inners)
+            if_i = 'if' if i == 0 else 'else if'
+            per_dtypes = per_dtypes + FMHA_BWD_API_PER_DTYPE.format(F_if=if_i, F_dtype=dtype, F_hdim_case=per_hdim_case)
+        return FMHA_BWD_KERNEL_HEADER + FMHA_BWD_API.format(F_dispatch=per_dtypes)
+
+def get_bwd_blobs(kernel_filter : Optional[str], receipt, mask_impl) -> Tuple[FmhaBwdApiPool, List]:
+    # TODO: no ck_tile fmha bwd pipeline yet, so there is no instance to register and fmha_bwd()
+    #       returns -1 for every traits. instances go here, reference_fmha_bwd() is the host
+    #       reference to validate them against
+    api_pool = FmhaBwdApiPool(mask_impl)
+    return (api_pool, [])
+
+def write_single_kernel(kernel, autogen_dir: Path) -> None:
     (autogen_dir / kernel.filename).write_text(kernel.template)
 
 def write_api(api_pool : FmhaFwdApiPool, autogen_dir: Path) -> None:
     (autogen_dir / FMHA_FWD_API_FILENAME).write_text(api_pool.api)
 
-def write_blobs(output_dir : Optional[str], kernel_filter : Optional[str], receipt, mask_impl) -> None:
+def write_blobs(output_dir : Optional[str], kernel_filter : Optional[str], receipt, mask_impl, directions : List[str]) -> None:
     if output_dir is None:
         output_dir = Path(__file__).parent
     else:
         output_dir = Path(output_dir) / GEN_DIR
 
     output_dir.mkdir(parents=True, exist_ok=True)
+    if 'fwd' in directions:
+        api_pool, kernels = get_blobs(kernel_filter, receipt, mask_impl)
+        for kernel in kernels:
+            write_single_kernel(kernel, output_dir)
+        write_api(api_pool, output_dir)
+
+        appendkv_api_pool, appendkv_kernels = get_fwd_appendkv_blobs(kernel_filter)
+        for kernel in appendkv_kernels:
+            write_single_kernel(kernel, output_dir)
+        (output_dir / FMHA_FWD_APPENDKV_API_FILENAME).write_text(appendkv_api_pool.api)
+
+    if 'bwd' in directions:
+        bwd_api_pool, bwd_kernels = get_bwd_blobs(kernel_filter, receipt, mask_impl)
+        for kernel in bwd_kernels:
+            write_single_kernel(kernel, output_dir)
+        (output_dir / FMHA_BWD_API_FILENAME).write_text(bwd_api_pool.api)
+
+def write_dispatch_bench(output_file : str, kernel_filter : Optional[str], receipt, mask_impl) -> None:
     api_pool, kernels = get_blobs(kernel_filter, receipt, mask_impl)
-    for kernel in kernels:
-        write_single_kernel(kernel, output_dir)
-    write_api(api_pool, output_dir)
+    main = FMHA_FWD_DISPATCH_BENCH_MAIN.format(F_dtypes=', '.join(f'"{d}"' for d in DTYPE_MAP.keys()),
+                                               F_num_instances=len(kernels))
+    Path(output_file).write_text(FMHA_FWD_DISPATCH_BENCH_HEADER.format() +
+                                 'namespace chain {\n' + api_pool.chain_api_body + '} // namespace chain\n' +
+                                 'namespace table {\n' + api_pool.api_body + '} // namespace table\n' + main)
 
 # list all the files that will be generated
-def list_blobs(output_file : Optional[str], kernel_filter : Optional[str], receipt, mask_impl) -> None:
+def list_blobs(output_file : Optional[str], kernel_filter : Optional[str], receipt, mask_impl, directions : List[str]) -> None:
     assert output_file is not None
     file_path = Path(output_file)
     with file_path.open('a') as f:
-        _, kernels = get_blobs(kernel_filter, receipt, mask_impl)
-        for kernel in kernels:
-            f.write(str(file_path.parent / GEN_DIR / kernel.filename) + "\n")
-        f.write(str(file_path.parent / GEN_DIR / FMHA_FWD_API_FILENAME) + "\n")
+        if 'fwd' in directions:
+            _, kernels = get_blobs(kernel_filter, receipt, mask_impl)
+            _, appendkv_kernels = get_fwd_appendkv_blobs(kernel_filter)
+            for kernel in kernels + appendkv_kernels:
+                f.write(str(file_path.parent / GEN_DIR / kernel.filename) + "\n")
+            f.write(str(file_path.parent / GEN_DIR / FMHA_FWD_API_FILENAME) + "\n")
+            f.write(str(file_path.parent / GEN_DIR / FMHA_FWD_APPENDKV_API_FILENAME) + "\n")
+
+        if 'bwd' in directions:
+            _, bwd_kernels = get_bwd_blobs(kernel_filter, receipt, mask_impl)
+            for kernel in bwd_kernels:
+                f.write(str(file_path.parent / GEN_DIR / kernel.filename) + "\n")
+            f.write(str(file_path.parent / GEN_DIR / FMHA_BWD_API_FILENAME) + "\n")
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(
@@ -598,8 +1219,26 @@ if __name__ == "__main__":
              "  1: generate more instance to cover all hdim"
     )
 
+    parser.add_argument(
+        "-d",
+        "--direction",
+        default="fwd",
+        required=False,
+        help="comma separated directions to generate, " + "/".join(DIRECTIONS)
+    )
+
+    parser.add_argument(
+        "--dispatch_bench",
+        required=False,
+        help="write a host only microbenchmark of the fmha_fwd() dispatch to a file"
+    )
+
     args = parser.parse_args()
-    if args.list_blobs is not None:
-        list_blobs(args.list_blobs, args.filter, args.receipt, mask_impl=args.mask)
+    directions = args.direction.split(',')
+    assert all(d in DIRECTIONS for d in directions), f"unknown direction in {args.direction}"
+    if args.dispatch_bench is not None:
+        write_dispatch_bench(args.dispatch_bench, args.filter, args.receipt, mask_impl=args.mask)
+    elif args.list_blobs is not None:
+        list_blobs(args.list_blobs, args.filter, args.receipt, mask_impl=args.mask, directions=directions)
     else:
-        write_blobs(args.output_dir, args.filter, args.receipt, mask_impl=args.mask)
+        write_blobs(args.output_dir, args.filter, args.receipt, mask_impl=args.mask, directions=directions)
@@ -18,6 +18,14 @@ enum class mask_enum
     window_generic,
 };
 
+// the masks the fmha fwd/bwd instances are generated with
+struct FmhaMasks
+{
+    using NoMask      = ck_tile::GenericAttentionMask<false>;
+    using GenericMask = ck_tile::GenericAttentionMask<true, true>;
+    using CausalMask  = ck_tile::GenericAttentionMask<true, false>;
+};
+
 struct mask_info
 {
     mask_enum type;
@@ -157,3 +165,30 @@ inline std::ostream& operator<<(std::ostream& os, const mask_info& mi)
     mi.serialize(os);
     return os;
 }
+
+// the ck_tile mask the kernel builds from mask_info for one sequence, MaskType is the mask the
+// kernel is instantiated with (e.g. FmhaMasks::CausalMask)
+template <typename MaskType>
+MaskType
+make_attention_mask(const mask_info& mask, ck_tile::index_t seqlen_q, ck_tile::index_t seqlen_k)
+{
+    if constexpr(MaskType::IsMasking)
+        return ck_tile::make_generic_attention_mask_from_lr_window<MaskType>(
+            mask.left, mask.right, seqlen_q, seqlen_k, mask.type == mask_enum::mask_top_left);
+    else
+        return MaskType{seqlen_q, seqlen_k};
+}
+
+template <typename MaskType, ck_tile::index_t kM0, ck_tile::index_t kN0>
+ck_tile::MaskTileTable make_mask_tile_table(const mask_info& mask,
+                                            ck_tile::index_t seqlen_q,
+                                            ck_tile::index_t seqlen_k,
+                                            ck_tile::number<kM0> tile_m,
+                                            ck_tile::number<kN0> tile_n)
+{
+    return ck_tile::make_mask_tile_table(make_attention_mask<MaskType>(mask, seqlen_q, seqlen_k),
+                                         seqlen_q,
+                                         seqlen_k,
+                                         tile_m,
+                                         tile_n);
+}
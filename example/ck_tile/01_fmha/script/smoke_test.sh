@@ -43,3 +43,50 @@ $EXE -prec=fp8 -init=3 -b=$b -h=1 -d=128 -s=128 -bias=$bias -iperm=$perm -operm=
 done
 done
 done
+
+# per-head kv dequant, tile aligned and decoding (seqlen_q=1, padded seqlen_k)
+for perm in 0 1 ; do
+for mode in 0 1 ; do
+$EXE -prec=fp8 -init=3 -mode=$mode -b=2 -h=4 -h_k=2 -d=128 -s=128 -iperm=$perm -operm=$perm -vlayout=c -squant=1 -kv_dequant=1 -kname=$KNAME $COMMON_ARGS
+$EXE -prec=fp8 -init=3 -mode=$mode -b=2 -h=8 -h_k=2 -d=128 -s=1 -s_k=1000 -iperm=$perm -operm=$perm -vlayout=c -squant=1 -kv_dequant=1 -kname=$KNAME $COMMON_ARGS
+$EXE -prec=fp8 -init=3 -mode=$mode -b=3 -h=4 -h_k=4 -d=128 -s=200 -s_k=520 -iperm=$perm -operm=$perm -mask=t:128,30 -vlayout=c -squant=1 -kv_dequant=1 -kname=$KNAME $COMMON_ARGS
+$EXE -prec=fp8 -init=3 -mode=$mode -b=2 -h=2 -h_k=1 -d=128 -s=99 -s_k=256 -iperm=$perm -operm=$perm -mask=b:4,35 -vlayout=c -squant=1 -kv_dequant=1 -kname=$KNAME $COMMON_ARGS
+done
+done
+
+# paged kv cache, page_block_size has to be a multiple of the kN0 tile (64 for hdim<=64, 128 above)
+for prec in "fp16" "bf16" ; do
+for mode in 1 0 ; do
+for hdim in 64 128 256 ; do
+for page_block_size in 128 256 ; do
+$EXE -prec=$prec -mode=$mode -b=3 -h=4 -h_k=2 -d=$hdim -s=1 -s_k=1000 -page_block_size=$page_block_size -lse=1 -vlayout=r -kname=$KNAME $COMMON_ARGS
+$EXE -prec=$prec -mode=$mode -b=2 -h=2 -d=$hdim -s=200 -s_k=520 -page_block_size=$page_block_size -mask=t:128,30 -vlayout=r -kname=$KNAME $COMMON_ARGS
+$EXE -prec=$prec -mode=$mode -b=2 -h=1 -d=$hdim -s=99 -s_k=256 -page_block_size=$page_block_size -mask=2 -vlayout=r -kname=$KNAME $COMMON_ARGS
+done
+done
+done
+done
+
+# split kv, decoding rows and splits that are left empty by the mask or by a short seqlen_k
+for prec in "fp16" "bf16" ; do
+for mode in 1 0 ; do
+for hdim in 64 128 256 ; do
+for num_splits in 2 3 8 ; do
+$EXE -prec=$prec -mode=$mode -b=2 -h=4 -h_k=1 -d=$hdim -s=1 -s_k=2000 -num_splits=$num_splits -lse=1 -vlayout=r -kname=$KNAME $COMMON_ARGS
+$EXE -prec=$prec -mode=$mode -b=3 -h=2 -d=$hdim -s=130 -s_k=300 -num_splits=$num_splits -mask=b:4,35 -vlayout=r -kname=$KNAME $COMMON_ARGS
+$EXE -prec=$prec -mode=$mode -b=1 -h=2 -d=$hdim -s=64 -s_k=100 -num_splits=$num_splits -mask=1 -vlayout=r -kname=$KNAME $COMMON_ARGS
+done
+done
+done
+done
+
+# append the new K/V rows to a contiguous or paged kv cache (batch mode only), with and without rope
+for prec in "fp16" "bf16" ; do
+for page_block_size in 0 128 ; do
+$EXE -prec=$prec -mode=0 -b=2 -h=4 -h_k=2 -d=128 -s=1 -s_k=1000 -s_knew=1 -page_block_size=$page_block_size -vlayout=r -kname=$KNAME $COMMON_ARGS
+$EXE -prec=$prec -mode=0 -b=2 -h=4 -h_k=2 -d=128 -s=1 -s_k=1000 -s_knew=1 -rotary_dim=64 -rotary_interleaved=1 -page_block_size=$page_block_size -vlayout=r -kname=$KNAME $COMMON_ARGS
+$EXE -prec=$prec -mode=0 -b=3 -h=2 -d=64 -s=64 -s_k=300 -s_knew=64 -rotary_dim=32 -rotary_interleaved=0 -page_block_size=$page_block_size -mask=b:4,35 -vlayout=r -kname=$KNAME $COMMON_ARGS
+$EXE -prec=$prec -mode=0 -b=1 -h=2 -d=128 -s=16 -s_k=16 -s_knew=16 -rotary_dim=128 -page_block_size=$page_block_size -mask=2 -lse=1 -vlayout=r -kname=$KNAME $COMMON_ARGS
+done
+$EXE -prec=$prec -mode=0 -b=2 -h=4 -h_k=1 -d=128 -s=1 -s_k=2000 -s_knew=1 -rotary_dim=64 -num_splits=4 -vlayout=r -kname=$KNAME $COMMON_ARGS
+done
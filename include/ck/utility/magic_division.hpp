@@ -155,6 +155,35 @@ struct MagicDivision
         uint32_t tmp          = static_cast<uint64_t>(dividend_u32) * multiplier >> 32;
         return (tmp + dividend_u32) >> shift;
     }
+
+    // magic division of num dividends by the same divisor on host, the loop has no dependency
+    // between iterations so that the compiler can vectorize it
+    __host__ static void DoMagicDivision(const uint32_t* p_dividend,
+                                         uint32_t* p_quotient,
+                                         index_t num,
+                                         uint32_t multiplier,
+                                         uint32_t shift)
+    {
+        for(index_t i = 0; i < num; ++i)
+        {
+            uint32_t tmp  = static_cast<uint64_t>(p_dividend[i]) * multiplier >> 32;
+            p_quotient[i] = (tmp + p_dividend[i]) >> shift;
+        }
+    }
+
+    __host__ static void DoMagicDivision(const int32_t* p_dividend_i32,
+                                         int32_t* p_quotient_i32,
+                                         index_t num,
+                                         uint32_t multiplier,
+                                         uint32_t shift)
+    {
+        for(index_t i = 0; i < num; ++i)
+        {
+            uint32_t dividend_u32 = bit_cast<uint32_t>(p_dividend_i32[i]);
+            uint32_t tmp          = static_cast<uint64_t>(dividend_u32) * multiplier >> 32;
+            p_quotient_i32[i]     = (tmp + dividend_u32) >> shift;
+        }
+    }
 };
 
 struct MDiv
@@ -196,6 +225,24 @@ struct MDiv
         remainder_ = dividend_ - (quotient_ * divisor);
     }
 
+    // num dividends at once, host only
+    __host__ void div(const uint32_t* dividends_, uint32_t* quotients_, index_t num_) const
+    {
+        MagicDivision::DoMagicDivision(dividends_, quotients_, num_, multiplier, shift);
+    }
+
+    __host__ void divmod(const uint32_t* dividends_,
+                         uint32_t* quotients_,
+                         uint32_t* remainders_,
+                         index_t num_) const
+    {
+        div(dividends_, quotients_, num_);
+        for(index_t i = 0; i < num_; ++i)
+        {
+            remainders_[i] = dividends_[i] - (quotients_[i] * divisor);
+        }
+    }
+
     __host__ __device__ uint32_t get() const { return divisor; }
 };
 
@@ -227,6 +274,59 @@ struct MDiv2
         quotient_  = div(dividend_);
         remainder_ = dividend_ - (quotient_ * divisor_);
     }
+
+    // num dividends at once, host only
+    __host__ void div(const uint32_t* dividends_, uint32_t* quotients_, index_t num_) const
+    {
+        MagicDivision::DoMagicDivision(dividends_, quotients_, num_, multiplier, shift);
+    }
+};
+
+// Mixed-radix decomposition of a 1d index into the coordinates of an N-d index, row-major (the
+// last dim is the fastest) as the strides of a packed tensor. The first dim takes the remaining
+// quotient, so it is not wrapped around.
+// Caution: same range as MagicDivision, the 1d index has to be within 31-bit value range.
+template <index_t NDim>
+struct MDivMixedRadix
+{
+    static_assert(NDim > 0, "wrong! at least one dim");
+
+    MDiv lengths[NDim];
+
+    // prefer construct on host
+    template <typename Lengths>
+    __host__ __device__ MDivMixedRadix(const Lengths& lengths_)
+    {
+        for(index_t d = 0; d < NDim; ++d)
+        {
+            lengths[d].update(lengths_[d]);
+        }
+    }
+
+    __host__ __device__ MDivMixedRadix() {}
+
+    __host__ __device__ void decompose(uint32_t idx_, uint32_t* coords_) const
+    {
+        for(index_t d = NDim - 1; d > 0; --d)
+        {
+            uint32_t quotient;
+            lengths[d].divmod(idx_, quotient, coords_[d]);
+            idx_ = quotient;
+        }
+        coords_[0] = idx_;
+    }
+
+    // num indices at once, host only. coords_ is [num_, NDim]. The divisions of an index depend
+    // on each other, but the ones of consecutive indices overlap
+    __host__ void decompose(const uint32_t* idxs_, index_t num_, uint32_t* coords_) const
+    {
+        for(index_t i = 0; i < num_; ++i)
+        {
+            decompose(idxs_[i], coords_ + i * NDim);
+        }
+    }
+
+    __host__ __device__ uint32_t get(index_t d) const { return lengths[d].get(); }
 };
 
 } // namespace ck
@@ -34,6 +34,44 @@ __host__ __device__ constexpr auto sequence_pop_front(Sequence<I, Is...>);
 template <typename Seq>
 __host__ __device__ constexpr auto sequence_pop_back(Seq);
 
+namespace detail {
+template <index_t I, index_t X, index_t... Is, index_t... Ids>
+__host__ __device__ constexpr auto sequence_modify(Sequence<Is...>, Sequence<Ids...>);
+} // namespace detail
+
+// Sequence<0, 1, ..., N - 1>, generated by the compiler builtin instead of recursive instantiation
+#if __has_builtin(__make_integer_seq)
+namespace detail {
+template <typename T, T... Is>
+struct make_index_sequence_impl
+{
+    using type = Sequence<Is...>;
+};
+} // namespace detail
+
+template <index_t N>
+using make_index_sequence =
+    typename __make_integer_seq<detail::make_index_sequence_impl, index_t, N>::type;
+#else
+template <index_t N>
+using make_index_sequence = Sequence<__integer_pack(N)...>;
+#endif
+
+namespace detail {
+// The algorithms on Sequence below compute their result into this array with constexpr loops and
+// only then turn it into a Sequence, instead of building it by recursive instantiation
+template <index_t N>
+struct sequence_values
+{
+    // the last dummy element is to prevent compiler complain about empty array, when N = 0
+    index_t data[N + 1] = {};
+
+    __host__ __device__ constexpr index_t& operator[](index_t i) { return data[i]; }
+
+    __host__ __device__ constexpr const index_t& operator[](index_t i) const { return data[i]; }
+};
+} // namespace detail
+
 template <index_t... Is>
 struct Sequence
 {
@@ -158,11 +196,7 @@ struct Sequence
     {
         static_assert(I < Size(), "wrong!");
 
-        using seq_split          = sequence_split<Type, I>;
-        constexpr auto seq_left  = typename seq_split::left_type{};
-        constexpr auto seq_right = typename seq_split::right_type{}.PopFront();
-
-        return seq_left.PushBack(Number<X>{}).PushBack(seq_right);
+        return detail::sequence_modify<I, X>(Type{}, make_index_sequence<mSize>{});
     }
 
     template <typename F>
@@ -181,10 +215,27 @@ struct Sequence
 };
 
 // merge sequence
+namespace detail {
+template <typename Seq>
+struct sequence_merge_operand
+{
+    using type = Seq;
+};
+
+template <index_t... Xs, index_t... Ys>
+__host__ __device__ constexpr auto operator+(sequence_merge_operand<Sequence<Xs...>>,
+                                             sequence_merge_operand<Sequence<Ys...>>)
+{
+    return sequence_merge_operand<Sequence<Xs..., Ys...>>{};
+}
+} // namespace detail
+
 template <typename Seq, typename... Seqs>
 struct sequence_merge
 {
-    using type = typename sequence_merge<Seq, typename sequence_merge<Seqs...>::type>::type;
+    // fold over all the sequences, instead of merging them one instantiation at a time
+    using type = typename decltype((detail::sequence_merge_operand<Seq>{} + ... +
+                                    detail::sequence_merge_operand<Seqs>{}))::type;
 };
 
 template <index_t... Xs, index_t... Ys>
@@ -203,91 +254,69 @@ struct sequence_merge<Seq>
 template <index_t NSize, typename F>
 struct sequence_gen
 {
-    template <index_t IBegin, index_t NRemain, typename G>
-    struct sequence_gen_impl
-    {
-        static constexpr index_t NRemainLeft  = NRemain / 2;
-        static constexpr index_t NRemainRight = NRemain - NRemainLeft;
-        static constexpr index_t IMiddle      = IBegin + NRemainLeft;
-
-        using type = typename sequence_merge<
-            typename sequence_gen_impl<IBegin, NRemainLeft, G>::type,
-            typename sequence_gen_impl<IMiddle, NRemainRight, G>::type>::type;
-    };
-
-    template <index_t I, typename G>
-    struct sequence_gen_impl<I, 1, G>
-    {
-        static constexpr index_t Is = G{}(Number<I>{});
-        using type                  = Sequence<Is>;
-    };
-
-    template <index_t I, typename G>
-    struct sequence_gen_impl<I, 0, G>
-    {
-        using type = Sequence<>;
-    };
+    template <index_t... Is>
+    static Sequence<static_cast<index_t>(F{}(Number<Is>{}))...> generate(Sequence<Is...>);
 
-    using type = typename sequence_gen_impl<0, NSize, F>::type;
+    using type = decltype(generate(make_index_sequence<NSize>{}));
 };
 
 // arithmetic sequence
 template <index_t IBegin, index_t IEnd, index_t Increment>
 struct arithmetic_sequence_gen
 {
-    struct F
-    {
-        __host__ __device__ constexpr index_t operator()(index_t i) const
-        {
-            return i * Increment + IBegin;
-        }
-    };
-
-    using type0 = typename sequence_gen<(IEnd - IBegin) / Increment, F>::type;
-    using type1 = Sequence<>;
-
     static constexpr bool kHasContent =
         (Increment > 0 && IBegin < IEnd) || (Increment < 0 && IBegin > IEnd);
 
-    using type = typename conditional<kHasContent, type0, type1>::type;
+    static constexpr index_t NSize = kHasContent ? (IEnd - IBegin) / Increment : 0;
+
+    template <index_t... Is>
+    static Sequence<(Is * Increment + IBegin)...> generate(Sequence<Is...>);
+
+    using type = decltype(generate(make_index_sequence<NSize>{}));
 };
 
 // uniform sequence
 template <index_t NSize, index_t I>
 struct uniform_sequence_gen
 {
-    struct F
-    {
-        __host__ __device__ constexpr index_t operator()(index_t) const { return I; }
-    };
+    template <index_t... Is>
+    static Sequence<(Is * 0 + I)...> generate(Sequence<Is...>);
 
-    using type = typename sequence_gen<NSize, F>::type;
+    using type = decltype(generate(make_index_sequence<NSize>{}));
 };
 
 // reverse inclusive scan (with init) sequence
-template <typename, typename, index_t>
-struct sequence_reverse_inclusive_scan;
-
-template <index_t I, index_t... Is, typename Reduce, index_t Init>
-struct sequence_reverse_inclusive_scan<Sequence<I, Is...>, Reduce, Init>
+namespace detail {
+template <typename Reduce, index_t Init, index_t... Is>
+__host__ __device__ constexpr auto sequence_reverse_inclusive_scan_values(Sequence<Is...>)
 {
-    using old_scan = typename sequence_reverse_inclusive_scan<Sequence<Is...>, Reduce, Init>::type;
+    constexpr index_t n     = sizeof...(Is);
+    const index_t xs[n + 1] = {Is..., 0};
 
-    static constexpr index_t new_reduce = Reduce{}(I, old_scan{}.Front());
+    sequence_values<n> scan{};
+    index_t acc = Init;
+    for(index_t i = n - 1; i >= 0; --i)
+    {
+        acc     = Reduce{}(xs[i], acc);
+        scan[i] = acc;
+    }
+    return scan;
+}
+} // namespace detail
 
-    using type = typename sequence_merge<Sequence<new_reduce>, old_scan>::type;
-};
+template <typename, typename, index_t>
+struct sequence_reverse_inclusive_scan;
 
-template <index_t I, typename Reduce, index_t Init>
-struct sequence_reverse_inclusive_scan<Sequence<I>, Reduce, Init>
+template <index_t... Is, typename Reduce, index_t Init>
+struct sequence_reverse_inclusive_scan<Sequence<Is...>, Reduce, Init>
 {
-    using type = Sequence<Reduce{}(I, Init)>;
-};
+    static constexpr auto scan =
+        detail::sequence_reverse_inclusive_scan_values<Reduce, Init>(Sequence<Is...>{});
 
-template <typename Reduce, index_t Init>
-struct sequence_reverse_inclusive_scan<Sequence<>, Reduce, Init>
-{
-    using type = Sequence<>;
+    template <index_t... Ids>
+    static Sequence<scan[Ids]...> generate(Sequence<Ids...>);
+
+    using type = decltype(generate(make_index_sequence<sizeof...(Is)>{}));
 };
 
 // split sequence
@@ -304,27 +333,15 @@ struct sequence_split
 };
 
 // reverse sequence
-template <typename Seq>
-struct sequence_reverse
+template <index_t... Is>
+struct sequence_reverse<Sequence<Is...>>
 {
-    static constexpr index_t NSize = Seq{}.Size();
+    static constexpr index_t NSize = sizeof...(Is);
 
-    using seq_split = sequence_split<Seq, NSize / 2>;
-    using type      = typename sequence_merge<
-        typename sequence_reverse<typename seq_split::right_type>::type,
-        typename sequence_reverse<typename seq_split::left_type>::type>::type;
-};
-
-template <index_t I>
-struct sequence_reverse<Sequence<I>>
-{
-    using type = Sequence<I>;
-};
+    template <index_t... Ids>
+    static Sequence<Sequence<Is...>::At(NSize - 1 - Ids)...> generate(Sequence<Ids...>);
 
-template <index_t I0, index_t I1>
-struct sequence_reverse<Sequence<I0, I1>>
-{
-    using type = Sequence<I1, I0>;
+    using type = decltype(generate(make_index_sequence<NSize>{}));
 };
 
 #if 1
@@ -349,151 +366,132 @@ struct sequence_reduce<Reduce, Seq>
 };
 #endif
 
-template <typename Values, typename Ids, typename Compare>
-struct sequence_sort_impl
+namespace detail {
+template <index_t N>
+struct sequence_values_and_ids
 {
-    template <typename LeftValues,
-              typename LeftIds,
-              typename RightValues,
-              typename RightIds,
-              typename MergedValues,
-              typename MergedIds,
-              typename Comp>
-    struct sorted_sequence_merge_impl
-    {
-        static constexpr bool choose_left = LeftValues::Front() < RightValues::Front();
-
-        static constexpr index_t chosen_value =
-            choose_left ? LeftValues::Front() : RightValues::Front();
-        static constexpr index_t chosen_id = choose_left ? LeftIds::Front() : RightIds::Front();
-
-        using new_merged_values = decltype(MergedValues::PushBack(Number<chosen_value>{}));
-        using new_merged_ids    = decltype(MergedIds::PushBack(Number<chosen_id>{}));
-
-        using new_left_values =
-            typename conditional<choose_left, decltype(LeftValues::PopFront()), LeftValues>::type;
-        using new_left_ids =
-            typename conditional<choose_left, decltype(LeftIds::PopFront()), LeftIds>::type;
-
-        using new_right_values =
-            typename conditional<choose_left, RightValues, decltype(RightValues::PopFront())>::type;
-        using new_right_ids =
-            typename conditional<choose_left, RightIds, decltype(RightIds::PopFront())>::type;
-
-        using merge = sorted_sequence_merge_impl<new_left_values,
-                                                 new_left_ids,
-                                                 new_right_values,
-                                                 new_right_ids,
-                                                 new_merged_values,
-                                                 new_merged_ids,
-                                                 Comp>;
-        // this is output
-        using merged_values = typename merge::merged_values;
-        using merged_ids    = typename merge::merged_ids;
-    };
-
-    template <typename LeftValues,
-              typename LeftIds,
-              typename MergedValues,
-              typename MergedIds,
-              typename Comp>
-    struct sorted_sequence_merge_impl<LeftValues,
-                                      LeftIds,
-                                      Sequence<>,
-                                      Sequence<>,
-                                      MergedValues,
-                                      MergedIds,
-                                      Comp>
-    {
-        using merged_values = typename sequence_merge<MergedValues, LeftValues>::type;
-        using merged_ids    = typename sequence_merge<MergedIds, LeftIds>::type;
-    };
-
-    template <typename RightValues,
-              typename RightIds,
-              typename MergedValues,
-              typename MergedIds,
-              typename Comp>
-    struct sorted_sequence_merge_impl<Sequence<>,
-                                      Sequence<>,
-                                      RightValues,
-                                      RightIds,
-                                      MergedValues,
-                                      MergedIds,
-                                      Comp>
+    sequence_values<N> values;
+    sequence_values<N> ids;
+    index_t size = N;
+};
+
+// top-down merge sort of values[begin, begin + n) and their ids. Equal values take the one from
+// the right half first
+template <typename Compare, index_t N>
+__host__ __device__ constexpr void
+sequence_merge_sort(sequence_values_and_ids<N>& x, index_t begin, index_t n)
+{
+    if(n == 2 && !Compare{}(x.values[begin], x.values[begin + 1]))
     {
-        using merged_values = typename sequence_merge<MergedValues, RightValues>::type;
-        using merged_ids    = typename sequence_merge<MergedIds, RightIds>::type;
-    };
-
-    template <typename LeftValues,
-              typename LeftIds,
-              typename RightValues,
-              typename RightIds,
-              typename Comp>
-    struct sorted_sequence_merge
+        const index_t value = x.values[begin];
+        const index_t id    = x.ids[begin];
+        x.values[begin]     = x.values[begin + 1];
+        x.ids[begin]        = x.ids[begin + 1];
+        x.values[begin + 1] = value;
+        x.ids[begin + 1]    = id;
+    }
+    if(n <= 2)
+        return;
+
+    const index_t n_left = n / 2;
+    sequence_merge_sort<Compare>(x, begin, n_left);
+    sequence_merge_sort<Compare>(x, begin + n_left, n - n_left);
+
+    sequence_values_and_ids<N> merged{};
+    index_t left  = begin;
+    index_t right = begin + n_left;
+    for(index_t i = 0; i < n; ++i)
+    {
+        const bool choose_left =
+            right == begin + n ||
+            (left < begin + n_left && Compare{}(x.values[left], x.values[right]));
+        const index_t from = choose_left ? left++ : right++;
+        merged.values[i]   = x.values[from];
+        merged.ids[i]      = x.ids[from];
+    }
+    for(index_t i = 0; i < n; ++i)
     {
-        using merge = sorted_sequence_merge_impl<LeftValues,
-                                                 LeftIds,
-                                                 RightValues,
-                                                 RightIds,
-                                                 Sequence<>,
-                                                 Sequence<>,
-                                                 Comp>;
-
-        using merged_values = typename merge::merged_values;
-        using merged_ids    = typename merge::merged_ids;
-    };
+        x.values[begin + i] = merged.values[i];
+        x.ids[begin + i]    = merged.ids[i];
+    }
+}
 
-    static constexpr index_t nsize = Values::Size();
+template <typename Compare, index_t... Vs, index_t... Is>
+__host__ __device__ constexpr auto sequence_sort_values(Sequence<Vs...>, Sequence<Is...>)
+{
+    static_assert(sizeof...(Vs) == sizeof...(Is), "wrong! inconsistent size");
 
-    using split_unsorted_values = sequence_split<Values, nsize / 2>;
-    using split_unsorted_ids    = sequence_split<Ids, nsize / 2>;
-
-    using left_unsorted_values = typename split_unsorted_values::left_type;
-    using left_unsorted_ids    = typename split_unsorted_ids::left_type;
-    using left_sort          = sequence_sort_impl<left_unsorted_values, left_unsorted_ids, Compare>;
-    using left_sorted_values = typename left_sort::sorted_values;
-    using left_sorted_ids    = typename left_sort::sorted_ids;
-
-    using right_unsorted_values = typename split_unsorted_values::right_type;
-    using right_unsorted_ids    = typename split_unsorted_ids::right_type;
-    using right_sort = sequence_sort_impl<right_unsorted_values, right_unsorted_ids, Compare>;
-    using right_sorted_values = typename right_sort::sorted_values;
-    using right_sorted_ids    = typename right_sort::sorted_ids;
-
-    using merged_sorted = sorted_sequence_merge<left_sorted_values,
-                                                left_sorted_ids,
-                                                right_sorted_values,
-                                                right_sorted_ids,
-                                                Compare>;
-
-    using sorted_values = typename merged_sorted::merged_values;
-    using sorted_ids    = typename merged_sorted::merged_ids;
-};
+    sequence_values_and_ids<sizeof...(Vs)> x{{{Vs...}}, {{Is...}}};
+    sequence_merge_sort<Compare>(x, 0, sizeof...(Vs));
+    return x;
+}
 
-template <index_t ValueX, index_t ValueY, index_t IdX, index_t IdY, typename Compare>
-struct sequence_sort_impl<Sequence<ValueX, ValueY>, Sequence<IdX, IdY>, Compare>
+// keeps the first of every run of equal values of a sorted sequence
+template <typename Equal, index_t... Vs, index_t... Is>
+__host__ __device__ constexpr auto sequence_uniquify_values(Sequence<Vs...>, Sequence<Is...>)
 {
-    static constexpr bool choose_x = Compare{}(ValueX, ValueY);
+    constexpr index_t n         = sizeof...(Vs);
+    const index_t values[n + 1] = {Vs..., 0};
+    const index_t ids[n + 1]    = {Is..., 0};
 
-    using sorted_values =
-        typename conditional<choose_x, Sequence<ValueX, ValueY>, Sequence<ValueY, ValueX>>::type;
-    using sorted_ids = typename conditional<choose_x, Sequence<IdX, IdY>, Sequence<IdY, IdX>>::type;
-};
+    sequence_values_and_ids<n> x{};
+    x.size = 0;
+    for(index_t i = 0; i < n; ++i)
+    {
+        if(x.size == 0 || !Equal{}(values[i], x.values[x.size - 1]))
+        {
+            x.values[x.size] = values[i];
+            x.ids[x.size]    = ids[i];
+            ++x.size;
+        }
+    }
+    return x;
+}
 
-template <index_t Value, index_t Id, typename Compare>
-struct sequence_sort_impl<Sequence<Value>, Sequence<Id>, Compare>
+template <index_t... Is>
+__host__ __device__ constexpr bool is_valid_sequence_map_values(Sequence<Is...>)
 {
-    using sorted_values = Sequence<Value>;
-    using sorted_ids    = Sequence<Id>;
-};
+    constexpr index_t n      = sizeof...(Is);
+    const index_t x2y[n + 1] = {Is..., 0};
 
-template <typename Compare>
-struct sequence_sort_impl<Sequence<>, Sequence<>, Compare>
+    bool found[n + 1] = {};
+    for(index_t x = 0; x < n; ++x)
+    {
+        if(x2y[x] < 0 || x2y[x] >= n || found[x2y[x]])
+            return false;
+        found[x2y[x]] = true;
+    }
+    return true;
+}
+
+template <index_t... Is>
+__host__ __device__ constexpr auto sequence_map_inverse_values(Sequence<Is...>)
 {
-    using sorted_values = Sequence<>;
-    using sorted_ids    = Sequence<>;
+    constexpr index_t n      = sizeof...(Is);
+    const index_t x2y[n + 1] = {Is..., 0};
+
+    sequence_values<n> y2x{};
+    for(index_t x = 0; x < n; ++x)
+        y2x[x2y[x]] = x;
+    return y2x;
+}
+} // namespace detail
+
+template <typename Values, typename Ids, typename Compare>
+struct sequence_sort_impl
+{
+    static constexpr index_t nsize = Values::Size();
+
+    static constexpr auto sorted = detail::sequence_sort_values<Compare>(Values{}, Ids{});
+
+    template <index_t... Is>
+    static Sequence<sorted.values[Is]...> generate_values(Sequence<Is...>);
+
+    template <index_t... Is>
+    static Sequence<sorted.ids[Is]...> generate_ids(Sequence<Is...>);
+
+    using sorted_values = decltype(generate_values(make_index_sequence<nsize>{}));
+    using sorted_ids    = decltype(generate_ids(make_index_sequence<nsize>{}));
 };
 
 template <typename Values, typename Compare>
@@ -510,108 +508,41 @@ struct sequence_sort
 template <typename Values, typename Less, typename Equal>
 struct sequence_unique_sort
 {
-    template <typename RemainValues,
-              typename RemainIds,
-              typename UniquifiedValues,
-              typename UniquifiedIds,
-              typename Eq>
-    struct sorted_sequence_uniquify_impl
-    {
-        static constexpr index_t current_value = RemainValues::Front();
-        static constexpr index_t current_id    = RemainIds::Front();
-
-        static constexpr bool is_unique_value = (current_value != UniquifiedValues::Back());
-
-        using new_remain_values = decltype(RemainValues::PopFront());
-        using new_remain_ids    = decltype(RemainIds::PopFront());
-
-        using new_uniquified_values =
-            typename conditional<is_unique_value,
-                                 decltype(UniquifiedValues::PushBack(Number<current_value>{})),
-                                 UniquifiedValues>::type;
-
-        using new_uniquified_ids =
-            typename conditional<is_unique_value,
-                                 decltype(UniquifiedIds::PushBack(Number<current_id>{})),
-                                 UniquifiedIds>::type;
-
-        using uniquify = sorted_sequence_uniquify_impl<new_remain_values,
-                                                       new_remain_ids,
-                                                       new_uniquified_values,
-                                                       new_uniquified_ids,
-                                                       Eq>;
-
-        // this is output
-        using uniquified_values = typename uniquify::uniquified_values;
-        using uniquified_ids    = typename uniquify::uniquified_ids;
-    };
-
-    template <typename UniquifiedValues, typename UniquifiedIds, typename Eq>
-    struct sorted_sequence_uniquify_impl<Sequence<>,
-                                         Sequence<>,
-                                         UniquifiedValues,
-                                         UniquifiedIds,
-                                         Eq>
-    {
-        using uniquified_values = UniquifiedValues;
-        using uniquified_ids    = UniquifiedIds;
-    };
-
-    template <typename SortedValues, typename SortedIds, typename Eq>
-    struct sorted_sequence_uniquify
-    {
-        using uniquify = sorted_sequence_uniquify_impl<decltype(SortedValues::PopFront()),
-                                                       decltype(SortedIds::PopFront()),
-                                                       Sequence<SortedValues::Front()>,
-                                                       Sequence<SortedIds::Front()>,
-                                                       Eq>;
-
-        using uniquified_values = typename uniquify::uniquified_values;
-        using uniquified_ids    = typename uniquify::uniquified_ids;
-    };
-
     using sort          = sequence_sort<Values, Less>;
     using sorted_values = typename sort::type;
     using sorted_ids    = typename sort::sorted2unsorted_map;
 
-    using uniquify = sorted_sequence_uniquify<sorted_values, sorted_ids, Equal>;
+    static constexpr auto uniquified =
+        detail::sequence_uniquify_values<Equal>(sorted_values{}, sorted_ids{});
+
+    template <index_t... Is>
+    static Sequence<uniquified.values[Is]...> generate_values(Sequence<Is...>);
+
+    template <index_t... Is>
+    static Sequence<uniquified.ids[Is]...> generate_ids(Sequence<Is...>);
+
+    using unique_ids = make_index_sequence<uniquified.size>;
 
     // this is output
-    using type                = typename uniquify::uniquified_values;
-    using sorted2unsorted_map = typename uniquify::uniquified_ids;
+    using type                = decltype(generate_values(unique_ids{}));
+    using sorted2unsorted_map = decltype(generate_ids(unique_ids{}));
 };
 
 template <typename SeqMap>
-struct is_valid_sequence_map : is_same<typename arithmetic_sequence_gen<0, SeqMap::Size(), 1>::type,
-                                       typename sequence_sort<SeqMap, math::less<index_t>>::type>
+struct is_valid_sequence_map
+    : integral_constant<bool, detail::is_valid_sequence_map_values(SeqMap{})>
 {
 };
 
 template <typename SeqMap>
 struct sequence_map_inverse
 {
-    template <typename X2Y, typename WorkingY2X, index_t XBegin, index_t XRemain>
-    struct sequence_map_inverse_impl
-    {
-        static constexpr auto new_y2x =
-            WorkingY2X::Modify(X2Y::At(Number<XBegin>{}), Number<XBegin>{});
+    static constexpr auto y2x = detail::sequence_map_inverse_values(SeqMap{});
 
-        using type =
-            typename sequence_map_inverse_impl<X2Y, decltype(new_y2x), XBegin + 1, XRemain - 1>::
-                type;
-    };
+    template <index_t... Is>
+    static Sequence<y2x[Is]...> generate(Sequence<Is...>);
 
-    template <typename X2Y, typename WorkingY2X, index_t XBegin>
-    struct sequence_map_inverse_impl<X2Y, WorkingY2X, XBegin, 0>
-    {
-        using type = WorkingY2X;
-    };
-
-    using type =
-        typename sequence_map_inverse_impl<SeqMap,
-                                           typename uniform_sequence_gen<SeqMap::Size(), 0>::type,
-                                           0,
-                                           SeqMap::Size()>::type;
+    using type = decltype(generate(make_index_sequence<SeqMap::Size()>{}));
 };
 
 template <index_t... Xs, index_t... Ys>
@@ -730,8 +661,16 @@ template <typename Seq>
 __host__ __device__ constexpr auto sequence_pop_back(Seq)
 {
     static_assert(Seq::Size() > 0, "wrong! cannot pop an empty Sequence!");
-    return sequence_pop_front(Seq::Reverse()).Reverse();
+    return Seq::Extract(make_index_sequence<Seq::Size() - 1>{});
+}
+
+namespace detail {
+template <index_t I, index_t X, index_t... Is, index_t... Ids>
+__host__ __device__ constexpr auto sequence_modify(Sequence<Is...>, Sequence<Ids...>)
+{
+    return Sequence<(Ids == I ? X : Is)...>{};
 }
+} // namespace detail
 
 template <typename... Seqs>
 __host__ __device__ constexpr auto merge_sequences(Seqs...)
@@ -789,27 +728,30 @@ __host__ __device__ constexpr auto pick_sequence_elements_by_ids(Seq, Sequence<I
     return Sequence<Seq::At(Number<Is>{})...>{};
 }
 
-#if 1
 namespace detail {
-template <typename WorkSeq, typename RemainSeq, typename RemainMask>
-struct pick_sequence_elements_by_mask_impl
+// positions of the non-zero elements of the mask
+template <index_t... Ms>
+__host__ __device__ constexpr auto sequence_mask_ids(Sequence<Ms...>)
 {
-    using new_work_seq = typename conditional<RemainMask::Front(),
-                                              decltype(WorkSeq::PushBack(RemainSeq::Front())),
-                                              WorkSeq>::type;
+    constexpr index_t n       = sizeof...(Ms);
+    const index_t mask[n + 1] = {Ms..., 0};
 
-    using type =
-        typename pick_sequence_elements_by_mask_impl<new_work_seq,
-                                                     decltype(RemainSeq::PopFront()),
-                                                     decltype(RemainMask::PopFront())>::type;
-};
+    sequence_values_and_ids<n> x{};
+    x.size = 0;
+    for(index_t i = 0; i < n; ++i)
+    {
+        if(mask[i])
+            x.ids[x.size++] = i;
+    }
+    return x;
+}
 
-template <typename WorkSeq>
-struct pick_sequence_elements_by_mask_impl<WorkSeq, Sequence<>, Sequence<>>
+template <typename Seq, typename Mask, index_t... Is>
+__host__ __device__ constexpr auto pick_sequence_elements_by_mask_impl(Sequence<Is...>)
 {
-    using type = WorkSeq;
-};
-
+    [[maybe_unused]] constexpr auto picked = sequence_mask_ids(Mask{});
+    return Sequence<Seq::At(picked.ids[Is])...>{};
+}
 } // namespace detail
 
 template <typename Seq, typename Mask>
@@ -817,26 +759,31 @@ __host__ __device__ constexpr auto pick_sequence_elements_by_mask(Seq, Mask)
 {
     static_assert(Seq::Size() == Mask::Size(), "wrong!");
 
-    return typename detail::pick_sequence_elements_by_mask_impl<Sequence<>, Seq, Mask>::type{};
+    return detail::pick_sequence_elements_by_mask_impl<Seq, Mask>(
+        make_index_sequence<detail::sequence_mask_ids(Mask{}).size>{});
 }
 
 namespace detail {
-template <typename WorkSeq, typename RemainValues, typename RemainIds>
-struct modify_sequence_elements_by_ids_impl
+// later ids overwrite earlier ones
+template <index_t... Xs, index_t... Vs, index_t... Ids>
+__host__ __device__ constexpr auto
+sequence_modify_values(Sequence<Xs...>, Sequence<Vs...>, Sequence<Ids...>)
 {
-    using new_work_seq = decltype(WorkSeq::Modify(RemainIds::Front(), RemainValues::Front()));
+    const index_t values[sizeof...(Vs) + 1] = {Vs..., 0};
+    const index_t ids[sizeof...(Ids) + 1]   = {Ids..., 0};
 
-    using type =
-        typename modify_sequence_elements_by_ids_impl<new_work_seq,
-                                                      decltype(RemainValues::PopFront()),
-                                                      decltype(RemainIds::PopFront())>::type;
-};
+    sequence_values<sizeof...(Xs)> x{{Xs...}};
+    for(index_t i = 0; i < index_t{sizeof...(Ids)}; ++i)
+        x[ids[i]] = values[i];
+    return x;
+}
 
-template <typename WorkSeq>
-struct modify_sequence_elements_by_ids_impl<WorkSeq, Sequence<>, Sequence<>>
+template <typename Seq, typename Values, typename Ids, index_t... Is>
+__host__ __device__ constexpr auto modify_sequence_elements_by_ids_impl(Sequence<Is...>)
 {
-    using type = WorkSeq;
-};
+    [[maybe_unused]] constexpr auto modified = sequence_modify_values(Seq{}, Values{}, Ids{});
+    return Sequence<modified[Is]...>{};
+}
 } // namespace detail
 
 template <typename Seq, typename Values, typename Ids>
@@ -844,9 +791,9 @@ __host__ __device__ constexpr auto modify_sequence_elements_by_ids(Seq, Values,
 {
     static_assert(Values::Size() == Ids::Size() && Seq::Size() >= Values::Size(), "wrong!");
 
-    return typename detail::modify_sequence_elements_by_ids_impl<Seq, Values, Ids>::type{};
+    return detail::modify_sequence_elements_by_ids_impl<Seq, Values, Ids>(
+        make_index_sequence<Seq::Size()>{});
 }
-#endif
 
 template <typename Seq, typename Reduce, index_t Init>
 __host__ __device__ constexpr index_t
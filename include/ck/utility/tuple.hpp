@@ -97,6 +97,22 @@ struct TupleImpl<Sequence<Is...>, Xs...> : TupleElementKeyData<TupleElementKey<I
 
     __host__ __device__ static constexpr index_t Size() { return sizeof...(Xs); }
 
+#if __has_builtin(__type_pack_element)
+    // name the base of element I directly, instead of deducing it from all the bases
+    template <index_t I>
+    __host__ __device__ constexpr const auto& GetElementDataByKey(TupleElementKey<I>) const
+    {
+        return get_tuple_element_data_reference<TupleElementKey<I>,
+                                                __type_pack_element<I, Xs...>>(*this);
+    }
+
+    template <index_t I>
+    __host__ __device__ constexpr auto& GetElementDataByKey(TupleElementKey<I>)
+    {
+        return get_tuple_element_data_reference<TupleElementKey<I>,
+                                                __type_pack_element<I, Xs...>>(*this);
+    }
+#else
     template <index_t I>
     __host__ __device__ constexpr const auto& GetElementDataByKey(TupleElementKey<I>) const
     {
@@ -108,15 +124,15 @@ struct TupleImpl<Sequence<Is...>, Xs...> : TupleElementKeyData<TupleElementKey<I
     {
         return get_tuple_element_data_reference<TupleElementKey<I>>(*this);
     }
+#endif
 };
 
 } // namespace detail
 
 template <typename... Xs>
-struct Tuple : detail::TupleImpl<typename arithmetic_sequence_gen<0, sizeof...(Xs), 1>::type, Xs...>
+struct Tuple : detail::TupleImpl<make_index_sequence<sizeof...(Xs)>, Xs...>
 {
-    using base =
-        detail::TupleImpl<typename arithmetic_sequence_gen<0, sizeof...(Xs), 1>::type, Xs...>;
+    using base = detail::TupleImpl<make_index_sequence<sizeof...(Xs)>, Xs...>;
 
     __host__ __device__ constexpr Tuple() = default;
 
@@ -204,6 +220,14 @@ struct tuple_element
     using type = decltype(detail::get_tuple_element_data<detail::TupleElementKey<I>>(TTuple{}));
 };
 
+#if __has_builtin(__type_pack_element)
+template <index_t I, typename... Xs>
+struct tuple_element<I, Tuple<Xs...>>
+{
+    using type = __type_pack_element<I, Xs...>;
+};
+#endif
+
 template <index_t I, typename TTuple>
 using tuple_element_t = typename tuple_element<I, TTuple>::type;
 
@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+
+#include "ck/wrapper/layout.hpp"
+#include "ck/utility/magic_division.hpp"
+
+// Disable from doxygen docs generation
+/// @cond INTERNAL
+namespace ck {
+namespace wrapper {
+/// @endcond
+
+/**
+ * \brief Host evaluation of a layout with runtime shape.
+ *
+ * Flattens the unrolled shape and strides of a Layout into arrays and
+ * precomputes the magic numbers of every length, so the offset of an index
+ * costs one multiply-shift per merged dimension instead of walking the
+ * merge transforms of the descriptors. The offsets are the same as the ones
+ * of Layout::operator(), including for the last (slowest) dimension of a
+ * merge that is not wrapped around.
+ *
+ * \note The unrolled descriptor has to be linear in its indices, which is the
+ *       case for the layouts of make_layout, pad, unmerge and get.
+ *
+ * \tparam Shape Tuple of Number<> or index_t (possibly nested), as for Layout.
+ */
+template <typename Shape>
+struct HostLayout
+{
+    static constexpr index_t NumDims = decltype(UnrollNestedTuple(Shape{}))::Size();
+
+    // Disable from doxygen docs generation
+    /// @cond INTERNAL
+    private:
+    static constexpr auto I0 = Number<0>{};
+
+    template <typename ShapeElem>
+    static constexpr index_t GetNumUnrolledDims()
+    {
+        if constexpr(is_detected<is_tuple, ShapeElem>::value)
+        {
+            return decltype(UnrollNestedTuple(ShapeElem{}))::Size();
+        }
+        else
+        {
+            return 1;
+        }
+    }
+
+    /**
+     * \brief Offset of an index merged over the unrolled dims [begin, end)
+     * (column-major, begin is the fastest dim).
+     *
+     * \tparam Begin First unrolled dim.
+     * \tparam End End of unrolled dims.
+     * \param idx Merged index, non-negative.
+     * \return Offset without the base offset.
+     */
+    template <index_t Begin, index_t End>
+    __host__ constexpr index_t CalculateMergedOffset(index_t idx) const
+    {
+        index_t offset = 0;
+        static_for<Begin, End - 1, 1>{}([&](auto d) {
+            const index_t quotient =
+                MagicDivision::DoMagicDivision(idx, multipliers_[d], shifts_[d]);
+            offset += (idx - quotient * lengths_[d]) * strides_[d];
+            idx = quotient;
+        });
+        return offset + idx * strides_[End - 1];
+    }
+
+    /**
+     * \brief Offset of a (nested) index aligned to a shape element.
+     *
+     * \tparam ShapeElem Shape element the index is aligned to.
+     * \tparam Dim First unrolled dim of the shape element.
+     * \param idx Index, a scalar is merged over all the dims of the shape element.
+     * \return Offset without the base offset.
+     */
+    template <typename ShapeElem, index_t Dim, typename IdxElem>
+    __host__ constexpr index_t CalculateNestedOffset(const IdxElem& idx) const
+    {
+        if constexpr(is_detected<is_tuple, IdxElem>::value)
+        {
+            static_assert(is_detected<is_tuple, ShapeElem>::value &&
+                              ShapeElem::Size() == IdxElem::Size(),
+                          "Wrong Idx for layout()");
+            index_t offset = 0;
+            static_for<0, IdxElem::Size(), 1>{}([&](auto i) {
+                // Unrolled dims of the shape elements before i
+                constexpr index_t dim =
+                    Dim + decltype(UnrollNestedTuple(TupleSlice<0, i>(ShapeElem{})))::Size();
+                offset += CalculateNestedOffset<tuple_element_t<i, ShapeElem>, dim>(idx.At(i));
+            });
+            return offset;
+        }
+        else
+        {
+            return CalculateMergedOffset<Dim, Dim + GetNumUnrolledDims<ShapeElem>()>(
+                static_cast<index_t>(idx));
+        }
+    }
+    /// @endcond
+
+    public:
+    /**
+     * \brief Host layout constructor.
+     *
+     * \param layout Layout to evaluate.
+     */
+    template <typename UnrolledDescriptorType>
+    __host__ constexpr explicit HostLayout(const Layout<Shape, UnrolledDescriptorType>& layout)
+    {
+        const auto unrolled_shape = UnrollNestedTuple(layout.GetShape());
+        const auto& desc          = layout.GetUnrolledDescriptor();
+
+        auto idx     = make_zero_multi_index<NumDims>();
+        base_offset_ = desc.CalculateOffset(idx);
+        static_for<0, NumDims, 1>{}([&](auto i) {
+            lengths_[i]      = static_cast<index_t>(unrolled_shape.At(i));
+            const auto magic = MagicDivision::CalculateMagicNumbers(uint32_t(lengths_[i]));
+            multipliers_[i]  = magic[Number<0>{}];
+            shifts_[i]       = magic[Number<1>{}];
+            // Strides of the linear descriptor
+            idx(i)      = 1;
+            strides_[i] = desc.CalculateOffset(idx) - base_offset_;
+            idx(i)      = 0;
+        });
+    }
+
+    /**
+     * \brief Returns offset to element, with the same index forms as
+     * Layout::operator() (1d, merged nests or nested).
+     *
+     * \param idx Tuple of indexes.
+     * \return Calculated offset.
+     */
+    template <typename... Ts>
+    __host__ constexpr index_t operator()(const Tuple<Ts...>& idx) const
+    {
+        if constexpr(!IsNestedTuple(Tuple<Ts...>{}) && Tuple<Ts...>::Size() == 1)
+        {
+            // 1d access
+            const index_t idx_1d = static_cast<index_t>(idx.At(I0));
+            return base_offset_ + CalculateMergedOffset<0, NumDims>(idx_1d);
+        }
+        else
+        {
+            static_assert(Shape::Size() == Tuple<Ts...>::Size(),
+                          "Idx rank and Shape rank must be the same (except 1d).");
+            return base_offset_ + CalculateNestedOffset<Shape, 0>(idx);
+        }
+    }
+
+    /**
+     * \brief Batched offsets of consecutive 1d indexes. The unrolled index is
+     * incremented with carries, without any division after the first index.
+     *
+     * \param begin First 1d index.
+     * \param num Number of indexes.
+     * \param offsets Output, num offsets.
+     */
+    __host__ void CalculateOffsets(index_t begin, index_t num, index_t* offsets) const
+    {
+        if(num <= 0)
+        {
+            return;
+        }
+        std::array<index_t, NumDims> coord{};
+        index_t idx = begin;
+        for(index_t d = 0; d < NumDims - 1; d++)
+        {
+            const index_t quotient =
+                MagicDivision::DoMagicDivision(idx, multipliers_[d], shifts_[d]);
+            coord[d] = idx - quotient * lengths_[d];
+            idx      = quotient;
+        }
+        coord[NumDims - 1] = idx;
+
+        index_t offset = base_offset_ + CalculateMergedOffset<0, NumDims>(begin);
+        for(index_t i = 0; i < num; i++)
+        {
+            offsets[i] = offset;
+            // The last dim is not wrapped around, as in the merge transform
+            index_t d = 0;
+            for(; d < NumDims - 1 && coord[d] == lengths_[d] - 1; d++)
+            {
+                coord[d] = 0;
+                offset -= (lengths_[d] - 1) * strides_[d];
+            }
+            coord[d]++;
+            offset += strides_[d];
+        }
+    }
+
+    /**
+     * \brief Batched offsets of any index form accepted by operator().
+     *
+     * \param idxs Input, num indexes.
+     * \param num Number of indexes.
+     * \param offsets Output, num offsets.
+     */
+    template <typename Idx>
+    __host__ void CalculateOffsets(const Idx* idxs, index_t num, index_t* offsets) const
+    {
+        for(index_t i = 0; i < num; i++)
+        {
+            offsets[i] = (*this)(idxs[i]);
+        }
+    }
+
+    /**
+     * \brief Unrolled lengths getter.
+     *
+     * \return Lengths of the unrolled dims.
+     */
+    __host__ constexpr const std::array<index_t, NumDims>& GetLengths() const { return lengths_; }
+
+    /**
+     * \brief Unrolled strides getter.
+     *
+     * \return Strides of the unrolled dims.
+     */
+    __host__ constexpr const std::array<index_t, NumDims>& GetStrides() const { return strides_; }
+
+    // Disable from doxygen docs generation
+    /// @cond INTERNAL
+    private:
+    // Example, shape: ((2, 2), 2), strides: ((1, 2), 4)
+    // lengths_: (2, 2, 2), strides_: (1, 2, 4)
+    std::array<index_t, NumDims> lengths_{};
+    std::array<index_t, NumDims> strides_{};
+    // Magic numbers of lengths_
+    std::array<uint32_t, NumDims> multipliers_{};
+    std::array<uint32_t, NumDims> shifts_{};
+    // Offset of the zero index
+    index_t base_offset_ = 0;
+    /// @endcond
+};
+
+/**
+ * \brief Make host layout function.
+ *
+ * \param layout Layout to evaluate on the host.
+ * \return Constructed host layout.
+ */
+template <typename Shape, typename UnrolledDescriptorType>
+__host__ constexpr auto make_host_layout(const Layout<Shape, UnrolledDescriptorType>& layout)
+{
+    return HostLayout<Shape>(layout);
+}
+
+} // namespace wrapper
+} // namespace ck
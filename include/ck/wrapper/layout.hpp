@@ -271,7 +271,7 @@ struct Layout
                   const Tuple<IdxDims...>& idxs,
                   const UnrolledDescriptorType& naive_descriptor)
     {
-        if constexpr(Tuple<IdxDims...>::Size() == I1)
+        if constexpr(!IsNestedTuple(Tuple<IdxDims...>{}) && Tuple<IdxDims...>::Size() == I1)
         {
             // 1d idx path
             return MakeMerge1d(shape, naive_descriptor);
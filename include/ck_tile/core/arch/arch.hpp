@@ -29,6 +29,46 @@ enum struct memory_operation_enum
     add
 };
 
+#if CK_TILE_HOST_EMULATION
+// defined in ck_tile/core/arch/host_emulation.hpp
+namespace host_emulation {
+CK_TILE_HOST index_t get_thread_id();
+CK_TILE_HOST index_t get_block_id();
+CK_TILE_HOST index_t get_block_size();
+CK_TILE_HOST index_t get_grid_size();
+CK_TILE_HOST void block_barrier();
+} // namespace host_emulation
+
+CK_TILE_HOST_DEVICE constexpr index_t get_warp_size() { return 64; }
+
+CK_TILE_DEVICE index_t get_grid_size() { return host_emulation::get_grid_size(); }
+
+CK_TILE_DEVICE index_t get_block_size() { return host_emulation::get_block_size(); }
+
+CK_TILE_DEVICE index_t get_thread_local_1d_id() { return host_emulation::get_thread_id(); }
+
+CK_TILE_DEVICE index_t get_thread_global_1d_id()
+{
+    return host_emulation::get_block_id() * host_emulation::get_block_size() +
+           host_emulation::get_thread_id();
+}
+
+CK_TILE_DEVICE index_t get_block_1d_id() { return host_emulation::get_block_id(); }
+
+CK_TILE_DEVICE index_t get_lane_id() { return host_emulation::get_thread_id() % get_warp_size(); }
+
+CK_TILE_DEVICE index_t get_warp_id() { return host_emulation::get_thread_id() / get_warp_size(); }
+
+CK_TILE_DEVICE index_t get_thread_id() { return host_emulation::get_thread_id(); }
+
+CK_TILE_DEVICE index_t get_block_id() { return host_emulation::get_block_id(); }
+
+CK_TILE_DEVICE void block_sync_lds() { host_emulation::block_barrier(); }
+
+CK_TILE_DEVICE void block_sync_lds_direct_load() { host_emulation::block_barrier(); }
+
+CK_TILE_DEVICE void s_nop() {}
+#else
 CK_TILE_HOST_DEVICE constexpr index_t get_warp_size()
 {
     // warpSize is defined by HIP
@@ -89,5 +129,8 @@ CK_TILE_DEVICE void s_nop()
     __builtin_amdgcn_sched_barrier(0);
 #endif
 }
+#endif
 
 } // namespace ck_tile
+
+#include "ck_tile/core/arch/host_emulation.hpp"
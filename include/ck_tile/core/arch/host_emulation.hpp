@@ -0,0 +1,393 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+// Host emulation of the device code of ck_tile, for functional tests of tile programs without GPU.
+//
+// With CK_TILE_HOST_EMULATION=1 (and a host only compilation, e.g. hipcc --cuda-host-only),
+// CK_TILE_DEVICE functions are also host functions and the device specific primitives fall back
+// on the host implementations below:
+//  - thread/block ids and block_sync_lds() come from the block being emulated
+//  - the LDS of a block is a host buffer, see get_lds()
+//  - buffer loads/stores are plain memory accesses (memcpy, so the host buffers need not be aligned
+//    to the vectors), with the out of bound behavior of the buffer instructions, and can be traced
+//    per thread
+//  - the cross lane operations (ds_bpermute, mfma) exchange the registers of a warp through host
+//    memory
+// The inline asm based paths (async loads, m0, raw buffer loads) are not emulated.
+//
+//   host_emulation::launch_config config;
+//   config.grid_size  = num_block;
+//   config.block_size = 256;
+//   host_emulation::launch_kernel(config, Kernel{}, kargs);
+
+#include "ck_tile/core/config.hpp"
+#include "ck_tile/core/numeric/integer.hpp"
+#include "ck_tile/core/arch/arch.hpp"
+
+#if CK_TILE_HOST_EMULATION
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <ucontext.h>
+
+namespace ck_tile {
+namespace host_emulation {
+
+// how the threads of a block are run, the blocks of a grid are always run one after the other
+enum struct schedule_enum
+{
+    // one host thread per emulated thread, a thread that throws while the others wait on a
+    // barrier hangs the launch
+    threads,
+    // the emulated threads take turns on the calling host thread and switch at the barriers, the
+    // order of the accesses is deterministic and the barriers that can not complete are reported
+    sequential,
+};
+
+struct launch_config
+{
+    index_t grid_size  = 1;
+    index_t block_size = 64;
+    // LDS of a block
+    index_t lds_byte       = 64 * 1024;
+    schedule_enum schedule = schedule_enum::threads;
+    bool trace             = false;
+    // stack of an emulated thread, sequential schedule only
+    std::size_t stack_byte = 1024 * 1024;
+};
+
+// a global or LDS access of buffer_view
+struct access_record
+{
+    index_t block_id;
+    index_t thread_id;
+    address_space_enum address_space;
+    // byte offset in the LDS of the block, host address for the global memory
+    long_index_t address;
+    index_t byte;
+    bool is_store;
+};
+
+struct barrier
+{
+    index_t count      = 0;
+    index_t arrived    = 0;
+    index_t generation = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+// registers of a warp exchanged by the cross lane operations, per lane
+static constexpr index_t max_exchange_byte_per_lane = 256;
+
+struct block_state
+{
+    const launch_config* config = nullptr;
+    index_t block_id            = 0;
+    std::vector<char> lds;
+    barrier block_barrier;
+    std::unique_ptr<barrier[]> warp_barriers;
+    std::vector<char> warp_exchange;
+    std::mutex trace_mutex;
+    std::vector<access_record>* trace = nullptr;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    // sequential schedule: the fibers of the threads, and the number of arrivals at the barriers
+    // and of finished threads, to detect the barriers that can not complete
+    void* p_body = nullptr;
+    std::vector<ucontext_t> contexts;
+    std::vector<std::unique_ptr<char[]>> stacks;
+    std::vector<bool> finished;
+    ucontext_t scheduler;
+    index_t progress = 0;
+};
+
+struct thread_state
+{
+    block_state* block = nullptr;
+    index_t thread_id  = 0;
+};
+
+CK_TILE_HOST thread_state& get_thread_state()
+{
+    static thread_local thread_state state;
+    return state;
+}
+
+CK_TILE_HOST block_state& get_block()
+{
+    auto* block = get_thread_state().block;
+    if(block == nullptr)
+    {
+        throw std::runtime_error("device code called outside of host_emulation::launch_kernel");
+    }
+    return *block;
+}
+
+CK_TILE_HOST index_t get_thread_id() { return get_thread_state().thread_id; }
+
+CK_TILE_HOST index_t get_block_id() { return get_block().block_id; }
+
+CK_TILE_HOST index_t get_block_size() { return get_block().config->block_size; }
+
+CK_TILE_HOST index_t get_grid_size() { return get_block().config->grid_size; }
+
+// LDS of the block of the calling thread
+CK_TILE_HOST void* get_lds() { return get_block().lds.data(); }
+
+CK_TILE_HOST void arrive_and_wait(barrier& b)
+{
+    auto& block = get_block();
+    if(block.config->schedule == schedule_enum::threads)
+    {
+        std::unique_lock<std::mutex> lock(b.mutex);
+        const index_t generation = b.generation;
+        if(++b.arrived == b.count)
+        {
+            b.arrived = 0;
+            b.generation++;
+            b.cv.notify_all();
+        }
+        else
+        {
+            b.cv.wait(lock, [&] { return b.generation != generation; });
+        }
+    }
+    else
+    {
+        const index_t generation = b.generation;
+        block.progress++;
+        if(++b.arrived == b.count)
+        {
+            b.arrived = 0;
+            b.generation++;
+        }
+        // switch to the other threads until the last one arrives
+        while(b.generation == generation)
+        {
+            const index_t tid = get_thread_id();
+            swapcontext(&block.contexts[tid], &block.scheduler);
+        }
+    }
+}
+
+CK_TILE_HOST void block_barrier() { arrive_and_wait(get_block().block_barrier); }
+
+CK_TILE_HOST void warp_barrier()
+{
+    arrive_and_wait(get_block().warp_barriers[get_thread_id() / get_warp_size()]);
+}
+
+// gathers v of every lane of the warp of the calling thread into p_all[warp size], a collective
+// operation of the warp
+template <typename T>
+CK_TILE_HOST void warp_all_gather(const T& v, T* p_all)
+{
+    static_assert(sizeof(T) <= max_exchange_byte_per_lane, "wrong! too large for an exchange");
+
+    auto& block        = get_block();
+    const index_t warp = get_thread_id() / get_warp_size();
+    const index_t lane = get_thread_id() % get_warp_size();
+    char* p_scratch =
+        block.warp_exchange.data() + warp * get_warp_size() * max_exchange_byte_per_lane;
+
+    std::memcpy(p_scratch + lane * max_exchange_byte_per_lane, &v, sizeof(T));
+    warp_barrier();
+    for(index_t i = 0; i < get_warp_size(); ++i)
+    {
+        std::memcpy(&p_all[i], p_scratch + i * max_exchange_byte_per_lane, sizeof(T));
+    }
+    // the scratch can be overwritten once every lane has read it
+    warp_barrier();
+}
+
+// value of v in lane src_lane (modulo the warp size), as ds_bpermute
+template <typename T>
+CK_TILE_HOST T warp_permute(const T& v, index_t src_lane)
+{
+    T all[get_warp_size()];
+    warp_all_gather(v, all);
+    return all[src_lane % get_warp_size()];
+}
+
+// serializes the read-modify-write of the atomics over every emulated thread
+template <typename F>
+CK_TILE_HOST void atomic(F f)
+{
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    f();
+}
+
+CK_TILE_HOST void
+trace_access(address_space_enum address_space, const void* p, index_t byte, bool is_store)
+{
+    auto& block = get_block();
+    if(block.trace == nullptr)
+    {
+        return;
+    }
+    long_index_t address = reinterpret_cast<long_index_t>(p);
+    if(address_space == address_space_enum::lds)
+    {
+        address -= reinterpret_cast<long_index_t>(block.lds.data());
+    }
+    std::lock_guard<std::mutex> lock(block.trace_mutex);
+    block.trace->push_back(
+        {block.block_id, get_thread_id(), address_space, address, byte, is_store});
+}
+
+// v_perm_b32: byte i of the result is byte selector[i] of {src0, src1} (src1 in the low bytes),
+// 0x00 for the selector 0x0c and 0xff for the other selectors from 8 (the sign replication
+// selectors 8-11 are not emulated)
+CK_TILE_HOST int32_t perm_b32(int32_t src0, int32_t src1, int32_t selector)
+{
+    const uint64_t src = (uint64_t(uint32_t(src0)) << 32) | uint32_t(src1);
+    uint32_t result    = 0;
+    for(index_t i = 0; i < 4; ++i)
+    {
+        const uint32_t sel = (uint32_t(selector) >> (8 * i)) & 0xff;
+        const uint32_t byte =
+            sel < 8 ? uint32_t(src >> (8 * sel)) & 0xff : (sel == 0x0c ? 0x00 : 0xff);
+        result |= byte << (8 * i);
+    }
+    return int32_t(result);
+}
+
+template <typename F>
+CK_TILE_HOST void run_thread(F& body)
+{
+    auto& block = get_block();
+    try
+    {
+        body();
+    }
+    catch(...)
+    {
+        std::lock_guard<std::mutex> lock(block.error_mutex);
+        block.error = std::current_exception();
+    }
+}
+
+template <typename F>
+CK_TILE_HOST void run_fiber()
+{
+    auto& block = get_block();
+    run_thread(*static_cast<F*>(block.p_body));
+    block.finished[get_thread_id()] = true;
+    block.progress++;
+}
+
+// runs body on every thread of the block
+template <typename F>
+CK_TILE_HOST void run_block(block_state& block, F& body)
+{
+    const launch_config& config = *block.config;
+    if(config.schedule == schedule_enum::threads)
+    {
+        std::vector<std::thread> threads;
+        for(index_t tid = 0; tid < config.block_size; ++tid)
+        {
+            threads.emplace_back([&, tid] {
+                get_thread_state() = {&block, tid};
+                run_thread(body);
+                get_thread_state() = {};
+            });
+        }
+        for(auto& t : threads)
+        {
+            t.join();
+        }
+        return;
+    }
+
+    block.p_body = &body;
+    block.contexts.resize(config.block_size);
+    block.stacks.resize(config.block_size);
+    block.finished.assign(config.block_size, false);
+    for(index_t tid = 0; tid < config.block_size; ++tid)
+    {
+        // not value initialized, only the pages used by the stack are touched
+        block.stacks[tid].reset(new char[config.stack_byte]);
+        auto& context = block.contexts[tid];
+        getcontext(&context);
+        context.uc_stack.ss_sp   = block.stacks[tid].get();
+        context.uc_stack.ss_size = config.stack_byte;
+        context.uc_link          = &block.scheduler;
+        makecontext(&context, &run_fiber<F>, 0);
+    }
+
+    // round robin until every thread is finished
+    index_t num_finished = 0;
+    while(num_finished < config.block_size && !block.error)
+    {
+        const index_t progress = block.progress;
+        num_finished           = 0;
+        for(index_t tid = 0; tid < config.block_size; ++tid)
+        {
+            if(!block.finished[tid])
+            {
+                get_thread_state() = {&block, tid};
+                swapcontext(&block.scheduler, &block.contexts[tid]);
+                get_thread_state() = {};
+            }
+            num_finished += block.finished[tid] ? 1 : 0;
+        }
+        if(num_finished < config.block_size && block.progress == progress)
+        {
+            throw std::runtime_error("host emulation: threads of block " +
+                                     std::to_string(block.block_id) +
+                                     " wait on a barrier that can not complete");
+        }
+    }
+}
+
+// runs kernel(args...) on every thread of the grid, returns the accesses of buffer_view if
+// config.trace
+template <typename Kernel, typename... Args>
+CK_TILE_HOST std::vector<access_record>
+launch_kernel(const launch_config& config, Kernel kernel, Args... args)
+{
+    std::vector<access_record> trace;
+    auto body = [&] { kernel(args...); };
+
+    const index_t num_warp = (config.block_size + get_warp_size() - 1) / get_warp_size();
+    for(index_t block_id = 0; block_id < config.grid_size; ++block_id)
+    {
+        block_state block;
+        block.config   = &config;
+        block.block_id = block_id;
+        block.lds.assign(config.lds_byte, 0);
+        block.block_barrier.count = config.block_size;
+        block.warp_barriers.reset(new barrier[num_warp]);
+        for(index_t warp = 0; warp < num_warp; ++warp)
+        {
+            const index_t num_lane = config.block_size - warp * get_warp_size();
+            block.warp_barriers[warp].count =
+                num_lane < get_warp_size() ? num_lane : get_warp_size();
+        }
+        block.warp_exchange.assign(num_warp * get_warp_size() * max_exchange_byte_per_lane, 0);
+        block.trace = config.trace ? &trace : nullptr;
+
+        run_block(block, body);
+        if(block.error)
+        {
+            std::rethrow_exception(block.error);
+        }
+    }
+    return trace;
+}
+
+} // namespace host_emulation
+} // namespace ck_tile
+#endif
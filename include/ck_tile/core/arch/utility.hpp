@@ -7,6 +7,7 @@
 // https://llvm.org/docs/AMDGPUUsage.html#address-space
 
 #include "ck_tile/core/config.hpp"
+#include "ck_tile/core/arch/host_emulation.hpp"
 #include "ck_tile/core/numeric/integer.hpp"
 #include "ck_tile/core/numeric/integral_constant.hpp"
 #include "ck_tile/core/utility/bit_cast.hpp"
@@ -32,6 +33,11 @@ CK_TILE_DEVICE T warp_shuffle_up(const T& v_local, uint32_t lane_delta)
 {
 #if 0
     return  __shfl_up(v_local, lane_delta);
+#elif CK_TILE_HOST_EMULATION
+    static_assert(sizeof(T) == sizeof(int32_t), "wrong!");
+
+    return host_emulation::warp_permute(
+        v_local, host_emulation::get_thread_id() + get_warp_size() - lane_delta);
 #elif 1
     static_assert(sizeof(T) == sizeof(int32_t), "wrong!");
 
@@ -49,6 +55,10 @@ CK_TILE_DEVICE T warp_shuffle_down(const T& v_local, uint32_t lane_delta)
 {
 #if 0
     return  __shfl_down(v_local, lane_delta);
+#elif CK_TILE_HOST_EMULATION
+    static_assert(sizeof(T) == sizeof(int32_t), "wrong!");
+
+    return host_emulation::warp_permute(v_local, host_emulation::get_thread_id() + lane_delta);
 #elif 1
     static_assert(sizeof(T) == sizeof(int32_t), "wrong!");
 
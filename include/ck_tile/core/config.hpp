@@ -8,9 +8,22 @@
 #include "hip/hip_fp16.h"
 #endif
 
+// host emulation of the device code, see ck_tile/core/arch/host_emulation.hpp
+#ifndef CK_TILE_HOST_EMULATION
+#define CK_TILE_HOST_EMULATION 0
+#endif
+
+#if CK_TILE_HOST_EMULATION && defined(__HIP_DEVICE_COMPILE__)
+#error "CK_TILE_HOST_EMULATION is for a host only compilation (--cuda-host-only)"
+#endif
+
 #ifdef __HIPCC__
 #define CK_TILE_HOST inline __host__
+#if CK_TILE_HOST_EMULATION
+#define CK_TILE_DEVICE inline __host__ __device__
+#else
 #define CK_TILE_DEVICE inline __device__
+#endif
 #define CK_TILE_HOST_DEVICE inline __host__ __device__
 #define CK_TILE_DEVICE_EXTERN __device__
 #else
@@ -90,6 +103,22 @@
 #define CK_TILE_EXPERIMENTAL_USE_BUFFER_ATOMIC_MAX_OOB_CHECK_OFFSET_TRICK 1
 #endif
 
+// the buffer instructions and the inline asm are not emulated, the generic paths are used instead.
+// these override a -D of the same macros, which can not be honored on the host
+#if CK_TILE_HOST_EMULATION
+#undef CK_TILE_USE_AMD_LDS_DIRECT_LOAD_INLINE_ASM
+#define CK_TILE_USE_AMD_LDS_DIRECT_LOAD_INLINE_ASM 0
+#undef CK_TILE_USE_AMD_BUFFER_LOAD
+#define CK_TILE_USE_AMD_BUFFER_LOAD 0
+#undef CK_TILE_USE_AMD_BUFFER_STORE
+#define CK_TILE_USE_AMD_BUFFER_STORE 0
+#undef CK_TILE_USE_AMD_BUFFER_ATOMIC_ADD_INTEGER
+#define CK_TILE_USE_AMD_BUFFER_ATOMIC_ADD_INTEGER 0
+// host buffers are only aligned to their element, a vector access can not be a vector deref
+#undef CK_TILE_EXPERIMENTAL_USE_MEMCPY_FOR_VECTOR_ACCESS
+#define CK_TILE_EXPERIMENTAL_USE_MEMCPY_FOR_VECTOR_ACCESS 1
+#endif
+
 #ifndef CK_TILE_USE_AMD_LDS_DIRECT_LOAD_INLINE_ASM
 #define CK_TILE_USE_AMD_LDS_DIRECT_LOAD_INLINE_ASM 1
 #endif
@@ -107,7 +136,9 @@
 #endif
 
 // buffer atomic add: floating point
-#ifndef __HIP_DEVICE_COMPILE__ // for host code
+#if CK_TILE_HOST_EMULATION
+#define CK_TILE_USE_AMD_BUFFER_ATOMIC_ADD_FLOAT 0
+#elif !defined(__HIP_DEVICE_COMPILE__) // for host code
 #define CK_TILE_USE_AMD_BUFFER_ATOMIC_ADD_FLOAT 1
 #elif defined(__gfx908__) || defined(__gfx90a__) || defined(__gfx940__) || defined(__gfx941__) || \
     defined(__gfx942__) // for GPU code
@@ -116,8 +147,8 @@
 #define CK_TILE_USE_AMD_BUFFER_ATOMIC_ADD_FLOAT 0
 #endif
 
-#if(defined(__gfx90a__) || defined(__gfx940__) || defined(__gfx941__) || \
-    defined(__gfx942__)) // for GPU code
+#if !CK_TILE_HOST_EMULATION && (defined(__gfx90a__) || defined(__gfx940__) || \
+                                 defined(__gfx941__) || defined(__gfx942__)) // for GPU code
 #define CK_TILE_USE_AMD_BUFFER_ATOMIC_MAX_FLOAT64 1
 #else
 #define CK_TILE_USE_AMD_BUFFER_ATOMIC_MAX_FLOAT64 0
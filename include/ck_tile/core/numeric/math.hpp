@@ -169,6 +169,8 @@ CK_TILE_HOST constexpr T max(T x, T y)
     return x > y ? x : y;
 }
 
+// the device twins are host functions as well in the host emulation
+#if !CK_TILE_HOST_EMULATION
 template <typename T>
 CK_TILE_DEVICE constexpr T max(T x, T y)
 {
@@ -186,6 +188,7 @@ CK_TILE_DEVICE constexpr double max(double x, double y)
 {
     return __builtin_fmax(x, y); // maybe still v_max3_f32
 }
+#endif
 
 template <index_t X>
 CK_TILE_HOST_DEVICE constexpr index_t max(number<X>, index_t y)
@@ -218,6 +221,7 @@ CK_TILE_HOST constexpr T min(T x, T y)
     return x < y ? x : y;
 }
 
+#if !CK_TILE_HOST_EMULATION
 template <typename T>
 CK_TILE_DEVICE constexpr T min(T x, T y)
 {
@@ -235,6 +239,7 @@ CK_TILE_DEVICE constexpr double min(double x, double y)
 {
     return __builtin_fmin(x, y);
 }
+#endif
 
 template <index_t X>
 CK_TILE_HOST_DEVICE constexpr index_t min(number<X>, index_t y)
@@ -262,7 +267,9 @@ CK_TILE_HOST_DEVICE constexpr T clamp(const T& x, const T& lowerbound, const T&
 }
 
 CK_TILE_HOST int clz(uint32_t x) { return __builtin_clz(x); }
+#if !CK_TILE_HOST_EMULATION
 CK_TILE_DEVICE int clz(uint32_t x) { return __clz(x); }
+#endif
 
 // greatest common divisor, aka highest common factor
 CK_TILE_HOST_DEVICE constexpr index_t gcd(index_t x, index_t y)
@@ -512,6 +519,7 @@ CK_TILE_HOST float sqrt(float x) { return std::sqrt(x); };
 
 CK_TILE_HOST double sqrt(double x) { return std::sqrt(x); };
 
+#if !CK_TILE_HOST_EMULATION
 CK_TILE_DEVICE
 float sqrt(float x) { return __builtin_amdgcn_sqrtf(x); };
 
@@ -520,18 +528,23 @@ double sqrt(double x) { return __builtin_amdgcn_sqrt(x); };
 
 CK_TILE_DEVICE
 float exp(float x) { return __expf(x); };
+#endif
 
 CK_TILE_HOST
 float exp(float x) { return std::expf(x); }
 
+#if !CK_TILE_HOST_EMULATION
 CK_TILE_DEVICE
 float exp2(float x) { return exp2f(x); };
+#endif
 
 CK_TILE_HOST
 float exp2(float x) { return std::exp2f(x); };
 
+#if !CK_TILE_HOST_EMULATION
 CK_TILE_DEVICE
 float log(float x) { return __logf(x); };
+#endif
 
 CK_TILE_HOST
 float log(float x) { return std::logf(x); };
@@ -12,6 +12,7 @@
 #include "ck_tile/core/numeric/float8.hpp"
 #include "ck_tile/core/numeric/half.hpp"
 #include "ck_tile/core/numeric/bfloat16.hpp"
+#include "ck_tile/core/numeric/type_convert.hpp"
 #include "ck_tile/core/utility/type_traits.hpp"
 
 namespace ck_tile {
@@ -303,6 +304,19 @@ struct buffer_view<address_space_enum::global,
         }
         else
         {
+#if CK_TILE_HOST_EMULATION
+            // the buffer loads return zero out of the buffer
+            constexpr index_t t_per_x = scalar_per_x_vector / scalar_per_t_vector;
+
+            if(is_valid_element && !(i >= 0 && i + t_per_x <= buffer_size_))
+            {
+                return X{numeric<remove_cvref_t<T>>::zero()};
+            }
+            if(is_valid_element)
+            {
+                host_emulation::trace_access(get_address_space(), &p_data_[i], sizeof(X), false);
+            }
+#endif
             if(is_valid_element)
             {
 #if CK_TILE_EXPERIMENTAL_USE_MEMCPY_FOR_VECTOR_ACCESS
@@ -346,10 +360,14 @@ struct buffer_view<address_space_enum::global,
         static_assert(scalar_per_x_vector % scalar_per_t_vector == 0,
                       "wrong! X should contain multiple T");
 
+#if CK_TILE_HOST_EMULATION
+        dst = get<X, oob_conditional_check>(i, is_valid_element);
+#else
         constexpr index_t t_per_x = scalar_per_x_vector / scalar_per_t_vector;
 
         amd_buffer_load_raw<remove_cvref_t<T>, t_per_x, Coherence, oob_conditional_check>(
             dst, p_data_, i, buffer_size_, is_valid_element);
+#endif
     }
 
     // i is offset of T, not X. i should be aligned to X
@@ -437,6 +455,16 @@ struct buffer_view<address_space_enum::global,
         }
         else
         {
+#if CK_TILE_HOST_EMULATION
+            // the buffer stores are dropped out of the buffer
+            constexpr index_t t_per_x = scalar_per_x_vector / scalar_per_t_vector;
+
+            is_valid_element = is_valid_element && i >= 0 && i + t_per_x <= buffer_size_;
+            if(is_valid_element)
+            {
+                host_emulation::trace_access(get_address_space(), &p_data_[i], sizeof(X), true);
+            }
+#endif
             if(is_valid_element)
             {
 #if CK_TILE_EXPERIMENTAL_USE_MEMCPY_FOR_VECTOR_ACCESS
@@ -467,9 +495,13 @@ struct buffer_view<address_space_enum::global,
         static_assert(scalar_per_x_vector % scalar_per_t_vector == 0,
                       "wrong! X should contain multiple T");
 
+#if CK_TILE_HOST_EMULATION
+        set<X, oob_conditional_check>(i, is_valid_element, x);
+#else
         constexpr index_t t_per_x = scalar_per_x_vector / scalar_per_t_vector;
         amd_buffer_store_raw<remove_cvref_t<T>, t_per_x, Coherence, oob_conditional_check>(
             x, p_data_, i, is_valid_element, buffer_size_);
+#endif
     }
 
     template <typename X,
@@ -518,7 +550,11 @@ struct buffer_view<address_space_enum::global,
         {
             if(is_valid_element)
             {
+#if CK_TILE_HOST_EMULATION
+                host_emulation_atomic<X>(i, x, [](auto a, auto b) { return a + b; });
+#else
                 atomic_add<X>(c_style_pointer_cast<X*>(&p_data_[i]), x);
+#endif
             }
         }
     }
@@ -556,10 +592,51 @@ struct buffer_view<address_space_enum::global,
         }
         else if(is_valid_element)
         {
+#if CK_TILE_HOST_EMULATION
+            host_emulation_atomic<X>(i, x, [](auto a, auto b) { return a < b ? b : a; });
+#else
             atomic_max<X>(c_style_pointer_cast<X*>(&p_data_[i]), x);
+#endif
         }
     }
 
+#if CK_TILE_HOST_EMULATION
+    // read-modify-write of every scalar of x, the ones out of the buffer are dropped as by the
+    // buffer atomics. The scalars smaller than 32 bits are operated on in float
+    template <typename X, typename F>
+    CK_TILE_DEVICE void host_emulation_atomic(index_t i, const X& x, F f)
+    {
+        using scalar_t = remove_cvref_t<typename vector_traits<remove_cvref_t<T>>::scalar_type>;
+
+        constexpr index_t scalar_per_t_vector = vector_traits<remove_cvref_t<T>>::vector_size;
+        constexpr index_t scalar_per_x_vector = vector_traits<remove_cvref_t<X>>::vector_size;
+        constexpr index_t t_per_x             = scalar_per_x_vector / scalar_per_t_vector;
+
+        if(!(i >= 0 && i + t_per_x <= buffer_size_))
+        {
+            return;
+        }
+        host_emulation::trace_access(get_address_space(), &p_data_[i], sizeof(X), true);
+
+        const auto v = bit_cast<array<scalar_t, scalar_per_x_vector>>(x);
+        auto* p      = c_style_pointer_cast<scalar_t*>(&p_data_[i]);
+        host_emulation::atomic([&] {
+            for(index_t k = 0; k < scalar_per_x_vector; ++k)
+            {
+                if constexpr(sizeof(scalar_t) < 4)
+                {
+                    p[k] = type_convert<scalar_t>(
+                        f(type_convert<float>(p[k]), type_convert<float>(v[k])));
+                }
+                else
+                {
+                    p[k] = f(p[k], v[k]);
+                }
+            }
+        });
+    }
+#endif
+
     // FIXME: remove
     CK_TILE_DEVICE static constexpr bool is_static_buffer() { return false; }
 
@@ -659,6 +736,9 @@ struct buffer_view<address_space_enum::lds,
 
         if(is_valid_element)
         {
+#if CK_TILE_HOST_EMULATION
+            host_emulation::trace_access(get_address_space(), &p_data_[i], sizeof(X), false);
+#endif
 #if CK_TILE_EXPERIMENTAL_USE_MEMCPY_FOR_VECTOR_ACCESS
             X tmp;
 
@@ -735,6 +815,9 @@ struct buffer_view<address_space_enum::lds,
         {
             if(is_valid_element)
             {
+#if CK_TILE_HOST_EMULATION
+                host_emulation::trace_access(get_address_space(), &p_data_[i], sizeof(X), true);
+#endif
                 // HACK: compiler would lower IR "store<i8, 16> address_space(3)" into inefficient
                 // ISA, so I try to let compiler emit IR "store<i32, 4>" which would be lower to
                 // ds_write_b128
@@ -828,6 +911,9 @@ struct buffer_view<address_space_enum::lds,
         {
             if(is_valid_element)
             {
+#if CK_TILE_HOST_EMULATION
+                host_emulation::trace_access(get_address_space(), &p_data_[i], sizeof(X), true);
+#endif
 #if CK_TILE_EXPERIMENTAL_USE_MEMCPY_FOR_VECTOR_ACCESS
                 X tmp = x;
 
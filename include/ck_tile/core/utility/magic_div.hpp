@@ -56,12 +56,14 @@ struct magic_division32_bit_range
     }
 
     // magic division for uint32_t
+#if !CK_TILE_HOST_EMULATION
     CK_TILE_DEVICE static constexpr uint32_t
     do_magic_division(uint32_t dividend, uint32_t multiplier, uint32_t shift)
     {
         uint32_t tmp = __umulhi(dividend, multiplier);
         return (tmp + dividend) >> shift;
     }
+#endif
 
     CK_TILE_HOST static constexpr uint32_t
     do_magic_division(uint32_t dividend, uint32_t multiplier, uint32_t shift)
@@ -74,6 +76,7 @@ struct magic_division32_bit_range
     // HACK: use dividend_i32 as if it's uint32_t, dividend_i32 need to be
     // non-negative for result to be correct
     // TODO: figure out how to do magic number divison for int32_t as dividended
+#if !CK_TILE_HOST_EMULATION
     CK_TILE_DEVICE static constexpr int32_t
     do_magic_division(int32_t dividend_i32, uint32_t multiplier, uint32_t shift)
     {
@@ -81,6 +84,7 @@ struct magic_division32_bit_range
         uint32_t tmp          = __umulhi(dividend_u32, multiplier);
         return (tmp + dividend_u32) >> shift;
     }
+#endif
 
     CK_TILE_HOST static constexpr int32_t
     do_magic_division(int32_t dividend_i32, uint32_t multiplier, uint32_t shift)
@@ -127,12 +131,14 @@ struct magic_division16_bit_range
     }
 
     // magic division for uint32_t
+#if !CK_TILE_HOST_EMULATION
     CK_TILE_DEVICE static constexpr uint32_t
     do_magic_division(uint32_t dividend, uint32_t multiplier, uint32_t shift)
     {
         uint32_t tmp = (dividend * multiplier) >> 16;
         return (tmp + dividend) >> shift;
     }
+#endif
 
     CK_TILE_HOST static constexpr uint32_t
     do_magic_division(uint32_t dividend, uint32_t multiplier, uint32_t shift)
@@ -145,6 +151,7 @@ struct magic_division16_bit_range
     // HACK: use dividend_i32 as if it's uint32_t, dividend_i32 need to be
     // non-negative for result to be correct
     // TODO: figure out how to do magic number divison for int32_t as dividended
+#if !CK_TILE_HOST_EMULATION
     CK_TILE_DEVICE static constexpr int32_t
     do_magic_division(int32_t dividend_i32, uint32_t multiplier, uint32_t shift)
     {
@@ -152,6 +159,7 @@ struct magic_division16_bit_range
         uint32_t tmp          = (dividend_u32 * multiplier) >> 16;
         return (tmp + dividend_u32) >> shift;
     }
+#endif
 
     CK_TILE_HOST static constexpr int32_t
     do_magic_division(int32_t dividend_i32, uint32_t multiplier, uint32_t shift)
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ck_tile/core/config.hpp"
+#include "ck_tile/core/arch/host_emulation.hpp"
 #include "ck_tile/core/container/array.hpp"
 #include "ck_tile/core/container/thread_buffer.hpp"
 #include "ck_tile/core/utility/bit_cast.hpp"
@@ -11,6 +12,18 @@
 
 namespace ck_tile {
 
+namespace detail {
+// v_perm_b32
+CK_TILE_DEVICE int32_t perm_b32(int32_t src0, int32_t src1, int32_t selector)
+{
+#if CK_TILE_HOST_EMULATION
+    return host_emulation::perm_b32(src0, src1, selector);
+#else
+    return __builtin_amdgcn_perm(src0, src1, selector);
+#endif
+}
+} // namespace detail
+
 // S: scalar type (or it can be non-scalar type)
 // NX: # of vector before transpose
 // NY: # of vector after transpose
@@ -57,8 +70,8 @@ struct transpose_vectors
                     //                   -- -- -- --     -- -- -- --      -  -  -  -
                     //             index  7  6  5  4      3  2  1  0     33 77 44 88
                     // index is reversed because of little endianness (least significant bits first)
-                    const int32_t y_s2_0 = __builtin_amdgcn_perm(x_s2_1, x_s2_0, m0);
-                    const int32_t y_s2_1 = __builtin_amdgcn_perm(x_s2_1, x_s2_0, m1);
+                    const int32_t y_s2_0 = detail::perm_b32(x_s2_1, x_s2_0, m0);
+                    const int32_t y_s2_1 = detail::perm_b32(x_s2_1, x_s2_0, m1);
 
                     // 2 16bitx2 data after transposed
                     vy_tuple(iy).template get_as<S2>()(ix / I2)      = bit_cast<S2>(y_s2_0);
@@ -98,14 +111,14 @@ struct transpose_vectors
                     //                   -- -- -- --     -- -- -- --      -  -  -  -
                     //             index  7  6  5  4      3  2  1  0     33 77 44 88
                     // index is reversed because of little endianness (least significant bits first)
-                    t_s4_0 = __builtin_amdgcn_perm(x_s4_1, x_s4_0, m0);
-                    t_s4_1 = __builtin_amdgcn_perm(x_s4_3, x_s4_2, m0);
-                    y_s4_0 = __builtin_amdgcn_perm(t_s4_1, t_s4_0, m1);
-                    y_s4_1 = __builtin_amdgcn_perm(t_s4_1, t_s4_0, m2);
-                    t_s4_0 = __builtin_amdgcn_perm(x_s4_1, x_s4_0, m3);
-                    t_s4_1 = __builtin_amdgcn_perm(x_s4_3, x_s4_2, m3);
-                    y_s4_2 = __builtin_amdgcn_perm(t_s4_1, t_s4_0, m1);
-                    y_s4_3 = __builtin_amdgcn_perm(t_s4_1, t_s4_0, m2);
+                    t_s4_0 = detail::perm_b32(x_s4_1, x_s4_0, m0);
+                    t_s4_1 = detail::perm_b32(x_s4_3, x_s4_2, m0);
+                    y_s4_0 = detail::perm_b32(t_s4_1, t_s4_0, m1);
+                    y_s4_1 = detail::perm_b32(t_s4_1, t_s4_0, m2);
+                    t_s4_0 = detail::perm_b32(x_s4_1, x_s4_0, m3);
+                    t_s4_1 = detail::perm_b32(x_s4_3, x_s4_2, m3);
+                    y_s4_2 = detail::perm_b32(t_s4_1, t_s4_0, m1);
+                    y_s4_3 = detail::perm_b32(t_s4_1, t_s4_0, m2);
 
                     // 4 int8x4 data from vy_tuple
                     vy_tuple(iy).template get_as<S4>()(ix / I4)      = bit_cast<S4>(y_s4_0);
@@ -5,7 +5,9 @@
 
 #include "ck_tile/core.hpp"
 #include "ck_tile/host/host_tensor.hpp"
+#include <array>
 #include <thread>
+#include <type_traits>
 
 namespace ck_tile {
 
@@ -25,37 +27,47 @@ CK_TILE_HOST void reference_batched_elementwise(const HostTensor<ADataType>& a_b
 {
     const ck_tile::index_t N = c_b_m_n.mDesc.get_lengths()[2];
 
-    const bool broadcast_a_dim_b = (a_b_m_n.get_lengths()[0] == 1);
-    const bool broadcast_a_dim_m = (a_b_m_n.get_lengths()[1] == 1);
-    const bool broadcast_a_dim_n = (a_b_m_n.get_lengths()[2] == 1);
+    // a broadcast dimension is walked with stride 0, so every row is addressed as base + n * stride
+    // and the index arithmetic of operator() is done once per row instead of once per element
+    auto get_strides = [](const auto& t) {
+        std::array<std::size_t, 3> strides;
+        for(std::size_t i = 0; i < 3; ++i)
+            strides[i] = t.get_lengths()[i] == 1 ? 0 : t.mDesc.GetStrides()[i];
+        return strides;
+    };
 
-    const bool broadcast_b_dim_b = (b_b_m_n.get_lengths()[0] == 1);
-    const bool broadcast_b_dim_m = (b_b_m_n.get_lengths()[1] == 1);
-    const bool broadcast_b_dim_n = (b_b_m_n.get_lengths()[2] == 1);
+    const auto a_strides = get_strides(a_b_m_n);
+    const auto b_strides = get_strides(b_b_m_n);
+    const auto c_strides = c_b_m_n.mDesc.GetStrides();
 
-    auto f = [&](auto batch, auto m) {
+    auto f_row = [&](const ADataType* p_a,
+                     const BDataType* p_b,
+                     CDataType* p_c,
+                     auto stride_a,
+                     auto stride_b,
+                     auto stride_c) {
         for(ck_tile::index_t n = 0; n < N; ++n)
         {
-            AccDataType v_a{};
-            {
-                ck_tile::index_t i_b = (broadcast_a_dim_b ? 0 : batch);
-                ck_tile::index_t i_m = (broadcast_a_dim_m ? 0 : m);
-                ck_tile::index_t i_n = (broadcast_a_dim_n ? 0 : n);
+            const AccDataType v_a =
+                ck_tile::type_convert<AccDataType>(a_element_op(p_a[n * stride_a]));
+            const AccDataType v_b =
+                ck_tile::type_convert<AccDataType>(b_element_op(p_b[n * stride_b]));
 
-                v_a = ck_tile::type_convert<AccDataType>(a_element_op(a_b_m_n(i_b, i_m, i_n)));
-            }
-
-            AccDataType v_b{};
-            {
-                ck_tile::index_t i_b = (broadcast_b_dim_b ? 0 : batch);
-                ck_tile::index_t i_m = (broadcast_b_dim_m ? 0 : m);
-                ck_tile::index_t i_n = (broadcast_b_dim_n ? 0 : n);
+            p_c[n * stride_c] = ck_tile::type_convert<CDataType>(binary_element_op(v_a, v_b));
+        }
+    };
 
-                v_b = ck_tile::type_convert<AccDataType>(b_element_op(b_b_m_n(i_b, i_m, i_n)));
-            }
+    auto f = [&](auto batch, auto m) {
+        const ADataType* p_a = a_b_m_n.data() + batch * a_strides[0] + m * a_strides[1];
+        const BDataType* p_b = b_b_m_n.data() + batch * b_strides[0] + m * b_strides[1];
+        CDataType* p_c       = c_b_m_n.data() + batch * c_strides[0] + m * c_strides[1];
 
-            c_b_m_n(batch, m, n) = ck_tile::type_convert<CDataType>(binary_element_op(v_a, v_b));
-        }
+        // compile-time unit strides for the common packed case, so the inner loop can vectorize
+        using unit = std::integral_constant<std::size_t, 1>;
+        if(a_strides[2] == 1 && b_strides[2] == 1 && c_strides[2] == 1)
+            f_row(p_a, p_b, p_c, unit{}, unit{}, unit{});
+        else
+            f_row(p_a, p_b, p_c, a_strides[2], b_strides[2], c_strides[2]);
     };
 
     make_ParallelTensorFunctor(f, c_b_m_n.mDesc.get_lengths()[0], c_b_m_n.mDesc.get_lengths()[1])(
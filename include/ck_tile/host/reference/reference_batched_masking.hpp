@@ -5,28 +5,80 @@
 
 #include "ck_tile/core.hpp"
 #include "ck_tile/host/host_tensor.hpp"
+#include <algorithm>
 #include <thread>
+#include <type_traits>
+#include <utility>
 
 namespace ck_tile {
 
+namespace detail {
+
+template <typename MaskingType, typename = void>
+struct has_tile_range_along_x : std::false_type
+{
+};
+
+template <typename MaskingType>
+struct has_tile_range_along_x<
+    MaskingType,
+    std::void_t<decltype(std::declval<const MaskingType&>().GetTileRangeAlongX(
+        0, number<1>{}, number<1>{}))>> : std::true_type
+{
+};
+
+} // namespace detail
+
+// Every row is streamed once: the masks of ck_tile keep a single contiguous run of valid columns
+// per row, so with a 1x1 tile GetTileRangeAlongX() gives the exact [x_start, x_end) of row m and
+// only the two masked spans around it are written. Masks without GetTileRangeAlongX() fall back to
+// the per-pixel IsOutOfBound() check, still walking the row in memory order
 template <typename CDataType, typename MaskingType>
 CK_TILE_HOST void reference_batched_masking(HostTensor<CDataType>& c_b_m_n, const MaskingType& mask)
 {
-    const int M = c_b_m_n.mDesc.get_lengths()[1];
-    const int N = c_b_m_n.mDesc.get_lengths()[2];
+    const index_t N = c_b_m_n.mDesc.get_lengths()[2];
+
+    const std::size_t stride_b = c_b_m_n.mDesc.GetStrides()[0];
+    const std::size_t stride_m = c_b_m_n.mDesc.GetStrides()[1];
+    const std::size_t stride_n = c_b_m_n.mDesc.GetStrides()[2];
+
+    const CDataType neg_inf = -ck_tile::numeric<CDataType>::infinity();
+
+    auto f = [&](auto batch, auto m) {
+        CDataType* row = c_b_m_n.data() + batch * stride_b + m * stride_m;
 
-    auto f = [&](auto batch) {
-        for(int n = 0; n < N; ++n)
+        if constexpr(detail::has_tile_range_along_x<MaskingType>::value)
+        {
+            const auto [x_start, x_end] = mask.GetTileRangeAlongX(m, number<1>{}, number<1>{});
+
+            // x_end may be smaller than x_start (or negative) if the whole row is masked
+            const index_t n_begin = min(max(x_start, 0), N);
+            const index_t n_end   = max(min(x_end, N), n_begin);
+
+            if(stride_n == 1)
+            {
+                std::fill(row, row + n_begin, neg_inf);
+                std::fill(row + n_end, row + N, neg_inf);
+            }
+            else
+            {
+                for(index_t n = 0; n < n_begin; ++n)
+                    row[n * stride_n] = neg_inf;
+                for(index_t n = n_end; n < N; ++n)
+                    row[n * stride_n] = neg_inf;
+            }
+        }
+        else
         {
-            for(int m = 0; m < M; ++m)
+            for(index_t n = 0; n < N; ++n)
             {
                 if(mask.IsOutOfBound(m, n))
-                    c_b_m_n(batch, m, n) = -ck_tile::numeric<CDataType>::infinity();
+                    row[n * stride_n] = neg_inf;
             }
         }
     };
 
-    make_ParallelTensorFunctor(f,
-                               c_b_m_n.mDesc.get_lengths()[0])(std::thread::hardware_concurrency());
+    make_ParallelTensorFunctor(f, c_b_m_n.mDesc.get_lengths()[0], c_b_m_n.mDesc.get_lengths()[1])(
+        std::thread::hardware_concurrency());
 }
 } // namespace ck_tile
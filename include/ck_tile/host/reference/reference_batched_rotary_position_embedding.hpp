@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include <cassert>
+#include <thread>
+#include <vector>
+
+namespace ck_tile {
+
+// Row s of batch b is at position position_offsets[b] + s (or s if position_offsets is empty), the
+// first rotary_dim = 2 * cos_s_d.get_lengths()[1] elements of the row are rotated pair by pair:
+// (x0, x1) -> (x0 * cos - x1 * sin, x1 * cos + x0 * sin), with cos/sin[position, j] for pair j.
+// pair j is (2j, 2j + 1) if interleaved, (j, j + rotary_dim / 2) otherwise. The other elements
+// are copied. output_b_s_d may be input_b_s_d
+template <typename DataType, typename CosSinDataType, typename ComputeDataType = float>
+CK_TILE_HOST void
+reference_batched_rotary_position_embedding(const HostTensor<DataType>& input_b_s_d,
+                                            const HostTensor<CosSinDataType>& cos_s_d,
+                                            const HostTensor<CosSinDataType>& sin_s_d,
+                                            bool interleaved,
+                                            HostTensor<DataType>& output_b_s_d,
+                                            const std::vector<index_t>& position_offsets = {})
+{
+    const index_t D           = input_b_s_d.mDesc.get_lengths()[2];
+    const index_t rotary_half = cos_s_d.mDesc.get_lengths()[1];
+    assert(2 * rotary_half <= D);
+
+    auto f = [&](auto b, auto s) {
+        const index_t pos = (position_offsets.empty() ? 0 : position_offsets[b]) + s;
+
+        for(index_t j = 0; j < rotary_half; ++j)
+        {
+            const index_t i0 = interleaved ? 2 * j : j;
+            const index_t i1 = interleaved ? 2 * j + 1 : j + rotary_half;
+
+            const auto c  = type_convert<ComputeDataType>(cos_s_d(pos, j));
+            const auto si = type_convert<ComputeDataType>(sin_s_d(pos, j));
+            const auto x0 = type_convert<ComputeDataType>(input_b_s_d(b, s, i0));
+            const auto x1 = type_convert<ComputeDataType>(input_b_s_d(b, s, i1));
+
+            output_b_s_d(b, s, i0) = type_convert<DataType>(x0 * c - x1 * si);
+            output_b_s_d(b, s, i1) = type_convert<DataType>(x1 * c + x0 * si);
+        }
+        for(index_t d = 2 * rotary_half; d < D; ++d)
+        {
+            output_b_s_d(b, s, d) = input_b_s_d(b, s, d);
+        }
+    };
+
+    make_ParallelTensorFunctor(
+        f, input_b_s_d.mDesc.get_lengths()[0], input_b_s_d.mDesc.get_lengths()[1])(
+        std::thread::hardware_concurrency());
+}
+} // namespace ck_tile
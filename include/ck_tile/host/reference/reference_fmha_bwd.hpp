@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ck_tile {
+
+// Tiled reference of the FMHA backward pass, the gradients of O = softmax(mask(S + bias)) * V with
+// S = scale_s * Q * K^T, given dO and the O/lse written by reference_fmha_fwd:
+//
+//   P  = exp(S + bias - lse)   (recomputed, 0 for masked elements and fully masked rows)
+//   D  = rowsum(dO o O)
+//   dS = P o (dO * V^T - D)
+//   dV = P^T * dO,  dQ = scale_s * dS * K,  dK = scale_s * dS^T * Q,  dBias = dS
+//
+// Like reference_fmha_fwd, S/P/dS only ever exist kM x kN elements at a time. dK/dV are
+// accumulated by (batch, kN keys) and dQ/dBias by (batch, kM queries), so every output element has
+// a single writer and each tile of P is recomputed once per pass. Everything is computed in
+// AccDataType, only the results are converted. The first dimension is usually batch * nhead; for
+// MQA/GQA K/V are expanded per query head and dK/dV have to be summed over each group afterwards.
+//
+// q_b_m_k:     [batch, seqlen_q, hdim_q]
+// k_b_n_k:     [batch, seqlen_k, hdim_q]
+// v_b_o_n:     [batch, hdim_v, seqlen_k]
+// bias_b_m_n:  [batch or 1, seqlen_q, seqlen_k], broadcast along the first dimension if it is 1
+// o_b_m_o:     [batch, seqlen_q, hdim_v]
+// lse_b_m:     [batch, seqlen_q]
+// do_b_m_o:    [batch, seqlen_q, hdim_v]
+// dq_b_m_k:    [batch, seqlen_q, hdim_q]
+// dk_b_n_k:    [batch, seqlen_k, hdim_q]
+// dv_b_n_o:    [batch, seqlen_k, hdim_v]
+// dbias_b_m_n: [batch, seqlen_q, seqlen_k], sum over the first dimension for a broadcast bias
+template <typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename BiasDataType,
+          typename ODataType,
+          typename LSEDataType,
+          typename OGradDataType,
+          typename AccDataType,
+          typename QGradDataType,
+          typename KGradDataType,
+          typename VGradDataType,
+          typename BiasGradDataType,
+          typename MaskingType>
+CK_TILE_HOST void reference_fmha_bwd(
+    const HostTensor<QDataType>& q_b_m_k,
+    const HostTensor<KDataType>& k_b_n_k,
+    const HostTensor<VDataType>& v_b_o_n,
+    std::optional<std::reference_wrapper<const HostTensor<BiasDataType>>> bias_b_m_n,
+    const HostTensor<ODataType>& o_b_m_o,
+    const HostTensor<LSEDataType>& lse_b_m,
+    const HostTensor<OGradDataType>& do_b_m_o,
+    HostTensor<QGradDataType>& dq_b_m_k,
+    HostTensor<KGradDataType>& dk_b_n_k,
+    HostTensor<VGradDataType>& dv_b_n_o,
+    std::optional<std::reference_wrapper<HostTensor<BiasGradDataType>>> dbias_b_m_n,
+    const MaskingType& mask,
+    AccDataType scale_s)
+{
+    constexpr index_t kM = 32;
+    constexpr index_t kN = 128;
+
+    const index_t batch   = q_b_m_k.mDesc.get_lengths()[0];
+    const index_t M       = q_b_m_k.mDesc.get_lengths()[1];
+    const index_t K       = q_b_m_k.mDesc.get_lengths()[2];
+    const index_t N       = k_b_n_k.mDesc.get_lengths()[1];
+    const index_t O       = v_b_o_n.mDesc.get_lengths()[1];
+    const index_t m_tiles = integer_divide_ceil(M, kM);
+    const index_t n_tiles = integer_divide_ceil(N, kN);
+
+    const bool broadcast_bias = bias_b_m_n && bias_b_m_n->get().mDesc.get_lengths()[0] == 1;
+
+    // D = rowsum(dO o O), the only thing both passes need over a full row
+    HostTensor<AccDataType> d_b_m({batch, M});
+    make_ParallelTensorFunctor(
+        [&](auto b, auto m) {
+            AccDataType d = 0;
+            for(index_t o = 0; o < O; ++o)
+                d += type_convert<AccDataType>(do_b_m_o(b, m, o)) *
+                     type_convert<AccDataType>(o_b_m_o(b, m, o));
+            d_b_m(b, m) = d;
+        },
+        batch,
+        M)(std::thread::hardware_concurrency());
+
+    // per worker tile buffers, bounded by kM/kN and the head dims
+    struct Tiles
+    {
+        std::vector<AccDataType> q, k, v, d_o, p, ds;
+
+        Tiles(index_t K_, index_t O_)
+            : q(kM * K_), k(kN * K_), v(kN * O_), d_o(kM * O_), p(kM * kN), ds(kM * kN)
+        {
+        }
+    };
+
+    // P and dS of queries [m_begin, m_begin + rows) and keys [n_begin, n_begin + cols)
+    auto compute_p_ds_tile =
+        [&](Tiles& t, index_t b, index_t m_begin, index_t rows, index_t n_begin, index_t cols) {
+            for(index_t m = 0; m < rows; ++m)
+            {
+                for(index_t k = 0; k < K; ++k)
+                    t.q[m * K + k] = type_convert<AccDataType>(q_b_m_k(b, m_begin + m, k));
+                for(index_t o = 0; o < O; ++o)
+                    t.d_o[m * O + o] = type_convert<AccDataType>(do_b_m_o(b, m_begin + m, o));
+            }
+            for(index_t n = 0; n < cols; ++n)
+            {
+                for(index_t k = 0; k < K; ++k)
+                    t.k[n * K + k] = type_convert<AccDataType>(k_b_n_k(b, n_begin + n, k));
+                for(index_t o = 0; o < O; ++o)
+                    t.v[n * O + o] = type_convert<AccDataType>(v_b_o_n(b, o, n_begin + n));
+            }
+
+            for(index_t m = 0; m < rows; ++m)
+            {
+                const auto lse = type_convert<AccDataType>(lse_b_m(b, m_begin + m));
+                const auto d   = d_b_m(b, m_begin + m);
+                // every key of the row is masked (lse = -inf)
+                const bool row_masked = std::isinf(lse) && lse < 0;
+
+                for(index_t n = 0; n < cols; ++n)
+                {
+                    AccDataType v_p = 0;
+                    if(!row_masked && !mask.IsOutOfBound(m_begin + m, n_begin + n))
+                    {
+                        AccDataType v_s = 0;
+                        for(index_t k = 0; k < K; ++k)
+                            v_s += t.q[m * K + k] * t.k[n * K + k];
+                        v_s *= scale_s;
+                        if(bias_b_m_n)
+                        {
+                            const auto& bias = bias_b_m_n->get();
+                            v_s += type_convert<AccDataType>(
+                                bias(broadcast_bias ? 0 : b, m_begin + m, n_begin + n));
+                        }
+                        v_p = ck_tile::exp(v_s - lse);
+                    }
+
+                    AccDataType v_dp = 0;
+                    for(index_t o = 0; o < O; ++o)
+                        v_dp += t.d_o[m * O + o] * t.v[n * O + o];
+
+                    t.p[m * kN + n]  = v_p;
+                    t.ds[m * kN + n] = v_p * (v_dp - d);
+                }
+            }
+        };
+
+    // dK/dV, every query tile against kN keys
+    make_ParallelTensorFunctor(
+        [&](auto b, auto i_tile) {
+            const index_t n_begin = i_tile * kN;
+            const index_t cols    = std::min(kN, N - n_begin);
+
+            Tiles t(K, O);
+            std::vector<AccDataType> dk_acc(kN * K, 0);
+            std::vector<AccDataType> dv_acc(kN * O, 0);
+
+            for(index_t m_begin = 0; m_begin < M; m_begin += kM)
+            {
+                const index_t rows = std::min(kM, M - m_begin);
+                compute_p_ds_tile(t, b, m_begin, rows, n_begin, cols);
+
+                for(index_t m = 0; m < rows; ++m)
+                {
+                    for(index_t n = 0; n < cols; ++n)
+                    {
+                        const AccDataType v_p  = t.p[m * kN + n];
+                        const AccDataType v_ds = t.ds[m * kN + n];
+                        for(index_t o = 0; o < O; ++o)
+                            dv_acc[n * O + o] += v_p * t.d_o[m * O + o];
+                        for(index_t k = 0; k < K; ++k)
+                            dk_acc[n * K + k] += v_ds * t.q[m * K + k];
+                    }
+                }
+            }
+
+            for(index_t n = 0; n < cols; ++n)
+            {
+                for(index_t k = 0; k < K; ++k)
+                    dk_b_n_k(b, n_begin + n, k) =
+                        type_convert<KGradDataType>(scale_s * dk_acc[n * K + k]);
+                for(index_t o = 0; o < O; ++o)
+                    dv_b_n_o(b, n_begin + n, o) = type_convert<VGradDataType>(dv_acc[n * O + o]);
+            }
+        },
+        batch,
+        n_tiles)(std::thread::hardware_concurrency());
+
+    // dQ/dBias, kM queries against every key tile
+    make_ParallelTensorFunctor(
+        [&](auto b, auto i_tile) {
+            const index_t m_begin = i_tile * kM;
+            const index_t rows    = std::min(kM, M - m_begin);
+
+            Tiles t(K, O);
+            std::vector<AccDataType> dq_acc(kM * K, 0);
+
+            for(index_t n_begin = 0; n_begin < N; n_begin += kN)
+            {
+                const index_t cols = std::min(kN, N - n_begin);
+                compute_p_ds_tile(t, b, m_begin, rows, n_begin, cols);
+
+                for(index_t m = 0; m < rows; ++m)
+                {
+                    for(index_t n = 0; n < cols; ++n)
+                    {
+                        const AccDataType v_ds = t.ds[m * kN + n];
+                        for(index_t k = 0; k < K; ++k)
+                            dq_acc[m * K + k] += v_ds * t.k[n * K + k];
+                        if(dbias_b_m_n)
+                            dbias_b_m_n->get()(b, m_begin + m, n_begin + n) =
+                                type_convert<BiasGradDataType>(v_ds);
+                    }
+                }
+            }
+
+            for(index_t m = 0; m < rows; ++m)
+                for(index_t k = 0; k < K; ++k)
+                    dq_b_m_k(b, m_begin + m, k) =
+                        type_convert<QGradDataType>(scale_s * dq_acc[m * K + k]);
+        },
+        batch,
+        m_tiles)(std::thread::hardware_concurrency());
+}
+} // namespace ck_tile
@@ -0,0 +1,518 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ck_tile {
+
+namespace detail {
+// element ops of the references may also take the index along the first dimension (batch or
+// head), e.g. to dequantize K/V by per-head scales
+template <typename ElementOp, typename X>
+CK_TILE_HOST auto apply_fmha_element_op(const ElementOp& op, index_t b, const X& x)
+{
+    if constexpr(std::is_invocable_v<const ElementOp&, index_t, const X&>)
+        return op(b, x);
+    else
+        return op(x);
+}
+
+// K and V are read through get_k(b, n, k) and get_v(b, o, n), so that their storage (contiguous or
+// paged) does not matter here. Only the keys [n_first, n_last) are visited, all the others are
+// treated as masked
+template <typename QDataType,
+          typename BiasDataType,
+          typename SaccDataType,
+          typename SMPLComputeDataType,
+          typename PDataType,
+          typename OaccDataType,
+          typename ODataType,
+          typename MaskingType,
+          typename KGetter,
+          typename VGetter,
+          typename SAccElementOp,
+          typename PComputeElementOp,
+          typename OAccElementOp>
+CK_TILE_HOST void reference_fmha_fwd_tiled(
+    const HostTensor<QDataType>& q_b_m_k,
+    const KGetter& get_k,
+    const VGetter& get_v,
+    index_t n_first,
+    index_t n_last,
+    index_t O,
+    std::optional<std::reference_wrapper<const HostTensor<BiasDataType>>> bias_b_m_n,
+    HostTensor<ODataType>& o_b_m_o,
+    const MaskingType& mask,
+    const SAccElementOp& s_acc_element_op,
+    const PComputeElementOp& p_compute_element_op,
+    const OAccElementOp& o_acc_element_op,
+    std::optional<std::reference_wrapper<HostTensor<SMPLComputeDataType>>> lse_b_m)
+{
+    constexpr index_t kM = 32;
+    constexpr index_t kN = 128;
+
+    const index_t batch   = q_b_m_k.mDesc.get_lengths()[0];
+    const index_t M       = q_b_m_k.mDesc.get_lengths()[1];
+    const index_t K       = q_b_m_k.mDesc.get_lengths()[2];
+    const index_t m_tiles = integer_divide_ceil(M, kM);
+
+    const bool broadcast_bias = bias_b_m_n && bias_b_m_n->get().mDesc.get_lengths()[0] == 1;
+
+    auto f = [&](auto b, auto i_tile) {
+        const index_t m_begin = i_tile * kM;
+        const index_t m_end   = std::min(m_begin + kM, M);
+        const index_t rows    = m_end - m_begin;
+
+        // tile buffers, everything stays bounded by kM/kN and the head dims
+        std::vector<SaccDataType> q_tile(rows * K);
+        std::vector<SaccDataType> k_tile(kN * K);
+        std::vector<OaccDataType> v_tile(kN * O);
+        std::vector<SMPLComputeDataType> s_tile(rows * kN);
+        std::vector<SMPLComputeDataType> row_max(rows, -numeric<SMPLComputeDataType>::infinity());
+        std::vector<SMPLComputeDataType> row_sum(rows, 0);
+        std::vector<OaccDataType> o_acc(rows * O, 0);
+
+        for(index_t m = 0; m < rows; ++m)
+            for(index_t k = 0; k < K; ++k)
+                q_tile[m * K + k] = type_convert<SaccDataType>(q_b_m_k(b, m_begin + m, k));
+
+        // S = mask(s_acc_element_op(Q * K^T) + bias) for the kN columns starting at n_begin
+        auto compute_s_tile = [&](index_t n_begin, index_t cols) {
+            for(index_t n = 0; n < cols; ++n)
+                for(index_t k = 0; k < K; ++k)
+                    k_tile[n * K + k] = type_convert<SaccDataType>(get_k(b, n_begin + n, k));
+
+            for(index_t m = 0; m < rows; ++m)
+            {
+                for(index_t n = 0; n < cols; ++n)
+                {
+                    SaccDataType v_acc = 0;
+                    for(index_t k = 0; k < K; ++k)
+                        v_acc += q_tile[m * K + k] * k_tile[n * K + k];
+
+                    auto v_s = type_convert<SMPLComputeDataType>(
+                        apply_fmha_element_op(s_acc_element_op, b, v_acc));
+                    if(bias_b_m_n)
+                    {
+                        const auto& bias = bias_b_m_n->get();
+                        v_s += type_convert<SMPLComputeDataType>(
+                            bias(broadcast_bias ? 0 : b, m_begin + m, n_begin + n));
+                    }
+                    if(mask.IsOutOfBound(m_begin + m, n_begin + n))
+                        v_s = -numeric<SMPLComputeDataType>::infinity();
+                    s_tile[m * kN + n] = v_s;
+                }
+            }
+        };
+
+        // first pass, online max and sum
+        for(index_t n_begin = n_first; n_begin < n_last; n_begin += kN)
+        {
+            const index_t cols = std::min(kN, n_last - n_begin);
+            compute_s_tile(n_begin, cols);
+
+            for(index_t m = 0; m < rows; ++m)
+            {
+                SMPLComputeDataType v_max = row_max[m];
+                for(index_t n = 0; n < cols; ++n)
+                    v_max = v_max < s_tile[m * kN + n] ? s_tile[m * kN + n] : v_max;
+
+                // the row is fully masked so far
+                if(std::isinf(v_max) && v_max < 0)
+                    continue;
+
+                SMPLComputeDataType v_exp_sum = 0;
+                for(index_t n = 0; n < cols; ++n)
+                    v_exp_sum += ck_tile::exp(s_tile[m * kN + n] - v_max);
+
+                row_sum[m] = row_sum[m] * ck_tile::exp(row_max[m] - v_max) + v_exp_sum;
+                row_max[m] = v_max;
+            }
+        }
+
+        // validate row_max if all the elements within a row are -INF
+        for(index_t m = 0; m < rows; ++m)
+        {
+            if(std::isinf(row_max[m]) && row_max[m] < 0)
+                row_max[m] = type_convert<SMPLComputeDataType>(0.f);
+        }
+
+        // second pass, P * V
+        for(index_t n_begin = n_first; n_begin < n_last; n_begin += kN)
+        {
+            const index_t cols = std::min(kN, n_last - n_begin);
+            compute_s_tile(n_begin, cols);
+
+            for(index_t n = 0; n < cols; ++n)
+                for(index_t o = 0; o < O; ++o)
+                    v_tile[n * O + o] = type_convert<OaccDataType>(get_v(b, o, n_begin + n));
+
+            for(index_t m = 0; m < rows; ++m)
+            {
+                // if sum is zero(masked), or nan/inf(other computation error), don't do divide
+                const SMPLComputeDataType inv_sum = (row_sum[m] == 0.f ? 1.f : 1.f / row_sum[m]);
+
+                for(index_t n = 0; n < cols; ++n)
+                {
+                    const SMPLComputeDataType v_p =
+                        ck_tile::exp(s_tile[m * kN + n] - row_max[m]) * inv_sum;
+                    const auto v_p_acc =
+                        type_convert<OaccDataType>(type_convert<PDataType>(
+                            apply_fmha_element_op(p_compute_element_op, b, v_p)));
+
+                    for(index_t o = 0; o < O; ++o)
+                        o_acc[m * O + o] += v_p_acc * v_tile[n * O + o];
+                }
+            }
+        }
+
+        for(index_t m = 0; m < rows; ++m)
+        {
+            for(index_t o = 0; o < O; ++o)
+                o_b_m_o(b, m_begin + m, o) = type_convert<ODataType>(
+                    apply_fmha_element_op(o_acc_element_op, b, o_acc[m * O + o]));
+
+            if(lse_b_m)
+                lse_b_m->get()(b, m_begin + m) = row_max[m] + ck_tile::log(row_sum[m]);
+        }
+    };
+
+    make_ParallelTensorFunctor(f, batch, m_tiles)(std::thread::hardware_concurrency());
+}
+} // namespace detail
+
+// Fused reference of O = softmax(mask(S + bias)) * V with S = s_acc_element_op(Q * K^T).
+// Equivalent to chaining reference_batched_gemm, reference_batched_elementwise,
+// reference_batched_masking, reference_batched_softmax and reference_batched_gemm, but S and P
+// are only ever computed kM x kN elements at a time, so the host memory does not grow with
+// seqlen_q * seqlen_k.
+//
+// Each [kM, seqlen_k] strip of S is streamed twice: the first pass keeps a running row max and
+// sum, the second one normalizes P exactly like reference_batched_softmax (so that the rounding
+// of P to PDataType matches) and accumulates P * V. Work is split over (batch, kM rows).
+//
+// q_b_m_k:    [batch, seqlen_q, hdim_q]
+// k_b_n_k:    [batch, seqlen_k, hdim_q]
+// v_b_o_n:    [batch, hdim_v, seqlen_k]
+// bias_b_m_n: [batch or 1, seqlen_q, seqlen_k], broadcast along the first dimension if it is 1
+// o_b_m_o:    [batch, seqlen_q, hdim_v]
+// lse_b_m:    [batch, seqlen_q]
+template <typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename BiasDataType,
+          typename SaccDataType,
+          typename SMPLComputeDataType,
+          typename PDataType,
+          typename OaccDataType,
+          typename ODataType,
+          typename MaskingType,
+          typename SAccElementOp     = ck_tile::identity,
+          typename PComputeElementOp = ck_tile::identity,
+          typename OAccElementOp     = ck_tile::identity>
+CK_TILE_HOST void reference_fmha_fwd(
+    const HostTensor<QDataType>& q_b_m_k,
+    const HostTensor<KDataType>& k_b_n_k,
+    const HostTensor<VDataType>& v_b_o_n,
+    std::optional<std::reference_wrapper<const HostTensor<BiasDataType>>> bias_b_m_n,
+    HostTensor<ODataType>& o_b_m_o,
+    const MaskingType& mask,
+    const SAccElementOp& s_acc_element_op                                          = {},
+    const PComputeElementOp& p_compute_element_op                                  = {},
+    const OAccElementOp& o_acc_element_op                                          = {},
+    std::optional<std::reference_wrapper<HostTensor<SMPLComputeDataType>>> lse_b_m = std::nullopt)
+{
+    detail::reference_fmha_fwd_tiled<QDataType,
+                                     BiasDataType,
+                                     SaccDataType,
+                                     SMPLComputeDataType,
+                                     PDataType,
+                                     OaccDataType,
+                                     ODataType>(
+        q_b_m_k,
+        [&](index_t b, index_t n, index_t k) { return k_b_n_k(b, n, k); },
+        [&](index_t b, index_t o, index_t n) { return v_b_o_n(b, o, n); },
+        0,
+        k_b_n_k.mDesc.get_lengths()[1],
+        v_b_o_n.mDesc.get_lengths()[1],
+        bias_b_m_n,
+        o_b_m_o,
+        mask,
+        s_acc_element_op,
+        p_compute_element_op,
+        o_acc_element_op,
+        lse_b_m);
+}
+
+// Same as reference_fmha_fwd with K/V quantized per head (the first dimension), as
+// FmhaFwdKernel does with kHasKVDequant: the Q * K^T accumulator of head b is multiplied by
+// k_descale[b] before s_acc_element_op, the P * V one by v_descale[b] before o_acc_element_op.
+// K/V stay in their quantized type (fp8, int8, ...) and are only converted to SaccDataType and
+// OaccDataType inside the gemms.
+//
+// k_descale, v_descale: [batch]
+template <typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename BiasDataType,
+          typename SaccDataType,
+          typename SMPLComputeDataType,
+          typename PDataType,
+          typename OaccDataType,
+          typename ODataType,
+          typename MaskingType,
+          typename SAccElementOp     = ck_tile::identity,
+          typename PComputeElementOp = ck_tile::identity,
+          typename OAccElementOp     = ck_tile::identity>
+CK_TILE_HOST void reference_fmha_fwd_kv_dequant(
+    const HostTensor<QDataType>& q_b_m_k,
+    const HostTensor<KDataType>& k_b_n_k,
+    const HostTensor<VDataType>& v_b_o_n,
+    std::optional<std::reference_wrapper<const HostTensor<BiasDataType>>> bias_b_m_n,
+    HostTensor<ODataType>& o_b_m_o,
+    const MaskingType& mask,
+    const std::vector<float>& k_descale,
+    const std::vector<float>& v_descale,
+    const SAccElementOp& s_acc_element_op                                          = {},
+    const PComputeElementOp& p_compute_element_op                                  = {},
+    const OAccElementOp& o_acc_element_op                                          = {},
+    std::optional<std::reference_wrapper<HostTensor<SMPLComputeDataType>>> lse_b_m = std::nullopt)
+{
+    assert(k_descale.size() == q_b_m_k.mDesc.get_lengths()[0]);
+    assert(v_descale.size() == q_b_m_k.mDesc.get_lengths()[0]);
+
+    reference_fmha_fwd<QDataType,
+                       KDataType,
+                       VDataType,
+                       BiasDataType,
+                       SaccDataType,
+                       SMPLComputeDataType,
+                       PDataType,
+                       OaccDataType,
+                       ODataType>(
+        q_b_m_k,
+        k_b_n_k,
+        v_b_o_n,
+        bias_b_m_n,
+        o_b_m_o,
+        mask,
+        [&](index_t b, SaccDataType x) {
+            return s_acc_element_op(type_convert<SaccDataType>(k_descale[b]) * x);
+        },
+        p_compute_element_op,
+        [&](index_t b, OaccDataType x) {
+            return o_acc_element_op(type_convert<OaccDataType>(v_descale[b]) * x);
+        },
+        lse_b_m);
+}
+
+// Same as reference_fmha_fwd for one sequence whose K/V live in a page pool. Row n of the
+// sequence is row n % page_block_size of pool page block_table[n / page_block_size]. Here the
+// first dimension of q/o/lse is the query head, K/V heads are shared by nhead_q / nhead_k of them.
+//
+// k_p_s_h_k:   [num_page_blocks, page_block_size, nhead_k, hdim_q]
+// v_p_s_h_o:   [num_page_blocks, page_block_size, nhead_k, hdim_v]
+// block_table: pages of the sequence, at least ceil(seqlen_k / page_block_size) of them
+template <typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename BiasDataType,
+          typename SaccDataType,
+          typename SMPLComputeDataType,
+          typename PDataType,
+          typename OaccDataType,
+          typename ODataType,
+          typename MaskingType,
+          typename SAccElementOp     = ck_tile::identity,
+          typename PComputeElementOp = ck_tile::identity,
+          typename OAccElementOp     = ck_tile::identity>
+CK_TILE_HOST void reference_fmha_fwd_paged_kv(
+    const HostTensor<QDataType>& q_h_m_k,
+    const HostTensor<KDataType>& k_p_s_h_k,
+    const HostTensor<VDataType>& v_p_s_h_o,
+    const std::vector<int32_t>& block_table,
+    index_t seqlen_k,
+    std::optional<std::reference_wrapper<const HostTensor<BiasDataType>>> bias_h_m_n,
+    HostTensor<ODataType>& o_h_m_o,
+    const MaskingType& mask,
+    const SAccElementOp& s_acc_element_op                                          = {},
+    const PComputeElementOp& p_compute_element_op                                  = {},
+    const OAccElementOp& o_acc_element_op                                          = {},
+    std::optional<std::reference_wrapper<HostTensor<SMPLComputeDataType>>> lse_h_m = std::nullopt)
+{
+    const index_t page_block_size = k_p_s_h_k.mDesc.get_lengths()[1];
+    const index_t nhead_ratio_qk =
+        q_h_m_k.mDesc.get_lengths()[0] / k_p_s_h_k.mDesc.get_lengths()[2];
+
+    detail::reference_fmha_fwd_tiled<QDataType,
+                                     BiasDataType,
+                                     SaccDataType,
+                                     SMPLComputeDataType,
+                                     PDataType,
+                                     OaccDataType,
+                                     ODataType>(
+        q_h_m_k,
+        [&](index_t h, index_t n, index_t k) {
+            return k_p_s_h_k(
+                block_table[n / page_block_size], n % page_block_size, h / nhead_ratio_qk, k);
+        },
+        [&](index_t h, index_t o, index_t n) {
+            return v_p_s_h_o(
+                block_table[n / page_block_size], n % page_block_size, h / nhead_ratio_qk, o);
+        },
+        0,
+        seqlen_k,
+        v_p_s_h_o.mDesc.get_lengths()[3],
+        bias_h_m_n,
+        o_h_m_o,
+        mask,
+        s_acc_element_op,
+        p_compute_element_op,
+        o_acc_element_op,
+        lse_h_m);
+}
+
+// Split-KV (flash-decoding) reference, first half. seqlen_k is cut into num_splits chunks of
+// ceil(seqlen_k / num_splits) keys (the last ones may be shorter or empty), split i computes the
+// attention of every query against its own chunk only: the normalized partial O and its lse.
+// Chunks without any unmasked key give O = 0 and lse = -inf. The way seqlen_k is cut does not
+// change the combined result, so this does not have to follow the tiling of the kernel.
+//
+// o_acc_s_b_m_o: [num_splits, batch, seqlen_q, hdim_v]
+// lse_acc_s_b_m: [num_splits, batch, seqlen_q]
+template <typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename BiasDataType,
+          typename SaccDataType,
+          typename SMPLComputeDataType,
+          typename PDataType,
+          typename OaccDataType,
+          typename MaskingType,
+          typename SAccElementOp     = ck_tile::identity,
+          typename PComputeElementOp = ck_tile::identity>
+CK_TILE_HOST void reference_fmha_fwd_splitkv(
+    const HostTensor<QDataType>& q_b_m_k,
+    const HostTensor<KDataType>& k_b_n_k,
+    const HostTensor<VDataType>& v_b_o_n,
+    std::optional<std::reference_wrapper<const HostTensor<BiasDataType>>> bias_b_m_n,
+    HostTensor<OaccDataType>& o_acc_s_b_m_o,
+    HostTensor<SMPLComputeDataType>& lse_acc_s_b_m,
+    const MaskingType& mask,
+    const SAccElementOp& s_acc_element_op         = {},
+    const PComputeElementOp& p_compute_element_op = {})
+{
+    const index_t num_splits = o_acc_s_b_m_o.mDesc.get_lengths()[0];
+    const index_t batch      = q_b_m_k.mDesc.get_lengths()[0];
+    const index_t M          = q_b_m_k.mDesc.get_lengths()[1];
+    const index_t N          = k_b_n_k.mDesc.get_lengths()[1];
+    const index_t O          = v_b_o_n.mDesc.get_lengths()[1];
+    const index_t split_size = integer_divide_ceil(N, num_splits);
+
+    HostTensor<OaccDataType> o_acc_b_m_o({batch, M, O});
+    HostTensor<SMPLComputeDataType> lse_acc_b_m({batch, M});
+
+    for(index_t i_split = 0; i_split < num_splits; ++i_split)
+    {
+        detail::reference_fmha_fwd_tiled<QDataType,
+                                         BiasDataType,
+                                         SaccDataType,
+                                         SMPLComputeDataType,
+                                         PDataType,
+                                         OaccDataType,
+                                         OaccDataType>(
+            q_b_m_k,
+            [&](index_t b, index_t n, index_t k) { return k_b_n_k(b, n, k); },
+            [&](index_t b, index_t o, index_t n) { return v_b_o_n(b, o, n); },
+            std::min(i_split * split_size, N),
+            std::min((i_split + 1) * split_size, N),
+            O,
+            bias_b_m_n,
+            o_acc_b_m_o,
+            mask,
+            s_acc_element_op,
+            p_compute_element_op,
+            ck_tile::identity{},
+            lse_acc_b_m);
+
+        for(index_t b = 0; b < batch; ++b)
+            for(index_t m = 0; m < M; ++m)
+            {
+                for(index_t o = 0; o < O; ++o)
+                    o_acc_s_b_m_o(i_split, b, m, o) = o_acc_b_m_o(b, m, o);
+                lse_acc_s_b_m(i_split, b, m) = lse_acc_b_m(b, m);
+            }
+    }
+}
+
+// Split-KV reference, second half. Merges the partial results of all the splits:
+//   lse = log(sum_i exp(lse_i)),  O = sum_i exp(lse_i - lse) * O_i
+// which is the same O and lse the unsplit reference_fmha_fwd gives, up to rounding.
+//
+// o_acc_s_b_m_o: [num_splits, batch, seqlen_q, hdim_v]
+// lse_acc_s_b_m: [num_splits, batch, seqlen_q]
+// o_b_m_o:       [batch, seqlen_q, hdim_v]
+// lse_b_m:       [batch, seqlen_q]
+template <typename OaccDataType,
+          typename LSEDataType,
+          typename ODataType,
+          typename OAccElementOp = ck_tile::identity>
+CK_TILE_HOST void reference_fmha_fwd_splitkv_combine(
+    const HostTensor<OaccDataType>& o_acc_s_b_m_o,
+    const HostTensor<LSEDataType>& lse_acc_s_b_m,
+    HostTensor<ODataType>& o_b_m_o,
+    const OAccElementOp& o_acc_element_op                                  = {},
+    std::optional<std::reference_wrapper<HostTensor<LSEDataType>>> lse_b_m = std::nullopt)
+{
+    const index_t num_splits = o_acc_s_b_m_o.mDesc.get_lengths()[0];
+    const index_t O          = o_acc_s_b_m_o.mDesc.get_lengths()[3];
+
+    auto f = [&](auto b, auto m) {
+        LSEDataType lse_max = -numeric<LSEDataType>::infinity();
+        for(index_t i_split = 0; i_split < num_splits; ++i_split)
+            lse_max = ck_tile::max(lse_max, lse_acc_s_b_m(i_split, b, m));
+
+        // every split is fully masked
+        if(std::isinf(lse_max) && lse_max < 0)
+        {
+            for(index_t o = 0; o < O; ++o)
+                o_b_m_o(b, m, o) = type_convert<ODataType>(o_acc_element_op(OaccDataType{0}));
+            if(lse_b_m)
+                lse_b_m->get()(b, m) = lse_max;
+            return;
+        }
+
+        LSEDataType lse_sum = 0;
+        for(index_t i_split = 0; i_split < num_splits; ++i_split)
+            lse_sum += ck_tile::exp(lse_acc_s_b_m(i_split, b, m) - lse_max);
+        const LSEDataType lse = lse_max + ck_tile::log(lse_sum);
+
+        for(index_t o = 0; o < O; ++o)
+        {
+            OaccDataType o_acc = 0;
+            for(index_t i_split = 0; i_split < num_splits; ++i_split)
+            {
+                const auto scale = ck_tile::exp(lse_acc_s_b_m(i_split, b, m) - lse);
+                o_acc += type_convert<OaccDataType>(scale) * o_acc_s_b_m_o(i_split, b, m, o);
+            }
+            o_b_m_o(b, m, o) = type_convert<ODataType>(o_acc_element_op(o_acc));
+        }
+        if(lse_b_m)
+            lse_b_m->get()(b, m) = lse;
+    };
+
+    make_ParallelTensorFunctor(
+        f, o_acc_s_b_m_o.mDesc.get_lengths()[1], o_acc_s_b_m_o.mDesc.get_lengths()[2])(
+        std::thread::hardware_concurrency());
+}
+} // namespace ck_tile
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_batched_rotary_position_embedding.hpp"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ck_tile {
+
+// K/V cache update done by FmhaFwdAppendKVKernel. b folds batch and nhead_k, rows
+// [0, seqlen_k[b]) of k_b_s_d/v_b_s_d are kept and row i of knew/vnew is written to row
+// seqlen_k[b] + i. If rotary cos/sin are given, knew rows are rotated at the same positions (Q has
+// to be rotated with reference_batched_rotary_position_embedding() and the same offsets)
+template <typename DataType, typename CosSinDataType = DataType, typename ComputeDataType = float>
+CK_TILE_HOST void reference_fmha_fwd_appendkv(
+    const HostTensor<DataType>& knew_b_s_d,
+    const HostTensor<DataType>& vnew_b_s_d,
+    HostTensor<DataType>& k_b_s_d,
+    HostTensor<DataType>& v_b_s_d,
+    const std::vector<index_t>& seqlen_k,
+    std::optional<std::reference_wrapper<const HostTensor<CosSinDataType>>> rotary_cos_s_d,
+    std::optional<std::reference_wrapper<const HostTensor<CosSinDataType>>> rotary_sin_s_d,
+    bool rotary_interleaved)
+{
+    const index_t seqlen_knew = knew_b_s_d.mDesc.get_lengths()[1];
+    const index_t hdim_q      = knew_b_s_d.mDesc.get_lengths()[2];
+    const index_t hdim_v      = vnew_b_s_d.mDesc.get_lengths()[2];
+    assert(seqlen_k.size() == knew_b_s_d.mDesc.get_lengths()[0]);
+
+    const bool apply_rotary = rotary_cos_s_d && rotary_sin_s_d;
+
+    HostTensor<DataType> knew_rotated(knew_b_s_d.mDesc);
+    if(apply_rotary)
+    {
+        reference_batched_rotary_position_embedding<DataType, CosSinDataType, ComputeDataType>(
+            knew_b_s_d,
+            rotary_cos_s_d->get(),
+            rotary_sin_s_d->get(),
+            rotary_interleaved,
+            knew_rotated,
+            seqlen_k);
+    }
+    const HostTensor<DataType>& knew = (apply_rotary ? knew_rotated : knew_b_s_d);
+
+    auto f = [&](auto b, auto i) {
+        const index_t row = seqlen_k[b] + i;
+        assert(row < static_cast<index_t>(k_b_s_d.mDesc.get_lengths()[1]));
+
+        for(index_t d = 0; d < hdim_q; ++d)
+            k_b_s_d(b, row, d) = knew(b, i, d);
+        for(index_t d = 0; d < hdim_v; ++d)
+            v_b_s_d(b, row, d) = vnew_b_s_d(b, i, d);
+    };
+
+    make_ParallelTensorFunctor(f, knew_b_s_d.mDesc.get_lengths()[0], seqlen_knew)(
+        std::thread::hardware_concurrency());
+}
+} // namespace ck_tile
@@ -173,7 +173,13 @@ struct GenericAttentionMask
     CK_TILE_HOST_DEVICE constexpr auto
     IsEdgeTile(index_t i_tile_top, index_t i_tile_left, number<TileHeight>, number<TileWidth>) const
     {
-        if constexpr(IsLocal)
+        if constexpr(!IsMasking)
+        {
+            // the only case that need do following compare is under kPadSeqLenK
+            // ... for non-masking kernel.
+            return (i_tile_left + TileWidth) > x_total;
+        }
+        else if constexpr(IsLocal)
         {
             // check top-right corner > x or left-borrom corner < x
             index_t i_tile_right  = i_tile_left + TileWidth;
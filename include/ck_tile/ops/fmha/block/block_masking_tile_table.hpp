@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace ck_tile {
+
+// Classification of one (q-tile, kv-tile) pair of the attention matrix under a mask
+enum struct MaskTileKind : uint8_t
+{
+    EMPTY = 0, // every element is masked, the tile is never visited
+    EDGE  = 1, // visited with per-pixel mask check
+    DENSE = 2, // visited without any mask check
+};
+
+// Host side precomputation of GetTileRangeAlongX()/IsEdgeTile() for all tiles of one sequence.
+// Kernels evaluate both per tile at run time, the table gives the same answer up front so empty
+// work can be skipped and scheduling can be weighted by the number of visited tiles.
+//
+// q-tile i visits kv-tiles [n_begin[i], n_end[i]), all the others are EMPTY. Kinds of the visited
+// tiles are stored compactly, the ones of q-tile i are kinds[offsets[i]] ... kinds[offsets[i+1]-1]
+struct MaskTileTable
+{
+    index_t tile_m;
+    index_t tile_n;
+    index_t num_tile_m;
+    index_t num_tile_n;
+
+    std::vector<index_t> n_begin;
+    std::vector<index_t> n_end;
+    std::vector<index_t> offsets;
+    std::vector<MaskTileKind> kinds;
+
+    index_t num_edge_tiles  = 0;
+    index_t num_dense_tiles = 0;
+
+    CK_TILE_HOST MaskTileKind get(index_t i_tile_m, index_t i_tile_n) const
+    {
+        if(i_tile_n < n_begin[i_tile_m] || n_end[i_tile_m] <= i_tile_n)
+            return MaskTileKind::EMPTY;
+        return kinds[offsets[i_tile_m] + i_tile_n - n_begin[i_tile_m]];
+    }
+
+    CK_TILE_HOST index_t get_num_visited_tiles(index_t i_tile_m) const
+    {
+        return n_end[i_tile_m] - n_begin[i_tile_m];
+    }
+
+    CK_TILE_HOST index_t get_num_empty_tiles() const
+    {
+        return num_tile_m * num_tile_n - num_edge_tiles - num_dense_tiles;
+    }
+};
+
+// mask must be the one the kernel builds for this sequence, i.e. with y_total = seqlen_q and
+// x_total = seqlen_k
+template <typename Mask, index_t kM0, index_t kN0>
+CK_TILE_HOST MaskTileTable make_mask_tile_table(
+    const Mask& mask, index_t seqlen_q, index_t seqlen_k, number<kM0>, number<kN0>)
+{
+    MaskTileTable table;
+    table.tile_m     = kM0;
+    table.tile_n     = kN0;
+    table.num_tile_m = integer_divide_ceil(seqlen_q, kM0);
+    table.num_tile_n = integer_divide_ceil(seqlen_k, kN0);
+
+    table.offsets.push_back(0);
+    for(index_t i_tile_m = 0; i_tile_m < table.num_tile_m; ++i_tile_m)
+    {
+        const index_t i_y = i_tile_m * kM0;
+
+        // x_start is tile aligned, x_end is tile aligned except for the no-mask case, and may
+        // be smaller than x_start (see GetTileRangeAlongX()), in which case nothing is visited
+        const auto [x_start, x_end] = mask.GetTileRangeAlongX(i_y, number<kM0>{}, number<kN0>{});
+        const index_t n_begin = min(x_start / kN0, table.num_tile_n);
+        const index_t n_end =
+            max(min(integer_divide_ceil(max(x_end, 0), kN0), table.num_tile_n), n_begin);
+
+        for(index_t i_tile_n = n_begin; i_tile_n < n_end; ++i_tile_n)
+        {
+            const bool is_edge = mask.IsEdgeTile(i_y, i_tile_n * kN0, number<kM0>{}, number<kN0>{});
+            table.kinds.push_back(is_edge ? MaskTileKind::EDGE : MaskTileKind::DENSE);
+            table.num_edge_tiles += is_edge;
+            table.num_dense_tiles += !is_edge;
+        }
+
+        table.n_begin.push_back(n_begin);
+        table.n_end.push_back(n_end);
+        table.offsets.push_back(static_cast<index_t>(table.kinds.size()));
+    }
+    return table;
+}
+
+} // namespace ck_tile
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+
+namespace ck_tile {
+
+// This class is used for codegen pattern matching
+enum class RotaryEmbeddingEnum
+{
+    NONE = 0,
+    INTERLEAVED,  // rotate pairs of adjacent elements (GPT-J style)
+    HALF_ROTATED, // rotate element j with element j + rotary_dim / 2 (GPT-NeoX style)
+};
+
+template <RotaryEmbeddingEnum>
+struct RotaryEmbeddingEnumToStr;
+
+template <>
+struct RotaryEmbeddingEnumToStr<RotaryEmbeddingEnum::NONE>
+{
+    static constexpr const char* name = "";
+};
+template <>
+struct RotaryEmbeddingEnumToStr<RotaryEmbeddingEnum::INTERLEAVED>
+{
+    static constexpr const char* name = "inter";
+};
+template <>
+struct RotaryEmbeddingEnumToStr<RotaryEmbeddingEnum::HALF_ROTATED>
+{
+    static constexpr const char* name = "half";
+};
+
+// the first rotary_dim elements of a row form rotary_dim / 2 pairs, pair j is rotated by the angle
+// of frequency j: (x0, x1) -> (x0 * cos - x1 * sin, x1 * cos + x0 * sin). returns the positions of
+// x0 and x1 of pair j within the row
+template <RotaryEmbeddingEnum kRotaryEnum>
+CK_TILE_HOST_DEVICE constexpr auto get_rotary_pair_index(index_t j, index_t rotary_dim)
+{
+    static_assert(kRotaryEnum != RotaryEmbeddingEnum::NONE);
+    if constexpr(kRotaryEnum == RotaryEmbeddingEnum::INTERLEAVED)
+    {
+        return make_tuple(2 * j, 2 * j + 1);
+    }
+    else
+    {
+        return make_tuple(j, j + rotary_dim / 2);
+    }
+}
+
+} // namespace ck_tile
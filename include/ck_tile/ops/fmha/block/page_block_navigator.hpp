@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+
+namespace ck_tile {
+
+// Maps the logical key index [0, seqlen_k) of one sequence to the row of the K/V page pool it is
+// stored in. The pool is viewed as [num_page_blocks * page_block_size] rows, logical page i of the
+// sequence lives in pool page block_table[i].
+// Pipelines only ask for rows at the start of a kN0 tile, so page_block_size must be a multiple
+// of kN0 for a tile never to straddle two pages.
+// The rows of the last page past seqlen_k belong to no sequence and may hold anything, NaN
+// included. Tiles are read from the whole pool, so the pipelines have to zero them out of V
+// (is_valid_row) rather than rely on P being 0 there.
+struct PageBlockNavigator
+{
+    const int32_t* block_table;
+    index_t page_block_size;
+    index_t num_blocks; // number of valid entries of the block_table
+    index_t seqlen_k;
+
+    CK_TILE_HOST_DEVICE bool is_valid_row(index_t logical_row) const
+    {
+        return logical_row < seqlen_k;
+    }
+
+    CK_TILE_HOST_DEVICE index_t get_physical_row(index_t logical_row) const
+    {
+        // the row past the last tile is asked for to compute the last window move, clamp it
+        // into the last page so we never read outside the block table
+        const index_t i_block = min(logical_row / page_block_size, num_blocks - 1);
+        return block_table[i_block] * page_block_size + (logical_row - i_block * page_block_size);
+    }
+};
+
+// K/V are contiguous along seqlen_k, logical and physical rows are the same
+struct TrivialPageBlockNavigator
+{
+    CK_TILE_HOST_DEVICE constexpr bool is_valid_row(index_t) const { return true; }
+
+    CK_TILE_HOST_DEVICE constexpr index_t get_physical_row(index_t logical_row) const
+    {
+        return logical_row;
+    }
+};
+
+} // namespace ck_tile
@@ -0,0 +1,403 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/ops/common.hpp"
+#include "ck_tile/ops/fmha/block/block_rotary_embedding.hpp"
+#include <string>
+#include <type_traits>
+
+// Pre-processing of fmha fwd for decoding with a K/V cache, in a single pass over the new tokens:
+// Knew[seqlen_knew, hdim_q] is rotated and written to rows [seqlen_k, seqlen_k + seqlen_knew) of
+// the K cache, Vnew[seqlen_knew, hdim_v] is copied to the same rows of the V cache, and Q is
+// rotated in place. seqlen_k is the number of rows already in the cache, per batch.
+// Row i of Q/Knew is at position seqlen_k + i, its first rotary_dim elements are rotated by
+// rotary_cos/rotary_sin[seqlen_k + i, rotary_dim / 2], the others are left as is
+
+namespace ck_tile {
+
+template <typename DataType_, RotaryEmbeddingEnum kRotaryEnum_, bool kIsPagedKV_>
+struct FmhaFwdAppendKVKernel
+{
+    using DataType = ck_tile::remove_cvref_t<DataType_>;
+
+    static constexpr auto kRotaryEnum = kRotaryEnum_;
+    static constexpr bool kApplyRoPE  = kRotaryEnum != RotaryEmbeddingEnum::NONE;
+    static constexpr bool kIsPagedKV  = kIsPagedKV_;
+
+    static constexpr ck_tile::index_t kBlockSize  = 256;
+    static constexpr ck_tile::index_t kBlockPerCu = 2;
+    // rows of Q and Knew/Vnew handled by one block, each by kThreadsPerRow threads that access
+    // it kVectorSize elements (16 bytes) at a time where the row allows
+    static constexpr ck_tile::index_t kM0            = 16;
+    static constexpr ck_tile::index_t kThreadsPerRow = kBlockSize / kM0;
+    static constexpr ck_tile::index_t kVectorSize    = 16 / sizeof(DataType);
+    static_assert(kBlockSize % kM0 == 0);
+
+    // clang-format off
+    template <typename T> struct t2s;
+    template <> struct t2s<ck_tile::fp16_t> { static constexpr const char * name = "fp16"; };
+    template <> struct t2s<ck_tile::bf16_t> { static constexpr const char * name = "bf16"; };
+    // clang-format on
+
+    __host__ static std::string GetName()
+    {
+        // clang-format off
+        return std::string("fmha_fwd_appendkv_") + t2s<DataType>::name + "_b" +
+            std::to_string(kM0) +
+            (kApplyRoPE ? std::string("_r") + RotaryEmbeddingEnumToStr<kRotaryEnum>::name : "") +
+            (kIsPagedKV ? "_pagedkv" : "");
+        // clang-format on
+    }
+
+    template <ck_tile::index_t I> // to avoid duplicated base class prblem, introduce an template
+                                  // arg
+    struct EmptyKargs
+    {
+    };
+
+    struct BasicKargs
+    {
+        void* q_ptr;
+        void* k_ptr;
+        const void* knew_ptr;
+        void* v_ptr;
+        const void* vnew_ptr;
+
+        const int32_t* seqlen_k_ptr;
+
+        ck_tile::index_t seqlen_q;
+        ck_tile::index_t seqlen_knew;
+        ck_tile::index_t hdim_q;
+        ck_tile::index_t hdim_v;
+
+        ck_tile::index_t nhead_ratio_qk;
+
+        ck_tile::index_t stride_q;
+        ck_tile::index_t stride_k;
+        ck_tile::index_t stride_knew;
+        ck_tile::index_t stride_v;
+        ck_tile::index_t stride_vnew;
+
+        ck_tile::index_t nhead_stride_q;
+        ck_tile::index_t nhead_stride_k;
+        ck_tile::index_t nhead_stride_knew;
+        ck_tile::index_t nhead_stride_v;
+        ck_tile::index_t nhead_stride_vnew;
+
+        ck_tile::index_t batch_stride_q;
+        ck_tile::index_t batch_stride_k; // page stride if kIsPagedKV
+        ck_tile::index_t batch_stride_knew;
+        ck_tile::index_t batch_stride_v; // page stride if kIsPagedKV
+        ck_tile::index_t batch_stride_vnew;
+    };
+
+    // rotary_cos/rotary_sin are [max position, rotary_dim / 2], row major
+    struct RoPEKargs
+    {
+        const void* rotary_cos_ptr;
+        const void* rotary_sin_ptr;
+        ck_tile::index_t rotary_dim;
+    };
+
+    // same page layout as FmhaFwdKernel with kIsPagedKV
+    struct PagedKVKargs
+    {
+        const int32_t* block_table_ptr;
+        ck_tile::index_t batch_stride_block_table;
+        ck_tile::index_t page_block_size;
+    };
+
+    struct Kargs : BasicKargs,
+                   std::conditional_t<kApplyRoPE, RoPEKargs, EmptyKargs<0>>,
+                   std::conditional_t<kIsPagedKV, PagedKVKargs, EmptyKargs<1>>
+    {
+    };
+
+    __host__ static constexpr Kargs MakeKargs(void* q_ptr,
+                                              void* k_ptr,
+                                              const void* knew_ptr,
+                                              void* v_ptr,
+                                              const void* vnew_ptr,
+                                              const void* seqlen_k_ptr,
+                                              ck_tile::index_t seqlen_q,
+                                              ck_tile::index_t seqlen_knew,
+                                              ck_tile::index_t hdim_q,
+                                              ck_tile::index_t hdim_v,
+                                              ck_tile::index_t nhead_ratio_qk,
+                                              const void* rotary_cos_ptr,
+                                              const void* rotary_sin_ptr,
+                                              ck_tile::index_t rotary_dim,
+                                              const void* block_table_ptr,
+                                              ck_tile::index_t batch_stride_block_table,
+                                              ck_tile::index_t page_block_size,
+                                              ck_tile::index_t stride_q,
+                                              ck_tile::index_t stride_k,
+                                              ck_tile::index_t stride_knew,
+                                              ck_tile::index_t stride_v,
+                                              ck_tile::index_t stride_vnew,
+                                              ck_tile::index_t nhead_stride_q,
+                                              ck_tile::index_t nhead_stride_k,
+                                              ck_tile::index_t nhead_stride_knew,
+                                              ck_tile::index_t nhead_stride_v,
+                                              ck_tile::index_t nhead_stride_vnew,
+                                              ck_tile::index_t batch_stride_q,
+                                              ck_tile::index_t batch_stride_k,
+                                              ck_tile::index_t batch_stride_knew,
+                                              ck_tile::index_t batch_stride_v,
+                                              ck_tile::index_t batch_stride_vnew)
+    {
+        Kargs kargs{{q_ptr,
+                     k_ptr,
+                     knew_ptr,
+                     v_ptr,
+                     vnew_ptr,
+                     reinterpret_cast<const int32_t*>(seqlen_k_ptr),
+                     seqlen_q,
+                     seqlen_knew,
+                     hdim_q,
+                     hdim_v,
+                     nhead_ratio_qk,
+                     stride_q,
+                     stride_k,
+                     stride_knew,
+                     stride_v,
+                     stride_vnew,
+                     nhead_stride_q,
+                     nhead_stride_k,
+                     nhead_stride_knew,
+                     nhead_stride_v,
+                     nhead_stride_vnew,
+                     batch_stride_q,
+                     batch_stride_k,
+                     batch_stride_knew,
+                     batch_stride_v,
+                     batch_stride_vnew}, // args for common karg
+                    {},                  // placeholder for rope
+                    {}};                 // placeholder for paged kv
+
+        if constexpr(kApplyRoPE)
+        {
+            kargs.rotary_cos_ptr = rotary_cos_ptr;
+            kargs.rotary_sin_ptr = rotary_sin_ptr;
+            kargs.rotary_dim     = rotary_dim;
+        }
+        if constexpr(kIsPagedKV)
+        {
+            kargs.block_table_ptr          = reinterpret_cast<const int32_t*>(block_table_ptr);
+            kargs.batch_stride_block_table = batch_stride_block_table;
+            kargs.page_block_size          = page_block_size;
+        }
+
+        return kargs;
+    }
+
+    __host__ static constexpr bool IsSupportedRotaryDim(ck_tile::index_t rotary_dim,
+                                                        ck_tile::index_t hdim_q)
+    {
+        if constexpr(kApplyRoPE)
+            return 0 < rotary_dim && rotary_dim % 2 == 0 && rotary_dim <= hdim_q;
+        else
+            return true;
+    }
+
+    __host__ static constexpr auto GridSize(ck_tile::index_t batch_size_,
+                                            ck_tile::index_t nhead_,
+                                            ck_tile::index_t seqlen_q_,
+                                            ck_tile::index_t seqlen_knew_)
+    {
+        return dim3(ck_tile::integer_divide_ceil(max(seqlen_q_, seqlen_knew_), kM0),
+                    nhead_,
+                    batch_size_);
+    }
+
+    __host__ static constexpr auto BlockSize() { return dim3(kBlockSize); }
+
+    CK_TILE_DEVICE void operator()(Kargs kargs) const
+    {
+        const index_t i_tile_m = blockIdx.x;
+        const index_t i_nhead  = blockIdx.y;
+        const index_t i_batch  = blockIdx.z;
+
+        const index_t i_m0 = __builtin_amdgcn_readfirstlane(i_tile_m * kM0);
+        const index_t tid  = get_thread_local_1d_id();
+
+        // rows of the cache already filled, the new ones go right after them
+        const index_t seqlen_k = kargs.seqlen_k_ptr[i_batch];
+
+        // row of the block this thread works on, and its position among the threads of the row
+        const index_t i_thread_row = tid / kThreadsPerRow;
+        const index_t i_lane       = tid % kThreadsPerRow;
+
+        // rotate the first rotary_dim elements of num_rows rows, src and dst may alias since every
+        // pair is read and written by the same thread. rope_kargs is only valid if kApplyRoPE
+        const auto rotate_rows = [&](const auto& rope_kargs,
+                                     const DataType* src,
+                                     index_t src_stride,
+                                     auto get_dst_row,
+                                     index_t num_rows) {
+            if(num_rows <= i_thread_row)
+                return;
+
+            const index_t rotary_half = rope_kargs.rotary_dim / 2;
+            const long_index_t i_pos  = seqlen_k + i_m0 + i_thread_row;
+            const auto* rotary_cos =
+                reinterpret_cast<const DataType*>(rope_kargs.rotary_cos_ptr) + i_pos * rotary_half;
+            const auto* rotary_sin =
+                reinterpret_cast<const DataType*>(rope_kargs.rotary_sin_ptr) + i_pos * rotary_half;
+
+            const DataType* src_row = src + static_cast<long_index_t>(i_thread_row) * src_stride;
+            DataType* dst_row       = get_dst_row(i_thread_row);
+            for(index_t j = i_lane; j < rotary_half; j += kThreadsPerRow)
+            {
+                const float c = type_convert<float>(rotary_cos[j]);
+                const float s = type_convert<float>(rotary_sin[j]);
+
+                const auto [i0, i1] =
+                    get_rotary_pair_index<kRotaryEnum>(j, rope_kargs.rotary_dim);
+
+                const float x0 = type_convert<float>(src_row[i0]);
+                const float x1 = type_convert<float>(src_row[i1]);
+                dst_row[i0]    = type_convert<DataType>(x0 * c - x1 * s);
+                dst_row[i1]    = type_convert<DataType>(x1 * c + x0 * s);
+            }
+        };
+
+        // Q, in place
+        if constexpr(kApplyRoPE)
+        {
+            if(i_m0 < kargs.seqlen_q)
+            {
+                DataType* q_ptr = reinterpret_cast<DataType*>(kargs.q_ptr) +
+                                  static_cast<long_index_t>(i_nhead) * kargs.nhead_stride_q +
+                                  static_cast<long_index_t>(i_batch) * kargs.batch_stride_q +
+                                  static_cast<long_index_t>(i_m0) * kargs.stride_q;
+
+                rotate_rows(
+                    kargs,
+                    q_ptr,
+                    kargs.stride_q,
+                    [&](index_t i_row) {
+                        return q_ptr + static_cast<long_index_t>(i_row) * kargs.stride_q;
+                    },
+                    min(kM0, kargs.seqlen_q - i_m0));
+            }
+        }
+
+        // K/V heads are shared by nhead_ratio_qk heads of Q, only the first of them appends
+        if(i_nhead % kargs.nhead_ratio_qk != 0 || kargs.seqlen_knew <= i_m0)
+        {
+            return;
+        }
+        const index_t i_nhead_k = i_nhead / kargs.nhead_ratio_qk;
+        const index_t num_rows  = min(kM0, kargs.seqlen_knew - i_m0);
+
+        // row i of the new tokens goes to row seqlen_k + i of the cache
+        const auto get_cache_row = [&](auto* cache_ptr,
+                                       index_t nhead_stride,
+                                       index_t batch_stride,
+                                       index_t stride,
+                                       index_t i_row) {
+            const index_t i_cache_row = seqlen_k + i_m0 + i_row;
+            if constexpr(kIsPagedKV)
+            {
+                const long_index_t i_page =
+                    kargs.block_table_ptr[i_batch * kargs.batch_stride_block_table +
+                                          i_cache_row / kargs.page_block_size];
+                return cache_ptr + i_page * batch_stride +
+                       static_cast<long_index_t>(i_nhead_k) * nhead_stride +
+                       static_cast<long_index_t>(i_cache_row % kargs.page_block_size) * stride;
+            }
+            else
+            {
+                return cache_ptr + static_cast<long_index_t>(i_batch) * batch_stride +
+                       static_cast<long_index_t>(i_nhead_k) * nhead_stride +
+                       static_cast<long_index_t>(i_cache_row) * stride;
+            }
+        };
+
+        const auto get_new_row_ptr = [&](const void* new_ptr,
+                                         index_t nhead_stride,
+                                         index_t batch_stride,
+                                         index_t stride) {
+            return reinterpret_cast<const DataType*>(new_ptr) +
+                   static_cast<long_index_t>(i_nhead_k) * nhead_stride +
+                   static_cast<long_index_t>(i_batch) * batch_stride +
+                   static_cast<long_index_t>(i_m0) * stride;
+        };
+
+        // copy elements [d_start, hdim) of every row, with 16 byte vectors if the range is made of
+        // whole vectors that start aligned in both rows
+        const auto copy_rows = [&](const DataType* src,
+                                   index_t src_stride,
+                                   auto get_dst_row,
+                                   index_t d_start,
+                                   index_t hdim) {
+            if(num_rows <= i_thread_row)
+                return;
+
+            const DataType* src_row = src + static_cast<long_index_t>(i_thread_row) * src_stride;
+            DataType* dst_row       = get_dst_row(i_thread_row);
+
+            const auto is_aligned = [](const DataType* ptr) {
+                return reinterpret_cast<uintptr_t>(ptr) % (kVectorSize * sizeof(DataType)) == 0;
+            };
+            if(d_start % kVectorSize == 0 && hdim % kVectorSize == 0 &&
+               is_aligned(src_row + d_start) && is_aligned(dst_row + d_start))
+            {
+                using vector_t = ext_vector_t<DataType, kVectorSize>;
+                for(index_t i_col = d_start + i_lane * kVectorSize; i_col < hdim;
+                    i_col += kThreadsPerRow * kVectorSize)
+                {
+                    *reinterpret_cast<vector_t*>(dst_row + i_col) =
+                        *reinterpret_cast<const vector_t*>(src_row + i_col);
+                }
+            }
+            else
+            {
+                for(index_t i_col = d_start + i_lane; i_col < hdim; i_col += kThreadsPerRow)
+                    dst_row[i_col] = src_row[i_col];
+            }
+        };
+
+        // K
+        {
+            DataType* k_ptr          = reinterpret_cast<DataType*>(kargs.k_ptr);
+            const DataType* knew_ptr = get_new_row_ptr(kargs.knew_ptr,
+                                                       kargs.nhead_stride_knew,
+                                                       kargs.batch_stride_knew,
+                                                       kargs.stride_knew);
+            const auto get_k_cache_row = [&](index_t i_row) {
+                return get_cache_row(
+                    k_ptr, kargs.nhead_stride_k, kargs.batch_stride_k, kargs.stride_k, i_row);
+            };
+
+            index_t rotary_dim = 0;
+            if constexpr(kApplyRoPE)
+            {
+                rotary_dim = kargs.rotary_dim;
+                rotate_rows(kargs, knew_ptr, kargs.stride_knew, get_k_cache_row, num_rows);
+            }
+            copy_rows(knew_ptr, kargs.stride_knew, get_k_cache_row, rotary_dim, kargs.hdim_q);
+        }
+
+        // V
+        {
+            DataType* v_ptr          = reinterpret_cast<DataType*>(kargs.v_ptr);
+            const DataType* vnew_ptr = get_new_row_ptr(kargs.vnew_ptr,
+                                                       kargs.nhead_stride_vnew,
+                                                       kargs.batch_stride_vnew,
+                                                       kargs.stride_vnew);
+            const auto get_v_cache_row = [&](index_t i_row) {
+                return get_cache_row(
+                    v_ptr, kargs.nhead_stride_v, kargs.batch_stride_v, kargs.stride_v, i_row);
+            };
+
+            copy_rows(vnew_ptr, kargs.stride_vnew, get_v_cache_row, 0, kargs.hdim_v);
+        }
+    }
+};
+
+} // namespace ck_tile
@@ -5,6 +5,7 @@
 
 #include "ck_tile/core.hpp"
 #include "ck_tile/ops/common.hpp"
+#include "ck_tile/ops/fmha/block/page_block_navigator.hpp"
 #include <string>
 #include <type_traits>
 
@@ -44,6 +45,14 @@ struct FmhaFwdKernel
     static constexpr bool kHasBias          = FmhaPipeline::kHasBias;
     static constexpr bool kStoreLSE         = FmhaPipeline::kStoreLSE;
     static constexpr bool kDoFp8StaticQuant = FmhaPipeline::Problem::kDoFp8StaticQuant;
+    static constexpr bool kIsPagedKV        = FmhaPipeline::Problem::kIsPagedKV;
+    static_assert(!(kIsPagedKV && kDoFp8StaticQuant), "paged kv does not support fp8 static quant");
+    static constexpr bool kHasSplitKV = FmhaPipeline::Problem::kHasSplitKV;
+    static_assert(!(kHasSplitKV && kDoFp8StaticQuant),
+                  "split kv does not support fp8 static quant");
+    static constexpr bool kHasKVDequant = FmhaPipeline::Problem::kHasKVDequant;
+    static_assert(!kHasKVDequant || kDoFp8StaticQuant,
+                  "per-head kv dequant is folded into the scales of fp8 static quant");
     using FmhaMask                 = ck_tile::remove_cvref_t<typename FmhaPipeline::FmhaMask>;
     static constexpr bool kHasMask = FmhaMask::IsMasking;
 
@@ -81,7 +90,7 @@ struct FmhaFwdKernel
             "w" + _TS_(gwt::at(ck_tile::number<0>{})) + "x" + _TS_(gwt::at(ck_tile::number<1>{})) + "x" + _TS_(gwt::at(ck_tile::number<2>{})) + "_" +
             (kBlockPerCuInput == -1 ? "" : ("o" + _TS_(kBlockPerCu) + "_")) + _SS_(FmhaPipeline::name) + "_" +
             "v" + (std::is_same_v<VLayout, ck_tile::tensor_layout::gemm::RowMajor> ? "r" : "c") + (pn.empty() ? "" : "_" + pn) +
-            (kHasBias ? "_bias" : "") + (kHasMask ? "_" + _SS_(FmhaMask::name) : "") + (kStoreLSE ? "_lse" : "" ) + (kDoFp8StaticQuant ? "_squant" : "" );
+            (kHasBias ? "_bias" : "") + (kHasMask ? "_" + _SS_(FmhaMask::name) : "") + (kStoreLSE ? "_lse" : "" ) + (kDoFp8StaticQuant ? "_squant" : "" ) + (kIsPagedKV ? "_pagedkv" : "" ) + (kHasSplitKV ? "_splitkv" : "" ) + (kHasKVDequant ? "_kvdequant" : "" );
         #undef _SS_
         #undef _TS_
         // clang-format on
@@ -160,12 +169,47 @@ struct FmhaFwdKernel
         ck_tile::index_t batch_stride_lse = 0;
     };
 
+    // K/V of a sequence are scattered over pages of page_block_size rows, the page_stride_k/v
+    // apart. Row i of sequence b is row (i % page_block_size) of page
+    // block_table_ptr[b * batch_stride_block_table + i / page_block_size]
+    struct FmhaFwdPagedKVKargs
+    {
+        const int32_t* block_table_ptr;
+        ck_tile::index_t batch_stride_block_table;
+        ck_tile::index_t page_block_size;
+        ck_tile::index_t num_page_blocks; // total number of pages in the K/V pool
+        ck_tile::index_t page_stride_k;
+        ck_tile::index_t page_stride_v;
+    };
+
+    // seqlen_k is cut into num_splits parts handled by different blocks. o_ptr/lse_ptr are then
+    // the accumulation buffers (ODataType is OaccDataType), the partial results of split i start
+    // i * split_stride_o_acc/split_stride_lse_acc elements after those of split 0
+    struct FmhaFwdSplitKVKargs
+    {
+        ck_tile::index_t num_splits;
+        ck_tile::index_t split_stride_lse_acc;
+        ck_tile::index_t split_stride_o_acc;
+    };
+
+    // K/V of head h_k are stored quantized, k_descale_ptr[h_k]/v_descale_ptr[h_k] bring S/O back
+    // to the scale of the other heads. Being constant over a head, they are folded into
+    // scale_s/scale_o instead of touching the K/V tiles
+    struct FmhaFwdKVDequantKargs
+    {
+        const float* k_descale_ptr;
+        const float* v_descale_ptr;
+    };
+
     struct FmhaFwdBatchModeKargs
         : FmhaFwdCommonKargs,
           std::conditional_t<kHasBias, FmhaFwdBatchModeBiasKargs, FmhaFwdEmptyKargs<0>>,
           std::conditional_t<kHasMask, FmhaFwdMaskKargs, FmhaFwdEmptyKargs<1>>,
           std::conditional_t<kStoreLSE, FmhaFwdBatchModeLSEKargs, FmhaFwdEmptyKargs<2>>,
-          std::conditional_t<kDoFp8StaticQuant, FmhaFwdFp8StaticQuantKargs, FmhaFwdEmptyKargs<3>>
+          std::conditional_t<kDoFp8StaticQuant, FmhaFwdFp8StaticQuantKargs, FmhaFwdEmptyKargs<3>>,
+          std::conditional_t<kIsPagedKV, FmhaFwdPagedKVKargs, FmhaFwdEmptyKargs<4>>,
+          std::conditional_t<kHasSplitKV, FmhaFwdSplitKVKargs, FmhaFwdEmptyKargs<5>>,
+          std::conditional_t<kHasKVDequant, FmhaFwdKVDequantKargs, FmhaFwdEmptyKargs<6>>
     {
         ck_tile::index_t batch_stride_q;
         ck_tile::index_t batch_stride_k;
@@ -178,7 +222,10 @@ struct FmhaFwdKernel
           std::conditional_t<kHasBias, FmhaFwdCommonBiasKargs, FmhaFwdEmptyKargs<0>>,
           std::conditional_t<kHasMask, FmhaFwdMaskKargs, FmhaFwdEmptyKargs<1>>,
           std::conditional_t<kStoreLSE, FmhaFwdCommonLSEKargs, FmhaFwdEmptyKargs<2>>,
-          std::conditional_t<kDoFp8StaticQuant, FmhaFwdFp8StaticQuantKargs, FmhaFwdEmptyKargs<3>>
+          std::conditional_t<kDoFp8StaticQuant, FmhaFwdFp8StaticQuantKargs, FmhaFwdEmptyKargs<3>>,
+          std::conditional_t<kIsPagedKV, FmhaFwdPagedKVKargs, FmhaFwdEmptyKargs<4>>,
+          std::conditional_t<kHasSplitKV, FmhaFwdSplitKVKargs, FmhaFwdEmptyKargs<5>>,
+          std::conditional_t<kHasKVDequant, FmhaFwdKVDequantKargs, FmhaFwdEmptyKargs<6>>
     {
         const int32_t* seqstart_q_ptr;
         const int32_t* seqstart_k_ptr;
@@ -222,7 +269,18 @@ struct FmhaFwdKernel
               ck_tile::index_t batch_stride_o,
               ck_tile::index_t window_size_left,
               ck_tile::index_t window_size_right,
-              ck_tile::index_t mask_type)
+              ck_tile::index_t mask_type,
+              const void* block_table_ptr,
+              ck_tile::index_t batch_stride_block_table,
+              ck_tile::index_t page_block_size,
+              ck_tile::index_t num_page_blocks,
+              ck_tile::index_t page_stride_k,
+              ck_tile::index_t page_stride_v,
+              ck_tile::index_t num_splits           = 1,
+              ck_tile::index_t split_stride_lse_acc = 0,
+              ck_tile::index_t split_stride_o_acc   = 0,
+              const void* k_descale_ptr             = nullptr,
+              const void* v_descale_ptr             = nullptr)
     {
         Kargs kargs{{q_ptr,
                      k_ptr,
@@ -250,6 +308,9 @@ struct FmhaFwdKernel
                     {},               // placeholder for mask
                     {},               // placeholder for lse
                     {},               // placeholder for fp8_static_quant args
+                    {},               // placeholder for paged kv args
+                    {},               // placeholder for split kv args
+                    {},               // placeholder for kv dequant args
                     batch_stride_q,
                     batch_stride_k,
                     batch_stride_v,
@@ -279,6 +340,26 @@ struct FmhaFwdKernel
             kargs.scale_p = scale_p;
             kargs.scale_o = scale_o;
         }
+        if constexpr(kIsPagedKV)
+        {
+            kargs.block_table_ptr          = reinterpret_cast<const int32_t*>(block_table_ptr);
+            kargs.batch_stride_block_table = batch_stride_block_table;
+            kargs.page_block_size          = page_block_size;
+            kargs.num_page_blocks          = num_page_blocks;
+            kargs.page_stride_k            = page_stride_k;
+            kargs.page_stride_v            = page_stride_v;
+        }
+        if constexpr(kHasSplitKV)
+        {
+            kargs.num_splits           = num_splits;
+            kargs.split_stride_lse_acc = split_stride_lse_acc;
+            kargs.split_stride_o_acc   = split_stride_o_acc;
+        }
+        if constexpr(kHasKVDequant)
+        {
+            kargs.k_descale_ptr = reinterpret_cast<const float*>(k_descale_ptr);
+            kargs.v_descale_ptr = reinterpret_cast<const float*>(v_descale_ptr);
+        }
 
         return kargs;
     }
@@ -313,7 +394,18 @@ struct FmhaFwdKernel
               ck_tile::index_t nhead_stride_o,
               ck_tile::index_t window_size_left,
               ck_tile::index_t window_size_right,
-              ck_tile::index_t mask_type)
+              ck_tile::index_t mask_type,
+              const void* block_table_ptr,
+              ck_tile::index_t batch_stride_block_table,
+              ck_tile::index_t page_block_size,
+              ck_tile::index_t num_page_blocks,
+              ck_tile::index_t page_stride_k,
+              ck_tile::index_t page_stride_v,
+              ck_tile::index_t num_splits           = 1,
+              ck_tile::index_t split_stride_lse_acc = 0,
+              ck_tile::index_t split_stride_o_acc   = 0,
+              const void* k_descale_ptr             = nullptr,
+              const void* v_descale_ptr             = nullptr)
     {
         Kargs kargs{{q_ptr,
                      k_ptr,
@@ -341,6 +433,9 @@ struct FmhaFwdKernel
                     {},               // placeholder for mask
                     {},               // placeholder for lse
                     {},               // placeholder for fp8_static_quant args
+                    {},               // placeholder for paged kv args
+                    {},               // placeholder for split kv args
+                    {},               // placeholder for kv dequant args
                     reinterpret_cast<const int32_t*>(seqstart_q_ptr),
                     reinterpret_cast<const int32_t*>(seqstart_k_ptr),
                     reinterpret_cast<const int32_t*>(seqlen_k_ptr)};
@@ -367,6 +462,26 @@ struct FmhaFwdKernel
             kargs.scale_p = scale_p;
             kargs.scale_o = scale_o;
         }
+        if constexpr(kIsPagedKV)
+        {
+            kargs.block_table_ptr          = reinterpret_cast<const int32_t*>(block_table_ptr);
+            kargs.batch_stride_block_table = batch_stride_block_table;
+            kargs.page_block_size          = page_block_size;
+            kargs.num_page_blocks          = num_page_blocks;
+            kargs.page_stride_k            = page_stride_k;
+            kargs.page_stride_v            = page_stride_v;
+        }
+        if constexpr(kHasSplitKV)
+        {
+            kargs.num_splits           = num_splits;
+            kargs.split_stride_lse_acc = split_stride_lse_acc;
+            kargs.split_stride_o_acc   = split_stride_o_acc;
+        }
+        if constexpr(kHasKVDequant)
+        {
+            kargs.k_descale_ptr = reinterpret_cast<const float*>(k_descale_ptr);
+            kargs.v_descale_ptr = reinterpret_cast<const float*>(v_descale_ptr);
+        }
 
         return kargs;
     }
@@ -374,9 +489,11 @@ struct FmhaFwdKernel
     __host__ static constexpr auto GridSize(ck_tile::index_t batch_size_,
                                             ck_tile::index_t nhead_,
                                             ck_tile::index_t seqlen_q_,
-                                            ck_tile::index_t hdim_v_)
+                                            ck_tile::index_t hdim_v_,
+                                            ck_tile::index_t num_splits_ = 1)
     {
-        return TilePartitioner::GridSize(batch_size_, nhead_, seqlen_q_, hdim_v_);
+        // splits of the same head are next to each other along the nhead dimension
+        return TilePartitioner::GridSize(batch_size_, nhead_ * num_splits_, seqlen_q_, hdim_v_);
     }
 
     __host__ static constexpr auto BlockSize() { return dim3(kBlockSize); }
@@ -392,9 +509,18 @@ struct FmhaFwdKernel
         __shared__ char smem_ptr[GetSmemSize()];
 
         // divide problem
-        const auto [i_tile_m, i_tile_n, i_nhead, i_batch] =
+        const auto [i_tile_m, i_tile_n, i_nhead_split, i_batch] =
             TilePartitioner{}(kargs.seqlen_q, kargs.hdim_v);
 
+        const index_t num_splits = [&]() {
+            if constexpr(kHasSplitKV)
+                return kargs.num_splits;
+            else
+                return 1;
+        }();
+        const index_t i_nhead = i_nhead_split / num_splits;
+        [[maybe_unused]] const index_t i_split = i_nhead_split - i_nhead * num_splits;
+
         const index_t i_m0 = __builtin_amdgcn_readfirstlane(i_tile_m * FmhaPipeline::kM0);
         const index_t i_n1 = __builtin_amdgcn_readfirstlane(i_tile_n * FmhaPipeline::kN1);
 
@@ -412,14 +538,18 @@ struct FmhaFwdKernel
             const long_index_t key_start   = kargs.seqstart_k_ptr[i_batch];
 
             batch_offset_q = query_start * kargs.stride_q;
-            batch_offset_k = key_start * kargs.stride_k;
-            if constexpr(std::is_same_v<VLayout, ck_tile::tensor_layout::gemm::RowMajor>)
+            // paged K/V are addressed through the block table instead
+            if constexpr(!kIsPagedKV)
             {
-                batch_offset_v = key_start * kargs.stride_v;
-            }
-            else
-            {
-                batch_offset_v = key_start;
+                batch_offset_k = key_start * kargs.stride_k;
+                if constexpr(std::is_same_v<VLayout, ck_tile::tensor_layout::gemm::RowMajor>)
+                {
+                    batch_offset_v = key_start * kargs.stride_v;
+                }
+                else
+                {
+                    batch_offset_v = key_start;
+                }
             }
             if constexpr(kHasBias)
             {
@@ -459,8 +589,11 @@ struct FmhaFwdKernel
         else
         {
             batch_offset_q = static_cast<long_index_t>(i_batch) * kargs.batch_stride_q;
-            batch_offset_k = static_cast<long_index_t>(i_batch) * kargs.batch_stride_k;
-            batch_offset_v = static_cast<long_index_t>(i_batch) * kargs.batch_stride_v;
+            if constexpr(!kIsPagedKV)
+            {
+                batch_offset_k = static_cast<long_index_t>(i_batch) * kargs.batch_stride_k;
+                batch_offset_v = static_cast<long_index_t>(i_batch) * kargs.batch_stride_v;
+            }
             if constexpr(kHasBias)
             {
                 batch_offset_bias = static_cast<long_index_t>(i_batch) * kargs.batch_stride_bias;
@@ -472,6 +605,13 @@ struct FmhaFwdKernel
             batch_offset_o = static_cast<long_index_t>(i_batch) * kargs.batch_stride_o;
         }
 
+        // partial results of each split go to their own slice of the accumulation buffers
+        if constexpr(kHasSplitKV)
+        {
+            batch_offset_lse += static_cast<long_index_t>(i_split) * kargs.split_stride_lse_acc;
+            batch_offset_o += static_cast<long_index_t>(i_split) * kargs.split_stride_o_acc;
+        }
+
         // for simplicity, batch stride we just modify the pointer
         const QDataType* q_ptr = reinterpret_cast<const QDataType*>(kargs.q_ptr) +
                                  static_cast<long_index_t>(i_nhead) * kargs.nhead_stride_q +
@@ -511,14 +651,52 @@ struct FmhaFwdKernel
                     sequence<kPadSeqLenQ, kPadHeadDimQ>{});
             }
         }();
-        const auto k_dram = [&]() {
-            const auto k_dram_naive = make_naive_tensor_view<address_space_enum::global>(
-                k_ptr,
-                make_tuple(kargs.seqlen_k, kargs.hdim_q),
-                make_tuple(kargs.stride_k, 1),
-                number<FmhaPipeline::kAlignmentK>{},
+        // paged K/V: view the rows of all the pages of the pool as one [pool rows, hdim] tensor,
+        // the pipeline places its windows at the rows given by the block table
+        const auto make_page_pool_view = [](const auto& paged_kargs,
+                                            auto kv_ptr,
+                                            index_t hdim,
+                                            index_t page_stride,
+                                            index_t stride,
+                                            auto alignment) {
+            const auto pool_naive = make_naive_tensor_view<address_space_enum::global>(
+                kv_ptr,
+                make_tuple(paged_kargs.num_page_blocks, paged_kargs.page_block_size, hdim),
+                make_tuple(page_stride, stride, 1),
+                alignment,
                 number<1>{});
 
+            return transform_tensor_view(
+                pool_naive,
+                make_tuple(make_merge_transform(make_tuple(paged_kargs.num_page_blocks,
+                                                           paged_kargs.page_block_size)),
+                           make_pass_through_transform(hdim)),
+                make_tuple(sequence<0, 1>{}, sequence<2>{}),
+                make_tuple(sequence<0>{}, sequence<1>{}));
+        };
+
+        const auto k_dram = [&]() {
+            const auto k_dram_naive = [&]() {
+                if constexpr(kIsPagedKV)
+                {
+                    return make_page_pool_view(kargs,
+                                               k_ptr,
+                                               kargs.hdim_q,
+                                               kargs.page_stride_k,
+                                               kargs.stride_k,
+                                               number<FmhaPipeline::kAlignmentK>{});
+                }
+                else
+                {
+                    return make_naive_tensor_view<address_space_enum::global>(
+                        k_ptr,
+                        make_tuple(kargs.seqlen_k, kargs.hdim_q),
+                        make_tuple(kargs.stride_k, 1),
+                        number<FmhaPipeline::kAlignmentK>{},
+                        number<1>{});
+                }
+            }();
+
             return pad_tensor_view(
                 k_dram_naive,
                 make_tuple(number<FmhaPipeline::kN0>{}, number<FmhaPipeline::kK0>{}),
@@ -527,17 +705,38 @@ struct FmhaFwdKernel
         const auto v_dram = [&]() {
             if constexpr(std::is_same_v<VLayout, ck_tile::tensor_layout::gemm::RowMajor>)
             {
-                const auto v_dram_naive = make_naive_tensor_view<address_space_enum::global>(
-                    v_ptr,
-                    make_tuple(kargs.seqlen_k, kargs.hdim_v),
-                    make_tuple(kargs.stride_v, 1),
-                    number<FmhaPipeline::kAlignmentV>{},
-                    number<1>{});
+                const auto v_dram_naive = [&]() {
+                    if constexpr(kIsPagedKV)
+                    {
+                        return make_page_pool_view(kargs,
+                                                   v_ptr,
+                                                   kargs.hdim_v,
+                                                   kargs.page_stride_v,
+                                                   kargs.stride_v,
+                                                   number<FmhaPipeline::kAlignmentV>{});
+                    }
+                    else
+                    {
+                        return make_naive_tensor_view<address_space_enum::global>(
+                            v_ptr,
+                            make_tuple(kargs.seqlen_k, kargs.hdim_v),
+                            make_tuple(kargs.stride_v, 1),
+                            number<FmhaPipeline::kAlignmentV>{},
+                            number<1>{});
+                    }
+                }();
+
+                const index_t v_rows = [&]() {
+                    if constexpr(kIsPagedKV)
+                        return kargs.num_page_blocks * kargs.page_block_size;
+                    else
+                        return kargs.seqlen_k;
+                }();
 
                 const auto v_dram_transposed =
                     transform_tensor_view(v_dram_naive,
                                           make_tuple(make_pass_through_transform(kargs.hdim_v),
-                                                     make_pass_through_transform(kargs.seqlen_k)),
+                                                     make_pass_through_transform(v_rows)),
                                           make_tuple(sequence<1>{}, sequence<0>{}),
                                           make_tuple(sequence<0>{}, sequence<1>{}));
 
@@ -642,6 +841,25 @@ struct FmhaFwdKernel
             }
         }();
 
+        /// FIXME: Before C++20, capturing structured binding variables are not supported. Remove
+        /// following copy capture of the 'i_batch' if in C++20
+        const auto kv_page_navigator = [&, i_batch_ = i_batch]() {
+            if constexpr(kIsPagedKV)
+            {
+                // keep one page for seqlen_k = 0, whatever is read from it gets masked out
+                return PageBlockNavigator{
+                    kargs.block_table_ptr +
+                        static_cast<long_index_t>(i_batch_) * kargs.batch_stride_block_table,
+                    kargs.page_block_size,
+                    max(integer_divide_ceil(kargs.seqlen_k, kargs.page_block_size), 1),
+                    kargs.seqlen_k};
+            }
+            else
+            {
+                return TrivialPageBlockNavigator{};
+            }
+        }();
+
         FmhaMask mask = [&]() {
             if constexpr(kHasMask)
                 return ck_tile::make_generic_attention_mask_from_lr_window<FmhaMask>(
@@ -654,6 +872,13 @@ struct FmhaFwdKernel
                 return FmhaMask{kargs.seqlen_q, kargs.seqlen_k};
         }();
 
+        if constexpr(kHasKVDequant)
+        {
+            const index_t i_nhead_k = i_nhead / kargs.nhead_ratio_qk;
+            kargs.scale_s *= kargs.k_descale_ptr[i_nhead_k];
+            kargs.scale_o *= kargs.v_descale_ptr[i_nhead_k];
+        }
+
         auto o_acc_tile = [&]() {
             if constexpr(kDoFp8StaticQuant)
             {
@@ -675,6 +900,20 @@ struct FmhaFwdKernel
                     kargs.scale_s,
                     smem_ptr);
             }
+            else if constexpr(kIsPagedKV || kHasSplitKV)
+            {
+                return FmhaPipeline{}(q_dram_window,
+                                      k_dram_window,
+                                      v_dram_window,
+                                      bias_dram_window,
+                                      lse_dram_window,
+                                      mask,
+                                      kargs.scale_s,
+                                      smem_ptr,
+                                      kv_page_navigator,
+                                      num_splits,
+                                      i_split);
+            }
             else
             {
                 return FmhaPipeline{}(q_dram_window,
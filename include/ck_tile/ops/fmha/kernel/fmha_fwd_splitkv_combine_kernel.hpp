@@ -0,0 +1,349 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/ops/common.hpp"
+#include <string>
+#include <type_traits>
+
+// Second half of split-kv (flash-decoding) fmha fwd. FmhaFwdKernel with kHasSplitKV writes, for
+// every split i of seqlen_k, the partial O_i normalized over its own keys and lse_i. They are
+// merged here:
+// lse[seqlen_q] = log(sum_i exp(lse_i[seqlen_q]))
+// O[seqlen_q, hdim_v] = sum_i exp(lse_i[seqlen_q] - lse[seqlen_q]) * O_i[seqlen_q, hdim_v]
+
+namespace ck_tile {
+
+template <typename LSEDataType_,
+          typename OaccDataType_,
+          typename ODataType_,
+          bool kIsGroupMode_,
+          bool kStoreLSE_>
+struct FmhaFwdSplitKVCombineKernel
+{
+    using LSEDataType  = ck_tile::remove_cvref_t<LSEDataType_>;
+    using OaccDataType = ck_tile::remove_cvref_t<OaccDataType_>;
+    using ODataType    = ck_tile::remove_cvref_t<ODataType_>;
+
+    static constexpr bool kIsGroupMode = kIsGroupMode_;
+    static constexpr bool kStoreLSE    = kStoreLSE_;
+
+    static constexpr ck_tile::index_t kBlockSize  = 256;
+    static constexpr ck_tile::index_t kBlockPerCu = 2;
+    // rows of O merged by one block
+    static constexpr ck_tile::index_t kM0 = 32;
+    // the weights of all the splits of the kM0 rows are kept in LDS
+    static constexpr ck_tile::index_t kMaxSplits = 128;
+
+    // clang-format off
+    template <typename T> struct t2s;
+    template <> struct t2s<float> { static constexpr const char * name = "fp32"; };
+    template <> struct t2s<ck_tile::fp16_t> { static constexpr const char * name = "fp16"; };
+    template <> struct t2s<ck_tile::bf16_t> { static constexpr const char * name = "bf16"; };
+    // clang-format on
+
+    __host__ static std::string GetName()
+    {
+        // clang-format off
+        return std::string("fmha_fwd_splitkv_combine_") + t2s<ODataType>::name + "_" +
+            (kIsGroupMode ? "group" : "batch") + "_b" + std::to_string(kM0) + (kStoreLSE ? "_lse" : "");
+        // clang-format on
+    }
+
+    template <ck_tile::index_t I> // to avoid duplicated base class prblem, introduce an template
+                                  // arg
+    struct EmptyKargs
+    {
+    };
+
+    // lse_acc/o_acc are laid out like lse/o of FmhaFwdKernel, with an extra outermost split
+    // dimension split_stride_lse_acc/split_stride_o_acc elements long
+    struct CommonKargs
+    {
+        const void* lse_acc_ptr;
+        const void* o_acc_ptr;
+        void* o_ptr;
+
+        ck_tile::index_t seqlen_q;
+        ck_tile::index_t hdim_v;
+        ck_tile::index_t num_splits;
+
+        ck_tile::index_t stride_o_acc;
+        ck_tile::index_t stride_o;
+
+        ck_tile::index_t nhead_stride_lse_acc;
+        ck_tile::index_t nhead_stride_o_acc;
+        ck_tile::index_t nhead_stride_o;
+
+        ck_tile::index_t split_stride_lse_acc;
+        ck_tile::index_t split_stride_o_acc;
+    };
+
+    struct CommonLSEKargs
+    {
+        void* lse_ptr                     = nullptr;
+        ck_tile::index_t nhead_stride_lse = 0;
+    };
+
+    struct BatchModeLSEKargs : CommonLSEKargs
+    {
+        ck_tile::index_t batch_stride_lse = 0;
+    };
+
+    struct BatchModeKargs
+        : CommonKargs,
+          std::conditional_t<kStoreLSE, BatchModeLSEKargs, EmptyKargs<0>>
+    {
+        ck_tile::index_t batch_stride_lse_acc;
+        ck_tile::index_t batch_stride_o_acc;
+        ck_tile::index_t batch_stride_o;
+    };
+
+    struct GroupModeKargs
+        : CommonKargs,
+          std::conditional_t<kStoreLSE, CommonLSEKargs, EmptyKargs<0>>
+    {
+        const int32_t* seqstart_q_ptr;
+    };
+
+    using Kargs = std::conditional_t<kIsGroupMode, GroupModeKargs, BatchModeKargs>;
+
+    template <bool Cond = !kIsGroupMode>
+    __host__ static constexpr std::enable_if_t<Cond, Kargs>
+    MakeKargs(const void* lse_acc_ptr,
+              const void* o_acc_ptr,
+              void* lse_ptr,
+              void* o_ptr,
+              ck_tile::index_t seqlen_q,
+              ck_tile::index_t hdim_v,
+              ck_tile::index_t num_splits,
+              ck_tile::index_t stride_o_acc,
+              ck_tile::index_t stride_o,
+              ck_tile::index_t nhead_stride_lse_acc,
+              ck_tile::index_t nhead_stride_o_acc,
+              ck_tile::index_t nhead_stride_lse,
+              ck_tile::index_t nhead_stride_o,
+              ck_tile::index_t split_stride_lse_acc,
+              ck_tile::index_t split_stride_o_acc,
+              ck_tile::index_t batch_stride_lse_acc,
+              ck_tile::index_t batch_stride_o_acc,
+              ck_tile::index_t batch_stride_lse,
+              ck_tile::index_t batch_stride_o)
+    {
+        Kargs kargs{{lse_acc_ptr,
+                     o_acc_ptr,
+                     o_ptr,
+                     seqlen_q,
+                     hdim_v,
+                     num_splits,
+                     stride_o_acc,
+                     stride_o,
+                     nhead_stride_lse_acc,
+                     nhead_stride_o_acc,
+                     nhead_stride_o,
+                     split_stride_lse_acc,
+                     split_stride_o_acc}, // args for common karg
+                    {},                   // placeholder for lse
+                    batch_stride_lse_acc,
+                    batch_stride_o_acc,
+                    batch_stride_o};
+
+        if constexpr(kStoreLSE)
+        {
+            kargs.lse_ptr          = lse_ptr;
+            kargs.nhead_stride_lse = nhead_stride_lse;
+            kargs.batch_stride_lse = batch_stride_lse;
+        }
+
+        return kargs;
+    }
+
+    template <bool Cond = kIsGroupMode>
+    __host__ static constexpr std::enable_if_t<Cond, Kargs>
+    MakeKargs(const void* lse_acc_ptr,
+              const void* o_acc_ptr,
+              void* lse_ptr,
+              void* o_ptr,
+              const void* seqstart_q_ptr,
+              ck_tile::index_t hdim_v,
+              ck_tile::index_t num_splits,
+              ck_tile::index_t stride_o_acc,
+              ck_tile::index_t stride_o,
+              ck_tile::index_t nhead_stride_lse_acc,
+              ck_tile::index_t nhead_stride_o_acc,
+              ck_tile::index_t nhead_stride_lse,
+              ck_tile::index_t nhead_stride_o,
+              ck_tile::index_t split_stride_lse_acc,
+              ck_tile::index_t split_stride_o_acc)
+    {
+        Kargs kargs{{lse_acc_ptr,
+                     o_acc_ptr,
+                     o_ptr,
+                     -1, // seqlen will be updated by another pointer
+                     hdim_v,
+                     num_splits,
+                     stride_o_acc,
+                     stride_o,
+                     nhead_stride_lse_acc,
+                     nhead_stride_o_acc,
+                     nhead_stride_o,
+                     split_stride_lse_acc,
+                     split_stride_o_acc}, // args for common karg
+                    {},                   // placeholder for lse
+                    reinterpret_cast<const int32_t*>(seqstart_q_ptr)};
+
+        if constexpr(kStoreLSE)
+        {
+            kargs.lse_ptr          = lse_ptr;
+            kargs.nhead_stride_lse = nhead_stride_lse;
+        }
+
+        return kargs;
+    }
+
+    __host__ static constexpr bool IsSupportedNumSplits(ck_tile::index_t num_splits)
+    {
+        return 1 <= num_splits && num_splits <= kMaxSplits;
+    }
+
+    __host__ static constexpr auto
+    GridSize(ck_tile::index_t batch_size_, ck_tile::index_t nhead_, ck_tile::index_t seqlen_q_)
+    {
+        return dim3(ck_tile::integer_divide_ceil(seqlen_q_, kM0), nhead_, batch_size_);
+    }
+
+    __host__ static constexpr auto BlockSize() { return dim3(kBlockSize); }
+
+    CK_TILE_DEVICE void operator()(Kargs kargs) const
+    {
+        // exp(lse_i - lse) of every split i and row of the block
+        __shared__ LSEDataType lse_scale[kMaxSplits * kM0];
+
+        const index_t i_tile_m = blockIdx.x;
+        const index_t i_nhead  = blockIdx.y;
+        const index_t i_batch  = blockIdx.z;
+
+        const index_t i_m0 = __builtin_amdgcn_readfirstlane(i_tile_m * kM0);
+
+        long_index_t batch_offset_lse_acc = 0;
+        long_index_t batch_offset_o_acc   = 0;
+        long_index_t batch_offset_lse     = 0;
+        long_index_t batch_offset_o       = 0;
+
+        if constexpr(kIsGroupMode)
+        {
+            // get starting offset for each batch
+            const long_index_t query_start = kargs.seqstart_q_ptr[i_batch];
+
+            batch_offset_lse_acc = query_start;
+            batch_offset_o_acc   = query_start * kargs.stride_o_acc;
+            batch_offset_lse     = query_start;
+            batch_offset_o       = query_start * kargs.stride_o;
+
+            // get real # queries of current batch
+            const auto adjusted_seqstart_q_ptr = kargs.seqstart_q_ptr + i_batch;
+            kargs.seqlen_q = adjusted_seqstart_q_ptr[1] - adjusted_seqstart_q_ptr[0];
+
+            // # of required blocks is different in each groups, terminate unnecessary blocks
+            // earlier
+            if(kargs.seqlen_q <= i_m0)
+            {
+                return;
+            }
+        }
+        else
+        {
+            batch_offset_lse_acc = static_cast<long_index_t>(i_batch) * kargs.batch_stride_lse_acc;
+            batch_offset_o_acc   = static_cast<long_index_t>(i_batch) * kargs.batch_stride_o_acc;
+            if constexpr(kStoreLSE)
+            {
+                batch_offset_lse = static_cast<long_index_t>(i_batch) * kargs.batch_stride_lse;
+            }
+            batch_offset_o = static_cast<long_index_t>(i_batch) * kargs.batch_stride_o;
+        }
+
+        // for simplicity, batch stride we just modify the pointer, all the pointers point to the
+        // first row of the block
+        const LSEDataType* lse_acc_ptr =
+            reinterpret_cast<const LSEDataType*>(kargs.lse_acc_ptr) +
+            static_cast<long_index_t>(i_nhead) * kargs.nhead_stride_lse_acc +
+            batch_offset_lse_acc + i_m0;
+        const OaccDataType* o_acc_ptr =
+            reinterpret_cast<const OaccDataType*>(kargs.o_acc_ptr) +
+            static_cast<long_index_t>(i_nhead) * kargs.nhead_stride_o_acc + batch_offset_o_acc +
+            static_cast<long_index_t>(i_m0) * kargs.stride_o_acc;
+        ODataType* o_ptr = reinterpret_cast<ODataType*>(kargs.o_ptr) +
+                           static_cast<long_index_t>(i_nhead) * kargs.nhead_stride_o +
+                           batch_offset_o + static_cast<long_index_t>(i_m0) * kargs.stride_o;
+
+        const index_t num_rows = min(kM0, kargs.seqlen_q - i_m0);
+        const index_t tid      = get_thread_local_1d_id();
+
+        // one thread per row, merged lse and the weight of every split
+        if(tid < num_rows)
+        {
+            LSEDataType lse_max = -numeric<LSEDataType>::infinity();
+            for(index_t i_split = 0; i_split < kargs.num_splits; ++i_split)
+            {
+                lse_max = max(lse_max, lse_acc_ptr[i_split * kargs.split_stride_lse_acc + tid]);
+            }
+
+            LSEDataType lse = lse_max;
+            // if every split is fully masked, all the weights are 0 and so is the row of O
+            if(lse_max == -numeric<LSEDataType>::infinity())
+            {
+                for(index_t i_split = 0; i_split < kargs.num_splits; ++i_split)
+                {
+                    lse_scale[i_split * kM0 + tid] = 0;
+                }
+            }
+            else
+            {
+                LSEDataType lse_sum = 0;
+                for(index_t i_split = 0; i_split < kargs.num_splits; ++i_split)
+                {
+                    lse_sum +=
+                        ck_tile::exp(lse_acc_ptr[i_split * kargs.split_stride_lse_acc + tid] -
+                                     lse_max);
+                }
+                lse = lse_max + ck_tile::log(lse_sum);
+
+                for(index_t i_split = 0; i_split < kargs.num_splits; ++i_split)
+                {
+                    lse_scale[i_split * kM0 + tid] = ck_tile::exp(
+                        lse_acc_ptr[i_split * kargs.split_stride_lse_acc + tid] - lse);
+                }
+            }
+
+            if constexpr(kStoreLSE)
+            {
+                LSEDataType* lse_ptr =
+                    reinterpret_cast<LSEDataType*>(kargs.lse_ptr) +
+                    static_cast<long_index_t>(i_nhead) * kargs.nhead_stride_lse + batch_offset_lse +
+                    i_m0;
+                lse_ptr[tid] = lse;
+            }
+        }
+        block_sync_lds();
+
+        // consecutive threads handle consecutive elements of a row of O
+        for(index_t i = tid; i < num_rows * kargs.hdim_v; i += kBlockSize)
+        {
+            const index_t i_row = i / kargs.hdim_v;
+            const index_t i_col = i - i_row * kargs.hdim_v;
+
+            OaccDataType o_acc = 0;
+            for(index_t i_split = 0; i_split < kargs.num_splits; ++i_split)
+            {
+                o_acc += type_convert<OaccDataType>(lse_scale[i_split * kM0 + i_row]) *
+                         o_acc_ptr[static_cast<long_index_t>(i_split) * kargs.split_stride_o_acc +
+                                   i_row * kargs.stride_o_acc + i_col];
+            }
+            o_ptr[i_row * kargs.stride_o + i_col] = type_convert<ODataType>(o_acc);
+        }
+    }
+};
+
+} // namespace ck_tile
@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+namespace ck_tile {
+
+// Host side scheduling of group (varlen) mode fmha fwd. FmhaFwdTilePartitioner sizes the grid by
+// the longest sequence, so short sequences leave most of their blocks empty. The work list below
+// only holds the (batch, head, q-tile) units that exist and packs them longest first onto a fixed
+// number of persistent blocks.
+//
+// Costs are counted in (query row, key column) pairs. Masking is not taken into account.
+
+struct FmhaFwdWorkItem
+{
+    index_t i_batch;
+    index_t i_nhead;
+    index_t i_tile_m;
+    index_t i_tile_n;
+};
+
+struct FmhaFwdScheduleProblem
+{
+    std::vector<int32_t> seqstart_q;
+    std::vector<int32_t> seqstart_k;
+    index_t nhead;
+    index_t hdim_v;
+    index_t kM0;
+    index_t kN1;
+    // blocks resident on the device at the same time, e.g. number of CUs * blocks per CU
+    index_t num_slots;
+    // fixed cost of every launched block, also paid by blocks without work
+    long_index_t block_overhead = 0;
+};
+
+struct FmhaFwdWorkList
+{
+    // units of persistent block i are items[block_starts[i]] ... items[block_starts[i + 1] - 1]
+    std::vector<FmhaFwdWorkItem> items;
+    std::vector<index_t> block_starts;
+    std::vector<long_index_t> block_costs;
+};
+
+struct FmhaFwdScheduleStats
+{
+    index_t num_blocks      = 0;
+    index_t num_idle_blocks = 0; // blocks launched without any work
+    long_index_t total_cost = 0; // cost of the useful work
+    long_index_t makespan   = 0; // predicted finish time of the last slot
+    // total_cost / (makespan * num_slots), 1 means all slots are busy until the end
+    double efficiency = 0;
+};
+
+CK_TILE_HOST long_index_t get_fmha_fwd_work_cost(const FmhaFwdScheduleProblem& problem,
+                                                 const FmhaFwdWorkItem& item)
+{
+    const index_t seqlen_q =
+        problem.seqstart_q[item.i_batch + 1] - problem.seqstart_q[item.i_batch];
+    const index_t seqlen_k =
+        problem.seqstart_k[item.i_batch + 1] - problem.seqstart_k[item.i_batch];
+    const index_t rows = min(problem.kM0, seqlen_q - item.i_tile_m * problem.kM0);
+    if(rows <= 0)
+        return 0;
+    const index_t cols = min(problem.kN1, problem.hdim_v - item.i_tile_n * problem.kN1);
+    return static_cast<long_index_t>(rows) * seqlen_k * cols / problem.kN1;
+}
+
+// All (batch, head, q-tile, v-tile) units that have at least one query row, longest first
+CK_TILE_HOST std::vector<FmhaFwdWorkItem>
+make_fmha_fwd_work_items(const FmhaFwdScheduleProblem& problem)
+{
+    const index_t batch       = static_cast<index_t>(problem.seqstart_q.size()) - 1;
+    const index_t num_tile_n1 = integer_divide_ceil(problem.hdim_v, problem.kN1);
+
+    std::vector<FmhaFwdWorkItem> items;
+    for(index_t i_batch = 0; i_batch < batch; ++i_batch)
+    {
+        const index_t seqlen_q = problem.seqstart_q[i_batch + 1] - problem.seqstart_q[i_batch];
+        const index_t num_tile_m0 = integer_divide_ceil(seqlen_q, problem.kM0);
+        for(index_t i_nhead = 0; i_nhead < problem.nhead; ++i_nhead)
+            for(index_t i_tile_m = 0; i_tile_m < num_tile_m0; ++i_tile_m)
+                for(index_t i_tile_n = 0; i_tile_n < num_tile_n1; ++i_tile_n)
+                    items.push_back({i_batch, i_nhead, i_tile_m, i_tile_n});
+    }
+
+    std::stable_sort(items.begin(), items.end(), [&](const auto& lhs, const auto& rhs) {
+        return get_fmha_fwd_work_cost(problem, lhs) > get_fmha_fwd_work_cost(problem, rhs);
+    });
+    return items;
+}
+
+// Longest-processing-time-first packing: every unit goes to the least loaded persistent block
+CK_TILE_HOST FmhaFwdWorkList make_fmha_fwd_work_list(const FmhaFwdScheduleProblem& problem,
+                                                     index_t num_blocks)
+{
+    const auto items = make_fmha_fwd_work_items(problem);
+
+    using slot = std::pair<long_index_t, index_t>; // (cost, block)
+    std::priority_queue<slot, std::vector<slot>, std::greater<slot>> blocks;
+    for(index_t i_block = 0; i_block < num_blocks; ++i_block)
+        blocks.push({problem.block_overhead, i_block});
+
+    std::vector<std::vector<FmhaFwdWorkItem>> block_items(num_blocks);
+    FmhaFwdWorkList work_list;
+    work_list.block_costs.assign(num_blocks, problem.block_overhead);
+    for(const auto& item : items)
+    {
+        auto [cost, i_block] = blocks.top();
+        blocks.pop();
+        cost += get_fmha_fwd_work_cost(problem, item);
+        block_items[i_block].push_back(item);
+        work_list.block_costs[i_block] = cost;
+        blocks.push({cost, i_block});
+    }
+
+    work_list.block_starts.push_back(0);
+    for(const auto& v : block_items)
+    {
+        work_list.items.insert(work_list.items.end(), v.begin(), v.end());
+        work_list.block_starts.push_back(static_cast<index_t>(work_list.items.size()));
+    }
+    return work_list;
+}
+
+namespace detail {
+// Blocks are dispatched in order, each one to the slot that frees up first
+CK_TILE_HOST FmhaFwdScheduleStats
+simulate_fmha_fwd_dispatch(const std::vector<long_index_t>& block_costs,
+                           long_index_t total_cost,
+                           index_t num_idle_blocks,
+                           index_t num_slots)
+{
+    std::priority_queue<long_index_t, std::vector<long_index_t>, std::greater<long_index_t>>
+        slots;
+    for(index_t i = 0; i < num_slots; ++i)
+        slots.push(0);
+
+    long_index_t makespan = 0;
+    for(auto cost : block_costs)
+    {
+        auto finish = slots.top() + cost;
+        slots.pop();
+        slots.push(finish);
+        makespan = max(makespan, finish);
+    }
+
+    FmhaFwdScheduleStats stats;
+    stats.num_blocks      = static_cast<index_t>(block_costs.size());
+    stats.num_idle_blocks = num_idle_blocks;
+    stats.total_cost      = total_cost;
+    stats.makespan        = makespan;
+    stats.efficiency =
+        makespan == 0 ? 1.0 : static_cast<double>(total_cost) / (makespan * double(num_slots));
+    return stats;
+}
+} // namespace detail
+
+// Predicted behavior of the grid of FmhaFwdTilePartitioner::GridSize(batch, nhead, max_seqlen_q,
+// hdim_v), launched with x (q-tile, v-tile) fastest, then head, then batch
+CK_TILE_HOST FmhaFwdScheduleStats get_fmha_fwd_grid_stats(const FmhaFwdScheduleProblem& problem)
+{
+    const index_t batch = static_cast<index_t>(problem.seqstart_q.size()) - 1;
+    index_t max_seqlen_q = 0;
+    for(index_t i_batch = 0; i_batch < batch; ++i_batch)
+        max_seqlen_q =
+            max(max_seqlen_q, problem.seqstart_q[i_batch + 1] - problem.seqstart_q[i_batch]);
+    const index_t num_tile_m0 = integer_divide_ceil(max_seqlen_q, problem.kM0);
+    const index_t num_tile_n1 = integer_divide_ceil(problem.hdim_v, problem.kN1);
+
+    std::vector<long_index_t> block_costs;
+    long_index_t total_cost = 0;
+    index_t num_idle_blocks = 0;
+    for(index_t i_batch = 0; i_batch < batch; ++i_batch)
+        for(index_t i_nhead = 0; i_nhead < problem.nhead; ++i_nhead)
+            for(index_t i_tile_m = 0; i_tile_m < num_tile_m0; ++i_tile_m)
+                for(index_t i_tile_n = 0; i_tile_n < num_tile_n1; ++i_tile_n)
+                {
+                    const auto cost = get_fmha_fwd_work_cost(
+                        problem, FmhaFwdWorkItem{i_batch, i_nhead, i_tile_m, i_tile_n});
+                    total_cost += cost;
+                    num_idle_blocks += (cost == 0);
+                    block_costs.push_back(problem.block_overhead + cost);
+                }
+    return detail::simulate_fmha_fwd_dispatch(
+        block_costs, total_cost, num_idle_blocks, problem.num_slots);
+}
+
+// Predicted behavior of a persistent launch of the work list, one block per slot at most
+CK_TILE_HOST FmhaFwdScheduleStats
+get_fmha_fwd_work_list_stats(const FmhaFwdScheduleProblem& problem,
+                             const FmhaFwdWorkList& work_list)
+{
+    long_index_t total_cost = 0;
+    for(const auto& item : work_list.items)
+        total_cost += get_fmha_fwd_work_cost(problem, item);
+
+    index_t num_idle_blocks = 0;
+    for(std::size_t i = 0; i + 1 < work_list.block_starts.size(); ++i)
+        num_idle_blocks += (work_list.block_starts[i] == work_list.block_starts[i + 1]);
+
+    return detail::simulate_fmha_fwd_dispatch(
+        work_list.block_costs, total_cost, num_idle_blocks, problem.num_slots);
+}
+
+} // namespace ck_tile
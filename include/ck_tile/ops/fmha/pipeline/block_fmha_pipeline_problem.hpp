@@ -49,6 +49,9 @@ struct BlockFmhaPipelineProblem
     static constexpr bool kStoreLSE         = Traits::kStoreLSE;
     static constexpr bool kDoFp8StaticQuant = Traits::kDoFp8StaticQuant;
     static constexpr index_t kBlockPerCu    = Traits::kBlockPerCu;
+    static constexpr bool kIsPagedKV        = Traits::kIsPagedKV;
+    static constexpr bool kHasSplitKV       = Traits::kHasSplitKV;
+    static constexpr bool kHasKVDequant     = Traits::kHasKVDequant;
 };
 
 } // namespace ck_tile
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ck_tile/core.hpp"
+#include "ck_tile/ops/fmha/block/page_block_navigator.hpp"
 #include "ck_tile/ops/fmha/pipeline/block_fmha_pipeline_qr_ks_vs_default_policy.hpp"
 #include "ck_tile/ops/reduce/block/block_reduce.hpp"
 
@@ -48,6 +49,19 @@ struct BlockFmhaPipelineQRKSVS
     static constexpr bool kPadHeadDimV = Problem::kPadHeadDimV;
     static constexpr bool kHasBias     = Problem::kHasBias;
     static constexpr bool kStoreLSE    = Problem::kStoreLSE;
+    static constexpr bool kIsPagedKV   = Problem::kIsPagedKV;
+    static constexpr bool kHasSplitKV  = Problem::kHasSplitKV;
+
+    // the last page of a sequence is only partially valid, the scores of the K rows past seqlen_k
+    // are masked by the seqlen_k padding check and those V rows are zeroed. V is paged along the
+    // rows of its [seqlen_k, hdim_v] layout
+    static_assert(!kIsPagedKV ||
+                      (kPadSeqLenK &&
+                       std::is_same_v<VLayout, ck_tile::tensor_layout::gemm::RowMajor>),
+                  "paged kv requires seqlen_k padding and row-major V");
+
+    // partial results of the splits are merged through their lse
+    static_assert(!kHasSplitKV || kStoreLSE, "split kv requires storing lse");
 
     // last dimension vector length used to create tensor view(and decide buffer_load vector length)
     // ... together with tensor distribution. tensor dist should able to overwrite this
@@ -113,7 +127,8 @@ struct BlockFmhaPipelineQRKSVS
               typename LSEElementFunction,
               typename SAccElementFunction,
               typename PComputeElementFunction,
-              typename OAccElementFunction>
+              typename OAccElementFunction,
+              typename KVPageNavigator = TrivialPageBlockNavigator>
     CK_TILE_HOST_DEVICE auto
     operator()(const QDramBlockWindowTmp& q_dram_block_window_tmp, // M0*K0 tile
                const QElementFunction& q_element_func,
@@ -130,7 +145,10 @@ struct BlockFmhaPipelineQRKSVS
                const OAccElementFunction& o_acc_element_func,
                FmhaMask mask,
                float scale_s,
-               void* smem_ptr) const
+               void* smem_ptr,
+               const KVPageNavigator& kv_page_navigator = {},
+               index_t num_splits                       = 1,
+               index_t i_split                          = 0) const
     {
         static_assert(
             std::is_same_v<QDataType, remove_cvref_t<typename QDramBlockWindowTmp::DataType>> &&
@@ -199,13 +217,30 @@ struct BlockFmhaPipelineQRKSVS
         clear_tile(l);
 
         const auto q_origin = q_dram_window.get_window_origin();
-        const auto [seqlen_k_start, seqlen_k_end] =
-            mask.GetTileRangeAlongX(q_origin.at(number<0>{}), number<kM0>{}, number<kN0>{});
+        const auto [seqlen_k_start, seqlen_k_end] = [&]() {
+            const auto [x_start, x_end] =
+                mask.GetTileRangeAlongX(q_origin.at(number<0>{}), number<kM0>{}, number<kN0>{});
+            if constexpr(kHasSplitKV)
+            {
+                // every split takes an equal share of the kN0 tiles visited by this q tile, the
+                // last splits may get fewer of them or none at all
+                const index_t num_tiles = integer_divide_ceil(max(x_end - x_start, 0), kN0);
+                const index_t num_tiles_per_split = integer_divide_ceil(num_tiles, num_splits);
+                const index_t split_start =
+                    x_start + min(i_split * num_tiles_per_split, num_tiles) * kN0;
+                const index_t split_end = min(split_start + num_tiles_per_split * kN0, x_end);
+                return make_tuple(split_start, split_end);
+            }
+            else
+            {
+                return make_tuple(x_start, x_end);
+            }
+        }();
 
         const auto num_total_loop = integer_divide_ceil(seqlen_k_end - seqlen_k_start, kN0);
 
         // check early exit if masked and no work to do.
-        if constexpr(FmhaMask::IsMasking)
+        if constexpr(FmhaMask::IsMasking || kHasSplitKV)
         {
             if(num_total_loop <= 0)
             {
@@ -225,10 +260,14 @@ struct BlockFmhaPipelineQRKSVS
             }
         }
 
+        // K/V windows are placed at physical rows, while masking and bias use logical positions
+        index_t seqlen_k_curr     = seqlen_k_start;
+        const index_t k_row_start = kv_page_navigator.get_physical_row(seqlen_k_start);
+
         auto k_dram_block_window =
             make_tile_window(k_dram_block_window_tmp.get_bottom_tensor_view(),
                              k_dram_block_window_tmp.get_window_lengths(),
-                             {seqlen_k_start, 0});
+                             {k_row_start, 0});
 
         const auto bias_origin = bias_dram_block_window_tmp.get_window_origin();
         auto bias_dram_window  = make_tile_window(
@@ -240,11 +279,26 @@ struct BlockFmhaPipelineQRKSVS
         auto v_dram_window =
             make_tile_window(v_dram_block_window_tmp.get_bottom_tensor_view(),
                              v_dram_block_window_tmp.get_window_lengths(),
-                             {0, seqlen_k_start}, // TODO: hdim split?
+                             {0, k_row_start}, // TODO: hdim split?
                              Policy::template MakeVDramTileDistribution<Problem>());
 
         auto q_tile = tile_elementwise_in(q_element_func, q);
 
+        // the V rows of the last page past seqlen_k are not covered by the seqlen_k padding of
+        // the view, zero them so that garbage (e.g. NaN) does not leak into P * V through P = 0
+        const auto zero_invalid_v_rows = [&](auto& v_tile, index_t v_seqlen_k) {
+            if constexpr(kIsPagedKV)
+            {
+                if(!kv_page_navigator.is_valid_row(v_seqlen_k + kK1 - 1))
+                {
+                    set_tile_if(v_tile, type_convert<VDataType>(0.f), [&](auto tile_idx) {
+                        return !kv_page_navigator.is_valid_row(v_seqlen_k +
+                                                               tile_idx.at(number<1>{}));
+                    });
+                }
+            }
+        };
+
         // prefetch K tile
         index_t i_total_loops      = 0;
         constexpr index_t k0_loops = kK0BlockLength / kK0;
@@ -301,7 +355,8 @@ struct BlockFmhaPipelineQRKSVS
                 });
             }
 
-            const auto v_prefetch = load_tile(v_dram_window); // prefetch load v tile
+            auto v_prefetch = load_tile(v_dram_window); // prefetch load v tile
+            zero_invalid_v_rows(v_prefetch, seqlen_k_curr);
             {                                                 // tail
                 block_sync_lds();
                 gemm_0(s_acc,
@@ -348,17 +403,14 @@ struct BlockFmhaPipelineQRKSVS
             move_tile_window(bias_dram_window, {0, kN0});
             if constexpr(kPadSeqLenK || FmhaMask::IsMasking)
             {
-                const auto k_origin      = k_dram_block_window.get_window_origin();
-                bool need_perpixel_check = mask.IsEdgeTile(q_origin.at(number<0>{}),
-                                                           k_origin.at(number<0>{}),
-                                                           number<kM0>{},
-                                                           number<kN0>{});
+                bool need_perpixel_check = mask.IsEdgeTile(
+                    q_origin.at(number<0>{}), seqlen_k_curr, number<kM0>{}, number<kN0>{});
                 if(need_perpixel_check)
                 {
                     set_tile_if(
                         s_acc, -numeric<SMPLComputeDataType>::infinity(), [&](auto tile_idx) {
                             const auto row = q_origin.at(number<0>{}) + tile_idx.at(number<0>{});
-                            const auto col = k_origin.at(number<0>{}) + tile_idx.at(number<1>{});
+                            const auto col = seqlen_k_curr + tile_idx.at(number<1>{});
                             return mask.IsOutOfBound(row, col);
                         });
                 }
@@ -474,7 +526,8 @@ struct BlockFmhaPipelineQRKSVS
             if constexpr(k1_loops > 1)
             {
                 static_for<0, k1_loops - 1, 1>{}([&](auto i_k1) {
-                    const auto v = load_tile(v_dram_window); // load next v
+                    auto v = load_tile(v_dram_window); // load next v
+                    zero_invalid_v_rows(v, seqlen_k_curr + (i_k1 + 1) * kK1);
                     block_sync_lds();
                     gemm_1(o_acc,
                            get_slice_tile(
@@ -499,7 +552,19 @@ struct BlockFmhaPipelineQRKSVS
                 });
             }
             // move K tile windows
-            move_tile_window(k_dram_block_window, {kN0, 0});
+            if constexpr(kIsPagedKV)
+            {
+                // the next kN0 keys may start a new page, V has already advanced by kN0 rows
+                const index_t k_row_curr = kv_page_navigator.get_physical_row(seqlen_k_curr);
+                const index_t k_row_next = kv_page_navigator.get_physical_row(seqlen_k_curr + kN0);
+                move_tile_window(k_dram_block_window, {k_row_next - k_row_curr, 0});
+                move_tile_window(v_dram_window, {0, k_row_next - k_row_curr - kN0});
+            }
+            else
+            {
+                move_tile_window(k_dram_block_window, {kN0, 0});
+            }
+            seqlen_k_curr += kN0;
             // tail
             {
                 block_sync_lds();
@@ -563,7 +628,8 @@ struct BlockFmhaPipelineQRKSVS
               typename KDramBlockWindowTmp,
               typename VDramBlockWindowTmp,
               typename BiasDramBlockWindowTmp,
-              typename LSEDramBlockWindowTmp>
+              typename LSEDramBlockWindowTmp,
+              typename KVPageNavigator = TrivialPageBlockNavigator>
     CK_TILE_HOST_DEVICE auto
     operator()(const QDramBlockWindowTmp& q_dram_block_window_tmp,       // M0*K0 tile
                const KDramBlockWindowTmp& k_dram_block_window_tmp,       // N0*K0 tile
@@ -572,7 +638,10 @@ struct BlockFmhaPipelineQRKSVS
                LSEDramBlockWindowTmp& lse_dram_block_window_tmp,         // M0*1 tile
                FmhaMask mask,
                float scale_s,
-               void* smem_ptr) const
+               void* smem_ptr,
+               const KVPageNavigator& kv_page_navigator = {},
+               index_t num_splits                       = 1,
+               index_t i_split                          = 0) const
     {
         return operator()(q_dram_block_window_tmp,
                           identity{},
@@ -589,7 +658,10 @@ struct BlockFmhaPipelineQRKSVS
                           identity{},
                           mask,
                           scale_s,
-                          smem_ptr);
+                          smem_ptr,
+                          kv_page_navigator,
+                          num_splits,
+                          i_split);
     }
 };
 
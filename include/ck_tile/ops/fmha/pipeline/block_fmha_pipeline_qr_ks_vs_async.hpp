@@ -53,6 +53,8 @@ struct BlockFmhaPipelineQRKSVSAsync
     static constexpr bool kPadHeadDimV = true; // support multiple of vector(like 8x)
     static constexpr bool kHasBias     = Problem::kHasBias;
     static constexpr bool kStoreLSE    = Problem::kStoreLSE;
+    static_assert(!Problem::kIsPagedKV, "paged kv is only supported by the qr pipeline");
+    static_assert(!Problem::kHasSplitKV, "split kv is only supported by the qr pipeline");
 
     // last dimension vector length used to create tensor view(and decide buffer_load vector length)
     // ... together with tensor distribution. tensor dist should able to overwrite this
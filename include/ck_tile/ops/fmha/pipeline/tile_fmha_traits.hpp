@@ -14,7 +14,10 @@ template <bool kPadSeqLenQ_ /* padding for seqlen_q */,
           bool kHasBias_,
           bool kStoreLSE_,
           bool kDoFp8StaticQuant_,
-          index_t kBlockPerCu_ = -1 /* overwrite occupancy if not -1 */>
+          index_t kBlockPerCu_ = -1 /* overwrite occupancy if not -1 */,
+          bool kIsPagedKV_     = false /* K/V are read through a block table of pages */,
+          bool kHasSplitKV_    = false /* seqlen_k is split across blocks, see combine kernel */,
+          bool kHasKVDequant_  = false /* K/V are dequantized by per-head scales */>
 struct TileFmhaTraits
 {
     static constexpr bool kPadSeqLenQ       = kPadSeqLenQ_;
@@ -25,6 +28,9 @@ struct TileFmhaTraits
     static constexpr bool kStoreLSE         = kStoreLSE_;
     static constexpr bool kDoFp8StaticQuant = kDoFp8StaticQuant_;
     static constexpr index_t kBlockPerCu    = kBlockPerCu_;
+    static constexpr bool kIsPagedKV        = kIsPagedKV_;
+    static constexpr bool kHasSplitKV       = kHasSplitKV_;
+    static constexpr bool kHasKVDequant     = kHasKVDequant_;
 };
 
 } // namespace ck_tile
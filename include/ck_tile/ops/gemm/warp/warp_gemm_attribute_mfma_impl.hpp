@@ -7,6 +7,50 @@
 
 namespace ck_tile {
 
+#if CK_TILE_HOST_EMULATION
+namespace host_emulation {
+// c_vec += a_vec * b_vec with the lane layouts of the mfma Impl, from the a_vec/b_vec of every lane
+// of the warp. C[m][n] += sum_k A[m][k] * B[n][k], accumulated in float
+template <typename Impl>
+CK_TILE_HOST void mfma(const Impl&,
+                       typename Impl::CVecType& c_vec,
+                       const typename Impl::AVecType& a_vec,
+                       const typename Impl::BVecType& b_vec)
+{
+    using AArray = array<typename Impl::ADataType, Impl::kABKPerLane>;
+    using BArray = array<typename Impl::BDataType, Impl::kABKPerLane>;
+    using CArray = array<typename Impl::CDataType, Impl::kCM0PerLane * Impl::kCM1PerLane>;
+
+    AArray a_all[get_warp_size()];
+    BArray b_all[get_warp_size()];
+    warp_all_gather(bit_cast<AArray>(a_vec), a_all);
+    warp_all_gather(bit_cast<BArray>(b_vec), b_all);
+
+    auto c              = bit_cast<CArray>(c_vec);
+    const index_t lane  = get_lane_id();
+    const index_t n     = lane % Impl::kCNLane;
+    const index_t mlane = lane / Impl::kCNLane;
+    for(index_t m0 = 0; m0 < Impl::kCM0PerLane; ++m0)
+    {
+        for(index_t m1 = 0; m1 < Impl::kCM1PerLane; ++m1)
+        {
+            const index_t m = (m0 * Impl::kCMLane + mlane) * Impl::kCM1PerLane + m1;
+            float acc       = type_convert<float>(c[m0 * Impl::kCM1PerLane + m1]);
+            for(index_t k = 0; k < Impl::kK; ++k)
+            {
+                const index_t klane = k / Impl::kABKPerLane;
+                const index_t kpack = k % Impl::kABKPerLane;
+                acc += type_convert<float>(a_all[klane * Impl::kAMLane + m][kpack]) *
+                       type_convert<float>(b_all[klane * Impl::kBNLane + n][kpack]);
+            }
+            c(m0 * Impl::kCM1PerLane + m1) = type_convert<typename Impl::CDataType>(acc);
+        }
+    }
+    c_vec = bit_cast<typename Impl::CVecType>(c);
+}
+} // namespace host_emulation
+#endif
+
 // FP16
 struct WarpGemmAttributeMfmaImplF16F16F32M32N32K8
 {
@@ -39,6 +83,8 @@ struct WarpGemmAttributeMfmaImplF16F16F32M32N32K8
 #if defined(__gfx908__) || defined(__gfx90a__) || defined(__gfx940__) || defined(__gfx941__) || \
     defined(__gfx942__)
         c_vec = __builtin_amdgcn_mfma_f32_32x32x8f16(a_vec, b_vec, c_vec, 0, 0, 0);
+#elif CK_TILE_HOST_EMULATION
+        host_emulation::mfma(*this, c_vec, a_vec, b_vec);
 #else
         ck_tile::ignore = c_vec;
         ck_tile::ignore = a_vec;
@@ -53,6 +99,10 @@ struct WarpGemmAttributeMfmaImplF16F16F32M32N32K8
     defined(__gfx942__)
         return bit_cast<CVecType>(
             __builtin_amdgcn_mfma_f32_32x32x8f16(a_vec, b_vec, fp32x16_t{0.f}, 0, 0, 0));
+#elif CK_TILE_HOST_EMULATION
+        CVecType c_vec{0.f};
+        host_emulation::mfma(*this, c_vec, a_vec, b_vec);
+        return c_vec;
 #else
         ck_tile::ignore = a_vec;
         ck_tile::ignore = b_vec;
@@ -92,6 +142,8 @@ struct WarpGemmAttributeMfmaImplF16F16F32M16N16K16
 #if defined(__gfx908__) || defined(__gfx90a__) || defined(__gfx940__) || defined(__gfx941__) || \
     defined(__gfx942__)
         c_vec = __builtin_amdgcn_mfma_f32_16x16x16f16(a_vec, b_vec, c_vec, 0, 0, 0);
+#elif CK_TILE_HOST_EMULATION
+        host_emulation::mfma(*this, c_vec, a_vec, b_vec);
 #else
         ck_tile::ignore = c_vec;
         ck_tile::ignore = a_vec;
@@ -106,6 +158,10 @@ struct WarpGemmAttributeMfmaImplF16F16F32M16N16K16
     defined(__gfx942__)
         return bit_cast<CVecType>(
             __builtin_amdgcn_mfma_f32_16x16x16f16(a_vec, b_vec, fp32x4_t{0.f}, 0, 0, 0));
+#elif CK_TILE_HOST_EMULATION
+        CVecType c_vec{0.f};
+        host_emulation::mfma(*this, c_vec, a_vec, b_vec);
+        return c_vec;
 #else
         ck_tile::ignore = a_vec;
         ck_tile::ignore = b_vec;
@@ -157,6 +213,8 @@ struct WarpGemmAttributeMfmaImplBf16Bf16F32M32N32K8
                 0,
                 0);
         });
+#elif CK_TILE_HOST_EMULATION
+        host_emulation::mfma(*this, c_vec, a_vec, b_vec);
 #else
         ck_tile::ignore = c_vec;
         ck_tile::ignore = a_vec;
@@ -184,6 +242,10 @@ struct WarpGemmAttributeMfmaImplBf16Bf16F32M32N32K8
                 0);
         });
         return c_vec;
+#elif CK_TILE_HOST_EMULATION
+        CVecType c_vec{0.f};
+        host_emulation::mfma(*this, c_vec, a_vec, b_vec);
+        return c_vec;
 #else
         ck_tile::ignore = a_vec;
         ck_tile::ignore = b_vec;
@@ -234,6 +296,8 @@ struct WarpGemmAttributeMfmaImplBf16Bf16F32M16N16K16
                 0,
                 0);
         });
+#elif CK_TILE_HOST_EMULATION
+        host_emulation::mfma(*this, c_vec, a_vec, b_vec);
 #else
         ck_tile::ignore = c_vec;
         ck_tile::ignore = a_vec;
@@ -261,6 +325,10 @@ struct WarpGemmAttributeMfmaImplBf16Bf16F32M16N16K16
                 0);
         });
         return c_vec;
+#elif CK_TILE_HOST_EMULATION
+        CVecType c_vec{0.f};
+        host_emulation::mfma(*this, c_vec, a_vec, b_vec);
+        return c_vec;
 #else
         ck_tile::ignore = a_vec;
         ck_tile::ignore = b_vec;
@@ -323,6 +391,8 @@ struct WarpGemmAttributeMfmaImpl_f32_32x32x16_f8_base
 
             c_vec = __builtin_amdgcn_mfma_f32_32x32x2f32(a_f32, b_f32, c_vec, 0, 0, 0);
         });
+#elif CK_TILE_HOST_EMULATION
+        host_emulation::mfma(*this, c_vec, a_vec, b_vec);
 #else
         ck_tile::ignore = c_vec;
         ck_tile::ignore = a_vec;
@@ -359,6 +429,10 @@ struct WarpGemmAttributeMfmaImpl_f32_32x32x16_f8_base
             c_vec = __builtin_amdgcn_mfma_f32_32x32x2f32(a_f32, b_f32, c_vec, 0, 0, 0);
         });
         return c_vec;
+#elif CK_TILE_HOST_EMULATION
+        CVecType c_vec{0.f};
+        host_emulation::mfma(*this, c_vec, a_vec, b_vec);
+        return c_vec;
 #else
         ck_tile::ignore = a_vec;
         ck_tile::ignore = b_vec;
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: MIT
 // Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
 
+#pragma once
+
 #include <cstdlib>
 
 #include "ck/ck.hpp"
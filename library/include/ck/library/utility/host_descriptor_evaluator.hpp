@@ -0,0 +1,328 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/common_header.hpp"
+#include "ck/tensor_description/tensor_descriptor.hpp"
+#include "ck/library/utility/lds_bank_conflict.hpp"
+
+namespace ck {
+namespace utils {
+
+// Offsets of every visible index of a TensorDescriptor, in row-major order of the visible
+// dimensions. Invalid elements (padding, out of bound after a merge/xor...) keep offset -1.
+struct DescriptorOffsetTable
+{
+    std::vector<index_t> mLengths;
+    std::vector<index_t> mOffsets;
+    std::vector<bool> mValid;
+    long_index_t mElementSpaceSize = 0;
+
+    std::size_t GetElementSize() const { return mOffsets.size(); }
+
+    // row-major linear index of a visible index
+    std::size_t GetLinearIndex(const std::vector<index_t>& idx) const
+    {
+        std::size_t linear = 0;
+        for(std::size_t d = 0; d < mLengths.size(); ++d)
+            linear = linear * mLengths[d] + idx[d];
+        return linear;
+    }
+
+    index_t GetOffset(const std::vector<index_t>& idx) const
+    {
+        return mOffsets[GetLinearIndex(idx)];
+    }
+
+    bool IsValid(const std::vector<index_t>& idx) const { return mValid[GetLinearIndex(idx)]; }
+};
+
+// Evaluates desc on the host the way the threadwise copies walk it: a coordinate is made at the
+// start of every row and moved along the last visible dimension, so the UpdateLowerIndex path of
+// every transform is covered as well as CalculateLowerIndex. Wrapper layouts can be evaluated
+// through their layout.GetUnrolledDescriptor(). The table has one entry per visible element, use
+// it on the small problem sizes of unit tests.
+template <typename TensorDesc>
+DescriptorOffsetTable evaluate_descriptor(const TensorDesc& desc)
+{
+    constexpr index_t NDim = TensorDesc::GetNumOfDimension();
+    static_assert(NDim > 0, "wrong! empty descriptor");
+
+    DescriptorOffsetTable table;
+    table.mElementSpaceSize = desc.GetElementSpaceSize();
+    table.mLengths.resize(NDim);
+    static_for<0, NDim, 1>{}([&](auto i) { table.mLengths[i] = desc.GetLength(i); });
+
+    std::size_t size = 1;
+    for(const auto length : table.mLengths)
+        size *= length;
+    table.mOffsets.assign(size, -1);
+    table.mValid.assign(size, false);
+    if(size == 0)
+        return table;
+
+    const index_t row_length = table.mLengths[NDim - 1];
+
+    auto step_idx                = make_zero_multi_index<NDim>();
+    step_idx(Number<NDim - 1>{}) = 1;
+    const auto step              = make_tensor_coordinate_step(desc, step_idx);
+
+    std::vector<index_t> row_idx(NDim, 0);
+    for(std::size_t row_begin = 0; row_begin < size; row_begin += row_length)
+    {
+        auto idx = make_zero_multi_index<NDim>();
+        static_for<0, NDim, 1>{}([&](auto i) { idx(i) = row_idx[i]; });
+
+        auto coord = make_tensor_coordinate(desc, idx);
+        for(index_t j = 0; j < row_length; ++j)
+        {
+            if(j > 0)
+                move_tensor_coordinate(desc, coord, step);
+
+            if(coordinate_has_valid_offset_assuming_visible_index_is_valid(desc, coord))
+            {
+                table.mOffsets[row_begin + j] = coord.GetOffset();
+                table.mValid[row_begin + j]   = true;
+            }
+        }
+
+        // next row
+        for(index_t d = NDim - 2; d >= 0; --d)
+        {
+            if(++row_idx[d] < table.mLengths[d])
+                break;
+            row_idx[d] = 0;
+        }
+    }
+
+    return table;
+}
+
+// Maximal runs of consecutive elements (in the order of the table) whose offsets have a constant
+// stride. Invalid elements form their own runs.
+struct StridedRun
+{
+    std::size_t mBegin; // linear index of the first element
+    std::size_t mLength;
+    index_t mOffset; // offset of the first element, -1 for invalid runs
+    index_t mStride;
+    bool mValid;
+};
+
+inline std::vector<StridedRun> compress_offset_table(const DescriptorOffsetTable& table)
+{
+    std::vector<StridedRun> runs;
+    for(std::size_t i = 0; i < table.GetElementSize(); ++i)
+    {
+        const bool valid = table.mValid[i];
+        if(!runs.empty())
+        {
+            auto& run = runs.back();
+            if(!valid && !run.mValid)
+            {
+                ++run.mLength;
+                continue;
+            }
+            if(valid && run.mValid)
+            {
+                const index_t stride = table.mOffsets[i] - table.mOffsets[i - 1];
+                if(run.mLength == 1)
+                    run.mStride = stride;
+                if(run.mStride == stride)
+                {
+                    ++run.mLength;
+                    continue;
+                }
+            }
+        }
+        runs.push_back(StridedRun{i, 1, table.mOffsets[i], 0, valid});
+    }
+    return runs;
+}
+
+// The largest vector length, a power of 2 up to max_vector_length, that dimension dim can be
+// accessed with: every aligned group of that many elements along dim is either invalid as a whole
+// (one predicate for the vector, like the padding of a conv), or valid with consecutive offsets
+// starting at an offset aligned to the vector length. 1 means scalar access only.
+inline index_t get_max_vector_length(const DescriptorOffsetTable& table,
+                                     index_t dim,
+                                     index_t max_vector_length = 16)
+{
+    const index_t ndim = table.mLengths.size();
+    if(dim < 0 || dim >= ndim)
+        throw std::runtime_error("wrong! dim out of range");
+
+    const index_t length = table.mLengths[dim];
+    std::size_t stride   = 1;
+    for(index_t d = ndim - 1; d > dim; --d)
+        stride *= table.mLengths[d];
+
+    auto is_vectorizable = [&](index_t vector_length) {
+        if(length % vector_length != 0)
+            return false;
+        for(std::size_t i = 0; i < table.GetElementSize(); ++i)
+        {
+            const index_t pos = (i / stride) % length;
+            if(pos % vector_length != 0)
+                continue;
+            if(table.mValid[i] && table.mOffsets[i] % vector_length != 0)
+                return false;
+            for(index_t v = 1; v < vector_length; ++v)
+            {
+                const std::size_t j = i + v * stride;
+                if(table.mValid[j] != table.mValid[i] ||
+                   (table.mValid[i] && table.mOffsets[j] != table.mOffsets[i] + v))
+                    return false;
+            }
+        }
+        return true;
+    };
+
+    index_t vector_length = 1;
+    while(vector_length * 2 <= max_vector_length && is_vectorizable(vector_length * 2))
+        vector_length *= 2;
+    return vector_length;
+}
+
+// LDS bank model: lane l of access group g reads the element g * lanes + l of the table (in the
+// order of the table), the lanes of a group access the banks at the same time
+struct BankConflictConfig
+{
+    index_t mElementBytes = 2;
+    index_t mLanes        = 32;
+    index_t mNumBanks     = 32;
+    index_t mBankBytes    = 4;
+};
+
+struct BankConflictReport
+{
+    std::size_t mNumGroups = 0;
+    // the number of distinct bank words one bank has to serve in a group, 1 is conflict free
+    index_t mMaxConflictDegree = 0;
+    double mAvgConflictDegree  = 0;
+    // first group with the max conflict degree
+    std::size_t mWorstGroup = 0;
+};
+
+inline BankConflictReport analyze_bank_conflicts(const DescriptorOffsetTable& table,
+                                                 const BankConflictConfig& config = {})
+{
+    BankConflictReport report;
+    double sum_degree = 0;
+
+    // first byte of every element, -1 for the invalid ones
+    std::vector<long_index_t> element_bytes(table.GetElementSize(), -1);
+    for(std::size_t i = 0; i < table.GetElementSize(); ++i)
+        if(table.mValid[i])
+            element_bytes[i] = long_index_t{table.mOffsets[i]} * config.mElementBytes;
+
+    for(std::size_t begin = 0; begin < table.GetElementSize(); begin += config.mLanes)
+    {
+        const index_t degree = get_lds_bank_conflict_degree(element_bytes,
+                                                            begin,
+                                                            begin + config.mLanes,
+                                                            config.mElementBytes,
+                                                            config.mNumBanks,
+                                                            config.mBankBytes);
+        if(degree == 0)
+            continue;
+
+        if(degree > report.mMaxConflictDegree)
+        {
+            report.mMaxConflictDegree = degree;
+            report.mWorstGroup        = report.mNumGroups;
+        }
+        sum_degree += degree;
+        ++report.mNumGroups;
+    }
+
+    if(report.mNumGroups > 0)
+        report.mAvgConflictDegree = sum_degree / report.mNumGroups;
+    return report;
+}
+
+struct DescriptorSummary
+{
+    std::vector<index_t> mLengths;
+    long_index_t mElementSpaceSize = 0;
+    std::size_t mNumElements       = 0;
+    std::size_t mNumValid          = 0;
+    // number of distinct offsets of the valid elements, less than mNumValid if elements alias
+    std::size_t mNumUniqueOffsets = 0;
+    index_t mMinOffset            = 0;
+    index_t mMaxOffset            = 0;
+    std::size_t mNumRuns          = 0;
+    std::size_t mLongestRun       = 0;
+    index_t mLastDimVectorLength  = 1;
+    BankConflictReport mBankConflicts;
+};
+
+inline DescriptorSummary summarize_offset_table(const DescriptorOffsetTable& table,
+                                                const BankConflictConfig& config = {})
+{
+    DescriptorSummary summary;
+    summary.mLengths          = table.mLengths;
+    summary.mElementSpaceSize = table.mElementSpaceSize;
+    summary.mNumElements      = table.GetElementSize();
+
+    std::vector<index_t> offsets;
+    for(std::size_t i = 0; i < table.GetElementSize(); ++i)
+        if(table.mValid[i])
+            offsets.push_back(table.mOffsets[i]);
+    summary.mNumValid = offsets.size();
+    if(!offsets.empty())
+    {
+        std::sort(offsets.begin(), offsets.end());
+        summary.mMinOffset        = offsets.front();
+        summary.mMaxOffset        = offsets.back();
+        summary.mNumUniqueOffsets = std::unique(offsets.begin(), offsets.end()) - offsets.begin();
+    }
+
+    const auto runs = compress_offset_table(table);
+    summary.mNumRuns = runs.size();
+    for(const auto& run : runs)
+        if(run.mValid)
+            summary.mLongestRun = std::max(summary.mLongestRun, run.mLength);
+
+    if(summary.mNumElements > 0)
+        summary.mLastDimVectorLength = get_max_vector_length(table, table.mLengths.size() - 1);
+    summary.mBankConflicts = analyze_bank_conflicts(table, config);
+    return summary;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const DescriptorSummary& summary)
+{
+    os << "lengths {";
+    for(std::size_t d = 0; d < summary.mLengths.size(); ++d)
+        os << (d == 0 ? "" : ", ") << summary.mLengths[d];
+    os << "}, element space " << summary.mElementSpaceSize << ", valid " << summary.mNumValid
+       << "/" << summary.mNumElements << ", unique offsets " << summary.mNumUniqueOffsets
+       << ", offsets [" << summary.mMinOffset << ", " << summary.mMaxOffset << "], strided runs "
+       << summary.mNumRuns << " (longest " << summary.mLongestRun << "), last dim vector "
+       << summary.mLastDimVectorLength << ", bank conflicts max "
+       << summary.mBankConflicts.mMaxConflictDegree << " avg "
+       << summary.mBankConflicts.mAvgConflictDegree << " over "
+       << summary.mBankConflicts.mNumGroups << " groups";
+    return os;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const StridedRun& run)
+{
+    if(run.mValid)
+        os << "[" << run.mBegin << ", +" << run.mLength << ") -> " << run.mOffset << " stride "
+           << run.mStride;
+    else
+        os << "[" << run.mBegin << ", +" << run.mLength << ") invalid";
+    return os;
+}
+
+} // namespace utils
+} // namespace ck
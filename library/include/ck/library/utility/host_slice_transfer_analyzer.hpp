@@ -0,0 +1,315 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/common_header.hpp"
+#include "ck/tensor_description/cluster_descriptor.hpp"
+#include "ck/tensor_description/tensor_space_filling_curve.hpp"
+#include "ck/tensor_operation/gpu/thread/threadwise_tensor_slice_transfer_util.hpp"
+#include "ck/library/utility/host_descriptor_evaluator.hpp"
+#include "ck/library/utility/lds_bank_conflict.hpp"
+
+namespace ck {
+namespace utils {
+
+struct SliceTransferConfig
+{
+    index_t mDataBytes      = 2;
+    index_t mWaveSize       = 64;
+    index_t mCacheLineBytes = 128;
+    // LDS: lanes served per cycle by 32-bit accesses, wider accesses serve proportionally less
+    index_t mLdsLanes  = 32;
+    index_t mNumBanks  = 32;
+    index_t mBankBytes = 4;
+};
+
+// One side (src or dst) of a ThreadGroupTensorSliceTransfer. A request is the vector access
+// number i of every lane of a wave, the access pattern of one load/store instruction.
+struct SliceTransferReport
+{
+    index_t mNumThreads         = 0;
+    index_t mNumAccessPerThread = 0;
+    index_t mScalarPerVector    = 1;
+    // widest vector the descriptor and the thread slice allow along the vector dim
+    index_t mMaxScalarPerVector = 1;
+    // false if some vector is not contiguous and aligned in memory, or mixes valid and invalid
+    // elements: the transfer then reads or writes wrong data
+    bool mVectorAccessValid = true;
+
+    std::size_t mNumRequests   = 0;
+    double mAvgBytesPerRequest = 0;
+    // bytes of a request divided by its number of contiguous byte ranges
+    double mAvgContiguousBytes      = 0;
+    index_t mMinContiguousBytes     = 0;
+    double mAvgCacheLinesPerRequest = 0;
+    // bytes accessed over bytes of the cache lines touched
+    double mCoalescingEfficiency = 0;
+    // if the side is in LDS
+    BankConflictReport mBankConflicts;
+};
+
+// Analyzes the accesses of a thread group: thread t starts at thread_origins[t] and does one
+// vector access of scalar_per_vector elements along vector_dim at every index of access_indices,
+// relative to its origin. The offsets come from table, indices outside of it are invalid.
+inline SliceTransferReport
+analyze_slice_transfer_accesses(const DescriptorOffsetTable& table,
+                                const std::vector<std::vector<index_t>>& thread_origins,
+                                const std::vector<std::vector<index_t>>& access_indices,
+                                index_t vector_dim,
+                                index_t scalar_per_vector,
+                                index_t max_scalar_per_vector,
+                                const SliceTransferConfig& config = {})
+{
+    const index_t ndim = table.mLengths.size();
+    if(vector_dim < 0 || vector_dim >= ndim)
+        throw std::runtime_error("wrong! vector dim out of range");
+
+    SliceTransferReport report;
+    report.mNumThreads         = thread_origins.size();
+    report.mNumAccessPerThread = access_indices.size();
+    report.mScalarPerVector    = scalar_per_vector;
+    report.mMaxScalarPerVector = max_scalar_per_vector;
+
+    // offset of the first element of a vector, -1 if the whole vector is invalid
+    auto get_vector_offset = [&](const std::vector<index_t>& origin,
+                                 const std::vector<index_t>& access) {
+        std::vector<index_t> idx(ndim);
+        index_t first_offset = -1;
+        bool any_valid       = false, any_invalid = false;
+        for(index_t v = 0; v < scalar_per_vector; ++v)
+        {
+            bool in_range = true;
+            for(index_t d = 0; d < ndim; ++d)
+            {
+                idx[d]   = origin[d] + access[d] + (d == vector_dim ? v : 0);
+                in_range = in_range && idx[d] >= 0 && idx[d] < table.mLengths[d];
+            }
+            const bool valid = in_range && table.IsValid(idx);
+            any_valid        = any_valid || valid;
+            any_invalid      = any_invalid || !valid;
+            if(!valid)
+                continue;
+
+            const index_t offset = table.GetOffset(idx);
+            if(v == 0)
+                first_offset = offset;
+            else if(first_offset < 0 || offset != first_offset + v)
+                report.mVectorAccessValid = false;
+        }
+        if(any_valid && any_invalid)
+            report.mVectorAccessValid = false;
+        if(first_offset >= 0 && first_offset % scalar_per_vector != 0)
+            report.mVectorAccessValid = false;
+        return first_offset;
+    };
+
+    const index_t vector_bytes    = scalar_per_vector * config.mDataBytes;
+    const index_t lanes_per_cycle = std::clamp(
+        config.mNumBanks * config.mBankBytes / vector_bytes, index_t{1}, config.mLdsLanes);
+
+    std::size_t num_contiguous = 0;
+    long_index_t total_bytes   = 0;
+    long_index_t total_lines   = 0;
+    double sum_conflict_degree = 0;
+    report.mMinContiguousBytes = std::numeric_limits<index_t>::max();
+
+    for(const auto& access : access_indices)
+    {
+        for(std::size_t wave_begin = 0; wave_begin < thread_origins.size();
+            wave_begin += config.mWaveSize)
+        {
+            const std::size_t wave_end =
+                std::min(thread_origins.size(), wave_begin + config.mWaveSize);
+
+            // byte ranges [begin, end) of the lanes, -1 for inactive lanes
+            std::vector<long_index_t> lane_bytes(wave_end - wave_begin, -1);
+            for(std::size_t t = wave_begin; t < wave_end; ++t)
+            {
+                const index_t offset = get_vector_offset(thread_origins[t], access);
+                if(offset >= 0)
+                    lane_bytes[t - wave_begin] = long_index_t{offset} * config.mDataBytes;
+            }
+
+            // global memory: contiguous ranges and cache lines of the request
+            std::vector<std::pair<long_index_t, long_index_t>> ranges;
+            for(const auto begin : lane_bytes)
+                if(begin >= 0)
+                    ranges.emplace_back(begin, begin + vector_bytes);
+            if(ranges.empty())
+                continue;
+            std::sort(ranges.begin(), ranges.end());
+
+            std::set<long_index_t> lines;
+            long_index_t range_begin = ranges.front().first, range_end = ranges.front().second;
+
+            auto close_range = [&]() {
+                const long_index_t bytes = range_end - range_begin;
+                total_bytes += bytes;
+                ++num_contiguous;
+                report.mMinContiguousBytes =
+                    std::min(report.mMinContiguousBytes, static_cast<index_t>(bytes));
+                for(long_index_t line = range_begin / config.mCacheLineBytes;
+                    line <= (range_end - 1) / config.mCacheLineBytes;
+                    ++line)
+                    lines.insert(line);
+            };
+            for(const auto& range : ranges)
+            {
+                if(range.first > range_end)
+                {
+                    close_range();
+                    range_begin = range.first;
+                }
+                range_end = std::max(range_end, range.second);
+            }
+            close_range();
+            total_lines += lines.size();
+            ++report.mNumRequests;
+
+            // LDS: distinct bank words per bank among the lanes served in the same cycle
+            for(std::size_t lane_begin = 0; lane_begin < lane_bytes.size();
+                lane_begin += lanes_per_cycle)
+            {
+                const index_t degree = get_lds_bank_conflict_degree(lane_bytes,
+                                                                    lane_begin,
+                                                                    lane_begin + lanes_per_cycle,
+                                                                    vector_bytes,
+                                                                    config.mNumBanks,
+                                                                    config.mBankBytes);
+                if(degree == 0)
+                    continue;
+
+                auto& conflicts = report.mBankConflicts;
+                if(degree > conflicts.mMaxConflictDegree)
+                {
+                    conflicts.mMaxConflictDegree = degree;
+                    conflicts.mWorstGroup        = conflicts.mNumGroups;
+                }
+                sum_conflict_degree += degree;
+                ++conflicts.mNumGroups;
+            }
+        }
+    }
+
+    if(report.mNumRequests > 0)
+    {
+        report.mAvgBytesPerRequest      = static_cast<double>(total_bytes) / report.mNumRequests;
+        report.mAvgContiguousBytes      = static_cast<double>(total_bytes) / num_contiguous;
+        report.mAvgCacheLinesPerRequest = static_cast<double>(total_lines) / report.mNumRequests;
+        report.mCoalescingEfficiency    =
+            static_cast<double>(total_bytes) / (total_lines * config.mCacheLineBytes);
+    }
+    else
+    {
+        report.mMinContiguousBytes = 0;
+    }
+    if(report.mBankConflicts.mNumGroups > 0)
+        report.mBankConflicts.mAvgConflictDegree =
+            sum_conflict_degree / report.mBankConflicts.mNumGroups;
+    return report;
+}
+
+// Analyzes one side of a ThreadGroupTensorSliceTransfer_v4r1 (SrcDimAccessOrder, SrcVectorDim,
+// SrcScalarPerVector or their Dst counterparts), v6r1 and v7 (DimAccessOrder, VectorDim,
+// ScalarPerVector) on desc, the block slice starting at slice_origin. Threads are mapped like
+// the transfers do, through make_cluster_descriptor, and the accesses of a thread are enumerated
+// by the SpaceFillingCurve the threadwise transfers walk.
+template <typename BlockSliceLengths,
+          typename ThreadClusterLengths,
+          typename ThreadClusterArrangeOrder,
+          typename DimAccessOrder,
+          index_t VectorDim,
+          index_t ScalarPerVector,
+          typename Desc>
+SliceTransferReport analyze_thread_group_slice_transfer(const Desc& desc,
+                                                        const SliceTransferConfig& config = {},
+                                                        std::vector<index_t> slice_origin = {})
+{
+    constexpr index_t nDim = BlockSliceLengths::Size();
+    static_assert(nDim == Desc::GetNumOfDimension() && nDim == ThreadClusterLengths::Size() &&
+                      nDim == ThreadClusterArrangeOrder::Size() && nDim == DimAccessOrder::Size(),
+                  "wrong! nDim not consistent");
+
+    constexpr auto thread_slice_lengths = BlockSliceLengths{} / ThreadClusterLengths{};
+    static_assert(
+        is_same<BlockSliceLengths, decltype(thread_slice_lengths * ThreadClusterLengths{})>{},
+        "wrong! threads should be mapped to cover entire slicing window");
+    static_assert(thread_slice_lengths[Number<VectorDim>{}] % ScalarPerVector == 0,
+                  "wrong! thread slice not divisible by ScalarPerVector");
+
+    if(slice_origin.empty())
+        slice_origin.assign(nDim, 0);
+
+    // threads
+    constexpr auto thread_cluster_desc =
+        make_cluster_descriptor(ThreadClusterLengths{}, ThreadClusterArrangeOrder{});
+    const index_t num_threads = thread_cluster_desc.GetElementSize();
+
+    std::vector<std::vector<index_t>> thread_origins(num_threads, std::vector<index_t>(nDim));
+    for(index_t t = 0; t < num_threads; ++t)
+    {
+        const auto thread_cluster_idx =
+            thread_cluster_desc.CalculateBottomIndex(make_multi_index(t));
+        static_for<0, nDim, 1>{}([&](auto i) {
+            thread_origins[t][i] =
+                slice_origin[i] + thread_cluster_idx[i] * thread_slice_lengths[i];
+        });
+    }
+
+    // accesses of a thread
+    constexpr auto scalar_per_access = generate_sequence(
+        detail::lambda_scalar_per_access<VectorDim, ScalarPerVector>{}, Number<nDim>{});
+    using SpaceFillingCurve = SpaceFillingCurve<remove_cv_t<decltype(thread_slice_lengths)>,
+                                                DimAccessOrder,
+                                                remove_cv_t<decltype(scalar_per_access)>>;
+    constexpr index_t num_access = SpaceFillingCurve::GetNumOfAccess();
+
+    std::vector<std::vector<index_t>> access_indices(num_access, std::vector<index_t>(nDim));
+    static_for<0, num_access, 1>{}([&](auto i) {
+        constexpr auto access_idx = SpaceFillingCurve::GetIndex(i);
+        static_for<0, nDim, 1>{}([&](auto d) { access_indices[i][d] = access_idx[d]; });
+    });
+
+    const auto table = evaluate_descriptor(desc);
+
+    // widest vector allowed by the thread slice and the descriptor
+    constexpr index_t thread_slice_vector_length = thread_slice_lengths[Number<VectorDim>{}];
+    index_t max_scalar_per_vector                = get_max_vector_length(table, VectorDim);
+    while(thread_slice_vector_length % max_scalar_per_vector != 0)
+        max_scalar_per_vector /= 2;
+
+    return analyze_slice_transfer_accesses(table,
+                                           thread_origins,
+                                           access_indices,
+                                           VectorDim,
+                                           ScalarPerVector,
+                                           max_scalar_per_vector,
+                                           config);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const SliceTransferReport& report)
+{
+    os << report.mNumThreads << " threads x " << report.mNumAccessPerThread
+       << " accesses, vector " << report.mScalarPerVector << " (max "
+       << report.mMaxScalarPerVector << (report.mVectorAccessValid ? "" : ", INVALID")
+       << "), bytes per request " << report.mAvgBytesPerRequest << ", contiguous bytes avg "
+       << report.mAvgContiguousBytes << " min " << report.mMinContiguousBytes
+       << ", cache lines per request " << report.mAvgCacheLinesPerRequest << ", coalescing "
+       << report.mCoalescingEfficiency << ", bank conflicts max "
+       << report.mBankConflicts.mMaxConflictDegree << " avg "
+       << report.mBankConflicts.mAvgConflictDegree;
+    return os;
+}
+
+} // namespace utils
+} // namespace ck
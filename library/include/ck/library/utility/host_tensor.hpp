@@ -6,12 +6,14 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <thread>
 #include <utility>
 #include <vector>
 
 #include "ck/utility/data_type.hpp"
+#include "ck/utility/magic_division.hpp"
 #include "ck/utility/span.hpp"
 #include "ck/utility/type_convert.hpp"
 
@@ -176,6 +178,22 @@ struct joinable_thread : std::thread
     }
 };
 
+// Order in which ParallelTensorFunctor visits the index space. Except for RowMajor, the space is
+// split into tiles, a tile is visited in row-major order by a single thread and every thread gets
+// a contiguous range of the tiles, ordered by:
+// Tiled:  the row-major order of the tile grid
+// Snake:  the snake curve of SpaceFillingCurve over the tile grid, consecutive tiles are adjacent
+// Morton: the Z-order curve over the tile grid
+// The tiled orders are experimental: they have not shown a speedup over RowMajor on a multi-core
+// host yet (benchmark/host_reference), so RowMajor stays the default and no reference uses them.
+enum struct HostTraversalEnum
+{
+    RowMajor,
+    Tiled,
+    Snake,
+    Morton
+};
+
 template <typename F, typename... Xs>
 struct ParallelTensorFunctor
 {
@@ -184,6 +202,11 @@ struct ParallelTensorFunctor
     std::array<std::size_t, NDIM> mLens;
     std::array<std::size_t, NDIM> mStrides;
     std::size_t mN1d;
+    // magic numbers of mLens, used if the 1d indices are within the range of magic division
+    ck::MDivMixedRadix<NDIM> mRadix;
+    bool mUseMagicDivision;
+    HostTraversalEnum mTraversal = HostTraversalEnum::RowMajor;
+    std::array<std::size_t, NDIM> mTileLens;
 
     ParallelTensorFunctor(F f, Xs... xs) : mF(f), mLens({static_cast<std::size_t>(xs)...})
     {
@@ -193,12 +216,24 @@ struct ParallelTensorFunctor
                          mStrides.rbegin() + 1,
                          std::multiplies<std::size_t>());
         mN1d = mStrides[0] * mLens[0];
+
+        mUseMagicDivision = mN1d <= static_cast<std::size_t>(INT32_MAX);
+        if(mUseMagicDivision)
+            mRadix = ck::MDivMixedRadix<NDIM>(mLens);
     }
 
     std::array<std::size_t, NDIM> GetNdIndices(std::size_t i) const
     {
         std::array<std::size_t, NDIM> indices;
 
+        if(mUseMagicDivision)
+        {
+            std::array<uint32_t, NDIM> coords;
+            mRadix.decompose(static_cast<uint32_t>(i), coords.data());
+            std::copy(coords.begin(), coords.end(), indices.begin());
+            return indices;
+        }
+
         for(std::size_t idim = 0; idim < NDIM; ++idim)
         {
             indices[idim] = i / mStrides[idim];
@@ -208,8 +243,157 @@ struct ParallelTensorFunctor
         return indices;
     }
 
+    // Experimental, see HostTraversalEnum. tile_lens[i] == 0 does not tile dim i
+    ParallelTensorFunctor& SetTraversal(HostTraversalEnum traversal,
+                                        const std::array<std::size_t, NDIM>& tile_lens)
+    {
+        mTraversal = traversal;
+        for(std::size_t idim = 0; idim < NDIM; ++idim)
+        {
+            const std::size_t tile_len = tile_lens[idim] == 0 ? mLens[idim] : tile_lens[idim];
+            mTileLens[idim]            = std::max<std::size_t>(std::min(tile_len, mLens[idim]), 1);
+        }
+        return *this;
+    }
+
+    // square tiles over the last two dims, one index of the leading dims per tile
+    ParallelTensorFunctor& SetTraversal(HostTraversalEnum traversal, std::size_t tile_len = 32)
+    {
+        std::array<std::size_t, NDIM> tile_lens;
+        for(std::size_t idim = 0; idim < NDIM; ++idim)
+        {
+            tile_lens[idim] = idim + 2 >= NDIM ? tile_len : 1;
+        }
+        return SetTraversal(traversal, tile_lens);
+    }
+
+    // row-major 1d indices of the tiles, in the order they are visited
+    std::vector<std::size_t> GetTileOrder(const std::array<std::size_t, NDIM>& grid_lens) const
+    {
+        const std::size_t num_tile = std::accumulate(
+            grid_lens.begin(), grid_lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+        std::vector<std::size_t> order(num_tile);
+        std::iota(order.begin(), order.end(), std::size_t{0});
+
+        auto get_tile_indices = [&](std::size_t tile) {
+            std::array<std::size_t, NDIM> indices;
+            for(std::size_t idim = NDIM; idim-- > 0;)
+            {
+                indices[idim] = tile % grid_lens[idim];
+                tile /= grid_lens[idim];
+            }
+            return indices;
+        };
+
+        if(mTraversal == HostTraversalEnum::Snake)
+        {
+            // as SpaceFillingCurve::GetIndex, a dim is walked backward if the merged index of the
+            // dims before it is odd
+            for(std::size_t tile = 0; tile < num_tile; ++tile)
+            {
+                const auto indices = get_tile_indices(tile);
+                std::size_t merged = 0;
+                std::size_t snake  = 0;
+                for(std::size_t idim = 0; idim < NDIM; ++idim)
+                {
+                    const bool forward_sweep = merged % 2 == 0;
+                    snake = snake * grid_lens[idim] +
+                            (forward_sweep ? indices[idim] : grid_lens[idim] - 1 - indices[idim]);
+                    merged = merged * grid_lens[idim] + indices[idim];
+                }
+                order[tile] = snake;
+            }
+        }
+        else if(mTraversal == HostTraversalEnum::Morton)
+        {
+            // interleave the bits of the tile indices, the last dim takes the lowest bit
+            const std::size_t num_bit = std::numeric_limits<std::size_t>::digits / NDIM;
+            std::vector<std::size_t> keys(num_tile);
+            for(std::size_t tile = 0; tile < num_tile; ++tile)
+            {
+                const auto indices = get_tile_indices(tile);
+                std::size_t key    = 0;
+                for(std::size_t ibit = num_bit; ibit-- > 0;)
+                {
+                    for(std::size_t idim = 0; idim < NDIM; ++idim)
+                    {
+                        key = (key << 1) | ((indices[idim] >> ibit) & 1);
+                    }
+                }
+                keys[tile] = key;
+            }
+            std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                return keys[a] < keys[b];
+            });
+        }
+
+        return order;
+    }
+
+    void VisitTile(const std::array<std::size_t, NDIM>& grid_lens, std::size_t tile) const
+    {
+        std::array<std::size_t, NDIM> begin;
+        std::array<std::size_t, NDIM> end;
+        for(std::size_t idim = NDIM; idim-- > 0;)
+        {
+            begin[idim] = tile % grid_lens[idim] * mTileLens[idim];
+            end[idim]   = std::min(begin[idim] + mTileLens[idim], mLens[idim]);
+            tile /= grid_lens[idim];
+        }
+
+        auto indices = begin;
+        while(true)
+        {
+            call_f_unpack_args(mF, indices);
+
+            std::size_t idim = NDIM;
+            for(; idim > 0; --idim)
+            {
+                if(++indices[idim - 1] < end[idim - 1])
+                    break;
+                indices[idim - 1] = begin[idim - 1];
+            }
+            if(idim == 0)
+                return;
+        }
+    }
+
+    void RunTiles(std::size_t num_thread) const
+    {
+        std::array<std::size_t, NDIM> grid_lens;
+        for(std::size_t idim = 0; idim < NDIM; ++idim)
+        {
+            grid_lens[idim] = (mLens[idim] + mTileLens[idim] - 1) / mTileLens[idim];
+        }
+        const auto order = GetTileOrder(grid_lens);
+
+        std::size_t tile_per_thread = (order.size() + num_thread - 1) / num_thread;
+
+        std::vector<joinable_thread> threads(num_thread);
+
+        for(std::size_t it = 0; it < num_thread; ++it)
+        {
+            std::size_t it_begin = std::min(it * tile_per_thread, order.size());
+            std::size_t it_end   = std::min((it + 1) * tile_per_thread, order.size());
+
+            auto f = [=, &order] {
+                for(std::size_t i = it_begin; i < it_end; ++i)
+                {
+                    VisitTile(grid_lens, order[i]);
+                }
+            };
+            threads[it] = joinable_thread(f);
+        }
+    }
+
     void operator()(std::size_t num_thread = 1) const
     {
+        if(mTraversal != HostTraversalEnum::RowMajor)
+        {
+            RunTiles(num_thread);
+            return;
+        }
+
         std::size_t work_per_thread = (mN1d + num_thread - 1) / num_thread;
 
         std::vector<joinable_thread> threads(num_thread);
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+// Only the standard library, the host code generator (codegen/) shares this model with the
+// descriptor and slice transfer analyzers without depending on the device headers.
+
+namespace ck {
+namespace utils {
+
+// The number of distinct bank words the busiest bank has to serve for the lanes
+// [lane_begin, lane_end) accessing LDS in the same cycle, 1 is conflict free and 0 means that no
+// lane is active. lane_bytes holds the first byte of every lane, negative for inactive lanes, and
+// every lane accesses access_bytes bytes, which may straddle several bank words.
+inline int get_lds_bank_conflict_degree(const std::vector<std::int64_t>& lane_bytes,
+                                        std::size_t lane_begin,
+                                        std::size_t lane_end,
+                                        int access_bytes,
+                                        int num_banks  = 32,
+                                        int bank_bytes = 4)
+{
+    std::vector<std::set<std::int64_t>> words_per_bank(num_banks);
+    for(std::size_t l = lane_begin; l < std::min(lane_end, lane_bytes.size()); ++l)
+    {
+        if(lane_bytes[l] < 0)
+            continue;
+        for(std::int64_t word = lane_bytes[l] / bank_bytes;
+            word <= (lane_bytes[l] + access_bytes - 1) / bank_bytes;
+            ++word)
+            words_per_bank[word % num_banks].insert(word);
+    }
+
+    int degree = 0;
+    for(const auto& words : words_per_bank)
+        degree = std::max(degree, static_cast<int>(words.size()));
+    return degree;
+}
+
+} // namespace utils
+} // namespace ck
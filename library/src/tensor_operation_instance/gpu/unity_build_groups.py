@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+# partition the sources of an instance library into unity translation units balanced by cost
+
+import argparse
+import json
+import math
+import re
+import sys
+from pathlib import Path
+from typing import Dict, List, Optional, Set, Tuple
+
+# declarations that may appear only once in a translation unit, whatever their definition
+UNIQUE_KINDS = ("alias_template", "variable", "class", "static_function")
+
+TEMPLATE_PREFIX = re.compile(r"^template\s*<")
+ALIAS = re.compile(r"^using\s+(\w+)\s*=")
+CLASS = re.compile(r"^(?:struct|class|union|enum(?:\s+class)?)\s+(\w+)\s*(?:final\s*)?(?::.*)?$")
+VARIABLE = re.compile(r"(\w+)\s*(?:\[[^\]]*\]\s*)?(?:=|\{|$)")
+FUNCTION = re.compile(r"(\w+)\s*\(")
+INCLUDE = re.compile(r'^\s*#\s*include\s*([<"])([^">]+)[">]', re.M)
+DEFINE = re.compile(r"^\s*#\s*(?:define|undef)\s+(\w+)", re.M)
+GUARD = re.compile(r"^\s*#\s*(?:pragma\s+once|ifndef\s+\w+)", re.M)
+
+
+def strip_comments_and_strings(text: str) -> str:
+    text = re.sub(r"//[^\n]*|/\*.*?\*/", " ", text, flags=re.S)
+    return re.sub(r'"(?:\\.|[^"\\\n])*"|\'(?:\\.|[^\'\\\n])*\'', '""', text)
+
+
+def skip_template_header(stmt: str) -> Tuple[bool, str]:
+    """'template <int N> using S = ...' -> (True, 'using S = ...')"""
+    if not TEMPLATE_PREFIX.match(stmt):
+        return False, stmt
+    depth = 0
+    for i, c in enumerate(stmt):
+        if c == "<":
+            depth += 1
+        elif c == ">":
+            depth -= 1
+            if depth == 0:
+                return True, stmt[i + 1:].strip()
+    return True, ""
+
+
+def classify(stmt: str, opens_block: bool) -> Optional[Tuple[str, str]]:
+    """kind and name of a namespace scope declaration, None for the ones that do not collide
+    (functions with external linkage, namespace aliases, using directives...)"""
+    if not stmt or stmt.startswith(("using namespace", "extern ", "friend ", "namespace ")):
+        return None
+    is_template, decl = skip_template_header(stmt)
+    m = ALIAS.match(decl)
+    if m:
+        return ("alias_template" if is_template else "alias"), m.group(1)
+    if opens_block:
+        m = CLASS.match(decl)
+        if m:
+            return "class", m.group(1)
+        m = FUNCTION.search(decl)
+        if m and re.match(r"^(?:inline\s+)?static\b", decl):
+            return "static_function", m.group(1)
+        return None
+    if "(" in decl.split("=")[0]:
+        return None  # function declaration
+    if not is_template and re.match(r"^(?:static|constexpr|inline|const)\b", decl):
+        m = VARIABLE.search(decl)
+        if m:
+            return "variable", m.group(1)
+    return None
+
+
+def scan_declarations(text: str) -> List[Tuple[str, str, str]]:
+    """(qualified name, kind, normalized text) of the namespace scope declarations of a file"""
+    text = strip_comments_and_strings(text)
+    text = re.sub(r"^\s*#(?:[^\n]*\\\n)*[^\n]*", " ", text, flags=re.M)
+    decls = []
+    scopes: List[Optional[str]] = []  # namespace name, None for any other brace
+    stmt = ""
+
+    def add(kind_name, scope, text):
+        if kind_name:
+            kind, name = kind_name
+            decls.append(("::".join(scope + [name]), kind, text))
+
+    for c in text:
+        at_namespace_scope = all(s is not None for s in scopes)
+        if c == "{":
+            head = " ".join(stmt.split())
+            m = re.match(r"^(?:inline\s+)?namespace\s*([\w:]*)$", head)
+            if at_namespace_scope and m:
+                scopes.append(m.group(1) or "(anonymous)")
+            else:
+                if at_namespace_scope:
+                    add(classify(head, True), scopes, head)
+                scopes.append(None)
+            stmt = ""
+        elif c == "}":
+            if scopes:
+                scopes.pop()
+            stmt = ""
+        elif c == ";":
+            if at_namespace_scope:
+                head = " ".join(stmt.split())
+                add(classify(head, False), scopes, head)
+            stmt = ""
+        elif at_namespace_scope:
+            stmt += c
+    return decls
+
+
+class Header:
+    def __init__(self, path: Path):
+        text = path.read_text(errors="replace")
+        self.decls = scan_declarations(text)
+        self.macros = {m for m in DEFINE.findall(text) if not m.endswith(("_HPP", "_H"))}
+        self.guarded = GUARD.search(text) is not None
+        self.includes = INCLUDE.findall(text)
+
+
+class Source:
+    def __init__(self, path: str):
+        self.path = path
+        self.abs_path = Path(path).resolve()
+        # declarations of the source itself, renamed in the unity unit
+        self.local_names: Set[str] = set()
+        # declarations of the instance headers it includes and the ones of the source that can
+        # not be renamed: qualified name -> (kind, text, file)
+        self.header_decls: Dict[str, Tuple[str, str, Path]] = {}
+        self.header_macros: Set[Tuple[str, Path]] = set()
+        # include lines of the source, as they are written in the unity unit
+        self.includes: List[str] = []
+        self.standalone = False
+        self.cost = 0.0
+
+    def conflicts(self, other: "Source") -> bool:
+        if self.standalone or other.standalone or self.header_macros != other.header_macros:
+            return True
+        for name, (kind, text, origin) in self.header_decls.items():
+            theirs = other.header_decls.get(name)
+            # the same header included by both is only parsed once
+            if theirs is None or theirs[2] == origin:
+                continue
+            if kind in UNIQUE_KINDS or theirs[0] in UNIQUE_KINDS or text != theirs[1]:
+                return True
+        return False
+
+
+def resolve(inc: str, base: Path, include_dirs: List[Path]) -> Optional[Path]:
+    for d in [base] + include_dirs:
+        candidate = (d / inc).resolve()
+        if candidate.is_file():
+            return candidate
+    return None
+
+
+def load_source(path: str, include_dirs: List[Path], scan_roots: List[Path],
+                headers: Dict[Path, Header]) -> Source:
+    source = Source(path)
+    text = source.abs_path.read_text(errors="replace")
+    # a macro of the source would leak into the sources after it
+    source.standalone = bool(DEFINE.findall(text))
+    code = strip_comments_and_strings(text)
+    for name, kind, decl in scan_declarations(text):
+        short = name.split("::")[-1]
+        # 'using PassThrough = ck::tensor_operation::element_wise::PassThrough;' can not be renamed
+        if re.search(r"(?:::|\.|->)\s*" + short + r"\b", code):
+            source.header_decls[name] = (kind, decl, source.abs_path)
+        else:
+            source.local_names.add(short)
+
+    pending = []
+    for quote, inc in INCLUDE.findall(text):
+        if quote == "<":
+            source.includes.append(f"<{inc}>")
+            continue
+        # includes relative to the source do not resolve from the unity unit
+        local = resolve(inc, source.abs_path.parent, [])
+        source.includes.append(f'"{local or inc}"')
+        found = resolve(inc, source.abs_path.parent, include_dirs)
+        if found:
+            pending.append(found)
+    seen = set()
+    while pending:
+        f = pending.pop()
+        # the ck headers are shared by every source, only the instance headers differ
+        if f in seen or not any(root in f.parents for root in scan_roots):
+            continue
+        seen.add(f)
+        if f not in headers:
+            headers[f] = Header(f)
+        header = headers[f]
+        # headers without include guard can not be included ahead of the source
+        source.standalone |= not header.guarded
+        for name, kind, decl in header.decls:
+            source.header_decls.setdefault(name, (kind, decl, f))
+        source.header_macros |= {(m, f) for m in header.macros}
+        for quote, inc in header.includes:
+            if quote == '"':
+                found = resolve(inc, f.parent, include_dirs)
+                if found:
+                    pending.append(found)
+    return source
+
+
+def load_costs(table: Optional[str], target: str, sources: List[Source]):
+    costs = {}
+    if table:
+        costs = json.loads(Path(table).read_text()).get("units_ms", {})
+    known = []
+    for s in sources:
+        s.cost = costs.get(f"{target}/{s.path}", 0.0)
+        if s.cost > 0:
+            known.append(s.cost)
+    # sources that were not measured cost as much as the median measured one
+    default = sorted(known)[len(known) // 2] if known else 1.0
+    for s in sources:
+        if s.cost <= 0:
+            s.cost = default
+
+
+def partition(sources: List[Source], max_sources: int, max_cost: float) -> List[List[Source]]:
+    """longest processing time first, into the least loaded group that can take the source"""
+    if not sources:
+        return []
+    largest = max(s.cost for s in sources)
+    if max_cost > 0:
+        budget = max(max_cost, largest)
+    else:
+        budget = max(largest, sum(s.cost for s in sources) / math.ceil(len(sources) / max_sources))
+
+    groups: List[List[Source]] = []
+    loads: List[float] = []
+    for s in sorted(sources, key=lambda s: (-s.cost, s.path)):
+        best = None
+        for i, group in enumerate(groups):
+            if len(group) >= max_sources or loads[i] + s.cost > budget:
+                continue
+            if any(s.conflicts(other) for other in group):
+                continue
+            if best is None or loads[i] < loads[best]:
+                best = i
+        if best is None:
+            groups.append([])
+            loads.append(0.0)
+            best = len(groups) - 1
+        groups[best].append(s)
+        loads[best] += s.cost
+    return groups
+
+
+def write_unity_unit(path: Path, group: List[Source]):
+    lines = ["// generated by unity_build_groups.py, do not edit", ""]
+    # every header is parsed ahead of the sources, so the renames below only touch the sources
+    includes = []
+    for s in group:
+        includes += [inc for inc in s.includes if inc not in includes]
+    lines += [f"#include {inc}" for inc in includes] + [""]
+    suffix = path.stem
+    for i, s in enumerate(sorted(group, key=lambda s: s.path)):
+        names = sorted(s.local_names)
+        lines += [f"#define {n} {n}_{suffix}_{i}" for n in names]
+        lines.append(f'#include "{s.abs_path}"')
+        lines += [f"#undef {n}" for n in names] + [""]
+    text = "\n".join(lines)
+    # leave the unit untouched if nothing changed, it would be rebuilt otherwise
+    if not path.is_file() or path.read_text() != text:
+        path.write_text(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="partition the sources of an instance library into unity translation units, "
+        "prints the sources to compile as a cmake list")
+    parser.add_argument("sources", nargs="*", help="sources, relative to the working directory")
+    parser.add_argument("--target", type=str, default="", help="cmake target of the sources")
+    parser.add_argument("--output-dir", type=str, required=True, help="where the units are written")
+    parser.add_argument("--include-dir", action="append", default=[],
+                        help="directories searched for quoted includes")
+    parser.add_argument("--scan-root", action="append", default=[],
+                        help="included headers below these directories are checked for "
+                        "collisions, the directory of the sources is always checked")
+    parser.add_argument("--cost-table", type=str, default=None,
+                        help="per-source compile times written by time_trace_report.py")
+    parser.add_argument("--max-sources", type=int, default=8, help="sources per unit")
+    parser.add_argument("--max-cost", type=float, default=0,
+                        help="compile time (ms) per unit, the groups are balanced if 0")
+    parser.add_argument("--summary", action="store_true", help="print the units and their costs")
+    args = parser.parse_args()
+
+    include_dirs = [Path(d).resolve() for d in args.include_dir]
+    scan_roots = [Path(d).resolve() for d in args.scan_root] + [Path.cwd().resolve()]
+    headers = {}
+    sources = [load_source(s, include_dirs, scan_roots, headers) for s in args.sources]
+    load_costs(args.cost_table, args.target, sources)
+    groups = partition(sources, max(1, args.max_sources), args.max_cost)
+
+    out_dir = Path(args.output_dir)
+    out_dir.mkdir(parents=True, exist_ok=True)
+    compiled = []
+    for i, group in enumerate(groups):
+        if len(group) == 1:
+            compiled.append(group[0].path)
+        else:
+            unit = out_dir / f"{args.target}_unity_{i}.cpp"
+            write_unity_unit(unit, group)
+            compiled.append(str(unit))
+        if args.summary:
+            print(f"unit {i}: cost {sum(s.cost for s in group):.0f}, " +
+                  " ".join(s.path for s in group), file=sys.stderr)
+    print(";".join(compiled), end="")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
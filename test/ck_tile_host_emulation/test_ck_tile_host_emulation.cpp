@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/fill.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_gemm.hpp"
+#include "ck_tile/ops/gemm/warp/warp_gemm.hpp"
+#include "ck_tile/ops/reduce.hpp"
+
+using ck_tile::index_t;
+namespace host_emulation = ck_tile::host_emulation;
+
+class HostEmulation : public ::testing::TestWithParam<host_emulation::schedule_enum>
+{
+    protected:
+    host_emulation::launch_config make_config(index_t grid_size, index_t block_size) const
+    {
+        host_emulation::launch_config config;
+        config.grid_size  = grid_size;
+        config.block_size = block_size;
+        config.schedule   = GetParam();
+        config.stack_byte = 256 * 1024;
+        return config;
+    }
+};
+
+TEST_P(HostEmulation, BlockSyncLds)
+{
+    const index_t grid_size = 3, block_size = 256;
+    std::vector<index_t> out(grid_size * block_size, -1);
+    host_emulation::launch_kernel(
+        make_config(grid_size, block_size),
+        [](index_t* p_out) {
+            auto* p_lds     = static_cast<index_t*>(host_emulation::get_lds());
+            const index_t t = ck_tile::get_thread_local_1d_id();
+            p_lds[t]        = ck_tile::get_block_1d_id() * 1000 + t;
+            ck_tile::block_sync_lds();
+            p_out[ck_tile::get_thread_global_1d_id()] = p_lds[ck_tile::get_block_size() - 1 - t];
+        },
+        out.data());
+
+    for(index_t i = 0; i < grid_size * block_size; ++i)
+    {
+        EXPECT_EQ(out[i], (i / block_size) * 1000 + block_size - 1 - i % block_size);
+    }
+}
+
+TEST_P(HostEmulation, WarpShuffle)
+{
+    const index_t block_size = 128;
+    std::vector<float> up(block_size), down(block_size);
+    host_emulation::launch_kernel(
+        make_config(1, block_size),
+        [](float* p_up, float* p_down) {
+            const index_t t = ck_tile::get_thread_id();
+            p_up[t]         = ck_tile::warp_shuffle_up(static_cast<float>(t), 3);
+            p_down[t]       = ck_tile::warp_shuffle_down(static_cast<float>(t), 5);
+        },
+        up.data(),
+        down.data());
+
+    // ds_bpermute wraps around the lanes of the warp
+    const index_t warp_size = ck_tile::get_warp_size();
+    for(index_t t = 0; t < block_size; ++t)
+    {
+        const index_t warp_base = t / warp_size * warp_size;
+        EXPECT_EQ(up[t], static_cast<float>(warp_base + (t + warp_size - 3) % warp_size));
+        EXPECT_EQ(down[t], static_cast<float>(warp_base + (t + 5) % warp_size));
+    }
+}
+
+TEST_P(HostEmulation, BufferViewOutOfBound)
+{
+    const index_t size = 37;
+    std::vector<float> src(size), dst(64, -1.f);
+    for(index_t i = 0; i < size; ++i)
+    {
+        src[i] = i + 1;
+    }
+
+    host_emulation::launch_config config = make_config(1, 64);
+    config.trace                         = true;
+
+    const auto trace = host_emulation::launch_kernel(
+        config,
+        [](const float* p_src, float* p_dst, index_t n) {
+            auto src_view =
+                ck_tile::make_buffer_view<ck_tile::address_space_enum::global>(p_src, n);
+            auto dst_view =
+                ck_tile::make_buffer_view<ck_tile::address_space_enum::global>(p_dst, n);
+            const index_t t = ck_tile::get_thread_id();
+            // out of the buffer: the loads return zero and the stores are dropped
+            const float v = src_view.template get<float>(t, true);
+            dst_view.template set<float>(t, true, v * 2);
+        },
+        src.data(),
+        dst.data(),
+        size);
+
+    for(index_t i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(dst[i], i < size ? 2.f * (i + 1) : -1.f);
+    }
+    // one load and one store per thread in the buffer
+    EXPECT_EQ(trace.size(), static_cast<std::size_t>(2 * size));
+    for(const auto& record : trace)
+    {
+        EXPECT_EQ(record.address_space, ck_tile::address_space_enum::global);
+        EXPECT_EQ(record.byte, static_cast<index_t>(sizeof(float)));
+    }
+}
+
+TEST_P(HostEmulation, AtomicAdd)
+{
+    const index_t grid_size = 4, block_size = 64;
+    std::vector<int32_t> sum(2, 0);
+    host_emulation::launch_kernel(
+        make_config(grid_size, block_size),
+        [](int32_t* p_sum) {
+            auto view = ck_tile::make_buffer_view<ck_tile::address_space_enum::global>(p_sum, 2);
+            view.template update<ck_tile::memory_operation_enum::atomic_add, int32_t>(
+                ck_tile::get_thread_id() % 2, true, ck_tile::get_thread_global_1d_id());
+        },
+        sum.data());
+
+    const index_t n = grid_size * block_size;
+    EXPECT_EQ(sum[0] + sum[1], n * (n - 1) / 2);
+    EXPECT_EQ(sum[1] - sum[0], n / 2);
+}
+
+// 64x64 tile of a block of 4 warps: a warp per 16 rows, 4 lanes per row, 16 columns per thread
+using RowTileEncoding = ck_tile::tile_distribution_encoding<
+    ck_tile::sequence<>,
+    ck_tile::tuple<ck_tile::sequence<4, 16>, ck_tile::sequence<4, 16>>,
+    ck_tile::tuple<ck_tile::sequence<1>, ck_tile::sequence<1, 2>>,
+    ck_tile::tuple<ck_tile::sequence<0>, ck_tile::sequence<1, 0>>,
+    ck_tile::sequence<2>,
+    ck_tile::sequence<1>>;
+
+// same tile, a warp per 16 columns, 16 lanes per column, 4x4 elements per thread
+using ColumnTileEncoding = ck_tile::tile_distribution_encoding<
+    ck_tile::sequence<>,
+    ck_tile::tuple<ck_tile::sequence<16, 4>, ck_tile::sequence<4, 4, 4>>,
+    ck_tile::tuple<ck_tile::sequence<2>, ck_tile::sequence<1, 2>>,
+    ck_tile::tuple<ck_tile::sequence<0>, ck_tile::sequence<0, 1>>,
+    ck_tile::sequence<1, 2>,
+    ck_tile::sequence<1, 2>>;
+
+// copies the [64 * grid size, 64] rows of src to dst, through the LDS where the tile is read back
+// with another distribution
+struct TileCopyKernel
+{
+    static constexpr index_t kM = 64;
+    static constexpr index_t kN = 64;
+
+    CK_TILE_DEVICE void operator()(const float* p_src, float* p_dst, index_t m) const
+    {
+        using namespace ck_tile;
+
+        const auto src_view = make_naive_tensor_view<address_space_enum::global>(
+            p_src, make_tuple(m, number<kN>{}), make_tuple(number<kN>{}, number<1>{}));
+        const auto dst_view = make_naive_tensor_view<address_space_enum::global>(
+            p_dst, make_tuple(m, number<kN>{}), make_tuple(number<kN>{}, number<1>{}));
+        const auto lds_view = make_naive_tensor_view<address_space_enum::lds>(
+            static_cast<float*>(ck_tile::host_emulation::get_lds()),
+            make_tuple(number<kM>{}, number<kN>{}),
+            make_tuple(number<kN>{}, number<1>{}));
+
+        constexpr auto row_dstr    = make_static_tile_distribution(RowTileEncoding{});
+        constexpr auto column_dstr = make_static_tile_distribution(ColumnTileEncoding{});
+        constexpr auto lengths     = make_tuple(number<kM>{}, number<kN>{});
+        const index_t i_m          = get_block_id() * kM;
+
+        auto src_window     = make_tile_window(src_view, lengths, {i_m, 0}, row_dstr);
+        auto lds_row_window = make_tile_window(lds_view, lengths, {0, 0}, row_dstr);
+        store_tile(lds_row_window, load_tile(src_window));
+
+        block_sync_lds();
+
+        auto lds_column_window = make_tile_window(lds_view, lengths, {0, 0}, column_dstr);
+        auto dst_window        = make_tile_window(dst_view, lengths, {i_m, 0}, column_dstr);
+        store_tile(dst_window, load_tile(lds_column_window));
+    }
+};
+
+TEST_P(HostEmulation, TileCopy)
+{
+    const index_t grid_size = 2;
+    const index_t m         = grid_size * TileCopyKernel::kM;
+    ck_tile::HostTensor<float> src({m, TileCopyKernel::kN});
+    ck_tile::HostTensor<float> dst({m, TileCopyKernel::kN});
+    ck_tile::FillUniformDistributionIntegerValue<float>{-100.f, 100.f, 1}(src);
+    dst.SetZero();
+
+    host_emulation::launch_kernel(
+        make_config(grid_size, 256), TileCopyKernel{}, src.data(), dst.data(), m);
+
+    EXPECT_EQ(dst.mData, src.mData);
+}
+
+// sums the rows of a 64x64 tile, the partial sums of the 4 lanes of a row are reduced with
+// warp_shuffle_down and broadcast back with warp_shuffle_up
+struct RowSumKernel
+{
+    static constexpr index_t kM = 64;
+    static constexpr index_t kN = 64;
+
+    CK_TILE_DEVICE void operator()(const float* p_in, float* p_row_sum, float* p_thread_sum) const
+    {
+        using namespace ck_tile;
+
+        const auto in_view = make_naive_tensor_view<address_space_enum::global>(
+            p_in, make_tuple(number<kM>{}, number<kN>{}), make_tuple(number<kN>{}, number<1>{}));
+        auto in_window = make_tile_window(in_view,
+                                          make_tuple(number<kM>{}, number<kN>{}),
+                                          {0, 0},
+                                          make_static_tile_distribution(RowTileEncoding{}));
+        const auto in = load_tile(in_window);
+
+        const auto f_sum = [](auto e0, auto e1) { return e0 + e1; };
+        auto row_sum     = block_tile_reduce<float>(in, sequence<1>{}, f_sum, 0.f);
+        block_tile_reduce_sync(row_sum, f_sum);
+
+        // every lane of a row holds the sum after the broadcast
+        p_thread_sum[get_thread_id()] = row_sum.get_thread_buffer()[number<0>{}];
+
+        const auto row_sum_view = make_naive_tensor_view<address_space_enum::global>(
+            p_row_sum, make_tuple(number<kM>{}), make_tuple(number<1>{}));
+        auto row_sum_window = make_tile_window(
+            row_sum_view, make_tuple(number<kM>{}), {0}, row_sum.get_tile_distribution());
+        store_tile(row_sum_window, row_sum);
+    }
+};
+
+TEST_P(HostEmulation, BlockReduce)
+{
+    const index_t block_size = 256;
+    ck_tile::HostTensor<float> in({RowSumKernel::kM, RowSumKernel::kN});
+    ck_tile::FillUniformDistributionIntegerValue<float>{-100.f, 100.f, 2}(in);
+    std::vector<float> row_sum(RowSumKernel::kM, -1.f), thread_sum(block_size, -1.f);
+
+    host_emulation::launch_kernel(
+        make_config(1, block_size), RowSumKernel{}, in.data(), row_sum.data(), thread_sum.data());
+
+    std::vector<float> ref(RowSumKernel::kM, 0.f);
+    for(index_t i = 0; i < RowSumKernel::kM; ++i)
+    {
+        for(index_t j = 0; j < RowSumKernel::kN; ++j)
+        {
+            ref[i] += in(i, j);
+        }
+    }
+    EXPECT_EQ(row_sum, ref);
+    // thread t holds row 16 * warp + lane / 4
+    const index_t warp_size = ck_tile::get_warp_size();
+    for(index_t t = 0; t < block_size; ++t)
+    {
+        EXPECT_EQ(thread_sum[t], ref[t / warp_size * 16 + t % warp_size / 4]) << "thread " << t;
+    }
+}
+
+// C[m][n] = sum_k A[m][k] * B[n][k] of one warp gemm tile, K looped over the warp gemm K
+template <typename WarpGemm>
+struct WarpGemmKernel
+{
+    CK_TILE_DEVICE void
+    operator()(const ck_tile::fp16_t* p_a, const ck_tile::fp16_t* p_b, float* p_c, index_t k) const
+    {
+        using namespace ck_tile;
+
+        constexpr index_t kM = WarpGemm::kM;
+        constexpr index_t kN = WarpGemm::kN;
+        constexpr index_t kK = WarpGemm::kK;
+
+        const auto a_view = make_naive_tensor_view<address_space_enum::global>(
+            p_a, make_tuple(number<kM>{}, k), make_tuple(k, number<1>{}));
+        const auto b_view = make_naive_tensor_view<address_space_enum::global>(
+            p_b, make_tuple(number<kN>{}, k), make_tuple(k, number<1>{}));
+        const auto c_view = make_naive_tensor_view<address_space_enum::global>(
+            p_c, make_tuple(number<kM>{}, number<kN>{}), make_tuple(number<kN>{}, number<1>{}));
+
+        auto a_window =
+            make_tile_window(a_view,
+                             make_tuple(number<kM>{}, number<kK>{}),
+                             {0, 0},
+                             make_static_tile_distribution(typename WarpGemm::AWarpDstrEncoding{}));
+        auto b_window =
+            make_tile_window(b_view,
+                             make_tuple(number<kN>{}, number<kK>{}),
+                             {0, 0},
+                             make_static_tile_distribution(typename WarpGemm::BWarpDstrEncoding{}));
+        auto c_window =
+            make_tile_window(c_view,
+                             make_tuple(number<kM>{}, number<kN>{}),
+                             {0, 0},
+                             make_static_tile_distribution(typename WarpGemm::CWarpDstrEncoding{}));
+
+        typename WarpGemm::CWarpTensor c;
+        clear_tile(c);
+        for(index_t i_k = 0; i_k < k; i_k += kK)
+        {
+            WarpGemm{}(c, load_tile(a_window), load_tile(b_window));
+            move_tile_window(a_window, {0, kK});
+            move_tile_window(b_window, {0, kK});
+        }
+        store_tile(c_window, c);
+    }
+};
+
+template <typename WarpGemm>
+void check_warp_gemm(const host_emulation::launch_config& config)
+{
+    const index_t k = 4 * WarpGemm::kK;
+    ck_tile::HostTensor<ck_tile::fp16_t> a({WarpGemm::kM, k});
+    ck_tile::HostTensor<ck_tile::fp16_t> b({WarpGemm::kN, k});
+    ck_tile::HostTensor<float> c({WarpGemm::kM, WarpGemm::kN});
+    ck_tile::HostTensor<float> c_ref({WarpGemm::kM, WarpGemm::kN});
+    // small integers, the products and sums are exact
+    ck_tile::FillUniformDistributionIntegerValue<ck_tile::fp16_t>{-5.f, 5.f, 3}(a);
+    ck_tile::FillUniformDistributionIntegerValue<ck_tile::fp16_t>{-5.f, 5.f, 4}(b);
+    c.SetZero();
+
+    host_emulation::launch_kernel(
+        config, WarpGemmKernel<WarpGemm>{}, a.data(), b.data(), c.data(), k);
+
+    ck_tile::reference_gemm<ck_tile::fp16_t, ck_tile::fp16_t, float, float>(a, b, c_ref);
+    EXPECT_EQ(c.mData, c_ref.mData);
+}
+
+TEST_P(HostEmulation, WarpGemmF16M32N32K8)
+{
+    check_warp_gemm<ck_tile::WarpGemmMfmaF16F16F32M32N32K8>(make_config(1, 64));
+}
+
+TEST_P(HostEmulation, WarpGemmF16M16N16K16)
+{
+    check_warp_gemm<ck_tile::WarpGemmMfmaF16F16F32M16N16K16>(make_config(1, 64));
+}
+
+INSTANTIATE_TEST_SUITE_P(Schedule,
+                         HostEmulation,
+                         ::testing::Values(host_emulation::schedule_enum::threads,
+                                           host_emulation::schedule_enum::sequential));
+
+TEST(HostEmulation, BarrierDeadlock)
+{
+    host_emulation::launch_config config;
+    config.block_size = 64;
+    config.schedule   = host_emulation::schedule_enum::sequential;
+    config.stack_byte = 256 * 1024;
+    // thread 0 never arrives at the barrier
+    EXPECT_THROW(host_emulation::launch_kernel(config,
+                                               [] {
+                                                   if(ck_tile::get_thread_id() != 0)
+                                                   {
+                                                       ck_tile::block_sync_lds();
+                                                   }
+                                               }),
+                 std::runtime_error);
+}
+
+TEST(HostEmulation, Perm)
+{
+    // v_perm_b32(0x 11 22 33 44, 0x 55 66 77 88, 0x 05 01 04 00) -> 0x33774488
+    EXPECT_EQ(host_emulation::perm_b32(0x11223344, 0x55667788, 0x05010400), 0x33774488);
+    EXPECT_EQ(host_emulation::perm_b32(0x11223344, 0x55667788, 0x0c07ff03), 0x0011ff55);
+}
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/fill.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_batched_rotary_position_embedding.hpp"
+#include "ck_tile/host/reference/reference_fmha_fwd_appendkv.hpp"
+
+using ck_tile::index_t;
+
+using DataType = float;
+
+// same table the fmha example generates: angle of pair j at position p is p * 10000^(-2j / dim)
+void make_rotary_table(ck_tile::HostTensor<DataType>& cos,
+                       ck_tile::HostTensor<DataType>& sin,
+                       index_t rotary_dim)
+{
+    cos.ForEach([&](auto& self, auto i) {
+        self(i) = std::cos(i[0] * std::pow(10000.f, -2.f * i[1] / rotary_dim));
+    });
+    sin.ForEach([&](auto& self, auto i) {
+        self(i) = std::sin(i[0] * std::pow(10000.f, -2.f * i[1] / rotary_dim));
+    });
+}
+
+class TestRotaryEmbeddingReference : public ::testing::TestWithParam<bool>
+{
+};
+
+// the score of a rotated query and a rotated key only depends on their distance
+TEST_P(TestRotaryEmbeddingReference, RelativePosition)
+{
+    constexpr index_t seqlen     = 24;
+    constexpr index_t hdim       = 40;
+    constexpr index_t rotary_dim = 32;
+    const bool interleaved       = GetParam();
+
+    ck_tile::HostTensor<DataType> cos({2 * seqlen, rotary_dim / 2});
+    ck_tile::HostTensor<DataType> sin({2 * seqlen, rotary_dim / 2});
+    make_rotary_table(cos, sin, rotary_dim);
+
+    // every row of q (k) is the same vector, at a different position
+    ck_tile::HostTensor<DataType> q({1, seqlen, hdim});
+    ck_tile::HostTensor<DataType> k({1, seqlen, hdim});
+    ck_tile::HostTensor<DataType> q_row({1, 1, hdim});
+    ck_tile::HostTensor<DataType> k_row({1, 1, hdim});
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 1}(q_row);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 2}(k_row);
+    q.ForEach([&](auto& self, auto i) { self(i) = q_row(0, 0, i[2]); });
+    k.ForEach([&](auto& self, auto i) { self(i) = k_row(0, 0, i[2]); });
+
+    ck_tile::HostTensor<DataType> q_rot({1, seqlen, hdim});
+    ck_tile::HostTensor<DataType> k_rot({1, seqlen, hdim});
+    ck_tile::reference_batched_rotary_position_embedding(q, cos, sin, interleaved, q_rot, {seqlen});
+    // in place
+    k_rot = k;
+    ck_tile::reference_batched_rotary_position_embedding(k_rot, cos, sin, interleaved, k_rot);
+
+    auto dot = [&](index_t sq, index_t sk) {
+        float acc = 0;
+        for(index_t d = 0; d < hdim; ++d)
+            acc += q_rot(0, sq, d) * k_rot(0, sk, d);
+        return acc;
+    };
+    for(index_t dist = 0; dist < seqlen; ++dist)
+    {
+        // q row s is at position seqlen + s
+        const float expected = dot(0, seqlen - dist);
+        for(index_t sq = 1; seqlen - dist + sq < seqlen; ++sq)
+            EXPECT_NEAR(dot(sq, seqlen - dist + sq), expected, 1e-4f) << "dist:" << dist;
+    }
+
+    // elements past rotary_dim are copied, position 0 is not rotated
+    for(index_t d = 0; d < hdim; ++d)
+    {
+        EXPECT_EQ(k_rot(0, 0, d), k(0, 0, d));
+        if(rotary_dim <= d)
+        {
+            EXPECT_EQ(q_rot(0, seqlen - 1, d), q(0, seqlen - 1, d));
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(FmhaAppendKV, TestRotaryEmbeddingReference, ::testing::Bool());
+
+class TestFmhaAppendKVReference : public ::testing::TestWithParam<bool>
+{
+};
+
+// new rows land right after the cached rows of each batch, K rotated at its new position
+TEST_P(TestFmhaAppendKVReference, Append)
+{
+    constexpr index_t seqlen_k    = 20;
+    constexpr index_t seqlen_knew = 5;
+    constexpr index_t hdim_q      = 16;
+    constexpr index_t hdim_v      = 8;
+    constexpr index_t rotary_dim  = 8;
+    const bool use_rotary         = GetParam();
+    const std::vector<index_t> cache_seqlen_k{0, 7, seqlen_k - seqlen_knew};
+
+    const index_t batch = cache_seqlen_k.size();
+
+    ck_tile::HostTensor<DataType> k({batch, seqlen_k, hdim_q});
+    ck_tile::HostTensor<DataType> v({batch, seqlen_k, hdim_v});
+    ck_tile::HostTensor<DataType> knew({batch, seqlen_knew, hdim_q});
+    ck_tile::HostTensor<DataType> vnew({batch, seqlen_knew, hdim_v});
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 1}(k);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 2}(v);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 3}(knew);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 4}(vnew);
+
+    ck_tile::HostTensor<DataType> cos({seqlen_k, rotary_dim / 2});
+    ck_tile::HostTensor<DataType> sin({seqlen_k, rotary_dim / 2});
+    make_rotary_table(cos, sin, rotary_dim);
+
+    std::optional<std::reference_wrapper<const ck_tile::HostTensor<DataType>>> cos_ref;
+    std::optional<std::reference_wrapper<const ck_tile::HostTensor<DataType>>> sin_ref;
+    if(use_rotary)
+    {
+        cos_ref = cos;
+        sin_ref = sin;
+    }
+
+    ck_tile::HostTensor<DataType> k_out = k;
+    ck_tile::HostTensor<DataType> v_out = v;
+    ck_tile::reference_fmha_fwd_appendkv(
+        knew, vnew, k_out, v_out, cache_seqlen_k, cos_ref, sin_ref, false);
+
+    ck_tile::HostTensor<DataType> knew_rot({batch, seqlen_knew, hdim_q});
+    ck_tile::reference_batched_rotary_position_embedding(
+        knew, cos, sin, false, knew_rot, cache_seqlen_k);
+
+    for(index_t b = 0; b < batch; ++b)
+    {
+        for(index_t s = 0; s < seqlen_k; ++s)
+        {
+            const index_t i   = s - cache_seqlen_k[b];
+            const bool is_new = 0 <= i && i < seqlen_knew;
+            for(index_t d = 0; d < hdim_q; ++d)
+            {
+                const DataType expected =
+                    is_new ? (use_rotary ? knew_rot(b, i, d) : knew(b, i, d)) : k(b, s, d);
+                EXPECT_EQ(k_out(b, s, d), expected) << "b:" << b << ", s:" << s << ", d:" << d;
+            }
+            for(index_t d = 0; d < hdim_v; ++d)
+            {
+                const DataType expected = is_new ? vnew(b, i, d) : v(b, s, d);
+                EXPECT_EQ(v_out(b, s, d), expected) << "b:" << b << ", s:" << s << ", d:" << d;
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(FmhaAppendKV, TestFmhaAppendKVReference, ::testing::Bool());
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/fill.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_fmha_bwd.hpp"
+#include "ck_tile/host/reference/reference_fmha_fwd.hpp"
+#include "ck_tile/ops/fmha.hpp"
+#include "mask.hpp"
+#include "test_fmha_util.hpp"
+
+using ck_tile::index_t;
+
+using DataType = float;
+
+using ck_tile::test::GenericMask;
+
+// the gradients must match central differences of L = sum(dO o O) for every input
+void check_bwd_reference(const std::string& mask_str,
+                         index_t seqlen_q,
+                         index_t seqlen_k,
+                         bool use_bias)
+{
+    constexpr index_t batch  = 2;
+    constexpr index_t hdim_q = 8;
+    constexpr index_t hdim_v = 6;
+    // sample every kStride-th element of each input, finite differences are costly
+    constexpr index_t kStride = 7;
+    constexpr float kEps      = 1e-2f;
+
+    SCOPED_TRACE(
+        ck_tile::test::fmha_test_trace(mask_str, seqlen_q, seqlen_k, {{"bias", use_bias}}));
+
+    ck_tile::HostTensor<DataType> q({batch, seqlen_q, hdim_q});
+    ck_tile::HostTensor<DataType> k({batch, seqlen_k, hdim_q});
+    ck_tile::HostTensor<DataType> v({batch, hdim_v, seqlen_k});
+    ck_tile::HostTensor<DataType> bias({batch, seqlen_q, seqlen_k});
+    ck_tile::HostTensor<DataType> d_o({batch, seqlen_q, hdim_v});
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 1}(q);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 2}(k);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 3}(v);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 4}(bias);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 5}(d_o);
+
+    std::optional<std::reference_wrapper<const ck_tile::HostTensor<DataType>>> bias_ref;
+    if(use_bias)
+        bias_ref = bias;
+
+    const mask_info info   = mask_info::decode(mask_str, seqlen_q, seqlen_k);
+    const auto mask        = make_attention_mask<GenericMask>(info, seqlen_q, seqlen_k);
+    const DataType scale_s = 1.f / std::sqrt(static_cast<float>(hdim_q));
+
+    ck_tile::HostTensor<DataType> o({batch, seqlen_q, hdim_v});
+    ck_tile::HostTensor<DataType> lse({batch, seqlen_q});
+    auto forward = [&](std::optional<std::reference_wrapper<ck_tile::HostTensor<DataType>>> lse_) {
+        ck_tile::reference_fmha_fwd<DataType,
+                                    DataType,
+                                    DataType,
+                                    DataType,
+                                    float,
+                                    float,
+                                    DataType,
+                                    float,
+                                    DataType>(
+            q, k, v, bias_ref, o, mask, ck_tile::scales(scale_s), {}, {}, lse_);
+    };
+    auto loss = [&]() {
+        forward(std::nullopt);
+        double l = 0;
+        for(index_t b = 0; b < batch; ++b)
+            for(index_t m = 0; m < seqlen_q; ++m)
+                for(index_t i = 0; i < hdim_v; ++i)
+                    l += static_cast<double>(d_o(b, m, i)) * o(b, m, i);
+        return l;
+    };
+
+    forward(lse);
+    ck_tile::HostTensor<DataType> dq({batch, seqlen_q, hdim_q});
+    ck_tile::HostTensor<DataType> dk({batch, seqlen_k, hdim_q});
+    ck_tile::HostTensor<DataType> dv({batch, seqlen_k, hdim_v});
+    ck_tile::HostTensor<DataType> dbias({batch, seqlen_q, seqlen_k});
+    std::optional<std::reference_wrapper<ck_tile::HostTensor<DataType>>> dbias_ref;
+    if(use_bias)
+        dbias_ref = dbias;
+    ck_tile::reference_fmha_bwd<DataType,
+                                DataType,
+                                DataType,
+                                DataType,
+                                DataType,
+                                DataType,
+                                DataType,
+                                float,
+                                DataType,
+                                DataType,
+                                DataType,
+                                DataType>(
+        q, k, v, bias_ref, o, lse, d_o, dq, dk, dv, dbias_ref, mask, scale_s);
+
+    // dV is [batch, seqlen_k, hdim_v] while V is [batch, hdim_v, seqlen_k]
+    auto check = [&](const char* name, ck_tile::HostTensor<DataType>& x, auto get_grad) {
+        index_t i = 0;
+        x.ForEach([&](auto& self, auto idx) {
+            if(i++ % kStride != 0)
+                return;
+            const DataType x0 = self(idx);
+            self(idx)         = x0 + kEps;
+            const double l_hi = loss();
+            self(idx)         = x0 - kEps;
+            const double l_lo = loss();
+            self(idx)         = x0;
+
+            const double expected = (l_hi - l_lo) / (2 * kEps);
+            const double grad     = get_grad(idx);
+            EXPECT_NEAR(grad, expected, 2e-3 + 1e-2 * std::abs(expected))
+                << name << "(" << idx[0] << ", " << idx[1] << ", " << idx[2] << ")";
+        });
+    };
+    check("dq", q, [&](auto idx) { return dq(idx); });
+    check("dk", k, [&](auto idx) { return dk(idx); });
+    check("dv", v, [&](auto idx) { return dv(idx[0], idx[2], idx[1]); });
+    if(use_bias)
+        check("dbias", bias, [&](auto idx) { return dbias(idx); });
+
+    // queries without any key left do not contribute
+    for(index_t b = 0; b < batch; ++b)
+    {
+        for(index_t m = 0; m < seqlen_q; ++m)
+        {
+            if(!std::isinf(lse(b, m)))
+                continue;
+            for(index_t i = 0; i < hdim_q; ++i)
+                EXPECT_EQ(dq(b, m, i), 0.f);
+        }
+    }
+}
+
+TEST(FmhaBwdReference, NoMask) { check_bwd_reference("0", 40, 140, false); }
+TEST(FmhaBwdReference, NoMaskBias) { check_bwd_reference("0", 40, 140, true); }
+TEST(FmhaBwdReference, CausalTopLeft) { check_bwd_reference("t", 40, 140, true); }
+// the first rows have no key left, lse is -inf there
+TEST(FmhaBwdReference, CausalBottomRight) { check_bwd_reference("b", 40, 20, false); }
+TEST(FmhaBwdReference, SlidingWindow)
+{
+    check_bwd_reference("t:5,3", 40, 140, true);
+    for(const std::string& mask_str : ck_tile::test::fmha_test_window_masks())
+        check_bwd_reference(mask_str, 40, 20, false);
+}
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/ops/fmha.hpp"
+#include "mask.hpp"
+
+namespace ck_tile::test {
+
+using NoMask      = GenericAttentionMask<false>;
+using GenericMask = GenericAttentionMask<true, true>;
+using CausalMask  = GenericAttentionMask<true, false>;
+
+// seqlen_q/seqlen_k pairs shared by the fmha host tests: decode rows, tile-sized and unaligned
+// squares, and both seqlen_q > seqlen_k and seqlen_q < seqlen_k, so bottom-right masks shift
+inline const std::vector<std::tuple<index_t, index_t>>& fmha_test_seqlens()
+{
+    // clang-format off
+    static const std::vector<std::tuple<index_t, index_t>> seqlens = {
+        {1, 1}, {1, 400}, {1, 1000}, {3, 777}, {7, 7}, {64, 64}, {128, 128}, {130, 130},
+        {61, 130}, {130, 61}, {64, 300}, {300, 64}, {129, 257}, {257, 129}, {400, 1}};
+    // clang-format on
+    return seqlens;
+}
+
+// sliding-window masks in every spelling mask_info::decode() accepts, some of them leave rows
+// without any visible key
+inline const std::vector<std::string>& fmha_test_window_masks()
+{
+    static const std::vector<std::string> masks = {"t:3,0",
+                                                   "t:0,5",
+                                                   "t:50,10",
+                                                   "t:100,50",
+                                                   "b:3,0",
+                                                   "b:64,64",
+                                                   "b:200,-1",
+                                                   "xt:64",
+                                                   "xb:129",
+                                                   "xt:-1",
+                                                   "g:1,1",
+                                                   "g:16,16",
+                                                   "g:100,1",
+                                                   "g:1,100"};
+    return masks;
+}
+
+// call f(seqlen_q, seqlen_k) for every shape in fmha_test_seqlens()
+template <typename F>
+void for_each_fmha_test_seqlen(F&& f)
+{
+    for(const auto& [seqlen_q, seqlen_k] : fmha_test_seqlens())
+        f(seqlen_q, seqlen_k);
+}
+
+// "mask:<str>, seqlen_q:<n>, seqlen_k:<n>" followed by the test specific ", <key>:<value>" pairs
+inline std::string fmha_test_trace(const std::string& mask_str,
+                                   index_t seqlen_q,
+                                   index_t seqlen_k,
+                                   const std::vector<std::tuple<std::string, index_t>>& extra = {})
+{
+    std::string trace = "mask:" + mask_str + ", seqlen_q:" + std::to_string(seqlen_q) +
+                        ", seqlen_k:" + std::to_string(seqlen_k);
+    for(const auto& [key, value] : extra)
+        trace += ", " + key + ":" + std::to_string(value);
+    return trace;
+}
+
+} // namespace ck_tile::test
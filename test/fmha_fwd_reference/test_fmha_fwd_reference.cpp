@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/fill.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_batched_elementwise.hpp"
+#include "ck_tile/host/reference/reference_batched_gemm.hpp"
+#include "ck_tile/host/reference/reference_batched_masking.hpp"
+#include "ck_tile/host/reference/reference_batched_softmax.hpp"
+#include "ck_tile/host/reference/reference_fmha_fwd.hpp"
+#include "ck_tile/ops/fmha.hpp"
+#include "mask.hpp"
+#include "test_fmha_util.hpp"
+
+using ck_tile::index_t;
+
+using ck_tile::test::GenericMask;
+using ck_tile::test::NoMask;
+
+// the data types of FmhaFwdTypeConfig<half_t> and FmhaFwdTypeConfig<fp8_t> in fmha_fwd.hpp
+struct Fp16Types
+{
+    using DataType     = ck_tile::half_t;
+    using BiasDataType = ck_tile::half_t;
+};
+
+struct Fp8Types
+{
+    using DataType     = ck_tile::fp8_t;
+    using BiasDataType = float;
+};
+
+// static quantization of fmha_fwd.cpp with squant=1 and every range_* set to 1
+constexpr float kFp8Max = 240.f;
+
+// the distance between x and its fp8 neighbour away from zero, the kernels are checked against
+// the reference with one such rounding step of slack as well
+float fp8_rounding_step(float x)
+{
+    const int exponent = x == 0.f ? -7 : std::max(std::ilogb(x), -7);
+    return std::ldexp(1.f, exponent - 3);
+}
+
+// reference_fmha_fwd against the chain of references fmha_fwd.cpp used before it was fused:
+// S = gemm(Q, K) -> S += bias -> mask(S) -> P = softmax(S) -> O = gemm(P, V).
+// bias_batch is 0 for no bias, 1 for a bias broadcast over the batch, batch otherwise
+template <typename Types, typename MaskType>
+void check_fwd_reference(const std::string& mask_str,
+                         index_t seqlen_q,
+                         index_t seqlen_k,
+                         index_t bias_batch)
+{
+    using DataType            = typename Types::DataType;
+    using BiasDataType        = typename Types::BiasDataType;
+    using SaccDataType        = float;
+    using SMPLComputeDataType = float;
+    using OaccDataType        = float;
+
+    constexpr bool is_fp8    = std::is_same_v<DataType, ck_tile::fp8_t>;
+    constexpr index_t batch  = 2;
+    constexpr index_t hdim_q = 40;
+    constexpr index_t hdim_v = 24;
+
+    SCOPED_TRACE(ck_tile::test::fmha_test_trace(
+        mask_str, seqlen_q, seqlen_k, {{"fp8", is_fp8}, {"bias_batch", bias_batch}}));
+
+    // fp8 holds the quantized values, the scales below bring them back into [-1, 1]
+    const float range = is_fp8 ? kFp8Max : 1.f;
+
+    ck_tile::HostTensor<DataType> q({batch, seqlen_q, hdim_q});
+    ck_tile::HostTensor<DataType> k({batch, seqlen_k, hdim_q});
+    ck_tile::HostTensor<DataType> v({batch, hdim_v, seqlen_k});
+    ck_tile::HostTensor<BiasDataType> bias({std::max<index_t>(bias_batch, 1), seqlen_q, seqlen_k});
+    ck_tile::FillUniformDistribution<DataType>{-range, range, 1}(q);
+    ck_tile::FillUniformDistribution<DataType>{-range, range, 2}(k);
+    ck_tile::FillUniformDistribution<DataType>{-range, range, 3}(v);
+    ck_tile::FillUniformDistribution<BiasDataType>{-1.f, 1.f, 4}(bias);
+
+    std::optional<std::reference_wrapper<const ck_tile::HostTensor<BiasDataType>>> bias_ref;
+    if(bias_batch != 0)
+        bias_ref = bias;
+
+    const mask_info info = mask_info::decode(mask_str, seqlen_q, seqlen_k);
+    const auto mask      = make_attention_mask<MaskType>(info, seqlen_q, seqlen_k);
+
+    const float scale_s = 1.f / std::sqrt(static_cast<float>(hdim_q)) / (range * range);
+    const float scale_p = is_fp8 ? kFp8Max : 1.f;
+    const float scale_o = is_fp8 ? 1.f / kFp8Max : 1.f;
+
+    const ck_tile::scales s_acc_element_op(scale_s);
+    const ck_tile::scales p_compute_element_op(scale_p);
+    const auto o_acc_element_op =
+        ck_tile::composes(ck_tile::saturates<DataType>{}, ck_tile::scales{scale_o});
+
+    ck_tile::HostTensor<DataType> o({batch, seqlen_q, hdim_v});
+    ck_tile::HostTensor<SMPLComputeDataType> lse({batch, seqlen_q});
+    ck_tile::reference_fmha_fwd<DataType,
+                                DataType,
+                                DataType,
+                                BiasDataType,
+                                SaccDataType,
+                                SMPLComputeDataType,
+                                DataType,
+                                OaccDataType,
+                                DataType>(q,
+                                          k,
+                                          v,
+                                          bias_ref,
+                                          o,
+                                          mask,
+                                          s_acc_element_op,
+                                          p_compute_element_op,
+                                          o_acc_element_op,
+                                          lse);
+
+    ck_tile::HostTensor<SMPLComputeDataType> s_ref({batch, seqlen_q, seqlen_k});
+    ck_tile::HostTensor<DataType> p_ref({batch, seqlen_q, seqlen_k});
+    ck_tile::HostTensor<DataType> o_ref({batch, seqlen_q, hdim_v});
+    ck_tile::HostTensor<SMPLComputeDataType> lse_ref({batch, seqlen_q});
+
+    ck_tile::reference_batched_gemm<DataType, DataType, SaccDataType, SMPLComputeDataType>(
+        q, k, s_ref, ck_tile::identity{}, ck_tile::identity{}, s_acc_element_op);
+    if(bias_batch != 0)
+        ck_tile::reference_batched_elementwise<SMPLComputeDataType,
+                                               BiasDataType,
+                                               SMPLComputeDataType,
+                                               SMPLComputeDataType>(s_ref, bias, s_ref);
+    ck_tile::reference_batched_masking<SaccDataType>(s_ref, mask);
+    ck_tile::reference_batched_softmax<SMPLComputeDataType, SMPLComputeDataType, DataType>(
+        s_ref, p_ref, p_compute_element_op, lse_ref);
+    ck_tile::reference_batched_gemm<DataType, DataType, OaccDataType, DataType>(
+        p_ref, v, o_ref, ck_tile::identity{}, ck_tile::identity{}, o_acc_element_op);
+
+    // S is bit-exact, only the softmax sum is accumulated in another order, so P may round to
+    // the neighbouring fp16/fp8 value here and there
+    for(index_t b = 0; b < batch; ++b)
+        for(index_t m = 0; m < seqlen_q; ++m)
+        {
+            if(std::isinf(lse_ref(b, m)))
+                EXPECT_EQ(lse(b, m), lse_ref(b, m)) << "row (" << b << ", " << m << ")";
+            else
+                EXPECT_NEAR(lse(b, m), lse_ref(b, m), 1e-5) << "row (" << b << ", " << m << ")";
+
+            for(index_t i = 0; i < hdim_v; ++i)
+            {
+                const float val = ck_tile::type_convert<float>(o(b, m, i));
+                const float ref = ck_tile::type_convert<float>(o_ref(b, m, i));
+                const float tol = is_fp8 ? fp8_rounding_step(std::max(std::abs(val), std::abs(ref)))
+                                         : 1e-3f;
+                EXPECT_NEAR(val, ref, tol) << "row (" << b << ", " << m << "), col " << i;
+            }
+        }
+}
+
+template <typename Types, typename MaskType>
+void check_fwd_reference_all_shapes(const std::string& mask_str)
+{
+    ck_tile::test::for_each_fmha_test_seqlen([&](index_t seqlen_q, index_t seqlen_k) {
+        check_fwd_reference<Types, MaskType>(mask_str, seqlen_q, seqlen_k, 0);
+        check_fwd_reference<Types, MaskType>(mask_str, seqlen_q, seqlen_k, 1);
+        check_fwd_reference<Types, MaskType>(mask_str, seqlen_q, seqlen_k, 2);
+    });
+}
+
+TEST(FmhaFwdReference, NoMask) { check_fwd_reference_all_shapes<Fp16Types, NoMask>("0"); }
+
+TEST(FmhaFwdReference, CausalTopLeft)
+{
+    check_fwd_reference_all_shapes<Fp16Types, GenericMask>("t");
+}
+
+TEST(FmhaFwdReference, CausalBottomRight)
+{
+    check_fwd_reference_all_shapes<Fp16Types, GenericMask>("b");
+}
+
+TEST(FmhaFwdReference, SlidingWindow)
+{
+    for(const std::string& mask_str : ck_tile::test::fmha_test_window_masks())
+        check_fwd_reference_all_shapes<Fp16Types, GenericMask>(mask_str);
+}
+
+// scale_p/scale_o of the static quantization are applied to P before it is rounded and to O
+TEST(FmhaFwdReference, Fp8)
+{
+    check_fwd_reference_all_shapes<Fp8Types, NoMask>("0");
+    check_fwd_reference_all_shapes<Fp8Types, GenericMask>("b");
+    check_fwd_reference_all_shapes<Fp8Types, GenericMask>("t:50,10");
+}
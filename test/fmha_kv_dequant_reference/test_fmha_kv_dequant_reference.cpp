@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/fill.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_fmha_fwd.hpp"
+#include "ck_tile/ops/fmha.hpp"
+#include "mask.hpp"
+#include "test_fmha_util.hpp"
+
+using ck_tile::index_t;
+
+using DataType   = float;
+using KVDataType = int8_t;
+
+using ck_tile::test::GenericMask;
+
+// int8 K/V with per-head scales must give the attention of the dequantized K/V
+void check_kv_dequant_reference(const std::string& mask_str, index_t seqlen_q, index_t seqlen_k)
+{
+    constexpr index_t nhead  = 4;
+    constexpr index_t hdim_q = 32;
+    constexpr index_t hdim_v = 16;
+
+    SCOPED_TRACE(ck_tile::test::fmha_test_trace(mask_str, seqlen_q, seqlen_k));
+
+    ck_tile::HostTensor<DataType> q({nhead, seqlen_q, hdim_q});
+    ck_tile::HostTensor<KVDataType> k({nhead, seqlen_k, hdim_q});
+    ck_tile::HostTensor<KVDataType> v({nhead, hdim_v, seqlen_k});
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 1}(q);
+    ck_tile::FillUniformDistributionIntegerValue<KVDataType>{-127.f, 127.f, 2}(k);
+    ck_tile::FillUniformDistributionIntegerValue<KVDataType>{-127.f, 127.f, 3}(v);
+
+    // every head has its own range
+    std::vector<float> k_descale, v_descale;
+    for(index_t h = 0; h < nhead; ++h)
+    {
+        k_descale.push_back((0.5f + h) / 127.f);
+        v_descale.push_back((2.f - 0.25f * h) / 127.f);
+    }
+
+    ck_tile::HostTensor<DataType> k_dequant({nhead, seqlen_k, hdim_q});
+    ck_tile::HostTensor<DataType> v_dequant({nhead, hdim_v, seqlen_k});
+    k_dequant.ForEach([&](auto& self, auto i) { self(i) = k_descale[i[0]] * k(i); });
+    v_dequant.ForEach([&](auto& self, auto i) { self(i) = v_descale[i[0]] * v(i); });
+
+    const mask_info info = mask_info::decode(mask_str, seqlen_q, seqlen_k);
+    const auto mask      = make_attention_mask<GenericMask>(info, seqlen_q, seqlen_k);
+    const ck_tile::scales s_acc_element_op(1.f / std::sqrt(static_cast<float>(hdim_q)));
+
+    ck_tile::HostTensor<DataType> o({nhead, seqlen_q, hdim_v});
+    ck_tile::HostTensor<float> lse({nhead, seqlen_q});
+    ck_tile::reference_fmha_fwd_kv_dequant<DataType,
+                                           KVDataType,
+                                           KVDataType,
+                                           DataType,
+                                           float,
+                                           float,
+                                           DataType,
+                                           float,
+                                           DataType>(q,
+                                                     k,
+                                                     v,
+                                                     std::nullopt,
+                                                     o,
+                                                     mask,
+                                                     k_descale,
+                                                     v_descale,
+                                                     s_acc_element_op,
+                                                     ck_tile::identity{},
+                                                     ck_tile::identity{},
+                                                     lse);
+
+    ck_tile::HostTensor<DataType> o_ref({nhead, seqlen_q, hdim_v});
+    ck_tile::HostTensor<float> lse_ref({nhead, seqlen_q});
+    ck_tile::reference_fmha_fwd<DataType,
+                                DataType,
+                                DataType,
+                                DataType,
+                                float,
+                                float,
+                                DataType,
+                                float,
+                                DataType>(q,
+                                          k_dequant,
+                                          v_dequant,
+                                          std::nullopt,
+                                          o_ref,
+                                          mask,
+                                          s_acc_element_op,
+                                          ck_tile::identity{},
+                                          ck_tile::identity{},
+                                          lse_ref);
+
+    for(index_t h = 0; h < nhead; ++h)
+    {
+        for(index_t m = 0; m < seqlen_q; ++m)
+        {
+            for(index_t i = 0; i < hdim_v; ++i)
+                EXPECT_NEAR(o(h, m, i), o_ref(h, m, i), 1e-4f);
+            if(std::isinf(lse_ref(h, m)))
+                EXPECT_EQ(lse(h, m), lse_ref(h, m));
+            else
+                EXPECT_NEAR(lse(h, m), lse_ref(h, m), 1e-4f);
+        }
+    }
+}
+
+TEST(FmhaKVDequantReference, NoMask) { check_kv_dequant_reference("0", 37, 300); }
+TEST(FmhaKVDequantReference, Decode) { check_kv_dequant_reference("b", 1, 1000); }
+TEST(FmhaKVDequantReference, SlidingWindow)
+{
+    for(const std::string& mask_str : ck_tile::test::fmha_test_window_masks())
+        check_kv_dequant_reference(mask_str, 64, 70);
+}
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <string>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/ops/fmha.hpp"
+#include "mask.hpp"
+#include "test_fmha_util.hpp"
+
+using ck_tile::index_t;
+using ck_tile::MaskTileKind;
+using ck_tile::number;
+
+using ck_tile::test::CausalMask;
+using ck_tile::test::GenericMask;
+using ck_tile::test::NoMask;
+
+// compare every tile of the table against the per-pixel IsOutOfBound() of the same mask
+template <typename MaskType, index_t kM0, index_t kN0>
+void check_mask_tile_table(const std::string& mask_str, index_t seqlen_q, index_t seqlen_k)
+{
+    const mask_info info = mask_info::decode(mask_str, seqlen_q, seqlen_k);
+    const auto mask      = make_attention_mask<MaskType>(info, seqlen_q, seqlen_k);
+    const auto table =
+        make_mask_tile_table<MaskType>(info, seqlen_q, seqlen_k, number<kM0>{}, number<kN0>{});
+
+    SCOPED_TRACE(ck_tile::test::fmha_test_trace(
+        mask_str, seqlen_q, seqlen_k, {{"tile_m", kM0}, {"tile_n", kN0}}));
+
+    ASSERT_EQ(table.num_tile_m, ck_tile::integer_divide_ceil(seqlen_q, kM0));
+    ASSERT_EQ(table.num_tile_n, ck_tile::integer_divide_ceil(seqlen_k, kN0));
+    ASSERT_EQ(table.offsets.back(), static_cast<index_t>(table.kinds.size()));
+
+    index_t num_edge_tiles  = 0;
+    index_t num_dense_tiles = 0;
+    for(index_t i_tile_m = 0; i_tile_m < table.num_tile_m; ++i_tile_m)
+    {
+        // same trip count as the pipeline loop over seqlen_k
+        const auto [x_start, x_end] =
+            mask.GetTileRangeAlongX(i_tile_m * kM0, number<kM0>{}, number<kN0>{});
+        EXPECT_EQ(table.get_num_visited_tiles(i_tile_m),
+                  ck_tile::integer_divide_ceil(ck_tile::max(x_end - x_start, 0), kN0));
+
+        for(index_t i_tile_n = 0; i_tile_n < table.num_tile_n; ++i_tile_n)
+        {
+            index_t num_valid = 0;
+            index_t num_total = 0;
+            for(index_t i_y = i_tile_m * kM0; i_y < ck_tile::min((i_tile_m + 1) * kM0, seqlen_q);
+                ++i_y)
+                for(index_t i_x = i_tile_n * kN0;
+                    i_x < ck_tile::min((i_tile_n + 1) * kN0, seqlen_k);
+                    ++i_x)
+                {
+                    num_valid += !mask.IsOutOfBound(i_y, i_x);
+                    ++num_total;
+                }
+
+            const MaskTileKind kind = table.get(i_tile_m, i_tile_n);
+            if(kind == MaskTileKind::EMPTY)
+            {
+                EXPECT_EQ(num_valid, 0) << "tile (" << i_tile_m << ", " << i_tile_n << ")";
+            }
+            else if(kind == MaskTileKind::DENSE)
+            {
+                EXPECT_EQ(num_valid, num_total) << "tile (" << i_tile_m << ", " << i_tile_n << ")";
+                EXPECT_LE((i_tile_n + 1) * kN0, seqlen_k);
+                ++num_dense_tiles;
+            }
+            else
+            {
+                ++num_edge_tiles;
+            }
+        }
+    }
+    EXPECT_EQ(table.num_edge_tiles, num_edge_tiles);
+    EXPECT_EQ(table.num_dense_tiles, num_dense_tiles);
+}
+
+template <typename MaskType>
+void check_mask_tile_table_all_shapes(const std::string& mask_str)
+{
+    ck_tile::test::for_each_fmha_test_seqlen([&](index_t seqlen_q, index_t seqlen_k) {
+        check_mask_tile_table<MaskType, 128, 128>(mask_str, seqlen_q, seqlen_k);
+        check_mask_tile_table<MaskType, 128, 64>(mask_str, seqlen_q, seqlen_k);
+        check_mask_tile_table<MaskType, 64, 128>(mask_str, seqlen_q, seqlen_k);
+        check_mask_tile_table<MaskType, 16, 32>(mask_str, seqlen_q, seqlen_k);
+    });
+}
+
+TEST(FmhaMaskTileTable, NoMask)
+{
+    check_mask_tile_table_all_shapes<NoMask>("0");
+
+    const auto table = make_mask_tile_table<NoMask>(
+        mask_info::decode("0", 200, 300), 200, 300, number<128>{}, number<128>{});
+    EXPECT_EQ(table.get_num_empty_tiles(), 0);
+    EXPECT_EQ(table.num_dense_tiles, 4);
+    EXPECT_EQ(table.num_edge_tiles, 2); // last kv-tile is padded
+}
+
+TEST(FmhaMaskTileTable, MaskTopLeft)
+{
+    check_mask_tile_table_all_shapes<CausalMask>("t");
+    check_mask_tile_table_all_shapes<CausalMask>("1");
+    check_mask_tile_table_all_shapes<ck_tile::SimplifiedGenericAttentionMask<true>>("t");
+
+    // causal, 4x4 tiles: upper triangle empty, diagonal edge, lower triangle dense
+    const auto table = make_mask_tile_table<CausalMask>(
+        mask_info::decode("t", 512, 512), 512, 512, number<128>{}, number<128>{});
+    EXPECT_EQ(table.get_num_empty_tiles(), 6);
+    EXPECT_EQ(table.num_edge_tiles, 4);
+    EXPECT_EQ(table.num_dense_tiles, 6);
+}
+
+TEST(FmhaMaskTileTable, MaskBottomRight)
+{
+    check_mask_tile_table_all_shapes<CausalMask>("b");
+    check_mask_tile_table_all_shapes<CausalMask>("2");
+    check_mask_tile_table_all_shapes<ck_tile::SimplifiedGenericAttentionMask<true>>("b");
+}
+
+TEST(FmhaMaskTileTable, SlidingWindow)
+{
+    for(const std::string& mask_str : ck_tile::test::fmha_test_window_masks())
+    {
+        check_mask_tile_table_all_shapes<GenericMask>(mask_str);
+        check_mask_tile_table_all_shapes<ck_tile::SimplifiedGenericAttentionMask<true>>(mask_str);
+    }
+
+    // window of 64 on the left, 4x4 tiles: only the diagonal and the one below it are visited
+    const auto table = make_mask_tile_table<GenericMask>(
+        mask_info::decode("t:64,0", 512, 512), 512, 512, number<128>{}, number<128>{});
+    EXPECT_EQ(table.get_num_empty_tiles(), 9);
+    EXPECT_EQ(table.num_edge_tiles, 7);
+    EXPECT_EQ(table.num_dense_tiles, 0);
+}
+
+TEST(FmhaMaskTileTable, WindowGeneric)
+{
+    // the shared window list has the small generic windows, this one is wider than most shapes
+    check_mask_tile_table_all_shapes<GenericMask>("g:300,300");
+    check_mask_tile_table_all_shapes<ck_tile::SimplifiedGenericAttentionMask<true>>("g:300,300");
+}
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/fill.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_batched_elementwise.hpp"
+#include "ck_tile/host/reference/reference_batched_masking.hpp"
+#include "ck_tile/ops/fmha.hpp"
+#include "mask.hpp"
+#include "test_fmha_util.hpp"
+
+using ck_tile::index_t;
+
+using ck_tile::test::CausalMask;
+using ck_tile::test::GenericMask;
+using ck_tile::test::NoMask;
+
+constexpr index_t kBatch = 3;
+
+// a mask without GetTileRangeAlongX(), reference_batched_masking has to fall back to IsOutOfBound()
+struct CheckerboardMask
+{
+    bool IsOutOfBound(index_t i_y, index_t i_x) const { return (i_y + i_x) % 3 == 0; }
+};
+
+// [batch, seqlen_q, seqlen_k] with the last dimension packed, or a transposed [.., seqlen_k, ..]
+// view of it so that the rows are walked with a stride
+ck_tile::HostTensor<float> make_s(index_t seqlen_q, index_t seqlen_k, bool transposed)
+{
+    const std::size_t sq = seqlen_q;
+    const std::size_t sk = seqlen_k;
+
+    const std::vector<std::size_t> lens    = {kBatch, sq, sk};
+    const std::vector<std::size_t> strides = {sq * sk, transposed ? 1 : sk, transposed ? sq : 1};
+    ck_tile::HostTensor<float> s(lens, strides);
+    ck_tile::FillUniformDistribution<float>{-1.f, 1.f, 1}(s);
+    return s;
+}
+
+// every element of reference_batched_masking must be the input or -inf as IsOutOfBound() says
+template <typename MaskType>
+void check_masking(const std::string& trace,
+                   const MaskType& mask,
+                   index_t seqlen_q,
+                   index_t seqlen_k)
+{
+    for(bool transposed : {false, true})
+    {
+        SCOPED_TRACE(trace + ", transposed:" + std::to_string(transposed));
+
+        const auto s_in = make_s(seqlen_q, seqlen_k, transposed);
+        auto s          = s_in;
+        ck_tile::reference_batched_masking<float>(s, mask);
+
+        for(index_t b = 0; b < kBatch; ++b)
+            for(index_t m = 0; m < seqlen_q; ++m)
+                for(index_t n = 0; n < seqlen_k; ++n)
+                {
+                    if(mask.IsOutOfBound(m, n))
+                        EXPECT_TRUE(std::isinf(s(b, m, n)) && s(b, m, n) < 0)
+                            << "(" << b << ", " << m << ", " << n << ") is not masked";
+                    else
+                        EXPECT_EQ(s(b, m, n), s_in(b, m, n))
+                            << "(" << b << ", " << m << ", " << n << ") is masked";
+                }
+    }
+}
+
+template <typename MaskType>
+void check_masking_all_shapes(const std::string& mask_str)
+{
+    ck_tile::test::for_each_fmha_test_seqlen([&](index_t seqlen_q, index_t seqlen_k) {
+        const mask_info info = mask_info::decode(mask_str, seqlen_q, seqlen_k);
+        check_masking(ck_tile::test::fmha_test_trace(mask_str, seqlen_q, seqlen_k),
+                      make_attention_mask<MaskType>(info, seqlen_q, seqlen_k),
+                      seqlen_q,
+                      seqlen_k);
+    });
+}
+
+TEST(FmhaMaskingReference, NoMask) { check_masking_all_shapes<NoMask>("0"); }
+
+TEST(FmhaMaskingReference, CausalTopLeft)
+{
+    check_masking_all_shapes<CausalMask>("t");
+    check_masking_all_shapes<GenericMask>("t");
+}
+
+// the shared shapes include seqlen_q > seqlen_k, where the first rows see no key at all
+TEST(FmhaMaskingReference, CausalBottomRight)
+{
+    check_masking_all_shapes<CausalMask>("b");
+    check_masking_all_shapes<GenericMask>("b");
+}
+
+TEST(FmhaMaskingReference, SlidingWindow)
+{
+    for(const std::string& mask_str : ck_tile::test::fmha_test_window_masks())
+    {
+        check_masking_all_shapes<GenericMask>(mask_str);
+        check_masking_all_shapes<ck_tile::SimplifiedGenericAttentionMask<true>>(mask_str);
+    }
+}
+
+TEST(FmhaMaskingReference, IsOutOfBoundOnly)
+{
+    ck_tile::test::for_each_fmha_test_seqlen([&](index_t seqlen_q, index_t seqlen_k) {
+        check_masking(ck_tile::test::fmha_test_trace("checkerboard", seqlen_q, seqlen_k),
+                      CheckerboardMask{},
+                      seqlen_q,
+                      seqlen_k);
+    });
+}
+
+// reference_batched_elementwise against c = a + b, with b broadcast over the batch or not and
+// with packed or strided rows
+TEST(FmhaMaskingReference, Elementwise)
+{
+    ck_tile::test::for_each_fmha_test_seqlen([&](index_t seqlen_q, index_t seqlen_k) {
+        for(index_t bias_batch : {1, kBatch})
+            for(bool transposed : {false, true})
+            {
+                SCOPED_TRACE(ck_tile::test::fmha_test_trace(
+                    "0",
+                    seqlen_q,
+                    seqlen_k,
+                    {{"bias_batch", bias_batch}, {"transposed", transposed}}));
+
+                const auto a = make_s(seqlen_q, seqlen_k, transposed);
+                ck_tile::HostTensor<float> bias({bias_batch, seqlen_q, seqlen_k});
+                ck_tile::FillUniformDistribution<float>{-1.f, 1.f, 2}(bias);
+
+                auto c = make_s(seqlen_q, seqlen_k, !transposed);
+                ck_tile::reference_batched_elementwise<float, float, float, float>(a, bias, c);
+
+                for(index_t b = 0; b < kBatch; ++b)
+                    for(index_t m = 0; m < seqlen_q; ++m)
+                        for(index_t n = 0; n < seqlen_k; ++n)
+                            EXPECT_EQ(c(b, m, n), a(b, m, n) + bias(bias_batch == 1 ? 0 : b, m, n))
+                                << "(" << b << ", " << m << ", " << n << ")";
+            }
+    });
+}
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/fill.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_fmha_fwd.hpp"
+#include "ck_tile/ops/fmha.hpp"
+#include "mask.hpp"
+#include "test_fmha_util.hpp"
+
+using ck_tile::index_t;
+
+using DataType = float;
+
+using ck_tile::test::GenericMask;
+
+// K/V scattered over shuffled pages whose unused rows, the tail of the last page of the sequence
+// and the pages of no sequence, hold NaN: the attention must be the one of the contiguous K/V
+void check_paged_kv_reference(const std::string& mask_str,
+                              index_t seqlen_q,
+                              index_t seqlen_k,
+                              index_t page_block_size)
+{
+    constexpr index_t nhead_q = 4;
+    constexpr index_t nhead_k = 2;
+    constexpr index_t hdim_q  = 32;
+    constexpr index_t hdim_v  = 16;
+
+    SCOPED_TRACE(ck_tile::test::fmha_test_trace(
+        mask_str, seqlen_q, seqlen_k, {{"page_block_size", page_block_size}}));
+
+    ck_tile::HostTensor<DataType> q({nhead_q, seqlen_q, hdim_q});
+    ck_tile::HostTensor<DataType> k({nhead_q, seqlen_k, hdim_q});
+    ck_tile::HostTensor<DataType> v({nhead_q, hdim_v, seqlen_k});
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 1}(q);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 2}(k);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 3}(v);
+    // query heads share the K/V heads
+    k.ForEach([&](auto& self, auto i) {
+        self(i) = self(i[0] / (nhead_q / nhead_k) * (nhead_q / nhead_k), i[1], i[2]);
+    });
+    v.ForEach([&](auto& self, auto i) {
+        self(i) = self(i[0] / (nhead_q / nhead_k) * (nhead_q / nhead_k), i[1], i[2]);
+    });
+
+    const index_t num_pages =
+        std::max(ck_tile::integer_divide_ceil(seqlen_k, page_block_size), index_t{1});
+    const index_t num_page_blocks = num_pages + 2;
+    std::vector<int32_t> pages(num_page_blocks);
+    std::iota(pages.begin(), pages.end(), 0);
+    std::shuffle(pages.begin(), pages.end(), std::mt19937(4));
+    const std::vector<int32_t> block_table(pages.begin(), pages.begin() + num_pages);
+
+    ck_tile::HostTensor<DataType> k_pool({num_page_blocks, page_block_size, nhead_k, hdim_q});
+    ck_tile::HostTensor<DataType> v_pool({num_page_blocks, page_block_size, nhead_k, hdim_v});
+    ck_tile::FillConstant<DataType>{ck_tile::numeric<DataType>::quiet_NaN()}(k_pool);
+    ck_tile::FillConstant<DataType>{ck_tile::numeric<DataType>::quiet_NaN()}(v_pool);
+    for(index_t n = 0; n < seqlen_k; ++n)
+    {
+        const index_t page = block_table[n / page_block_size];
+        const index_t row  = n % page_block_size;
+        for(index_t h = 0; h < nhead_k; ++h)
+        {
+            for(index_t d = 0; d < hdim_q; ++d)
+                k_pool(page, row, h, d) = k(h * (nhead_q / nhead_k), n, d);
+            for(index_t d = 0; d < hdim_v; ++d)
+                v_pool(page, row, h, d) = v(h * (nhead_q / nhead_k), d, n);
+        }
+    }
+
+    const mask_info info = mask_info::decode(mask_str, seqlen_q, seqlen_k);
+    const auto mask      = make_attention_mask<GenericMask>(info, seqlen_q, seqlen_k);
+    const ck_tile::scales s_acc_element_op(1.f / std::sqrt(static_cast<float>(hdim_q)));
+
+    ck_tile::HostTensor<DataType> o({nhead_q, seqlen_q, hdim_v});
+    ck_tile::HostTensor<float> lse({nhead_q, seqlen_q});
+    ck_tile::reference_fmha_fwd_paged_kv<DataType,
+                                         DataType,
+                                         DataType,
+                                         DataType,
+                                         float,
+                                         float,
+                                         DataType,
+                                         float,
+                                         DataType>(q,
+                                                   k_pool,
+                                                   v_pool,
+                                                   block_table,
+                                                   seqlen_k,
+                                                   std::nullopt,
+                                                   o,
+                                                   mask,
+                                                   s_acc_element_op,
+                                                   ck_tile::identity{},
+                                                   ck_tile::identity{},
+                                                   lse);
+
+    ck_tile::HostTensor<DataType> o_ref({nhead_q, seqlen_q, hdim_v});
+    ck_tile::HostTensor<float> lse_ref({nhead_q, seqlen_q});
+    ck_tile::reference_fmha_fwd<DataType,
+                                DataType,
+                                DataType,
+                                DataType,
+                                float,
+                                float,
+                                DataType,
+                                float,
+                                DataType>(q,
+                                          k,
+                                          v,
+                                          std::nullopt,
+                                          o_ref,
+                                          mask,
+                                          s_acc_element_op,
+                                          ck_tile::identity{},
+                                          ck_tile::identity{},
+                                          lse_ref);
+
+    for(index_t h = 0; h < nhead_q; ++h)
+    {
+        for(index_t m = 0; m < seqlen_q; ++m)
+        {
+            for(index_t i = 0; i < hdim_v; ++i)
+            {
+                ASSERT_FALSE(std::isnan(o(h, m, i)));
+                EXPECT_NEAR(o(h, m, i), o_ref(h, m, i), 1e-5f);
+            }
+            if(std::isinf(lse_ref(h, m)))
+                EXPECT_EQ(lse(h, m), lse_ref(h, m));
+            else
+                EXPECT_NEAR(lse(h, m), lse_ref(h, m), 1e-5f);
+        }
+    }
+}
+
+// seqlen_k that is not a multiple of the page size leaves a partially used last page
+TEST(FmhaPagedKVReference, NoMask) { check_paged_kv_reference("0", 37, 300, 128); }
+TEST(FmhaPagedKVReference, Decode) { check_paged_kv_reference("b", 1, 1000, 256); }
+TEST(FmhaPagedKVReference, FullPages) { check_paged_kv_reference("0", 16, 256, 128); }
+TEST(FmhaPagedKVReference, SlidingWindow)
+{
+    for(const std::string& mask_str : ck_tile::test::fmha_test_window_masks())
+        check_paged_kv_reference(mask_str, 64, 70, 64);
+}
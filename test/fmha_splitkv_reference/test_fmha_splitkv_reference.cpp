@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/fill.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_fmha_fwd.hpp"
+#include "ck_tile/ops/fmha.hpp"
+#include "mask.hpp"
+#include "test_fmha_util.hpp"
+
+using ck_tile::index_t;
+
+using DataType    = ck_tile::half_t;
+using AccDataType = float;
+
+using ck_tile::test::GenericMask;
+using ck_tile::test::NoMask;
+
+// merging the partial results of any number of splits must give back the unsplit attention
+template <typename MaskType>
+void check_splitkv_reference(const std::string& mask_str,
+                             index_t seqlen_q,
+                             index_t seqlen_k,
+                             index_t num_splits,
+                             bool use_bias)
+{
+    constexpr index_t batch  = 2;
+    constexpr index_t hdim_q = 40;
+    constexpr index_t hdim_v = 24;
+
+    SCOPED_TRACE(ck_tile::test::fmha_test_trace(
+        mask_str, seqlen_q, seqlen_k, {{"num_splits", num_splits}, {"bias", use_bias}}));
+
+    ck_tile::HostTensor<DataType> q({batch, seqlen_q, hdim_q});
+    ck_tile::HostTensor<DataType> k({batch, seqlen_k, hdim_q});
+    ck_tile::HostTensor<DataType> v({batch, hdim_v, seqlen_k});
+    ck_tile::HostTensor<DataType> bias({1, seqlen_q, seqlen_k});
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 1}(q);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 2}(k);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 3}(v);
+    ck_tile::FillUniformDistribution<DataType>{-1.f, 1.f, 4}(bias);
+
+    std::optional<std::reference_wrapper<const ck_tile::HostTensor<DataType>>> bias_ref;
+    if(use_bias)
+        bias_ref = bias;
+
+    const mask_info info = mask_info::decode(mask_str, seqlen_q, seqlen_k);
+    const auto mask      = make_attention_mask<MaskType>(info, seqlen_q, seqlen_k);
+    const ck_tile::scales s_acc_element_op(1.f / std::sqrt(static_cast<float>(hdim_q)));
+
+    ck_tile::HostTensor<DataType> o({batch, seqlen_q, hdim_v});
+    ck_tile::HostTensor<AccDataType> lse({batch, seqlen_q});
+    ck_tile::reference_fmha_fwd<DataType,
+                                DataType,
+                                DataType,
+                                DataType,
+                                AccDataType,
+                                AccDataType,
+                                DataType,
+                                AccDataType,
+                                DataType>(q,
+                                          k,
+                                          v,
+                                          bias_ref,
+                                          o,
+                                          mask,
+                                          s_acc_element_op,
+                                          ck_tile::identity{},
+                                          ck_tile::identity{},
+                                          lse);
+
+    ck_tile::HostTensor<AccDataType> o_acc({num_splits, batch, seqlen_q, hdim_v});
+    ck_tile::HostTensor<AccDataType> lse_acc({num_splits, batch, seqlen_q});
+    ck_tile::reference_fmha_fwd_splitkv<DataType,
+                                        DataType,
+                                        DataType,
+                                        DataType,
+                                        AccDataType,
+                                        AccDataType,
+                                        DataType,
+                                        AccDataType>(
+        q, k, v, bias_ref, o_acc, lse_acc, mask, s_acc_element_op);
+
+    ck_tile::HostTensor<DataType> o_split({batch, seqlen_q, hdim_v});
+    ck_tile::HostTensor<AccDataType> lse_split({batch, seqlen_q});
+    ck_tile::reference_fmha_fwd_splitkv_combine<AccDataType, AccDataType, DataType>(
+        o_acc, lse_acc, o_split, ck_tile::identity{}, lse_split);
+
+    // P is normalized per split before being rounded to fp16, so results are close, not equal
+    for(index_t b = 0; b < batch; ++b)
+        for(index_t m = 0; m < seqlen_q; ++m)
+        {
+            if(std::isinf(lse(b, m)))
+                EXPECT_EQ(lse_split(b, m), lse(b, m)) << "row (" << b << ", " << m << ")";
+            else
+                EXPECT_NEAR(lse_split(b, m), lse(b, m), 1e-4) << "row (" << b << ", " << m << ")";
+
+            for(index_t i = 0; i < hdim_v; ++i)
+                EXPECT_NEAR(ck_tile::type_convert<float>(o_split(b, m, i)),
+                            ck_tile::type_convert<float>(o(b, m, i)),
+                            2e-3)
+                    << "row (" << b << ", " << m << "), col " << i;
+        }
+}
+
+template <typename MaskType>
+void check_splitkv_reference_all_shapes(const std::string& mask_str)
+{
+    ck_tile::test::for_each_fmha_test_seqlen([&](index_t seqlen_q, index_t seqlen_k) {
+        // bias alternates with the split count to keep the sweep over the shared shapes short
+        bool use_bias = false;
+        for(index_t num_splits : {1, 2, 5, 16, 128})
+        {
+            check_splitkv_reference<MaskType>(mask_str, seqlen_q, seqlen_k, num_splits, use_bias);
+            use_bias = !use_bias;
+        }
+    });
+}
+
+TEST(FmhaSplitKVReference, NoMask) { check_splitkv_reference_all_shapes<NoMask>("0"); }
+
+TEST(FmhaSplitKVReference, Causal)
+{
+    check_splitkv_reference_all_shapes<GenericMask>("t");
+    check_splitkv_reference_all_shapes<GenericMask>("b");
+}
+
+TEST(FmhaSplitKVReference, SlidingWindow)
+{
+    // some splits only see masked keys, some rows have no key at all
+    for(const std::string& mask_str : ck_tile::test::fmha_test_window_masks())
+        check_splitkv_reference_all_shapes<GenericMask>(mask_str);
+}
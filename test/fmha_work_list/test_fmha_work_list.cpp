@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/ops/fmha/kernel/fmha_fwd_work_list.hpp"
+
+using ck_tile::index_t;
+using ck_tile::long_index_t;
+
+ck_tile::FmhaFwdScheduleProblem make_problem(const std::vector<int32_t>& seqlens_q,
+                                             const std::vector<int32_t>& seqlens_k,
+                                             index_t num_slots,
+                                             long_index_t block_overhead = 0)
+{
+    ck_tile::FmhaFwdScheduleProblem problem{{0}, {0}, 2, 64, 128, 64, num_slots, block_overhead};
+    for(auto s : seqlens_q)
+        problem.seqstart_q.push_back(problem.seqstart_q.back() + s);
+    for(auto s : seqlens_k)
+        problem.seqstart_k.push_back(problem.seqstart_k.back() + s);
+    return problem;
+}
+
+// every unit of the work list exactly once, and block costs that add up
+void check_work_list(const ck_tile::FmhaFwdScheduleProblem& problem,
+                     const ck_tile::FmhaFwdWorkList& work_list,
+                     index_t num_blocks)
+{
+    const auto items = ck_tile::make_fmha_fwd_work_items(problem);
+    ASSERT_EQ(work_list.items.size(), items.size());
+    ASSERT_EQ(work_list.block_starts.size(), static_cast<std::size_t>(num_blocks + 1));
+    ASSERT_EQ(work_list.block_costs.size(), static_cast<std::size_t>(num_blocks));
+    EXPECT_EQ(work_list.block_starts.front(), 0);
+    EXPECT_EQ(work_list.block_starts.back(), static_cast<index_t>(items.size()));
+
+    auto key = [](const ck_tile::FmhaFwdWorkItem& item) {
+        return std::vector<index_t>{item.i_batch, item.i_nhead, item.i_tile_m, item.i_tile_n};
+    };
+    std::vector<std::vector<index_t>> expected, actual;
+    for(const auto& item : items)
+        expected.push_back(key(item));
+    for(const auto& item : work_list.items)
+        actual.push_back(key(item));
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    EXPECT_EQ(actual, expected);
+
+    for(index_t i = 0; i < num_blocks; ++i)
+    {
+        long_index_t cost = problem.block_overhead;
+        for(index_t j = work_list.block_starts[i]; j < work_list.block_starts[i + 1]; ++j)
+            cost += ck_tile::get_fmha_fwd_work_cost(problem, work_list.items[j]);
+        EXPECT_EQ(work_list.block_costs[i], cost);
+    }
+}
+
+TEST(FmhaFwdWorkList, LongestFirst)
+{
+    const auto problem = make_problem({300, 17, 1000, 128, 0, 129}, {300, 17, 1000, 64, 5, 0}, 4);
+    const auto items   = ck_tile::make_fmha_fwd_work_items(problem);
+
+    // 3 + 1 + 8 + 1 + 0 + 2 q-tiles of 2 heads, one v-tile each
+    ASSERT_EQ(items.size(), 30u);
+    for(std::size_t i = 1; i < items.size(); ++i)
+        EXPECT_GE(ck_tile::get_fmha_fwd_work_cost(problem, items[i - 1]),
+                  ck_tile::get_fmha_fwd_work_cost(problem, items[i]));
+
+    const auto work_list = ck_tile::make_fmha_fwd_work_list(problem, 4);
+    check_work_list(problem, work_list, 4);
+
+    // the greedy packing keeps the blocks within the largest unit of each other
+    const auto [min_cost, max_cost] =
+        std::minmax_element(work_list.block_costs.begin(), work_list.block_costs.end());
+    EXPECT_LE(*max_cost - *min_cost, ck_tile::get_fmha_fwd_work_cost(problem, items.front()));
+}
+
+TEST(FmhaFwdWorkList, Empty)
+{
+    // no batch at all, and batches without query rows
+    for(const auto& problem :
+        {make_problem({}, {}, 8, 10), make_problem({0, 0, 0}, {0, 4, 0}, 8, 10)})
+    {
+        EXPECT_TRUE(ck_tile::make_fmha_fwd_work_items(problem).empty());
+
+        const auto work_list = ck_tile::make_fmha_fwd_work_list(problem, 8);
+        check_work_list(problem, work_list, 8);
+
+        const auto grid = ck_tile::get_fmha_fwd_grid_stats(problem);
+        EXPECT_EQ(grid.num_blocks, 0);
+        EXPECT_EQ(grid.makespan, 0);
+        EXPECT_EQ(grid.efficiency, 1.0);
+
+        const auto packed = ck_tile::get_fmha_fwd_work_list_stats(problem, work_list);
+        EXPECT_EQ(packed.num_blocks, 8);
+        EXPECT_EQ(packed.num_idle_blocks, 8);
+        EXPECT_EQ(packed.total_cost, 0);
+        EXPECT_EQ(packed.makespan, 10);
+    }
+}
+
+TEST(FmhaFwdWorkList, SkewedSeqlens)
+{
+    // one long sequence among many short ones, the grid is sized by the long one
+    std::vector<std::vector<int32_t>> distributions = {
+        {4096, 16, 16, 16, 16, 16, 16, 16},
+        {8192, 1, 2, 3, 5, 8, 13, 21, 34, 55, 89, 144, 233, 377},
+        {2000, 2000, 100, 100, 100, 100, 50, 50, 50, 50, 1, 1},
+    };
+    for(const auto& seqlens : distributions)
+        for(index_t num_slots : {4, 16, 64})
+            for(long_index_t block_overhead : {0, 1000})
+            {
+                const auto problem   = make_problem(seqlens, seqlens, num_slots, block_overhead);
+                const auto grid      = ck_tile::get_fmha_fwd_grid_stats(problem);
+                const auto work_list = ck_tile::make_fmha_fwd_work_list(problem, num_slots);
+                check_work_list(problem, work_list, num_slots);
+                const auto packed = ck_tile::get_fmha_fwd_work_list_stats(problem, work_list);
+
+                EXPECT_EQ(packed.total_cost, grid.total_cost);
+                EXPECT_GT(grid.num_idle_blocks, 0);
+                EXPECT_LE(packed.makespan, grid.makespan);
+                EXPECT_GE(packed.efficiency, grid.efficiency);
+            }
+}
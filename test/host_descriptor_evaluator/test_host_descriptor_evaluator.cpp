@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <sstream>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_description/tensor_descriptor_helper.hpp"
+#include "ck/tensor_operation/operator_transform/transform_conv_fwd_to_gemm.hpp"
+#include "ck/library/utility/host_descriptor_evaluator.hpp"
+
+using namespace ck;
+using ck::utils::evaluate_descriptor;
+
+TEST(HostDescriptorEvaluator, Packed)
+{
+    const auto desc  = make_naive_tensor_descriptor_packed(make_tuple(4, 8));
+    const auto table = evaluate_descriptor(desc);
+
+    ASSERT_EQ(table.GetElementSize(), 32);
+    for(index_t i = 0; i < 32; ++i)
+    {
+        EXPECT_TRUE(table.mValid[i]);
+        EXPECT_EQ(table.mOffsets[i], i);
+    }
+
+    const auto runs = ck::utils::compress_offset_table(table);
+    ASSERT_EQ(runs.size(), 1);
+    EXPECT_EQ(runs[0].mLength, 32);
+    EXPECT_EQ(runs[0].mStride, 1);
+
+    EXPECT_EQ(ck::utils::get_max_vector_length(table, 1), 8);
+    EXPECT_EQ(ck::utils::get_max_vector_length(table, 1, 4), 4);
+    EXPECT_EQ(ck::utils::get_max_vector_length(table, 0), 1);
+}
+
+TEST(HostDescriptorEvaluator, PadAndMerge)
+{
+    // [4, 6] padded to [4, 8], then merged into [32]
+    const auto desc = make_naive_tensor_descriptor_packed(make_tuple(4, 6));
+    const auto desc_padded =
+        transform_tensor_descriptor(desc,
+                                    make_tuple(make_pass_through_transform(4),
+                                               make_right_pad_transform(6, 2)),
+                                    make_tuple(Sequence<0>{}, Sequence<1>{}),
+                                    make_tuple(Sequence<0>{}, Sequence<1>{}));
+    const auto desc_merged =
+        transform_tensor_descriptor(desc_padded,
+                                    make_tuple(make_merge_transform(make_tuple(4, 8))),
+                                    make_tuple(Sequence<0, 1>{}),
+                                    make_tuple(Sequence<0>{}));
+
+    for(const auto& table : {evaluate_descriptor(desc_padded), evaluate_descriptor(desc_merged)})
+    {
+        ASSERT_EQ(table.GetElementSize(), 32);
+        for(index_t m = 0; m < 4; ++m)
+        {
+            for(index_t n = 0; n < 8; ++n)
+            {
+                EXPECT_EQ(table.mValid[m * 8 + n], n < 6);
+                if(n < 6)
+                {
+                    EXPECT_EQ(table.mOffsets[m * 8 + n], m * 6 + n);
+                }
+            }
+        }
+
+        // a valid and an invalid run per row
+        const auto runs = ck::utils::compress_offset_table(table);
+        ASSERT_EQ(runs.size(), 8);
+        EXPECT_EQ(runs[2].mBegin, 8);
+        EXPECT_EQ(runs[2].mOffset, 6);
+        EXPECT_FALSE(runs[3].mValid);
+
+        const auto summary = ck::utils::summarize_offset_table(table);
+        EXPECT_EQ(summary.mNumValid, 24);
+        EXPECT_EQ(summary.mNumUniqueOffsets, 24);
+        EXPECT_EQ(summary.mMaxOffset, 23);
+    }
+
+    // rows start at offsets 6, 12, 18, only pairs are aligned. The padded pair of every row is
+    // skipped as a whole.
+    EXPECT_EQ(ck::utils::get_max_vector_length(evaluate_descriptor(desc_padded), 1), 2);
+    const auto desc_aligned = make_naive_tensor_descriptor(make_tuple(4, 6), make_tuple(8, 1));
+    EXPECT_EQ(ck::utils::get_max_vector_length(evaluate_descriptor(desc_aligned), 1), 2);
+}
+
+TEST(HostDescriptorEvaluator, BankConflicts)
+{
+    // 32 lanes reading a column of a 32 x 32 fp32 tile in LDS
+    const ck::utils::BankConflictConfig config{4, 32, 32, 4};
+
+    const auto desc_col = make_naive_tensor_descriptor(make_tuple(32, 32), make_tuple(1, 32));
+    const auto conflicts =
+        ck::utils::analyze_bank_conflicts(evaluate_descriptor(desc_col), config);
+    EXPECT_EQ(conflicts.mNumGroups, 32);
+    EXPECT_EQ(conflicts.mMaxConflictDegree, 32);
+
+    // padding every row by one element removes the conflicts
+    const auto desc_col_padded =
+        make_naive_tensor_descriptor(make_tuple(32, 32), make_tuple(1, 33));
+    const auto no_conflicts =
+        ck::utils::analyze_bank_conflicts(evaluate_descriptor(desc_col_padded), config);
+    EXPECT_EQ(no_conflicts.mMaxConflictDegree, 1);
+    EXPECT_EQ(no_conflicts.mAvgConflictDegree, 1);
+
+    // fp16 pairs share a bank word
+    const auto desc_row = make_naive_tensor_descriptor_packed(make_tuple(4, 64));
+    EXPECT_EQ(ck::utils::analyze_bank_conflicts(evaluate_descriptor(desc_row)).mMaxConflictDegree,
+              1);
+
+    std::ostringstream os;
+    os << ck::utils::summarize_offset_table(evaluate_descriptor(desc_col), config);
+    EXPECT_NE(os.str().find("bank conflicts max 32"), std::string::npos);
+}
+
+// the im2col descriptor of a 3x3 conv fwd against the input offsets computed directly
+TEST(HostDescriptorEvaluator, ConvFwdIm2col)
+{
+    constexpr index_t NDimSpatial = 2;
+    constexpr index_t G = 1, N = 2, C = 4, K = 3, Hi = 5, Wi = 6, Y = 3, X = 3;
+    constexpr index_t Ho = Hi, Wo = Wi;
+
+    // G, N, C, Hi, Wi lengths in NHWGC memory order
+    const std::array<index_t, 5> a_lengths{G, N, C, Hi, Wi};
+    const std::array<index_t, 5> a_strides{C, Hi * Wi * G * C, 1, Wi * G * C, G * C};
+    const std::array<index_t, 5> b_lengths{G, K, C, Y, X};
+    const std::array<index_t, 5> b_strides{K * Y * X * C, Y * X * C, 1, X * C, C};
+    const std::array<index_t, 5> e_lengths{G, N, K, Ho, Wo};
+    const std::array<index_t, 5> e_strides{K, Ho * Wo * G * K, 1, Wo * G * K, G * K};
+    const std::array<index_t, 2> strides{1, 1}, dilations{1, 1}, pads{1, 1};
+
+    using Transform = tensor_operation::TransformConvFwdToGemm<
+        NDimSpatial,
+        tensor_operation::device::ConvolutionForwardSpecialization::Default>;
+    const auto desc_m_k =
+        Transform::template MakeADescriptor_M_K<tensor_layout::convolution::NHWGC>(a_lengths,
+                                                                                  a_strides,
+                                                                                  b_lengths,
+                                                                                  b_strides,
+                                                                                  e_lengths,
+                                                                                  e_strides,
+                                                                                  strides,
+                                                                                  dilations,
+                                                                                  pads,
+                                                                                  pads);
+    const auto table = evaluate_descriptor(desc_m_k);
+
+    ASSERT_EQ(table.mLengths, (std::vector<index_t>{N * Ho * Wo, Y * X * C}));
+    for(index_t m = 0; m < N * Ho * Wo; ++m)
+    {
+        const index_t n = m / (Ho * Wo), ho = m / Wo % Ho, wo = m % Wo;
+        for(index_t k = 0; k < Y * X * C; ++k)
+        {
+            const index_t y = k / (X * C), x = k / C % X, c = k % C;
+            const index_t hi = ho + y - 1, wi = wo + x - 1;
+            const bool valid = hi >= 0 && hi < Hi && wi >= 0 && wi < Wi;
+
+            EXPECT_EQ(table.IsValid({m, k}), valid) << m << " " << k;
+            if(valid)
+            {
+                EXPECT_EQ(table.GetOffset({m, k}),
+                          n * a_strides[1] + hi * a_strides[3] + wi * a_strides[4] + c);
+            }
+        }
+    }
+
+    // C is contiguous, the padding is all or nothing per vector
+    EXPECT_EQ(ck::utils::get_max_vector_length(table, 1), 4);
+}
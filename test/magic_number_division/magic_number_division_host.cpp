@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/utility/magic_division.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace {
+
+// Small divisors against every 16-bit dividend, and dividends close to the end of the 31-bit range
+std::vector<uint32_t> MakeDividends(uint32_t divisor)
+{
+    std::vector<uint32_t> dividends(1 << 16);
+    std::iota(dividends.begin(), dividends.end(), 0);
+    for(uint32_t i = 0; i < 64; ++i)
+    {
+        dividends.push_back(INT32_MAX - i);
+    }
+    // around the multiples of the divisor closest to INT32_MAX
+    for(uint32_t k = 1; k <= 8 && k <= INT32_MAX / divisor; ++k)
+    {
+        const uint32_t multiple = (INT32_MAX / divisor - k + 1) * divisor;
+        for(uint32_t j = 0; j < 8; ++j)
+        {
+            if(multiple + j <= INT32_MAX)
+                dividends.push_back(multiple + j);
+            dividends.push_back(multiple - 1 - j);
+        }
+    }
+    return dividends;
+}
+
+std::vector<uint32_t> MakeDivisors()
+{
+    std::vector<uint32_t> divisors(4096);
+    std::iota(divisors.begin(), divisors.end(), 1);
+    for(uint32_t shift = 12; shift < 31; ++shift)
+    {
+        divisors.push_back((1U << shift) - 1);
+        divisors.push_back(1U << shift);
+        divisors.push_back((1U << shift) + 1);
+    }
+    divisors.push_back(INT32_MAX);
+    return divisors;
+}
+
+} // namespace
+
+TEST(MagicNumberDivisionHost, Batched)
+{
+    std::vector<uint32_t> quotients;
+    std::vector<uint32_t> remainders;
+    std::vector<uint32_t> quotients2;
+    for(uint32_t divisor : MakeDivisors())
+    {
+        const auto dividends  = MakeDividends(divisor);
+        const ck::index_t num = dividends.size();
+        quotients.resize(num);
+        remainders.resize(num);
+        quotients2.resize(num);
+
+        const ck::MDiv mdiv(divisor);
+        mdiv.divmod(dividends.data(), quotients.data(), remainders.data(), num);
+        ck::MDiv2(divisor).div(dividends.data(), quotients2.data(), num);
+
+        std::size_t num_errors = 0;
+        for(ck::index_t i = 0; i < num; ++i)
+        {
+            const bool pass =
+                quotients[i] == dividends[i] / divisor && remainders[i] == dividends[i] % divisor &&
+                quotients2[i] == quotients[i] && mdiv.div(dividends[i]) == quotients[i];
+            num_errors += pass ? 0 : 1;
+        }
+        EXPECT_EQ(num_errors, 0) << "divisor " << divisor;
+    }
+}
+
+TEST(MagicNumberDivisionHost, BatchedInt32)
+{
+    const int32_t divisor = 641;
+    uint32_t multiplier, shift;
+    ck::tie(multiplier, shift) = ck::MagicDivision::CalculateMagicNumbers(uint32_t(divisor));
+
+    std::vector<int32_t> dividends(1 << 20);
+    std::iota(dividends.begin(), dividends.end(), INT32_MAX - (1 << 20) + 1);
+    std::vector<int32_t> quotients(dividends.size());
+    ck::MagicDivision::DoMagicDivision(
+        dividends.data(), quotients.data(), dividends.size(), multiplier, shift);
+    for(std::size_t i = 0; i < dividends.size(); ++i)
+    {
+        EXPECT_EQ(quotients[i], dividends[i] / divisor);
+    }
+}
+
+TEST(MagicNumberDivisionHost, MixedRadix)
+{
+    const std::array<uint32_t, 4> lengths{3, 7, 1, 64};
+    const uint32_t size = 3 * 7 * 1 * 64;
+    const ck::MDivMixedRadix<4> radix(lengths);
+
+    std::vector<uint32_t> idxs(size + 16);
+    std::iota(idxs.begin(), idxs.end(), 0);
+    std::vector<uint32_t> coords(idxs.size() * 4);
+    radix.decompose(idxs.data(), idxs.size(), coords.data());
+
+    for(uint32_t i = 0; i < idxs.size(); ++i)
+    {
+        std::array<uint32_t, 4> expected;
+        uint32_t idx = i;
+        for(int d = 3; d >= 0; --d)
+        {
+            // the first dim is not wrapped around
+            expected[d] = d == 0 ? idx : idx % lengths[d];
+            idx /= lengths[d];
+        }
+        std::array<uint32_t, 4> scalar;
+        radix.decompose(i, scalar.data());
+        for(int d = 0; d < 4; ++d)
+        {
+            EXPECT_EQ(coords[i * 4 + d], expected[d]);
+            EXPECT_EQ(scalar[d], expected[d]);
+        }
+        EXPECT_EQ(radix.get(3), 64);
+    }
+
+    // lengths with random idxs up to the end of the 31-bit range
+    const std::array<uint32_t, 3> large_lengths{1U << 10, 3, 699051};
+    const ck::MDivMixedRadix<3> large_radix(large_lengths);
+    std::mt19937 gen(11939);
+    std::uniform_int_distribution<uint32_t> dis(0, INT32_MAX);
+    for(int i = 0; i < 100000; ++i)
+    {
+        const uint32_t idx = dis(gen);
+        std::array<uint32_t, 3> coord;
+        large_radix.decompose(idx, coord.data());
+        EXPECT_EQ(coord[2], idx % large_lengths[2]);
+        EXPECT_EQ(coord[1], idx / large_lengths[2] % large_lengths[1]);
+        EXPECT_EQ(coord[0], idx / large_lengths[2] / large_lengths[1]);
+    }
+}
+
+TEST(MagicNumberDivisionHost, ParallelTensorFunctor)
+{
+    // every index is visited once, with the coordinates of its row-major position
+    const std::size_t n0 = 5, n1 = 1, n2 = 13, n3 = 6;
+    std::vector<int> visits(n0 * n1 * n2 * n3, 0);
+    make_ParallelTensorFunctor(
+        [&](std::size_t i0, std::size_t i1, std::size_t i2, std::size_t i3) {
+            visits[((i0 * n1 + i1) * n2 + i2) * n3 + i3]++;
+        },
+        n0,
+        n1,
+        n2,
+        n3)(1);
+    EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](int v) { return v == 1; }));
+}
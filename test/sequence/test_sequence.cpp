@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/utility/common_header.hpp"
+
+using namespace ck;
+
+namespace {
+
+template <index_t... Is>
+std::vector<index_t> to_vector(Sequence<Is...>)
+{
+    return {Is...};
+}
+
+// unsorted values with duplicates
+template <index_t I, index_t NSize>
+struct ValueGen
+{
+    __host__ __device__ constexpr index_t operator()(index_t k) const
+    {
+        return (k * 37 + I * 11) % (2 * NSize + 1) - 3;
+    }
+};
+
+// a permutation of [0, NSize)
+template <index_t I, index_t NSize>
+struct PermutationGen
+{
+    __host__ __device__ constexpr index_t operator()(index_t k) const
+    {
+        return (k * (NSize - 1) + I) % NSize;
+    }
+};
+
+template <index_t I>
+void check_sequence_algorithms()
+{
+    constexpr index_t NSize = I;
+
+    using Values      = typename sequence_gen<NSize, ValueGen<I, NSize>>::type;
+    const auto values = to_vector(Values{});
+    ASSERT_EQ(values.size(), NSize);
+    for(index_t k = 0; k < NSize; ++k)
+        EXPECT_EQ(values[k], (ValueGen<I, NSize>{}(k)));
+
+    // sort, ids map the sorted values back to the unsorted ones
+    using Sort        = sequence_sort<Values, math::less<index_t>>;
+    const auto sorted = to_vector(typename Sort::type{});
+    const auto ids    = to_vector(typename Sort::sorted2unsorted_map{});
+    EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+    ASSERT_EQ(ids.size(), NSize);
+    for(index_t k = 0; k < NSize; ++k)
+        EXPECT_EQ(sorted[k], values[ids[k]]);
+    auto sorted_ids = ids;
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    std::vector<index_t> iota(NSize);
+    std::iota(iota.begin(), iota.end(), 0);
+    EXPECT_EQ(sorted_ids, iota);
+
+    // unique sort keeps the first of every run of equal sorted values
+    using UniqueSort = sequence_unique_sort<Values, math::less<index_t>, math::equal<index_t>>;
+    const auto unique     = to_vector(typename UniqueSort::type{});
+    const auto unique_ids = to_vector(typename UniqueSort::sorted2unsorted_map{});
+    std::vector<index_t> ref_unique, ref_unique_ids;
+    for(index_t k = 0; k < NSize; ++k)
+    {
+        if(k == 0 || sorted[k] != sorted[k - 1])
+        {
+            ref_unique.push_back(sorted[k]);
+            ref_unique_ids.push_back(ids[k]);
+        }
+    }
+    EXPECT_EQ(unique, ref_unique);
+    EXPECT_EQ(unique_ids, ref_unique_ids);
+
+    // map inverse and reorder
+    using Map      = typename sequence_gen<NSize, PermutationGen<I, NSize>>::type;
+    const auto map = to_vector(Map{});
+    if constexpr(is_valid_sequence_map<Map>::value)
+    {
+        const auto inverse = to_vector(typename sequence_map_inverse<Map>::type{});
+        for(index_t k = 0; k < NSize; ++k)
+            EXPECT_EQ(inverse[map[k]], k);
+
+        const auto new2old = to_vector(Values::ReorderGivenNew2Old(Map{}));
+        const auto old2new = to_vector(Values::ReorderGivenOld2New(Map{}));
+        for(index_t k = 0; k < NSize; ++k)
+        {
+            EXPECT_EQ(new2old[k], values[map[k]]);
+            EXPECT_EQ(old2new[map[k]], values[k]);
+        }
+    }
+    else
+    {
+        auto sorted_map = map;
+        std::sort(sorted_map.begin(), sorted_map.end());
+        EXPECT_NE(sorted_map, iota);
+    }
+
+    // scans
+    const auto rscan =
+        to_vector(reverse_inclusive_scan_sequence(Values{}, math::plus<index_t>{}, Number<1>{}));
+    const auto scan =
+        to_vector(inclusive_scan_sequence(Values{}, math::plus<index_t>{}, Number<0>{}));
+    index_t acc = 1;
+    for(index_t k = NSize - 1; k >= 0; --k)
+    {
+        acc += values[k];
+        EXPECT_EQ(rscan[k], acc);
+    }
+    acc = 0;
+    for(index_t k = 0; k < NSize; ++k)
+    {
+        acc += values[k];
+        EXPECT_EQ(scan[k], acc);
+    }
+
+    // reverse
+    auto reversed = values;
+    std::reverse(reversed.begin(), reversed.end());
+    EXPECT_EQ(to_vector(Values::Reverse()), reversed);
+
+    if constexpr(NSize > 0)
+    {
+        // pop back, modify
+        EXPECT_EQ(to_vector(Values::PopBack()),
+                  std::vector<index_t>(values.begin(), values.end() - 1));
+
+        auto modified       = values;
+        modified[NSize / 2] = 99;
+        EXPECT_EQ(to_vector(Values::Modify(Number<NSize / 2>{}, Number<99>{})), modified);
+
+        // pick by mask
+        using Mask = typename sequence_gen<NSize, PermutationGen<I, 2>>::type;
+        std::vector<index_t> picked;
+        for(index_t k = 0; k < NSize; ++k)
+            if(Mask::At(k))
+                picked.push_back(values[k]);
+        EXPECT_EQ(to_vector(pick_sequence_elements_by_mask(Values{}, Mask{})), picked);
+    }
+
+    if constexpr(NSize > 1)
+    {
+        // modify by ids
+        auto modified       = values;
+        modified[NSize - 1] = 7;
+        modified[0]         = 8;
+        EXPECT_EQ(to_vector(modify_sequence_elements_by_ids(
+                      Values{}, Sequence<7, 8>{}, Sequence<NSize - 1, 0>{})),
+                  modified);
+    }
+}
+
+template <index_t... Is>
+void check_sequence_algorithms(Sequence<Is...>)
+{
+    (check_sequence_algorithms<Is>(), ...);
+}
+
+} // namespace
+
+TEST(Sequence, Generate)
+{
+    static_assert(is_same<typename arithmetic_sequence_gen<0, 0, 1>::type, Sequence<>>::value);
+    static_assert(is_same<typename arithmetic_sequence_gen<2, 9, 3>::type, Sequence<2, 5>>::value);
+    static_assert(
+        is_same<typename arithmetic_sequence_gen<6, -1, -2>::type, Sequence<6, 4, 2>>::value);
+    static_assert(is_same<typename arithmetic_sequence_gen<5, 0, 1>::type, Sequence<>>::value);
+    static_assert(is_same<typename uniform_sequence_gen<3, 7>::type, Sequence<7, 7, 7>>::value);
+    static_assert(is_same<make_index_sequence<4>, Sequence<0, 1, 2, 3>>::value);
+    static_assert(is_same<typename sequence_merge<Sequence<1>, Sequence<>, Sequence<2, 3>>::type,
+                          Sequence<1, 2, 3>>::value);
+}
+
+TEST(Sequence, Sort)
+{
+    using Sort = sequence_sort<Sequence<3, 1, 2, 1, 0>, math::less<index_t>>;
+    static_assert(is_same<typename Sort::type, Sequence<0, 1, 1, 2, 3>>::value);
+    static_assert(is_same<typename Sort::sorted2unsorted_map, Sequence<4, 3, 1, 2, 0>>::value);
+
+    using UniqueSort =
+        sequence_unique_sort<Sequence<3, 1, 2, 1, 0>, math::less<index_t>, math::equal<index_t>>;
+    static_assert(is_same<typename UniqueSort::type, Sequence<0, 1, 2, 3>>::value);
+    static_assert(is_same<typename UniqueSort::sorted2unsorted_map, Sequence<4, 3, 2, 0>>::value);
+
+    static_assert(is_valid_sequence_map<Sequence<2, 0, 1>>::value);
+    static_assert(!is_valid_sequence_map<Sequence<2, 0, 0>>::value);
+    static_assert(!is_valid_sequence_map<Sequence<3, 0, 1>>::value);
+    static_assert(
+        is_same<typename sequence_map_inverse<Sequence<2, 0, 1>>::type, Sequence<1, 2, 0>>::value);
+}
+
+TEST(Sequence, Algorithms)
+{
+    check_sequence_algorithms(make_index_sequence<24>{});
+}
+
+TEST(Tuple, ElementAccess)
+{
+    int a   = 1;
+    float b = 2;
+
+    auto t         = make_tuple(1, 2.5f, Number<3>{});
+    t(Number<1>{}) = 4.5f;
+    EXPECT_EQ(t[Number<0>{}], 1);
+    EXPECT_EQ(t[Number<1>{}], 4.5f);
+    static_assert(remove_cvref_t<decltype(t[Number<2>{}])>::value == 3);
+    static_assert(is_same<tuple_element_t<1, decltype(t)>, float>::value);
+
+    auto refs         = tie(a, b);
+    refs(Number<0>{}) = 5;
+    EXPECT_EQ(a, 5);
+    static_assert(is_same<tuple_element_t<0, decltype(refs)>, int&>::value);
+
+    const auto lengths = generate_tuple([](auto i) { return i * 2; }, Number<5>{});
+    static_assert(decltype(lengths)::Size() == 5);
+    EXPECT_EQ(lengths[Number<4>{}], 8);
+}
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_description/tensor_descriptor_helper.hpp"
+#include "ck/library/utility/host_slice_transfer_analyzer.hpp"
+
+using namespace ck;
+using ck::utils::analyze_thread_group_slice_transfer;
+
+namespace {
+
+// the A block transfer of the xdl gemms: [K0, M, K1] = [4, 64, 8] slice of a row major fp16 A
+// with K = 64, 256 threads
+using BlockSliceLengths    = Sequence<4, 64, 8>;
+using ThreadClusterLengths = Sequence<4, 64, 1>;
+using ArrangeOrder         = Sequence<1, 0, 2>;
+
+constexpr index_t M = 64, K0 = 8, K1 = 8;
+
+auto make_a_desc()
+{
+    return make_naive_tensor_descriptor(make_tuple(K0, M, K1), make_tuple(K1, K0 * K1, 1));
+}
+
+} // namespace
+
+TEST(SliceTransferAnalyzer, RowMajorSrc)
+{
+    const auto report = analyze_thread_group_slice_transfer<BlockSliceLengths,
+                                                            ThreadClusterLengths,
+                                                            ArrangeOrder,
+                                                            Sequence<1, 0, 2>,
+                                                            2,
+                                                            8>(make_a_desc());
+    EXPECT_EQ(report.mNumThreads, 256);
+    EXPECT_EQ(report.mNumAccessPerThread, 1);
+    EXPECT_TRUE(report.mVectorAccessValid);
+    EXPECT_EQ(report.mMaxScalarPerVector, 8);
+    // 4 waves, 16 rows of M per wave, 4 lanes load 64 contiguous bytes of a 128 byte row
+    EXPECT_EQ(report.mNumRequests, 4);
+    EXPECT_EQ(report.mAvgBytesPerRequest, 1024);
+    EXPECT_EQ(report.mAvgContiguousBytes, 64);
+    EXPECT_EQ(report.mMinContiguousBytes, 64);
+    EXPECT_EQ(report.mAvgCacheLinesPerRequest, 16);
+    EXPECT_EQ(report.mCoalescingEfficiency, 0.5);
+
+    std::ostringstream os;
+    os << report;
+    EXPECT_NE(os.str().find("vector 8 (max 8)"), std::string::npos);
+}
+
+TEST(SliceTransferAnalyzer, ScalarSrc)
+{
+    // same slice loaded element by element: 8 times the requests, the wider vector is reported
+    const auto report = analyze_thread_group_slice_transfer<BlockSliceLengths,
+                                                            ThreadClusterLengths,
+                                                            ArrangeOrder,
+                                                            Sequence<1, 0, 2>,
+                                                            2,
+                                                            1>(make_a_desc());
+    EXPECT_TRUE(report.mVectorAccessValid);
+    EXPECT_EQ(report.mNumAccessPerThread, 8);
+    EXPECT_EQ(report.mMaxScalarPerVector, 8);
+    EXPECT_EQ(report.mNumRequests, 32);
+    EXPECT_EQ(report.mAvgBytesPerRequest, 128);
+    EXPECT_EQ(report.mMinContiguousBytes, 2);
+    EXPECT_EQ(report.mAvgCacheLinesPerRequest, 16);
+    EXPECT_EQ(report.mCoalescingEfficiency, 128.0 / (16 * 128));
+}
+
+TEST(SliceTransferAnalyzer, WrongVectorDim)
+{
+    // M is not contiguous in a row major A
+    const auto report = analyze_thread_group_slice_transfer<Sequence<4, 64, 8>,
+                                                            Sequence<4, 8, 8>,
+                                                            Sequence<0, 2, 1>,
+                                                            Sequence<0, 2, 1>,
+                                                            1,
+                                                            8>(make_a_desc());
+    EXPECT_FALSE(report.mVectorAccessValid);
+    EXPECT_EQ(report.mMaxScalarPerVector, 1);
+}
+
+TEST(SliceTransferAnalyzer, LdsDst)
+{
+    // the [K0, M, K1] LDS block of the xdl gemms, with and without the extra M padding
+    auto analyze_lds = [](index_t extra_m) {
+        const auto desc = make_naive_tensor_descriptor(make_tuple(4, M, K1),
+                                                       make_tuple((M + extra_m) * K1, K1, 1));
+        return analyze_thread_group_slice_transfer<BlockSliceLengths,
+                                                   ThreadClusterLengths,
+                                                   ArrangeOrder,
+                                                   Sequence<0, 1, 2>,
+                                                   2,
+                                                   8>(desc);
+    };
+
+    // 8 lanes of 16 bytes per cycle, the 4 K0 of a row of M hit the same banks without padding
+    const auto report = analyze_lds(0);
+    EXPECT_TRUE(report.mVectorAccessValid);
+    EXPECT_EQ(report.mBankConflicts.mNumGroups, 32);
+    EXPECT_EQ(report.mBankConflicts.mMaxConflictDegree, 4);
+
+    const auto padded_report = analyze_lds(1);
+    EXPECT_TRUE(padded_report.mVectorAccessValid);
+    EXPECT_EQ(padded_report.mBankConflicts.mMaxConflictDegree, 2);
+}
+
+TEST(SliceTransferAnalyzer, OutOfBound)
+{
+    // the last rows of the block slice are past the end of a 48 x 64 A
+    const auto desc =
+        make_naive_tensor_descriptor(make_tuple(K0, 48, K1), make_tuple(K1, K0 * K1, 1));
+    const auto report = analyze_thread_group_slice_transfer<BlockSliceLengths,
+                                                            ThreadClusterLengths,
+                                                            ArrangeOrder,
+                                                            Sequence<1, 0, 2>,
+                                                            2,
+                                                            8>(desc);
+    EXPECT_TRUE(report.mVectorAccessValid);
+    EXPECT_EQ(report.mNumRequests, 3);
+    EXPECT_EQ(report.mAvgContiguousBytes, 64);
+}
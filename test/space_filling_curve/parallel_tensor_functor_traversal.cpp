@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/utility/common_header.hpp"
+#include "ck/tensor_description/tensor_space_filling_curve.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace {
+
+// every index is visited once, whatever the order and the tiles
+void CheckVisits(HostTraversalEnum traversal,
+                 const std::array<std::size_t, 3>& tile_lens,
+                 std::size_t num_thread)
+{
+    const std::size_t n0 = 3, n1 = 37, n2 = 70;
+    std::vector<std::atomic<int>> visits(n0 * n1 * n2);
+    for(auto& v : visits)
+        v = 0;
+    make_ParallelTensorFunctor(
+        [&](std::size_t i0, std::size_t i1, std::size_t i2) { visits[(i0 * n1 + i1) * n2 + i2]++; },
+        n0,
+        n1,
+        n2)
+        .SetTraversal(traversal, tile_lens)(num_thread);
+    EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](const auto& v) { return v == 1; }))
+        << "traversal " << static_cast<int>(traversal) << ", tiles " << tile_lens[0] << "x"
+        << tile_lens[1] << "x" << tile_lens[2] << ", " << num_thread << " threads";
+}
+
+} // namespace
+
+TEST(ParallelTensorFunctorTraversal, VisitOnce)
+{
+    for(auto traversal : {HostTraversalEnum::RowMajor,
+                          HostTraversalEnum::Tiled,
+                          HostTraversalEnum::Snake,
+                          HostTraversalEnum::Morton})
+    {
+        for(const auto& tile_lens : std::vector<std::array<std::size_t, 3>>{
+                {1, 8, 8}, {2, 5, 16}, {0, 0, 0}, {1, 64, 128}, {4, 1, 1}})
+        {
+            for(std::size_t num_thread : {1, 3, 8})
+            {
+                CheckVisits(traversal, tile_lens, num_thread);
+            }
+        }
+    }
+}
+
+TEST(ParallelTensorFunctorTraversal, SnakeTileOrder)
+{
+    // one index per tile, the visit order is the one of the snake curve of SpaceFillingCurve
+    using Curve = ck::SpaceFillingCurve<ck::Sequence<3, 4, 5>,
+                                        ck::Sequence<0, 1, 2>,
+                                        ck::Sequence<1, 1, 1>,
+                                        true>;
+    std::vector<std::array<std::size_t, 3>> visits;
+    make_ParallelTensorFunctor(
+        [&](std::size_t i0, std::size_t i1, std::size_t i2) { visits.push_back({i0, i1, i2}); },
+        3,
+        4,
+        5)
+        .SetTraversal(HostTraversalEnum::Snake, {1, 1, 1})(1);
+
+    ASSERT_EQ(visits.size(), Curve::GetNumOfAccess());
+    ck::static_for<0, Curve::GetNumOfAccess(), 1>{}([&](auto i) {
+        constexpr auto idx = Curve::GetIndex(i);
+        EXPECT_EQ(visits[i][0], idx[ck::Number<0>{}]);
+        EXPECT_EQ(visits[i][1], idx[ck::Number<1>{}]);
+        EXPECT_EQ(visits[i][2], idx[ck::Number<2>{}]);
+    });
+}
+
+TEST(ParallelTensorFunctorTraversal, MortonTileOrder)
+{
+    // 4x4 tiles of 2x2, the tiles follow the Z-order curve and are visited row-major
+    std::vector<std::array<std::size_t, 2>> visits;
+    make_ParallelTensorFunctor([&](std::size_t i0, std::size_t i1) { visits.push_back({i0, i1}); },
+                               8,
+                               8)
+        .SetTraversal(HostTraversalEnum::Morton, 2)(1);
+
+    const std::array<std::array<std::size_t, 2>, 16> tiles{{{0, 0},
+                                                            {0, 1},
+                                                            {1, 0},
+                                                            {1, 1},
+                                                            {0, 2},
+                                                            {0, 3},
+                                                            {1, 2},
+                                                            {1, 3},
+                                                            {2, 0},
+                                                            {2, 1},
+                                                            {3, 0},
+                                                            {3, 1},
+                                                            {2, 2},
+                                                            {2, 3},
+                                                            {3, 2},
+                                                            {3, 3}}};
+    ASSERT_EQ(visits.size(), 64);
+    for(std::size_t t = 0; t < tiles.size(); ++t)
+    {
+        for(std::size_t i = 0; i < 4; ++i)
+        {
+            EXPECT_EQ(visits[t * 4 + i][0], tiles[t][0] * 2 + i / 2);
+            EXPECT_EQ(visits[t * 4 + i][1], tiles[t][1] * 2 + i % 2);
+        }
+    }
+}
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MIT
 // Copyright (c) 2023-2024, Advanced Micro Devices, Inc. All rights reserved.
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <initializer_list>
@@ -10,6 +11,7 @@
 #include "ck/utility/common_header.hpp"
 
 #include "ck/wrapper/layout.hpp"
+#include "ck/wrapper/host_layout.hpp"
 
 #include "ck/tensor_description/tensor_descriptor.hpp"
 #include "ck/tensor_description/tensor_descriptor_helper.hpp"
@@ -63,6 +65,36 @@ class TestWrapperLayout : public ::testing::Test
             EXPECT_EQ(layout_runtime_offset, desc_offset);
             EXPECT_EQ(layout_runtime_offset, layout_compiletime_offset);
         }
+        RunHost(layout_runtime, idxs);
+        RunHost(layout_compiletime, idxs);
+    }
+
+    // Check host layout against the descriptors of the layout
+    template <typename Layout, typename Idxs>
+    void RunHost(Layout& layout, const std::vector<Idxs>& idxs)
+    {
+        const auto host_layout = ck::wrapper::make_host_layout(layout);
+        const ck::index_t size = ck::wrapper::size(layout);
+
+        std::vector<ck::index_t> offsets_1d(size);
+        host_layout.CalculateOffsets(0, size, offsets_1d.data());
+        for(ck::index_t i = 0; i < size; i++)
+        {
+            EXPECT_EQ(host_layout(ck::make_tuple(i)), layout(ck::make_tuple(i)));
+            EXPECT_EQ(offsets_1d[i], layout(ck::make_tuple(i)));
+        }
+        // Batch starting in the middle of the unrolled dims
+        std::vector<ck::index_t> offsets_tail(size - size / 3);
+        host_layout.CalculateOffsets(size / 3, size - size / 3, offsets_tail.data());
+        EXPECT_TRUE(std::equal(offsets_tail.begin(), offsets_tail.end(), &offsets_1d[size / 3]));
+
+        std::vector<ck::index_t> offsets(idxs.size());
+        host_layout.CalculateOffsets(idxs.data(), idxs.size(), offsets.data());
+        for(std::size_t i = 0; i < idxs.size(); i++)
+        {
+            EXPECT_EQ(host_layout(idxs[i]), layout(idxs[i]));
+            EXPECT_EQ(offsets[i], layout(idxs[i]));
+        }
     }
 };
 
@@ -472,3 +504,45 @@ TEST(TestLayoutHelpers, Hierarchical)
 
     EXPECT_EQ((ck::wrapper::get<0, 0, 0>(runtime_shape)), d4);
 }
+
+TEST(TestLayoutHelpers, HostLayout)
+{
+    // dims:((3, 5), 7) strides:((7, 21), 1)
+    constexpr ck::index_t d2  = 3;
+    constexpr ck::index_t d1  = 5;
+    constexpr ck::index_t d0  = 7;
+    const auto layout_runtime = ck::wrapper::make_layout(
+        ck::make_tuple(ck::make_tuple(d2, d1), d0), ck::make_tuple(ck::make_tuple(d0, d0 * d2), 1));
+    const auto host_layout = ck::wrapper::make_host_layout(layout_runtime);
+
+    EXPECT_EQ(host_layout.GetLengths(), (std::array<ck::index_t, 3>{d2, d1, d0}));
+    EXPECT_EQ(host_layout.GetStrides(), (std::array<ck::index_t, 3>{d0, d0 * d2, 1}));
+
+    // Padded and sliced layouts are evaluated through their descriptors
+    const auto layout_padded = ck::wrapper::pad(ck::wrapper::make_layout(ck::make_tuple(d2, d0)),
+                                                ck::make_tuple(4, 8));
+    const auto host_padded   = ck::wrapper::make_host_layout(layout_padded);
+    for(ck::index_t i = 0; i < 4 * 8; i++)
+    {
+        EXPECT_EQ(host_padded(ck::make_tuple(i)), layout_padded(ck::make_tuple(i)));
+    }
+    const auto layout_sub = ck::wrapper::get<0>(layout_runtime);
+    const auto host_sub   = ck::wrapper::make_host_layout(layout_sub);
+    for(ck::index_t i = 0; i < d2 * d1; i++)
+    {
+        EXPECT_EQ(host_sub(ck::make_tuple(i)), layout_sub(ck::make_tuple(i)));
+    }
+    // Nested index of a rank-1 shape is not a 1d access
+    const auto layout_rank1 = ck::wrapper::make_layout(
+        ck::make_tuple(ck::make_tuple(d2, d1)), ck::make_tuple(ck::make_tuple(d0, d0 * d2)));
+    const auto host_rank1 = ck::wrapper::make_host_layout(layout_rank1);
+    for(ck::index_t j = 0; j < d1; j++)
+    {
+        for(ck::index_t i = 0; i < d2; i++)
+        {
+            const auto idx = ck::make_tuple(ck::make_tuple(i, j));
+            EXPECT_EQ(host_rank1(idx), layout_rank1(idx));
+            EXPECT_EQ(host_rank1(idx), i * d0 + j * d0 * d2);
+        }
+    }
+}